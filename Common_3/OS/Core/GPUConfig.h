@@ -4,38 +4,9 @@
 #include "../Interfaces/IFileSystem.h"
 #include "../../Renderer/IRenderer.h"
 
-#include <regex>
+#include "../../ThirdParty/OpenSource/EASTL/sort.h"
 
-static void fsReadFromStreamLine(FileStream* stream, char* pOutLine)
-{
-	uint32_t charIndex = 0;
-	while (!fsStreamAtEnd(stream))
-	{
-		char nextChar = 0;
-		fsReadFromStream(stream, &nextChar, sizeof(nextChar));
-		if (nextChar == 0 || nextChar == '\n')
-		{
-			break;
-		}
-		if (nextChar == '\r')
-		{
-			char newLine = 0;
-			fsReadFromStream(stream, &newLine, sizeof(newLine));
-			if (newLine == '\n')
-			{
-				break;
-			}
-			else
-			{
-				// We're not looking at a "\r\n" sequence, so add the '\r' to the buffer.
-				fsSeekStream(stream, SBO_CURRENT_POSITION, -1);
-			}
-		}
-		pOutLine[charIndex++] = nextChar;
-	}
-
-	pOutLine[charIndex] = 0;
-}
+#include <stdlib.h>
 
 inline GPUPresetLevel stringToPresetLevel(const char* presetLevel)
 {
@@ -67,145 +38,305 @@ inline const char* presetLevelToString(GPUPresetLevel preset)
 	}
 }
 
-bool parseConfigLine(
-	const char* pLine,
-	const char* pInVendorId,
-	const char* pInModelId,
-	char pOutVendorId[MAX_GPU_VENDOR_STRING_LENGTH],
-	char pOutModelId[MAX_GPU_VENDOR_STRING_LENGTH],
-	char pOutRevisionId[MAX_GPU_VENDOR_STRING_LENGTH],
-	char pOutModelName[MAX_GPU_VENDOR_STRING_LENGTH],
-    GPUPresetLevel* pOutPresetLevel)
+/************************************************************************/
+// GPU config table
+/************************************************************************/
+// gpu.cfg is parsed once into a table sorted by vendor and model id which all queries share.
+// The table is saved next to it as gpu.bin whenever gpu.cfg had to be parsed, later runs load gpu.bin with a single read
+// until gpu.cfg is modified again. Shipping builds can ship the gpu.bin written on a development machine.
+#define GPU_CONFIG_BINARY_MAGIC   0x47464347 // "GCFG"
+#define GPU_CONFIG_BINARY_VERSION 1
+
+typedef struct GPUConfigEntry
 {
-	//     VendorId;         ModelId;        Preset;             Name;               RevisionId (optional); Codename (can be null)
-	// ([0xA-Fa-f0-9]+); ([0xA-Fa-f0-9]+); ([A-Za-z]); ([A-Za-z0-9 /\\(\\);]+)[; ]*([0xA-Fa-f0-9]*)
-	char buffer[128] = {};
-	sprintf(
-		buffer,
-		"%s; %s; ([A-Za-z]+); ([A-Za-z0-9 /\\(\\);]+)[; ]*([0xA-Fa-f0-9]*)",
-		// If input is unspecified it means we need to fill it
-		pInVendorId ? pInVendorId : "([0xA-Fa-f0-9]+)",
-		pInModelId ? pInModelId : "([0xA-Fa-f0-9]+)");
-
-	const uint32_t presetIndex   = pInVendorId ? 1 : 3;
-	const uint32_t gpuNameIndex  = pInVendorId ? 2 : 4;
-	const uint32_t revisionIndex = pInVendorId ? 3 : 5;
-
-	std::regex expr(buffer, std::regex::optimize);
-	std::cmatch match;
-	if (std::regex_match(pLine, match, expr))
-	{
-		if (!pInVendorId)
-		{
-			strncpy(pOutVendorId, match[1].first, match[1].second - match[1].first);
-			strncpy(pOutModelId, match[2].first, match[2].second - match[2].first);
-		}
+	uint32_t       mVendorId;
+	uint32_t       mModelId;
+	/// Zero if the entry applies to all revisions
+	uint32_t       mRevisionId;
+	GPUPresetLevel mPresetLevel;
+	char           mGpuName[MAX_GPU_VENDOR_STRING_LENGTH];
+} GPUConfigEntry;
+
+typedef struct GPUConfigBinaryHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mEntrySize;
+	uint32_t mEntryCount;
+} GPUConfigBinaryHeader;
+
+typedef struct GPUConfigTable
+{
+	GPUConfigEntry* pEntries;
+	uint32_t        mEntryCount;
+	bool            mLoaded;
+} GPUConfigTable;
 
-		char presetLevel[MAX_GPU_VENDOR_STRING_LENGTH] = {};
-		strncpy(presetLevel, match[presetIndex].first,   match[presetIndex].second -   match[presetIndex].first);
-		strncpy(pOutModelName,  match[gpuNameIndex].first,  match[gpuNameIndex].second -  match[gpuNameIndex].first);
-		strncpy(pOutRevisionId,  match[revisionIndex].first, match[revisionIndex].second - match[revisionIndex].first);
+static GPUConfigTable gGPUConfigTable = {};
 
-		*pOutPresetLevel = stringToPresetLevel(presetLevel);
-		return true;
-	}
+static inline uint64_t gpuConfigKey(uint32_t vendorId, uint32_t modelId) { return ((uint64_t)vendorId << 32) | modelId; }
+
+// Ids are stored as hex strings with or without leading zeros ("0x10de", "0x0045", "0x45")
+static inline bool parseGPUConfigId(const char* pStr, uint32_t* pOutId)
+{
+	char*               pEnd = NULL;
+	const unsigned long id = strtoul(pStr, &pEnd, 16);
+	if (pEnd == pStr || *pEnd)
+		return false;
 
-	*pOutPresetLevel = GPU_PRESET_LOW;
-	return false;
+	*pOutId = (uint32_t)id;
+	return true;
 }
 
-GPUPresetLevel getSinglePresetLevel(const char* line, const char* inVendorId, const char* inModelId, const char* inRevId)
+static inline char* trimGPUConfigField(char* pField)
 {
-	char vendorId[MAX_GPU_VENDOR_STRING_LENGTH] = {};
-	char deviceId[MAX_GPU_VENDOR_STRING_LENGTH] = {};
-	GPUPresetLevel presetLevel = {};
-	char gpuName[MAX_GPU_VENDOR_STRING_LENGTH] = {};
-	char revisionId[MAX_GPU_VENDOR_STRING_LENGTH] = {};
+	while (*pField == ' ' || *pField == '\t')
+		++pField;
+	char* pEnd = pField + strlen(pField);
+	while (pEnd > pField && (pEnd[-1] == ' ' || pEnd[-1] == '\t' || pEnd[-1] == '\r'))
+		*--pEnd = 0;
+	return pField;
+}
 
-	//check if current vendor line is one of the selected gpu's
-	if (!parseConfigLine(line, inVendorId, inModelId, vendorId, deviceId, revisionId, gpuName, &presetLevel))
-		return GPU_PRESET_NONE;
+// VendorId; ModelId; Preset; Name; RevisionId (optional); Codename (optional)
+// Comments start with #. The line is modified in place
+static inline bool parseGPUConfigLine(char* pLine, GPUConfigEntry* pOutEntry)
+{
+	const uint32_t maxFieldCount = 6;
+	char*          pFields[maxFieldCount] = {};
+	uint32_t       fieldCount = 0;
 
-	//if we have a revision Id then we want to match it as well
-	if (_stricmp(inRevId, "0x00") && strlen(revisionId) && _stricmp(revisionId, "0x00") && _stricmp(inRevId, revisionId))
-		return GPU_PRESET_NONE;
+	pLine = trimGPUConfigField(pLine);
+	if (!*pLine || *pLine == '#')
+		return false;
 
-	return presetLevel;
+	while (pLine && fieldCount < maxFieldCount)
+	{
+		char* pSeparator = strchr(pLine, ';');
+		if (pSeparator)
+			*pSeparator = 0;
+		pFields[fieldCount++] = trimGPUConfigField(pLine);
+		pLine = pSeparator ? pSeparator + 1 : NULL;
+	}
+
+	if (fieldCount < 4)
+		return false;
+
+	*pOutEntry = {};
+	if (!parseGPUConfigId(pFields[0], &pOutEntry->mVendorId) || !parseGPUConfigId(pFields[1], &pOutEntry->mModelId))
+		return false;
+
+	pOutEntry->mPresetLevel = stringToPresetLevel(pFields[2]);
+	if (pOutEntry->mPresetLevel == GPU_PRESET_NONE)
+		return false;
+
+	strncpy(pOutEntry->mGpuName, pFields[3], MAX_GPU_VENDOR_STRING_LENGTH - 1);
+
+	if (fieldCount > 4 && !parseGPUConfigId(pFields[4], &pOutEntry->mRevisionId))
+		pOutEntry->mRevisionId = 0;
+
+	return true;
 }
 
-//TODO: Add name matching as well.
-void checkForPresetLevel(const char* line, Renderer* pRenderer, uint32_t gpuCount, GPUSettings* pGpuSettings)
+// Reads the whole file at once and returns it null terminated, the caller frees it with tf_free
+static inline char* readGPUConfigFile(ResourceDirectory resourceDir, const char* fileName, size_t* pOutSize)
 {
-	char vendorId[MAX_GPU_VENDOR_STRING_LENGTH] = {};
-	char deviceId[MAX_GPU_VENDOR_STRING_LENGTH] = {};
-	GPUPresetLevel presetLevel = {};
-	char gpuName[MAX_GPU_VENDOR_STRING_LENGTH] = {};
-	char revisionId[MAX_GPU_VENDOR_STRING_LENGTH] = {};
+	FileStream fh = {};
+	if (!fsOpenStreamFromPath(resourceDir, fileName, FM_READ_BINARY, &fh))
+		return NULL;
 
-	//search if any of the current gpu's match the current gpu cfg entry
-	for (uint32_t i = 0; i < gpuCount; i++)
+	const ssize_t fileSize = fsGetStreamFileSize(&fh);
+	char*         pData = NULL;
+	if (fileSize >= 0)
 	{
-		GPUSettings* currentSettings = &pGpuSettings[i];
-
-		//check if current vendor line is one of the selected gpu's
-		if (!parseConfigLine(line,
-			currentSettings->mGpuVendorPreset.mVendorId,
-			currentSettings->mGpuVendorPreset.mModelId,
-			vendorId, deviceId, revisionId, gpuName, &presetLevel))
-			return;
-
-		//if we have a revision Id then we want to match it as well
-		if (strcmp(currentSettings->mGpuVendorPreset.mRevisionId, "0x00") != 0 &&
-			strlen(revisionId) && strcmp(revisionId, "0x00") != 0 &&
-			strcmp(currentSettings->mGpuVendorPreset.mRevisionId, revisionId) == 0)
-			continue;
+		pData = (char*)tf_malloc(fileSize + 1);
+		*pOutSize = fsReadFromStream(&fh, pData, fileSize);
+		pData[*pOutSize] = 0;
+	}
+
+	fsCloseStream(&fh);
+	return pData;
+}
 
-		currentSettings->mGpuVendorPreset.mPresetLevel = presetLevel;
+// Parses every valid line of the text config. Returns the number of entries written to pOutEntries (NULL only counts lines)
+static inline uint32_t parseGPUConfigText(char* pText, GPUConfigEntry* pOutEntries)
+{
+	uint32_t count = 0;
+	char*    pLine = pText;
+	while (pLine && *pLine)
+	{
+		char* pLineEnd = strchr(pLine, '\n');
+		if (pLineEnd)
+			*pLineEnd = 0;
 
-		//Extra information for GPU
-		//Not all gpu's will have that info in the gpu.cfg file
-		strncpy(currentSettings->mGpuVendorPreset.mGpuName, gpuName, MAX_GPU_VENDOR_STRING_LENGTH);
+		if (pOutEntries)
+		{
+			if (parseGPUConfigLine(pLine, &pOutEntries[count]))
+				++count;
+		}
+		else
+		{
+			++count;
+		}
+
+		if (pLineEnd)
+			*pLineEnd = '\n';
+		pLine = pLineEnd ? pLineEnd + 1 : NULL;
 	}
+	return count;
 }
 
-bool checkForActiveGPU(const char* line, GPUVendorPreset& pActiveGpu)
+static inline bool loadGPUConfigBinary(GPUConfigTable* pTable)
 {
-	if (!parseConfigLine(
-		line,
-		NULL, NULL,
-		pActiveGpu.mVendorId,
-		pActiveGpu.mModelId,
-		pActiveGpu.mRevisionId,
-		pActiveGpu.mGpuName,
-		&pActiveGpu.mPresetLevel))
+	size_t size = 0;
+	char*  pData = readGPUConfigFile(RD_GPU_CONFIG, "gpu.bin", &size);
+	if (!pData)
 		return false;
 
-	// #TODO: Hardcoded for now as its only used for automated testing
-	// We will want to test with different presets
-	pActiveGpu.mPresetLevel = GPU_PRESET_ULTRA;
+	const GPUConfigBinaryHeader* pHeader = (const GPUConfigBinaryHeader*)pData;
+	if (size < sizeof(GPUConfigBinaryHeader) || pHeader->mMagic != GPU_CONFIG_BINARY_MAGIC || pHeader->mVersion != GPU_CONFIG_BINARY_VERSION ||
+		pHeader->mEntrySize != sizeof(GPUConfigEntry) || size < sizeof(GPUConfigBinaryHeader) + pHeader->mEntryCount * sizeof(GPUConfigEntry))
+	{
+		LOGF(LogLevel::eWARNING, "gpu.bin is invalid or was saved by a different version, falling back to gpu.cfg");
+		tf_free(pData);
+		return false;
+	}
 
+	pTable->mEntryCount = pHeader->mEntryCount;
+	pTable->pEntries = (GPUConfigEntry*)tf_malloc(pTable->mEntryCount * sizeof(GPUConfigEntry));
+	memcpy(pTable->pEntries, pHeader + 1, pTable->mEntryCount * sizeof(GPUConfigEntry));
+	tf_free(pData);
 	return true;
 }
 
-//Reads the gpu config and sets the preset level of all available gpu's
-void setGPUPresetLevel(Renderer* pRenderer, uint32_t gpuCount, GPUSettings* pGpuSettings)
+static inline bool loadGPUConfigText(GPUConfigTable* pTable)
+{
+	size_t size = 0;
+	char*  pText = readGPUConfigFile(RD_GPU_CONFIG, "gpu.cfg", &size);
+	if (!pText)
+		return false;
+
+	pTable->pEntries = (GPUConfigEntry*)tf_malloc(max(1U, parseGPUConfigText(pText, NULL)) * sizeof(GPUConfigEntry));
+	pTable->mEntryCount = parseGPUConfigText(pText, pTable->pEntries);
+	tf_free(pText);
+
+	// Stable so the first line for a gpu still wins as before
+	eastl::stable_sort(pTable->pEntries, pTable->pEntries + pTable->mEntryCount, [](const GPUConfigEntry& lhs, const GPUConfigEntry& rhs) {
+		return gpuConfigKey(lhs.mVendorId, lhs.mModelId) < gpuConfigKey(rhs.mVendorId, rhs.mModelId);
+	});
+	return true;
+}
+
+static inline bool writeGPUConfigBinary(const GPUConfigTable* pTable, ResourceDirectory resourceDir, const char* fileName)
 {
 	FileStream fh = {};
-	if (!fsOpenStreamFromPath(RD_GPU_CONFIG, "gpu.cfg", FM_READ, &fh))
+	if (!fsOpenStreamFromPath(resourceDir, fileName, FM_WRITE_BINARY, &fh))
+		return false;
+
+	GPUConfigBinaryHeader header = {};
+	header.mMagic = GPU_CONFIG_BINARY_MAGIC;
+	header.mVersion = GPU_CONFIG_BINARY_VERSION;
+	header.mEntrySize = sizeof(GPUConfigEntry);
+	header.mEntryCount = pTable->mEntryCount;
+	fsWriteToStream(&fh, &header, sizeof(header));
+	fsWriteToStream(&fh, pTable->pEntries, pTable->mEntryCount * sizeof(GPUConfigEntry));
+	fsCloseStream(&fh);
+	return true;
+}
+
+static inline GPUConfigTable* loadGPUConfigTable()
+{
+	GPUConfigTable* pTable = &gGPUConfigTable;
+	if (!pTable->mLoaded)
 	{
-		LOGF(LogLevel::eWARNING, "gpu.cfg could not be found, setting preset to Low as a default.");
-		return;
+		pTable->mLoaded = true;
+
+		// An edited gpu.cfg wins over the gpu.bin saved from an older version of it.
+		// Bundled files report no timestamp, gpu.bin is used for them whenever it can be read
+		const bool textNewer = fsGetLastModifiedTime(RD_GPU_CONFIG, "gpu.cfg") > fsGetLastModifiedTime(RD_GPU_CONFIG, "gpu.bin");
+		bool       loaded = !textNewer && loadGPUConfigBinary(pTable);
+		if (!loaded && loadGPUConfigText(pTable))
+		{
+			loaded = true;
+			// Save the parsed table so the next runs can skip parsing
+			if (!writeGPUConfigBinary(pTable, RD_GPU_CONFIG, "gpu.bin"))
+				LOGF(LogLevel::eINFO, "Could not save gpu.bin, gpu.cfg will be parsed again on the next run");
+		}
+		if (!loaded && textNewer)
+			loaded = loadGPUConfigBinary(pTable);
+		if (!loaded)
+			LOGF(LogLevel::eWARNING, "gpu.cfg could not be found, setting preset to Low as a default.");
+	}
+	return pTable;
+}
+
+/// Frees the parsed gpu config. It is loaded again on the next query
+static inline void exitGPUConfig()
+{
+	tf_free(gGPUConfigTable.pEntries);
+	gGPUConfigTable = {};
+}
+
+static inline const GPUConfigEntry* findGPUConfigEntry(const char* vendorId, const char* modelId, const char* revId)
+{
+	uint32_t vendor = 0;
+	uint32_t model = 0;
+	uint32_t revision = 0;
+	if (!parseGPUConfigId(vendorId, &vendor) || !parseGPUConfigId(modelId, &model))
+		return NULL;
+	if (!revId || !parseGPUConfigId(revId, &revision))
+		revision = 0;
+
+	const GPUConfigTable* pTable = loadGPUConfigTable();
+	const uint64_t        key = gpuConfigKey(vendor, model);
+
+	// Lower bound of the key
+	uint32_t first = 0;
+	uint32_t count = pTable->mEntryCount;
+	while (count)
+	{
+		const uint32_t step = count / 2;
+		if (gpuConfigKey(pTable->pEntries[first + step].mVendorId, pTable->pEntries[first + step].mModelId) < key)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
 	}
 
-	char configStr[1024] = {};
-	while (!fsStreamAtEnd(&fh))
+	//if we have a revision Id then we want to match it as well
+	for (uint32_t i = first; i < pTable->mEntryCount; ++i)
 	{
-		fsReadFromStreamLine(&fh, configStr);
-		checkForPresetLevel(configStr, pRenderer, gpuCount, pGpuSettings);
-		// Do something with the tok
+		const GPUConfigEntry* pEntry = &pTable->pEntries[i];
+		if (gpuConfigKey(pEntry->mVendorId, pEntry->mModelId) != key)
+			break;
+		if (!revision || !pEntry->mRevisionId || revision == pEntry->mRevisionId)
+			return pEntry;
 	}
 
-	fsCloseStream(&fh);
+	return NULL;
+}
+
+//TODO: Add name matching as well.
+//Reads the gpu config and sets the preset level of all available gpu's
+void setGPUPresetLevel(Renderer* pRenderer, uint32_t gpuCount, GPUSettings* pGpuSettings)
+{
+	for (uint32_t i = 0; i < gpuCount; i++)
+	{
+		GPUVendorPreset*      pPreset = &pGpuSettings[i].mGpuVendorPreset;
+		const GPUConfigEntry* pEntry = findGPUConfigEntry(pPreset->mVendorId, pPreset->mModelId, pPreset->mRevisionId);
+		if (!pEntry)
+			continue;
+
+		pPreset->mPresetLevel = pEntry->mPresetLevel;
+
+		//Extra information for GPU
+		//Not all gpu's will have that info in the gpu.cfg file
+		strncpy(pPreset->mGpuName, pEntry->mGpuName, MAX_GPU_VENDOR_STRING_LENGTH);
+	}
 }
 
 //Reads the gpu config and sets the preset level of all available gpu's
@@ -219,50 +350,37 @@ GPUPresetLevel getGPUPresetLevel(const eastl::string vendorId, const eastl::stri
 //Reads the gpu config and sets the preset level of all available gpu's
 GPUPresetLevel getGPUPresetLevel(const char* vendorId, const char* modelId, const char* revId)
 {
-	FileStream fh = {};
-	if (!fsOpenStreamFromPath(RD_GPU_CONFIG, "gpu.cfg", FM_READ, &fh))
-	{
-		LOGF(LogLevel::eWARNING, "gpu.cfg could not be found, setting preset to Low as a default.");
-		return GPU_PRESET_LOW;
-	}
-
-	GPUPresetLevel foundLevel = GPU_PRESET_LOW;
-
-	char gpuCfgString[1024] = {};
-	while (!fsStreamAtEnd(&fh))
-	{
-		fsReadFromStreamLine(&fh, gpuCfgString);
-		GPUPresetLevel level = getSinglePresetLevel(gpuCfgString, vendorId, modelId, revId);
-		// Do something with the tok
-		if (level != GPU_PRESET_NONE)
-		{
-			foundLevel = level;
-			break;
-		}
-	}
-
-	fsCloseStream(&fh);
-	return foundLevel;
+	const GPUConfigEntry* pEntry = findGPUConfigEntry(vendorId, modelId, revId);
+	return pEntry ? pEntry->mPresetLevel : GPU_PRESET_LOW;
 }
 
 bool getActiveGpuConfig(GPUVendorPreset& pActiveGpu)
 {
-	FileStream fh = {};
-	if (!fsOpenStreamFromPath(RD_GPU_CONFIG, "activeTestingGpu.cfg", FM_READ, &fh))
+	size_t size = 0;
+	char*  pText = readGPUConfigFile(RD_GPU_CONFIG, "activeTestingGpu.cfg", &size);
+	if (!pText)
 	{
 		LOGF(LogLevel::eINFO, "activeTestingGpu.cfg could not be found, Using default GPU.");
 		return false;
 	}
 
-	bool successFinal = false;
-	char gpuCfgString[1024] = {};
-	while (!fsStreamAtEnd(&fh) && !successFinal)
+	// Only the first valid line is used
+	GPUConfigEntry* pEntries = (GPUConfigEntry*)tf_malloc(max(1U, parseGPUConfigText(pText, NULL)) * sizeof(GPUConfigEntry));
+	const bool      successFinal = parseGPUConfigText(pText, pEntries) > 0;
+	if (successFinal)
 	{
-		fsReadFromStreamLine(&fh, gpuCfgString);
-		successFinal = checkForActiveGPU(gpuCfgString, pActiveGpu);
+		sprintf(pActiveGpu.mVendorId, "%#x", pEntries[0].mVendorId);
+		sprintf(pActiveGpu.mModelId, "%#x", pEntries[0].mModelId);
+		sprintf(pActiveGpu.mRevisionId, "0x%02x", pEntries[0].mRevisionId);
+		strncpy(pActiveGpu.mGpuName, pEntries[0].mGpuName, MAX_GPU_VENDOR_STRING_LENGTH);
+
+		// #TODO: Hardcoded for now as its only used for automated testing
+		// We will want to test with different presets
+		pActiveGpu.mPresetLevel = GPU_PRESET_ULTRA;
 	}
 
-	fsCloseStream(&fh);
+	tf_free(pEntries);
+	tf_free(pText);
 
 	return successFinal;
 }
@@ -273,14 +391,24 @@ void selectActiveGpu(GPUSettings* pGpuSettings, uint32_t* pGpuIndex, uint32_t gp
 	bool            activeTestingGpu = getActiveGpuConfig(activeTestingPreset);
 	if (activeTestingGpu)
 	{
+		// Compare the ids as numbers since backends format them differently
+		uint32_t activeVendorId = 0, activeModelId = 0, activeRevisionId = 0;
+		parseGPUConfigId(activeTestingPreset.mVendorId, &activeVendorId);
+		parseGPUConfigId(activeTestingPreset.mModelId, &activeModelId);
+		parseGPUConfigId(activeTestingPreset.mRevisionId, &activeRevisionId);
+
 		for (uint32_t i = 0; i < gpuCount; i++)
 		{
-			if (strcmp(pGpuSettings[i].mGpuVendorPreset.mVendorId,activeTestingPreset.mVendorId)==0 &&
-				strcmp(pGpuSettings[i].mGpuVendorPreset.mModelId,activeTestingPreset.mModelId)==0)
+			uint32_t vendorId = 0, modelId = 0, revisionId = 0;
+			if (!parseGPUConfigId(pGpuSettings[i].mGpuVendorPreset.mVendorId, &vendorId) ||
+				!parseGPUConfigId(pGpuSettings[i].mGpuVendorPreset.mModelId, &modelId))
+				continue;
+			parseGPUConfigId(pGpuSettings[i].mGpuVendorPreset.mRevisionId, &revisionId);
+
+			if (vendorId == activeVendorId && modelId == activeModelId)
 			{
 				//if revision ID is valid then use it to select active GPU
-				if (strcmp(pGpuSettings[i].mGpuVendorPreset.mRevisionId,"0x00")!=0 &&
-					strcmp(pGpuSettings[i].mGpuVendorPreset.mRevisionId,activeTestingPreset.mRevisionId)!=0)
+				if (revisionId && revisionId != activeRevisionId)
 					continue;
 
 				*pGpuIndex = i;
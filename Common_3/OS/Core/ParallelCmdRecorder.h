@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+
+#pragma once
+
+#include "../../Renderer/IRenderer.h"
+#include "../Interfaces/IThread.h"
+#include "../Interfaces/ILog.h"
+#include "Atomics.h"
+#include "ThreadSystem.h"
+
+#define IMEMORY_FROM_HEADER
+#include "../../OS/Interfaces/IMemory.h"
+
+/************************************************************************/
+/* PARALLEL COMMAND RECORDING                                           */
+/************************************************************************/
+// Splits a list of items (draw packets, passes, ...) in contiguous ranges and records each range into its own
+// command buffer on the workers of a ThreadSystem. Every range has its own command pool per frame so no pool is
+// ever used by two threads. The command buffers are returned in range order so the submission order does not depend
+// on which worker finished first.
+//
+// Command buffers are primary command buffers submitted one after the other, so each range has to bind its render
+// targets, pipeline and descriptor sets itself (see 03_MultiThread).
+
+/// Records items [firstItem, firstItem + itemCount) into pCmd. beginCmd / endCmd are called by the recorder
+typedef void (*RecordCmdFunc)(void* pUserData, Cmd* pCmd, uint32_t cmdIndex, uint32_t firstItem, uint32_t itemCount);
+
+typedef struct ParallelCmdRecorderDesc
+{
+	Queue*        pQueue;
+	/// Workers used for recording. NULL records everything on the calling thread
+	ThreadSystem* pThreadSystem;
+	/// Number of frames in flight, the command pools of a frame are reset when it is recorded again
+	uint32_t      mFrameCount;
+	/// Maximum number of command buffers the items of a frame are split in
+	uint32_t      mMaxCmdCount;
+} ParallelCmdRecorderDesc;
+
+typedef struct ParallelCmdRecordDesc
+{
+	RecordCmdFunc pRecordFunc;
+	void*         pUserData;
+	uint32_t      mFrameIndex;
+	uint32_t      mItemCount;
+	/// Ranges smaller than this are not worth a command buffer of their own
+	uint32_t      mMinItemsPerCmd;
+} ParallelCmdRecordDesc;
+
+typedef struct ParallelCmdRecorder
+{
+	Renderer*             pRenderer;
+	ThreadSystem*         pThreadSystem;
+	/// mFrameCount * mMaxCmdCount pools and command buffers, indexed by frameIndex * mMaxCmdCount + cmdIndex
+	CmdPool**             ppCmdPools;
+	Cmd**                 ppCmds;
+	uint32_t              mFrameCount;
+	uint32_t              mMaxCmdCount;
+
+	/// State of the recording in flight
+	ParallelCmdRecordDesc mRecordDesc;
+	uint32_t              mRecordCmdCount;
+	tfrg_atomic32_t       mRecordedCmdCount;
+	/// Signalled when a command buffer is recorded, endParallelCmds sleeps on it once no range is left to help with
+	theforge::Mutex             mRecordMutex;
+	theforge::ConditionVariable mRecordCond;
+} ParallelCmdRecorder;
+
+static inline void addParallelCmdRecorder(Renderer* pRenderer, const ParallelCmdRecorderDesc* pDesc, ParallelCmdRecorder** ppRecorder)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(pDesc->pQueue);
+	ASSERT(pDesc->mFrameCount && pDesc->mMaxCmdCount);
+
+	ParallelCmdRecorder* pRecorder = (ParallelCmdRecorder*)tf_calloc(1, sizeof(ParallelCmdRecorder));
+	pRecorder->pRenderer = pRenderer;
+	pRecorder->pThreadSystem = pDesc->pThreadSystem;
+	pRecorder->mFrameCount = pDesc->mFrameCount;
+	pRecorder->mMaxCmdCount = pDesc->mMaxCmdCount;
+	pRecorder->mRecordMutex.Init();
+	pRecorder->mRecordCond.Init();
+
+	const uint32_t totalCmdCount = pDesc->mFrameCount * pDesc->mMaxCmdCount;
+	pRecorder->ppCmdPools = (CmdPool**)tf_calloc(totalCmdCount, sizeof(CmdPool*));
+	pRecorder->ppCmds = (Cmd**)tf_calloc(totalCmdCount, sizeof(Cmd*));
+
+	for (uint32_t i = 0; i < totalCmdCount; ++i)
+	{
+		CmdPoolDesc cmdPoolDesc = {};
+		cmdPoolDesc.pQueue = pDesc->pQueue;
+		addCmdPool(pRenderer, &cmdPoolDesc, &pRecorder->ppCmdPools[i]);
+		CmdDesc cmdDesc = {};
+		cmdDesc.pPool = pRecorder->ppCmdPools[i];
+		addCmd(pRenderer, &cmdDesc, &pRecorder->ppCmds[i]);
+	}
+
+	*ppRecorder = pRecorder;
+}
+
+static inline void removeParallelCmdRecorder(Renderer* pRenderer, ParallelCmdRecorder* pRecorder)
+{
+	ASSERT(pRenderer);
+	ASSERT(pRecorder);
+
+	const uint32_t totalCmdCount = pRecorder->mFrameCount * pRecorder->mMaxCmdCount;
+	for (uint32_t i = 0; i < totalCmdCount; ++i)
+	{
+		removeCmd(pRenderer, pRecorder->ppCmds[i]);
+		removeCmdPool(pRenderer, pRecorder->ppCmdPools[i]);
+	}
+
+	pRecorder->mRecordCond.Destroy();
+	pRecorder->mRecordMutex.Destroy();
+
+	tf_free(pRecorder->ppCmds);
+	tf_free(pRecorder->ppCmdPools);
+	tf_free(pRecorder);
+}
+
+static inline void recordParallelCmd(ParallelCmdRecorder* pRecorder, uint32_t cmdIndex)
+{
+	const ParallelCmdRecordDesc* pDesc = &pRecorder->mRecordDesc;
+	const uint32_t               index = pDesc->mFrameIndex * pRecorder->mMaxCmdCount + cmdIndex;
+	// 64 bit products so large item counts don't overflow
+	const uint32_t firstItem = (uint32_t)((uint64_t)pDesc->mItemCount * cmdIndex / pRecorder->mRecordCmdCount);
+	const uint32_t endItem = (uint32_t)((uint64_t)pDesc->mItemCount * (cmdIndex + 1) / pRecorder->mRecordCmdCount);
+
+	Cmd* pCmd = pRecorder->ppCmds[index];
+	resetCmdPool(pRecorder->pRenderer, pRecorder->ppCmdPools[index]);
+	beginCmd(pCmd);
+	pDesc->pRecordFunc(pDesc->pUserData, pCmd, cmdIndex, firstItem, endItem - firstItem);
+	endCmd(pCmd);
+
+	pRecorder->mRecordMutex.Acquire();
+	tfrg_atomic32_add_relaxed(&pRecorder->mRecordedCmdCount, 1);
+	pRecorder->mRecordMutex.Release();
+	pRecorder->mRecordCond.WakeOne();
+}
+
+static inline void recordParallelCmdTask(void* pUserData, uintptr_t cmdIndex)
+{
+	recordParallelCmd((ParallelCmdRecorder*)pUserData, (uint32_t)cmdIndex);
+}
+
+/// Starts recording pDesc->mItemCount items on the workers and returns right away, so the calling thread can record
+/// its own command buffers in the meantime. A recorder can only record one frame at a time
+static inline void beginParallelCmds(ParallelCmdRecorder* pRecorder, const ParallelCmdRecordDesc* pDesc)
+{
+	ASSERT(pRecorder);
+	ASSERT(pDesc);
+	ASSERT(pDesc->pRecordFunc);
+	ASSERT(pDesc->mFrameIndex < pRecorder->mFrameCount);
+
+	const uint32_t minItemsPerCmd = max(1U, pDesc->mMinItemsPerCmd);
+	uint32_t       cmdCount = (pDesc->mItemCount + minItemsPerCmd - 1) / minItemsPerCmd;
+	cmdCount = min(max(1U, cmdCount), pRecorder->mMaxCmdCount);
+
+	pRecorder->mRecordDesc = *pDesc;
+	pRecorder->mRecordCmdCount = cmdCount;
+	tfrg_atomic32_store_release(&pRecorder->mRecordedCmdCount, 0);
+
+	if (!pRecorder->pThreadSystem || cmdCount == 1)
+	{
+		for (uint32_t i = 0; i < cmdCount; ++i)
+			recordParallelCmd(pRecorder, i);
+	}
+	else
+	{
+		addThreadSystemRangeTask(pRecorder->pThreadSystem, recordParallelCmdTask, pRecorder, cmdCount);
+	}
+}
+
+/// Waits for the recording started by beginParallelCmds and returns the command buffers to submit, in item order, through pppOutCmds.
+/// The calling thread records remaining ranges as well while waiting
+static inline uint32_t endParallelCmds(ParallelCmdRecorder* pRecorder, Cmd*** pppOutCmds)
+{
+	ASSERT(pRecorder);
+	ASSERT(pppOutCmds);
+
+	// Help with the remaining ranges, then sleep until the workers recording the last ones are done
+	while (tfrg_atomic32_load_acquire(&pRecorder->mRecordedCmdCount) < pRecorder->mRecordCmdCount &&
+		   assistThreadSystem(pRecorder->pThreadSystem))
+		;
+	if (tfrg_atomic32_load_acquire(&pRecorder->mRecordedCmdCount) < pRecorder->mRecordCmdCount)
+	{
+		theforge::MutexLock lock(pRecorder->mRecordMutex);
+		while (tfrg_atomic32_load_acquire(&pRecorder->mRecordedCmdCount) < pRecorder->mRecordCmdCount)
+			pRecorder->mRecordCond.Wait(pRecorder->mRecordMutex);
+	}
+
+	*pppOutCmds = pRecorder->ppCmds + pRecorder->mRecordDesc.mFrameIndex * pRecorder->mMaxCmdCount;
+	return pRecorder->mRecordCmdCount;
+}
+
+/// Records pDesc->mItemCount items and returns the command buffers to submit, in item order, through pppOutCmds
+static inline uint32_t recordParallelCmds(ParallelCmdRecorder* pRecorder, const ParallelCmdRecordDesc* pDesc, Cmd*** pppOutCmds)
+{
+	beginParallelCmds(pRecorder, pDesc);
+	return endParallelCmds(pRecorder, pppOutCmds);
+}
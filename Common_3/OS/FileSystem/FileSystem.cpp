@@ -23,6 +23,11 @@
 */
 
 #include <errno.h>
+#if defined(_WIN32)
+#include <io.h>    // _get_osfhandle
+#elif !defined(NX64)
+#include <sys/mman.h>
+#endif
 
 #include "../Interfaces/ILog.h"
 #include "../Interfaces/IMemory.h"
@@ -357,6 +362,289 @@ bool fsStreamAtEnd(const FileStream* pStream)
 {
 	return pStream->pIO->IsAtEnd(pStream);
 }
+
+bool fsMapStream(FileStream* pStream, void** ppMappedData)
+{
+	ASSERT(ppMappedData);
+	*ppMappedData = NULL;
+
+	// Only plain files on disk can be mapped
+	if (pStream->pIO != &gSystemFileIO || pStream->mSize <= 0)
+		return false;
+
+#if defined(_WIN32) && !defined(XBOX)
+	HANDLE file = (HANDLE)_get_osfhandle(_fileno(pStream->pFile));
+	HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping)
+	{
+		LOGF(LogLevel::eWARNING, "Error creating file mapping: %u", (uint32_t)GetLastError());
+		return false;
+	}
+
+	// The view keeps the mapping object alive
+	void* pData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T)pStream->mSize);
+	CloseHandle(mapping);
+	if (!pData)
+	{
+		LOGF(LogLevel::eWARNING, "Error mapping file view: %u", (uint32_t)GetLastError());
+		return false;
+	}
+
+	*ppMappedData = pData;
+	return true;
+#elif defined(__linux__) || defined(__APPLE__) || defined(__ANDROID__)
+	void* pData = mmap(NULL, (size_t)pStream->mSize, PROT_READ, MAP_PRIVATE, fileno(pStream->pFile), 0);
+	if (pData == MAP_FAILED)
+	{
+		LOGF(LogLevel::eWARNING, "Error mapping file: %s", strerror(errno));
+		return false;
+	}
+
+	*ppMappedData = pData;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void fsUnmapStream(void* pMappedData, size_t size)
+{
+	if (!pMappedData)
+		return;
+
+#if defined(_WIN32) && !defined(XBOX)
+	UNREF_PARAM(size);
+	UnmapViewOfFile(pMappedData);
+#elif defined(__linux__) || defined(__APPLE__) || defined(__ANDROID__)
+	munmap(pMappedData, size);
+#else
+	UNREF_PARAM(size);
+#endif
+}
+/************************************************************************/
+// Buffered reading
+/************************************************************************/
+static inline bool fsReaderIsSpace(int c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Refills the buffer once all of it was consumed, returns false at the end of the stream
+static inline bool fsReaderFill(FileStreamReader* pReader)
+{
+	if (pReader->mPosition < pReader->mSize)
+		return true;
+
+	pReader->mPosition = 0;
+	pReader->mSize = fsReadFromStream(pReader->pStream, pReader->pBuffer, pReader->mBlockSize);
+	return pReader->mSize > 0;
+}
+
+bool fsInitStreamReader(FileStream* pStream, size_t blockSize, void* pBuffer, FileStreamReader* pOut)
+{
+	ASSERT(pStream);
+	ASSERT(pOut);
+
+	FileStreamReader reader = {};
+	reader.pStream = pStream;
+	reader.mBlockSize = blockSize ? blockSize : FS_READER_DEFAULT_BLOCK_SIZE;
+	reader.pBuffer = (uint8_t*)pBuffer;
+	if (!reader.pBuffer)
+	{
+		reader.pBuffer = (uint8_t*)tf_malloc(reader.mBlockSize);
+		reader.mOwnsBuffer = true;
+	}
+
+	*pOut = reader;
+	return reader.pBuffer != NULL;
+}
+
+void fsExitStreamReader(FileStreamReader* pReader)
+{
+	const size_t unread = pReader->mSize - pReader->mPosition;
+	if (unread && pReader->pStream)
+		fsSeekStream(pReader->pStream, SBO_CURRENT_POSITION, -(ssize_t)unread);
+
+	if (pReader->mOwnsBuffer)
+		tf_free(pReader->pBuffer);
+
+	*pReader = {};
+}
+
+bool fsReaderAtEnd(FileStreamReader* pReader)
+{
+	return !fsReaderFill(pReader);
+}
+
+int fsReaderPeek(FileStreamReader* pReader)
+{
+	if (!fsReaderFill(pReader))
+		return -1;
+
+	return pReader->pBuffer[pReader->mPosition];
+}
+
+size_t fsReaderRead(FileStreamReader* pReader, void* pOutputBuffer, size_t bufferSizeInBytes)
+{
+	uint8_t* dst = (uint8_t*)pOutputBuffer;
+	size_t   read = min(pReader->mSize - pReader->mPosition, bufferSizeInBytes);
+	memcpy(dst, pReader->pBuffer + pReader->mPosition, read);
+	pReader->mPosition += read;
+
+	const size_t remaining = bufferSizeInBytes - read;
+	if (!remaining)
+		return read;
+
+	// Large reads go straight to the stream instead of through the buffer
+	if (remaining >= pReader->mBlockSize)
+		return read + fsReadFromStream(pReader->pStream, dst + read, remaining);
+
+	if (!fsReaderFill(pReader))
+		return read;
+
+	const size_t tail = min(pReader->mSize, remaining);
+	memcpy(dst + read, pReader->pBuffer, tail);
+	pReader->mPosition = tail;
+	return read + tail;
+}
+
+const void* fsReaderNextBlock(FileStreamReader* pReader, size_t* pOutSize)
+{
+	if (!fsReaderFill(pReader))
+	{
+		*pOutSize = 0;
+		return NULL;
+	}
+
+	const uint8_t* pData = pReader->pBuffer + pReader->mPosition;
+	*pOutSize = pReader->mSize - pReader->mPosition;
+	pReader->mPosition = pReader->mSize;
+	return pData;
+}
+
+ssize_t fsReaderReadLine(FileStreamReader* pReader, char* pOutLine, size_t lineSize, bool* pOutPartial)
+{
+	// Room for at least one character next to a held back '\r' and the terminator
+	ASSERT(pOutLine && lineSize > 2);
+
+	if (pOutPartial)
+		*pOutPartial = false;
+
+	if (!fsReaderFill(pReader))
+	{
+		pOutLine[0] = 0;
+		return -1;
+	}
+
+	size_t length = 0;
+	while (fsReaderFill(pReader))
+	{
+		// Scan the buffered bytes for the line end instead of going through the reader for every character
+		const uint8_t* pBegin = pReader->pBuffer + pReader->mPosition;
+		const uint8_t* pEnd = pReader->pBuffer + pReader->mSize;
+		const uint8_t* pNewLine = (const uint8_t*)memchr(pBegin, '\n', pEnd - pBegin);
+		const uint8_t* pStop = pNewLine ? pNewLine : pEnd;
+
+		size_t count = min((size_t)(pStop - pBegin), lineSize - 1 - length);
+		memcpy(pOutLine + length, pBegin, count);
+		length += count;
+		pReader->mPosition += count;
+
+		if (pNewLine && pBegin + count == pNewLine)
+		{
+			// Consume the "\n", a preceding '\r' belongs to the line ending
+			++pReader->mPosition;
+			if (length && pOutLine[length - 1] == '\r')
+				--length;
+			pOutLine[length] = 0;
+			return (ssize_t)length;
+		}
+
+		if (length == lineSize - 1)
+		{
+			// Keep a trailing '\r' back so a "\r\n" split by the output buffer is still recognized as line ending
+			if (pOutLine[length - 1] == '\r')
+			{
+				--length;
+				--pReader->mPosition;
+			}
+			if (pOutPartial)
+				*pOutPartial = true;
+			pOutLine[length] = 0;
+			return (ssize_t)length;
+		}
+	}
+
+	pOutLine[length] = 0;
+	return (ssize_t)length;
+}
+
+ssize_t fsReaderReadToken(FileStreamReader* pReader, char* pOutToken, size_t tokenSize)
+{
+	ASSERT(pOutToken && tokenSize);
+
+	int c = fsReaderPeek(pReader);
+	while (c >= 0 && fsReaderIsSpace(c))
+	{
+		++pReader->mPosition;
+		c = fsReaderPeek(pReader);
+	}
+
+	if (c < 0)
+	{
+		pOutToken[0] = 0;
+		return -1;
+	}
+
+	size_t length = 0;
+	while (c >= 0 && !fsReaderIsSpace(c))
+	{
+		if (length < tokenSize - 1)
+			pOutToken[length++] = (char)c;
+		++pReader->mPosition;
+		c = fsReaderPeek(pReader);
+	}
+
+	pOutToken[length] = 0;
+	return (ssize_t)length;
+}
+
+bool fsReaderReadInt64(FileStreamReader* pReader, int64_t* pOutValue)
+{
+	char token[64] = {};
+	const ssize_t length = fsReaderReadToken(pReader, token, sizeof(token));
+	// A token filling the buffer may have been cut and would parse as a different number
+	if (length <= 0 || length >= (ssize_t)sizeof(token) - 1)
+		return false;
+
+	const char* pDigits = token[0] == '-' || token[0] == '+' ? token + 1 : token;
+	const int   base = pDigits[0] == '0' && (pDigits[1] == 'x' || pDigits[1] == 'X') ? 16 : 10;
+	char*       pEnd = NULL;
+	errno = 0;
+	const long long value = strtoll(token, &pEnd, base);
+	if (pEnd != token + length || errno == ERANGE)
+		return false;
+
+	*pOutValue = (int64_t)value;
+	return true;
+}
+
+bool fsReaderReadFloat(FileStreamReader* pReader, float* pOutValue)
+{
+	char token[64] = {};
+	const ssize_t length = fsReaderReadToken(pReader, token, sizeof(token));
+	// A token filling the buffer may have been cut and would parse as a different number
+	if (length <= 0 || length >= (ssize_t)sizeof(token) - 1)
+		return false;
+
+	char*       pEnd = NULL;
+	const float value = strtof(token, &pEnd);
+	if (pEnd != token + length)
+		return false;
+
+	*pOutValue = value;
+	return true;
+}
 /************************************************************************/
 // Platform independent filename, extension functions
 /************************************************************************/
@@ -668,10 +668,10 @@ struct InputSystemImpl : public gainput::InputListener
 #if defined(__linux__) && !defined(__ANDROID__) && !defined(GAINPUT_PLATFORM_GGP)
 		//this needs to be done before updating the events
 		//that way current frame data will be delta after resetting mouse position
-		if (mInputCaptured)
+		//headless runs have no display to warp the pointer on
+		ASSERT(pWindow);
+		if (mInputCaptured && pWindow->handle.display)
 		{
-			ASSERT(pWindow);
-
 			float x = 0;
 			float y = 0;
 			x = (pWindow->windowedRect.right - pWindow->windowedRect.left) / 2;
@@ -1047,7 +1047,11 @@ struct InputSystemImpl : public gainput::InputListener
 #elif defined(__linux__) && !defined(__ANDROID__) && !defined(GAINPUT_PLATFORM_GGP)
 		if (mInputCaptured != enable)
 		{
-			if (enable)
+			if (!pWindow->handle.display)
+			{
+				// Headless runs have no display to grab the pointer on
+			}
+			else if (enable)
 			{
 				// Create invisible cursor that will be used when mouse is captured
 				Cursor      invisibleCursor = {};
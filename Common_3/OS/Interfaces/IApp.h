@@ -129,6 +129,14 @@ public:
 		/// Force lowDPI settings for this window
 		bool mForceLowDPI = false;
 
+		/// Run without a window or display connection (--headless on the command line)
+		/// Pair with a null renderer backend to profile the CPU side of a sample
+		bool		mHeadless = false;
+		/// Number of frames to run in headless mode before exiting (--frames <count>)
+		uint32_t	mHeadlessFrameCount = 120;
+		/// Fixed delta time fed to Update in headless mode so runs are deterministic
+		float		mHeadlessDeltaTime = 1.0f / 60.0f;
+
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 		bool		mDefaultVSyncEnabled = true;
 #else
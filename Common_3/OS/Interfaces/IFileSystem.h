@@ -214,6 +214,66 @@ bool fsFlushStream(FileStream* stream);
 
 /// Returns whether the current seek position is at the end of the file stream.
 bool fsStreamAtEnd(const FileStream* stream);
+
+/// Maps the whole file behind `stream` read-only into memory. Only supported for files opened from disk,
+/// returns false for memory and bundled streams so callers can fall back to `fsReadFromStream`.
+/// The mapping stays valid after the stream is closed and must be released with `fsUnmapStream`.
+bool fsMapStream(FileStream* stream, void** ppMappedData);
+
+/// Releases a mapping of `size` bytes returned by `fsMapStream`.
+void fsUnmapStream(void* pMappedData, size_t size);
+/************************************************************************/
+// MARK: - Buffered reading
+/************************************************************************/
+#define FS_READER_DEFAULT_BLOCK_SIZE 4096
+
+/// Reads a FileStream in blocks of `mBlockSize` bytes so text parsers don't pay for one IO call per character.
+/// The stream must not be read from directly while a reader is attached to it.
+typedef struct FileStreamReader
+{
+	FileStream* pStream;
+	uint8_t*    pBuffer;
+	size_t      mBlockSize;
+	size_t      mPosition;
+	size_t      mSize;
+	bool        mOwnsBuffer;
+} FileStreamReader;
+
+/// Attaches a reader to `stream`. `pBuffer` must hold at least `blockSize` bytes, if it is NULL the reader allocates its own.
+/// A `blockSize` of 0 selects FS_READER_DEFAULT_BLOCK_SIZE.
+bool fsInitStreamReader(FileStream* stream, size_t blockSize, void* pBuffer, FileStreamReader* pOut);
+
+/// Detaches the reader. Buffered bytes that were not consumed are returned to the stream by seeking back.
+void fsExitStreamReader(FileStreamReader* pReader);
+
+/// Returns whether all bytes of the stream have been consumed.
+bool fsReaderAtEnd(FileStreamReader* pReader);
+
+/// Returns the next byte without consuming it, or -1 at the end of the stream.
+int fsReaderPeek(FileStreamReader* pReader);
+
+/// Returns the number of bytes read.
+size_t fsReaderRead(FileStreamReader* pReader, void* pOutputBuffer, size_t bufferSizeInBytes);
+
+/// Consumes and returns all buffered bytes, refilling the buffer first if it is empty. Returns NULL at the end of the stream.
+/// The data stays valid until the next call on the reader.
+const void* fsReaderNextBlock(FileStreamReader* pReader, size_t* pOutSize);
+
+/// Reads up to the next "\n" or "\r\n" into `pOutLine` and null terminates it. The line ending is consumed but not stored.
+/// Any other byte, NUL included, is part of the line.
+/// A line longer than `lineSize - 1` characters is returned in pieces and `pOutPartial` (optional) is set for all but the last one.
+/// Returns the number of characters stored, or -1 at the end of the stream.
+ssize_t fsReaderReadLine(FileStreamReader* pReader, char* pOutLine, size_t lineSize, bool* pOutPartial);
+
+/// Skips whitespace and reads the following whitespace separated token into `pOutToken`.
+/// Characters that don't fit into `tokenSize - 1` are consumed and dropped. Returns the token length, or -1 at the end of the stream.
+ssize_t fsReaderReadToken(FileStreamReader* pReader, char* pOutToken, size_t tokenSize);
+
+/// Reads the next token as a decimal or 0x prefixed hexadecimal integer. Returns false if the token is not a number.
+bool fsReaderReadInt64(FileStreamReader* pReader, int64_t* pOutValue);
+
+/// Reads the next token as a floating point number. Returns false if the token is not a number.
+bool fsReaderReadFloat(FileStreamReader* pReader, float* pOutValue);
 /************************************************************************/
 // MARK: - Minor filename manipulation
 /************************************************************************/
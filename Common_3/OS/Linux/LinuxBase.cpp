@@ -25,6 +25,8 @@
 #ifdef __linux__
 
 #include <ctime>
+#include <cstdlib>
+#include <cstring>
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
 #include <X11/Xresource.h>
@@ -91,6 +93,13 @@ void adjustWindow(WindowsDesc* winDesc);
 
 void getRecommendedResolution(RectDesc* rect) 
 { 
+	// Headless runs have no display to query, fall back to the largest recommended size
+	if (!gDefaultDisplay)
+	{
+		*rect = { 0, 0, 1920, 1080 };
+		return;
+	}
+
     Screen* screen = XDefaultScreenOfDisplay(gDefaultDisplay);
 
 	*rect = { 0, 0, min(1920, (int)(WidthOfScreen(screen)*0.75)), min(1080, (int)(HeightOfScreen(screen)*0.75)) };
@@ -103,6 +112,9 @@ void requestShutdown()
 
 void toggleFullscreen(WindowsDesc* window)
 {
+	if (!gDefaultDisplay)
+		return;
+
     Atom wmState = XInternAtom(window->handle.display, "_NET_WM_STATE", False);
     Atom wmStateFullscreen = XInternAtom(window->handle.display, "_NET_WM_STATE_FULLSCREEN", False);
 
@@ -478,6 +490,9 @@ void setWindowRect(WindowsDesc* winDesc, const RectDesc& rect)
 	RectDesc& currentRect = winDesc->fullScreen ? winDesc->fullscreenRect : winDesc->windowedRect;
 	currentRect = rect;
 
+	if (!gDefaultDisplay)
+		return;
+
     XResizeWindow(winDesc->handle.display, winDesc->handle.window, rect.right - rect.left, rect.bottom - rect.top);
     XMoveWindow(winDesc->handle.display, winDesc->handle.window, rect.left, rect.top);
     XFlush(winDesc->handle.display);
@@ -489,12 +504,18 @@ void setWindowSize(WindowsDesc* winDesc, unsigned width, unsigned height)
     currentRect.right = currentRect.left + width;
     currentRect.bottom = currentRect.top + height; 
 
+	if (!gDefaultDisplay)
+		return;
+
     XResizeWindow(winDesc->handle.display, winDesc->handle.window, width, height);
     XFlush(winDesc->handle.display);
 }
 
 void toggleBorderless(WindowsDesc* winDesc, unsigned width, unsigned height)
 {
+	if (!gDefaultDisplay)
+		return;
+
 	if (winDesc->fullScreen)
         return;
    
@@ -529,17 +550,24 @@ void toggleBorderless(WindowsDesc* winDesc, unsigned width, unsigned height)
 void showWindow(WindowsDesc* winDesc)
 {
     winDesc->hide = false;
+	if (!gDefaultDisplay)
+		return;
 	XMapWindow(winDesc->handle.display, winDesc->handle.window);
 }
 
 void hideWindow(WindowsDesc* winDesc)
 {
     winDesc->hide = true;
+	if (!gDefaultDisplay)
+		return;
     XUnmapWindow(winDesc->handle.display, winDesc->handle.window);
 }
 
 void maximizeWindow(WindowsDesc* winDesc)
 {
+	if (!gDefaultDisplay)
+		return;
+
     Atom wmState = XInternAtom(winDesc->handle.display, "_NET_WM_STATE", False);
     Atom maxHorz = XInternAtom(winDesc->handle.display, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
     Atom maxVert = XInternAtom(winDesc->handle.display, "_NET_WM_STATE_MAXIMIZED_VERT", False);
@@ -560,6 +588,9 @@ void maximizeWindow(WindowsDesc* winDesc)
 
 void minimizeWindow(WindowsDesc* winDesc)
 {
+	if (!gDefaultDisplay)
+		return;
+
     Atom wmState = XInternAtom(winDesc->handle.display, "_NET_WM_STATE", False);
     Atom maxHorz = XInternAtom(winDesc->handle.display, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
     Atom maxVert = XInternAtom(winDesc->handle.display, "_NET_WM_STATE_MAXIMIZED_VERT", False);
@@ -580,6 +611,9 @@ void minimizeWindow(WindowsDesc* winDesc)
 
 void centerWindow(WindowsDesc* winDesc)
 {
+	if (!gDefaultDisplay)
+		return;
+
 	uint32_t fsHalfWidth = getRectWidth(winDesc->fullscreenRect) >> 1;
 	uint32_t fsHalfHeight = getRectHeight(winDesc->fullscreenRect) >> 1;
 	uint32_t windowHalfWidth = getRectWidth(winDesc->windowedRect) >> 1;
@@ -593,6 +627,9 @@ void centerWindow(WindowsDesc* winDesc)
 
 void* createCursor(const char* path)
 {
+	if (!gDefaultDisplay)
+		return NULL;
+
 	Pixmap      bitmap = {};
 	unsigned int bitmap_width, bitmap_height;
 	int hotspot_x, hotspot_y;
@@ -608,18 +645,27 @@ void* createCursor(const char* path)
 
 void setCursor(void* cursor)
 {
+	if (!gDefaultDisplay)
+		return;
+
 	Cursor* linuxCursor = (Cursor*)cursor;
 	XDefineCursor(gWindow.handle.display, gWindow.handle.window, *linuxCursor);
 }
 
 void showCursor()
 {
+	if (!gDefaultDisplay)
+		return;
+
 	XUndefineCursor(gWindow.handle.display, gWindow.handle.window);
 	XDefineCursor(gWindow.handle.display, gWindow.handle.window, gCursor);
 }
 
 void hideCursor()
 {
+	if (!gDefaultDisplay)
+		return;
+
 	XDefineCursor(gWindow.handle.display, gWindow.handle.window, gInvisibleCursor);
 }
 
@@ -630,6 +676,9 @@ bool isCursorInsideTrackingArea()
 
 void setMousePositionRelative(const WindowsDesc* winDesc, int32_t x, int32_t y)
 {
+	if (!gDefaultDisplay)
+		return;
+
     XWarpPointer(winDesc->handle.display, winDesc->handle.window, None, 0, 0, 0, 0, x, y);
     XFlush(winDesc->handle.display);
 }
@@ -641,7 +690,7 @@ void setMousePositionAbsolute(int32_t x, int32_t y)
 
 void setResolution(const MonitorDesc* pMonitor, const Resolution* pRes)
 {
-    if (!requireXRandrVersion(1, 2))
+    if (!gDefaultDisplay || !requireXRandrVersion(1, 2))
         return;
 
     Window rootWindow = RootWindowOfScreen(pMonitor->screen);
@@ -804,6 +853,23 @@ void closeWindow(const WindowsDesc* winDesc)
 	XSendEvent(winDesc->handle.display, winDesc->handle.window, False, NoEventMask, &event);
 }
 
+static void parseHeadlessArgs(int argc, char** argv, IApp::Settings* pSettings)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--headless") == 0)
+		{
+			pSettings->mHeadless = true;
+		}
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+		{
+			int frameCount = atoi(argv[++i]);
+			if (frameCount > 0)
+				pSettings->mHeadlessFrameCount = (uint32_t)frameCount;
+		}
+	}
+}
+
 int LinuxMain(int argc, char** argv, IApp* app)
 {
 	extern bool MemAllocInit(const char*);
@@ -837,11 +903,26 @@ int LinuxMain(int argc, char** argv, IApp* app)
 	IApp::Settings* pSettings = &pApp->mSettings;
 	Timer           deltaTimer;
 
-	gDefaultDisplay = XOpenDisplay(NULL);
-    ASSERT(gDefaultDisplay);
+	parseHeadlessArgs(argc, argv, pSettings);
+	const bool headless = pSettings->mHeadless;
+
+	if (headless)
+	{
+		// No display connection, no monitors and no window. Everything that would
+		// talk to X checks gDefaultDisplay and turns into a no-op.
+		gDefaultDisplay = NULL;
+		gMonitorCount = 0;
+		pSettings->mFullScreen = false;
+		LOGF(LogLevel::eINFO, "Running headless for %u frames", pSettings->mHeadlessFrameCount);
+	}
+	else
+	{
+		gDefaultDisplay = XOpenDisplay(NULL);
+		ASSERT(gDefaultDisplay);
 
-    collectXRandrInfo();
-    collectMonitorInfo();
+		collectXRandrInfo();
+		collectMonitorInfo();
+	}
 
     RectDesc rect = {};
     getRecommendedResolution(&rect);
@@ -856,12 +937,15 @@ int LinuxMain(int argc, char** argv, IApp* app)
 
 	gWindow.windowedRect = { 0, 0, (int)pSettings->mWidth, (int)pSettings->mHeight };
 	gWindow.fullScreen = pSettings->mFullScreen;
-	openWindow(pApp->GetName(), &gWindow);
+	if (!headless)
+	{
+		openWindow(pApp->GetName(), &gWindow);
 
-    // NOTE: Some window manaters set the window to maximized
-    // if the window size matches the screen resolution.
-    // This might result in move/resize requests to be ignored.
-    minimizeWindow(&gWindow);
+		// NOTE: Some window manaters set the window to maximized
+		// if the window size matches the screen resolution.
+		// This might result in move/resize requests to be ignored.
+		minimizeWindow(&gWindow);
+	}
 
 	pSettings->mWidth = gWindow.fullScreen ? getRectWidth(gWindow.fullscreenRect) : getRectWidth(gWindow.windowedRect);
 	pSettings->mHeight = gWindow.fullScreen ? getRectHeight(gWindow.fullscreenRect) : getRectHeight(gWindow.windowedRect);
@@ -873,9 +957,21 @@ int LinuxMain(int argc, char** argv, IApp* app)
 	if (!pApp->Load())
 		return EXIT_FAILURE;
 
+	uint32_t headlessFrame = 0;
 	int64_t lastCounter = getUSec();
 	while (!gQuit)
 	{
+		if (headless)
+		{
+			// Fixed step and fixed frame count so CPU profiles are comparable between runs
+			pApp->Update(pSettings->mHeadlessDeltaTime);
+			pApp->Draw();
+
+			if (++headlessFrame >= pSettings->mHeadlessFrameCount || pSettings->mQuit)
+				gQuit = true;
+			continue;
+		}
+
 		int64_t counter = getUSec();
 		float deltaTime = (float)(counter - lastCounter) / (float)1e6;
 		lastCounter = counter;
@@ -897,13 +993,17 @@ int LinuxMain(int argc, char** argv, IApp* app)
 #endif
 	}
 
-    restoreResolutions();
+	if (!headless)
+		restoreResolutions();
 
 	pApp->Unload();
 
-    closeWindow(&gWindow);
-    destroyMonitorInfo();
-    XCloseDisplay(gDefaultDisplay);
+	if (!headless)
+	{
+		closeWindow(&gWindow);
+		destroyMonitorInfo();
+		XCloseDisplay(gDefaultDisplay);
+	}
 
 	pApp->Exit();
 	
@@ -168,6 +168,10 @@ PROFILE_API Profile* ProfileGet()
 
 void ProfileInit()
 {
+	// Fast path for threads registering after initialization, avoids touching the mutex
+	if (!g_bOnce)
+		return;
+
 	Mutex& mutex = ProfileMutex();
 	Profile & S = g_Profile;
 	bool bUseLock = g_bUseLock;
@@ -178,7 +182,7 @@ void ProfileInit()
 		g_bOnce = false;
         mutex.Init();
 		memset(&S, 0, sizeof(S));
-		S.nMemUsage = sizeof(S);
+		tfrg_atomic32_store_relaxed(&S.nMemUsage, (uint32_t)sizeof(S));
 		for (int i = 0; i < PROFILE_MAX_GROUPS; ++i)
 		{
 			S.GroupInfo[i].pName[0] = '\0';
@@ -237,10 +241,67 @@ void ProfileInit()
 		mutex.Release();
 }
 
+static inline FORGE_CONSTEXPR uint32_t ProfilePreallocatedLogCount()
+{
+	return PROFILE_PREALLOCATED_THREAD_LOGS < PROFILE_MAX_THREADS ? PROFILE_PREALLOCATED_THREAD_LOGS : PROFILE_MAX_THREADS;
+}
+
+static void ProfilePreallocateThreadLogs()
+{
+	Profile & S = g_Profile;
+	const uint32_t nCount = ProfilePreallocatedLogCount();
+	if (S.pPreallocatedLogs || !nCount)
+		return;
+
+	S.pPreallocatedLogs = static_cast<ProfileLogEntry *>(tf_malloc(sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE * nCount));
+	memset(S.pPreallocatedLogs, 0, sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE * nCount);
+	tfrg_atomic32_add_relaxed(&S.nMemUsage, (uint32_t)(sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE * nCount));
+
+	for (uint32_t i = 0; i < nCount; ++i)
+	{
+		// Reserve the slot so a thread registering concurrently cannot race with the buffer assignment
+		if (P_THREAD_LOG_FREE == tfrg_atomic32_cas_relaxed(&S.nPoolState[i], P_THREAD_LOG_FREE, P_THREAD_LOG_ACTIVE))
+		{
+			if (!S.PoolStorage[i].Log)
+				S.PoolStorage[i].Log = S.pPreallocatedLogs + (size_t)i * PROFILE_BUFFER_SIZE;
+			tfrg_atomic32_store_release(&S.nPoolState[i], P_THREAD_LOG_FREE);
+		}
+	}
+}
+
+static bool ProfileIsPreallocatedLog(const ProfileLogEntry* pLog)
+{
+	Profile & S = g_Profile;
+	return S.pPreallocatedLogs && pLog >= S.pPreallocatedLogs && pLog < S.pPreallocatedLogs + (size_t)ProfilePreallocatedLogCount() * PROFILE_BUFFER_SIZE;
+}
+
+static void ProfileFreeThreadLogs()
+{
+	Profile & S = g_Profile;
+	for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
+	{
+		ProfileThreadLog* pLog = &S.PoolStorage[i];
+		if (pLog->Log && !ProfileIsPreallocatedLog(pLog->Log))
+		{
+			tf_free(pLog->Log);
+			tfrg_atomic32_add_relaxed(&S.nMemUsage, -(int32_t)(sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE));
+		}
+		pLog->Log = nullptr;
+	}
+
+	if (S.pPreallocatedLogs)
+	{
+		tf_free(S.pPreallocatedLogs);
+		tfrg_atomic32_add_relaxed(&S.nMemUsage, -(int32_t)(sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE * ProfilePreallocatedLogCount()));
+		S.pPreallocatedLogs = nullptr;
+	}
+}
+
 void initProfiler(Renderer* pRenderer, Queue** ppQueue, const char** ppProfilerNames, ProfileToken* pProfileTokens, uint32_t nGpuProfilerCount)
 {
 #if PROFILE_ENABLED
     ProfileInit();
+    ProfilePreallocateThreadLogs();
     ProfileSetEnableAllGroups(true);
     ProfileWebServerStart();
 
@@ -266,6 +327,7 @@ void exitCpuProfiler()
 	ProfileOnThreadExit();
 	ProfileWebServerStop();
 	ProfileContextSwitchTraceStop();
+	ProfileFreeThreadLogs();
 
     g_bOnce = true;
     g_bUseLock = false;
@@ -308,39 +370,22 @@ void ProfileSetThreadLog(ProfileThreadLog* pLog)
 #endif
 
 
-PROFILE_API void ProfileRemoveThreadLog(ProfileThreadLog * pLog)
+// Thread logs live in S.PoolStorage and are never freed while the profiler runs.
+// A slot is claimed with a CAS on its state, and handed back by marking it retired.
+// Only ProfileFlipCpu recycles retired slots, so the flip never reads a log that is being reused.
+static void ProfileRetireThreadLog(ProfileThreadLog* pLog)
 {
-	MutexLock lock(ProfileMutex());
 	Profile & S = g_Profile;
+	P_ASSERT(pLog >= &S.PoolStorage[0] && pLog < &S.PoolStorage[PROFILE_MAX_THREADS]);
+	// The CAS fails when the profiler was shut down and reinitialized while this thread was alive
+	tfrg_atomic32_cas_relaxed(&S.nPoolState[pLog->nLogIndex], P_THREAD_LOG_ACTIVE, P_THREAD_LOG_RETIRED);
+}
+
+PROFILE_API void ProfileRemoveThreadLog(ProfileThreadLog * pLog)
+{
 	if (pLog)
 	{
-		int32_t nLogIndex = -1;
-		for (int i = 0; i < PROFILE_MAX_THREADS; ++i)
-		{
-			if (pLog == S.Pool[i])
-			{
-				nLogIndex = i;
-				break;
-			}
-		}
-		P_ASSERT(nLogIndex < PROFILE_MAX_THREADS);
-
-		S.Pool[nLogIndex] = 0;
-
-		for (int i = 0; i < PROFILE_MAX_FRAME_HISTORY; ++i)
-		{
-			S.Frames[i].nLogStart[nLogIndex] = 0;
-		}
-
-		if (pLog->Log)
-		{
-			tf_free(pLog->Log);
-			S.nMemUsage -= sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE;
-		}
-
-		pLog->~ProfileThreadLog();
-		tf_free(pLog);
-		S.nMemUsage -= sizeof(ProfileThreadLog);
+		ProfileRetireThreadLog(pLog);
 	}
 }
 
@@ -351,13 +396,11 @@ ProfileThreadLog* ProfileCreateThreadLog(const char* pName)
 	uint32_t nLogIndex = 0;
 	for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
 	{
-		if (!S.Pool[i])
+		if (P_THREAD_LOG_FREE == tfrg_atomic32_load_relaxed(&S.nPoolState[i]) &&
+			P_THREAD_LOG_FREE == tfrg_atomic32_cas_relaxed(&S.nPoolState[i], P_THREAD_LOG_FREE, P_THREAD_LOG_ACTIVE))
 		{
 			nLogIndex = i;
-			pLog = static_cast<ProfileThreadLog *>(tf_malloc(sizeof(ProfileThreadLog)));
-			memset(pLog, 0, sizeof(ProfileThreadLog));
-			S.nMemUsage += sizeof(ProfileThreadLog);
-			S.Pool[i] = pLog;
+			pLog = &S.PoolStorage[i];
 			break;
 		}
 	}
@@ -365,7 +408,17 @@ ProfileThreadLog* ProfileCreateThreadLog(const char* pName)
 	if (!pLog)
 		return nullptr;
 
+	// Recycled slots keep their buffer so short lived threads never go through the allocator
+	ProfileLogEntry* pBuffer = pLog->Log;
+	if (!pBuffer)
+	{
+		pBuffer = static_cast<ProfileLogEntry *>(tf_malloc(sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE));
+		memset(pBuffer, 0, sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE);
+		tfrg_atomic32_add_relaxed(&S.nMemUsage, (uint32_t)(sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE));
+	}
+
 	memset(pLog, 0, sizeof(*pLog));
+	pLog->Log = pBuffer;
 	pLog->nLogIndex = nLogIndex;
 	int len = (int)strlen(pName);
 	int maxlen = sizeof(pLog->ThreadName) - 1;
@@ -373,6 +426,8 @@ ProfileThreadLog* ProfileCreateThreadLog(const char* pName)
 	memcpy(&pLog->ThreadName[0], pName, len);
 	pLog->ThreadName[len] = '\0';
 	pLog->nThreadId = Thread::GetCurrentThreadID();
+
+	tfrg_atomicptr_store_release((tfrg_atomicptr_t*)&S.Pool[nLogIndex], (uintptr_t)pLog);
 	return pLog;
 }
 
@@ -380,10 +435,16 @@ void ProfileOnThreadCreate(const char* pThreadName)
 {
 	g_bUseLock = true;
 	ProfileInit();
-	MutexLock lock(ProfileMutex());
 	if (ProfileGetThreadLog() == 0)
 	{
-		ProfileThreadLog* pLog = ProfileCreateThreadLog(pThreadName ? pThreadName : ProfileGetThreadName());
+		// ProfileGetThreadName uses a shared buffer, so query the name into local storage
+		char threadName[MAX_THREAD_NAME_LENGTH + 1] = {};
+		if (!pThreadName)
+		{
+			Thread::GetCurrentThreadName(threadName, MAX_THREAD_NAME_LENGTH);
+			pThreadName = threadName;
+		}
+		ProfileThreadLog* pLog = ProfileCreateThreadLog(pThreadName);
 		P_ASSERT(pLog);
 		ProfileSetThreadLog(pLog);
 		g_ForceProfileThreadExit.EnsureConstruction();
@@ -392,39 +453,10 @@ void ProfileOnThreadCreate(const char* pThreadName)
 
 void ProfileOnThreadExit()
 {
-    MutexLock lock(ProfileMutex());
-	Profile & S = g_Profile;
 	ProfileThreadLog* pLog = ProfileGetThreadLog();
 	if (pLog)
 	{
-		int32_t nLogIndex = -1;
-		for (int i = 0; i < PROFILE_MAX_THREADS; ++i)
-		{
-			if (pLog == S.Pool[i])
-			{
-				nLogIndex = i;
-				break;
-			}
-		}
-		P_ASSERT(nLogIndex < PROFILE_MAX_THREADS);
-
-		S.Pool[nLogIndex] = 0;
-
-		for (int i = 0; i < PROFILE_MAX_FRAME_HISTORY; ++i)
-		{
-			S.Frames[i].nLogStart[nLogIndex] = 0;
-		}
-
-		if (pLog->Log)
-		{
-			tf_free(pLog->Log);
-			S.nMemUsage -= sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE;
-		}
-
-		pLog->~ProfileThreadLog();
-		tf_free(pLog);
-		S.nMemUsage -= sizeof(ProfileThreadLog);
-
+		ProfileRetireThreadLog(pLog);
 		ProfileSetThreadLog(0);
 	}
 }
@@ -740,14 +772,8 @@ inline void ProfileLogPut(ProfileToken nToken_, uint64_t nTick, uint64_t nBegin,
 	{
 		S.nOverflow = 100;
 	}
-	else
+	else if (pLog->Log) //buffers are attached when the log is claimed, null only after exitProfiler
 	{
-		if (!pLog->Log)
-		{
-			pLog->Log = static_cast<ProfileLogEntry *>(tf_malloc(sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE));
-			memset(pLog->Log, 0, sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE);
-			S.nMemUsage += sizeof(ProfileLogEntry) * PROFILE_BUFFER_SIZE;
-		}
 		pLog->Log[nPos] = ProfileMakeLogIndex(nBegin, nToken_, nTick);
         tfrg_atomic32_store_release(&pLog->nPut, nNextPos);
 	}
@@ -797,7 +823,7 @@ uint64_t ProfileAllocateLabel(const char* pName)
 		{
 			pLabelBuffer = static_cast<char *>(tf_malloc(PROFILE_LABEL_BUFFER_SIZE + PROFILE_LABEL_MAX_LEN));
 			memset(pLabelBuffer, 0, PROFILE_LABEL_BUFFER_SIZE + PROFILE_LABEL_MAX_LEN);
-			S.nMemUsage += PROFILE_LABEL_BUFFER_SIZE + PROFILE_LABEL_MAX_LEN;
+			tfrg_atomic32_add_relaxed(&S.nMemUsage, (uint32_t)(PROFILE_LABEL_BUFFER_SIZE + PROFILE_LABEL_MAX_LEN));
             tfrg_atomicptr_store_release((tfrg_atomic64_t*)&S.LabelBuffer, *pLabelBuffer);
 		}
 	}
@@ -1005,328 +1031,369 @@ void ProfileGetRange(uint32_t nPut, uint32_t nGet, uint32_t nRange[2][2])
 
 void ProfileDumpToFile(Renderer* pRenderer);
 
-void ProfileFlipCpu()
-{
-    MutexLock lock(ProfileMutex());
+// Back buffers of ProfileFlipCpu. Only the flipping thread touches them, everything
+// shared with other profiler users is written from them under the profiler mutex.
+struct ProfileFlipState
+{
+	ProfileThreadLog*	Logs[PROFILE_MAX_THREADS];
+	int64_t				LogGroupTicks[PROFILE_MAX_THREADS][PROFILE_MAX_GROUPS];
+	uint32_t			nLogCount;
+	uint32_t			RetiredLogs[PROFILE_MAX_THREADS];
+	uint32_t			nRetiredLogCount;
+	ProfileTimer		Frame[PROFILE_MAX_TIMERS];
+	uint64_t			FrameExclusive[PROFILE_MAX_TIMERS];
+	uint64_t			FrameGroup[PROFILE_MAX_GROUPS];
+	uint64_t			MetaCounters[PROFILE_META_MAX][PROFILE_MAX_TIMERS];
+};
+
+static ProfileFlipState g_ProfileFlip;
 
+// Parses the entries one thread produced during the current frame into the flip back buffers.
+// Runs without the profiler mutex: the parse state of the log (stacks) is only used by the flip,
+// and the group ticks for the log are stored in `pOutGroupTicks` and applied under the mutex.
+static void ProfileFlipThreadLog(ProfileThreadLog* pLog, uint32_t nPut, uint32_t nGet, int64_t* pOutGroupTicks)
+{
 	Profile & S = g_Profile;
+	ProfileFlipState & F = g_ProfileFlip;
+	uint8_t* pTimerToGroup = &S.TimerToGroup[0];
+	uint64_t* pFrameGroup = &F.FrameGroup[0];
+
+	uint8_t* pGroupStackPos = &pLog->nGroupStackPos[0];
+	int64_t nGroupTicks[PROFILE_MAX_GROUPS] = { 0 };
+
+	uint32_t nRange[2][2] = { {0, 0}, {0, 0}, };
+	ProfileGetRange(nPut, nGet, nRange);
 
-	if (S.nToggleRunning)
+	uint32_t* pStack = &pLog->nStack[0];
+	int64_t* pChildTickStack = &pLog->nChildTickStack[0];
+	uint32_t nStackPos = pLog->nStackPos;
+
+	for (uint32_t j = 0; j < 2; ++j)
 	{
-		S.nRunning = !S.nRunning;
-		if (!S.nRunning)
-			S.nPauseTicks = P_TICK();
-		S.nToggleRunning = 0;
-		for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
+		uint32_t nStart = nRange[j][0];
+		uint32_t nEnd = nRange[j][1];
+		for (uint32_t k = nStart; k < nEnd; ++k)
 		{
-			ProfileThreadLog* pLog = S.Pool[i];
-			if (pLog)
+			ProfileLogEntry LE = pLog->Log[k];
+			uint64_t nType = ProfileLogType(LE);
+
+			if (P_LOG_ENTER == nType)
+			{
+				uint64_t nTimer = ProfileLogTimerIndex(LE);
+				uint8_t nGroup = pTimerToGroup[nTimer];
+				P_ASSERT(nStackPos < PROFILE_STACK_MAX);
+				P_ASSERT(nGroup < PROFILE_MAX_GROUPS);
+				pGroupStackPos[nGroup]++;
+				pStack[nStackPos++] = k;
+				pChildTickStack[nStackPos] = 0;
+
+			}
+			else if (P_LOG_META == nType)
 			{
-				pLog->nStackPos = 0;
+				if (nStackPos)
+				{
+					int64_t nMetaIndex = ProfileLogTimerIndex(LE);
+					int64_t nMetaCount = ProfileLogGetTick(LE);
+					P_ASSERT(nMetaIndex < PROFILE_META_MAX);
+					int64_t nCounter = ProfileLogTimerIndex(pLog->Log[pStack[nStackPos - 1]]);
+					F.MetaCounters[nMetaIndex][nCounter] += nMetaCount;
+				}
+			}
+			else if (P_LOG_LEAVE == nType)
+			{
+				uint64_t nTimer = ProfileLogTimerIndex(LE);
+				uint8_t nGroup = pTimerToGroup[nTimer];
+				P_ASSERT(nGroup < PROFILE_MAX_GROUPS);
+				if (nStackPos)
+				{
+					int64_t nTickStart = pLog->Log[pStack[nStackPos - 1]];
+					int64_t nTicks = ProfileLogTickDifference(nTickStart, LE);
+					int64_t nChildTicks = pChildTickStack[nStackPos];
+					nStackPos--;
+					pChildTickStack[nStackPos] += nTicks;
+
+					if (!pLog->nGpu)
+					{
+						uint32_t nTimerIndex = (uint32_t)ProfileLogTimerIndex(LE);
+						F.Frame[nTimerIndex].nTicks += nTicks;
+						F.FrameExclusive[nTimerIndex] += (nTicks - nChildTicks);
+						F.Frame[nTimerIndex].nCount += 1;
+					}
+					P_ASSERT(nGroup < PROFILE_MAX_GROUPS);
+					uint8_t nGroupStackPos = pGroupStackPos[nGroup];
+					if (nGroupStackPos)
+					{
+						nGroupStackPos--;
+						if (0 == nGroupStackPos)
+						{
+							nGroupTicks[nGroup] += nTicks;
+						}
+						pGroupStackPos[nGroup] = nGroupStackPos;
+					}
+				}
 			}
 		}
 	}
-	uint32_t nAggregateClear = S.nAggregateClear || S.nAutoClearFrames, nAggregateFlip = 0;
-	if (S.nDumpFileNextFrame)
+	for (uint32_t i = 0; i < PROFILE_MAX_GROUPS; ++i)
 	{
-		ProfileDumpToFile(nullptr);
-		S.nDumpFileNextFrame = 0;
-		S.nAutoClearFrames = PROFILE_GPU_FRAME_DELAY + 3; //hide spike from dumping webpage
+		pOutGroupTicks[i] = nGroupTicks[i];
+		pFrameGroup[i] += nGroupTicks[i];
 	}
+	pLog->nStackPos = nStackPos;
+}
 
-	if (S.nAutoClearFrames)
-	{
-		nAggregateClear = 1;
-		nAggregateFlip = 1;
-		S.nAutoClearFrames -= 1;
-	}
+// The flip runs in three steps so producers and other profiler users are not held up while the thread logs are parsed:
+// 1. Under the mutex, advance the frame and snapshot the put position of every active log (cheap, no parsing)
+// 2. Without the mutex, parse the snapshot into the flip back buffers
+// 3. Under the mutex, publish the back buffers, accumulate, and recycle logs of exited threads
+// Only one thread may call ProfileFlipCpu at a time.
+void ProfileFlipCpu()
+{
+	Profile & S = g_Profile;
+	ProfileFlipState & F = g_ProfileFlip;
 
+	uint32_t nAggregateClear = 0, nAggregateFlip = 0;
+	uint32_t nFrameCurrent = 0, nFrameNext = 0;
+	bool bFrameAdvanced = false;
+	bool bParseLogs = false;
 
-	if (S.nRunning || S.nForceEnable)
 	{
-		S.nFramePutIndex++;
-		S.nFramePut = (S.nFramePut + 1) % PROFILE_MAX_FRAME_HISTORY;
-		P_ASSERT((S.nFramePutIndex % PROFILE_MAX_FRAME_HISTORY) == S.nFramePut);
-		S.nFrameCurrent = (S.nFramePut + PROFILE_MAX_FRAME_HISTORY - PROFILE_GPU_FRAME_DELAY - 1) % PROFILE_MAX_FRAME_HISTORY;
-		S.nFrameCurrentIndex++;
-		uint32_t nFrameNext = (S.nFrameCurrent + 1) % PROFILE_MAX_FRAME_HISTORY;
+		MutexLock lock(ProfileMutex());
 
-		uint32_t nContextSwitchPut = S.nContextSwitchPut;
-		if (S.nContextSwitchLastPut < nContextSwitchPut)
+		if (S.nToggleRunning)
 		{
-			S.nContextSwitchUsage = (nContextSwitchPut - S.nContextSwitchLastPut);
+			S.nRunning = !S.nRunning;
+			if (!S.nRunning)
+				S.nPauseTicks = P_TICK();
+			S.nToggleRunning = 0;
+			for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
+			{
+				ProfileThreadLog* pLog = S.Pool[i];
+				if (pLog)
+				{
+					pLog->nStackPos = 0;
+				}
+			}
 		}
-		else
+		nAggregateClear = S.nAggregateClear || S.nAutoClearFrames;
+		if (S.nDumpFileNextFrame)
 		{
-			S.nContextSwitchUsage = PROFILE_CONTEXT_SWITCH_BUFFER_SIZE - S.nContextSwitchLastPut + nContextSwitchPut;
+			ProfileDumpToFile(nullptr);
+			S.nDumpFileNextFrame = 0;
+			S.nAutoClearFrames = PROFILE_GPU_FRAME_DELAY + 3; //hide spike from dumping webpage
 		}
-		S.nContextSwitchLastPut = nContextSwitchPut;
-
-		ProfileFrameState* pFramePut = &S.Frames[S.nFramePut];
-		ProfileFrameState* pFrameCurrent = &S.Frames[S.nFrameCurrent];
-		ProfileFrameState* pFrameNext = &S.Frames[nFrameNext];
 
-		pFramePut->nFrameStartCpu = P_TICK();
-        memset(&pFramePut->nFrameStartGpu[0], 0, PROFILE_MAX_THREADS * sizeof(pFramePut->nFrameStartGpu[0]));
+		if (S.nAutoClearFrames)
+		{
+			nAggregateClear = 1;
+			nAggregateFlip = 1;
+			S.nAutoClearFrames -= 1;
+		}
 
-		uint64_t nFrameStartCpu = pFrameCurrent->nFrameStartCpu;
-		uint64_t nFrameEndCpu = pFrameNext->nFrameStartCpu;
+		F.nLogCount = 0;
 
+		// Only logs retired before this point are recycled at the end of the flip
+		F.nRetiredLogCount = 0;
+		for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
 		{
-			uint64_t nTick = nFrameEndCpu - nFrameStartCpu;
-			S.nFlipTicks = nTick;
-			S.nFlipAggregate += nTick;
-            S.nFlipMin = ProfileMin(S.nFlipMin, nTick);
-			S.nFlipMax = ProfileMax(S.nFlipMax, nTick);
+			if (P_THREAD_LOG_RETIRED == tfrg_atomic32_load_acquire(&S.nPoolState[i]))
+				F.RetiredLogs[F.nRetiredLogCount++] = i;
 		}
 
-		uint8_t* pTimerToGroup = &S.TimerToGroup[0];
-		for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
+		if (S.nRunning || S.nForceEnable)
 		{
-			ProfileThreadLog* pLog = S.Pool[i];
-			if (!pLog)
+			S.nFramePutIndex++;
+			S.nFramePut = (S.nFramePut + 1) % PROFILE_MAX_FRAME_HISTORY;
+			P_ASSERT((S.nFramePutIndex % PROFILE_MAX_FRAME_HISTORY) == S.nFramePut);
+			S.nFrameCurrent = (S.nFramePut + PROFILE_MAX_FRAME_HISTORY - PROFILE_GPU_FRAME_DELAY - 1) % PROFILE_MAX_FRAME_HISTORY;
+			S.nFrameCurrentIndex++;
+			nFrameCurrent = S.nFrameCurrent;
+			nFrameNext = (S.nFrameCurrent + 1) % PROFILE_MAX_FRAME_HISTORY;
+
+			uint32_t nContextSwitchPut = S.nContextSwitchPut;
+			if (S.nContextSwitchLastPut < nContextSwitchPut)
 			{
-				pFramePut->nLogStart[i] = 0;
+				S.nContextSwitchUsage = (nContextSwitchPut - S.nContextSwitchLastPut);
 			}
 			else
 			{
-				uint32_t nPut = tfrg_atomic32_load_acquire(&pLog->nPut);
-				pFramePut->nLogStart[i] = nPut;
-				P_ASSERT(nPut < PROFILE_BUFFER_SIZE);
-                if (pLog->nGpu && pLog->Log && pFramePut->nFrameStartGpu[i] == 0)
-                {
-                    uint32_t nPreviousPos = (nPut - 1) % PROFILE_BUFFER_SIZE;
-                    pFramePut->nFrameStartGpu[i] = ProfileLogGetTick(pLog->Log[nPreviousPos]);
-                }
-				//need to keep last frame around to close timers. timers more than 1 frame old is ditched.
-                tfrg_atomic32_store_relaxed(&pLog->nGet, nPut);
+				S.nContextSwitchUsage = PROFILE_CONTEXT_SWITCH_BUFFER_SIZE - S.nContextSwitchLastPut + nContextSwitchPut;
 			}
-		}
+			S.nContextSwitchLastPut = nContextSwitchPut;
+
+			ProfileFrameState* pFramePut = &S.Frames[S.nFramePut];
+			ProfileFrameState* pFrameCurrent = &S.Frames[nFrameCurrent];
+			ProfileFrameState* pFrameNext = &S.Frames[nFrameNext];
+
+			pFramePut->nFrameStartCpu = P_TICK();
+			memset(&pFramePut->nFrameStartGpu[0], 0, PROFILE_MAX_THREADS * sizeof(pFramePut->nFrameStartGpu[0]));
+
+			uint64_t nFrameStartCpu = pFrameCurrent->nFrameStartCpu;
+			uint64_t nFrameEndCpu = pFrameNext->nFrameStartCpu;
 
-		if (S.nRunning)
-		{
-			uint64_t* pFrameGroup = &S.FrameGroup[0];
 			{
-                PROFILER_SET_CPU_SCOPE("Profile", "Clear", 0x3355ee);
-				for (uint32_t i = 0; i < S.nTotalTimers; ++i)
-				{
-                    if (S.GroupInfo[S.TimerInfo[i].nGroupIndex].Type == ProfileTokenTypeGpu)
-                    {
-                        continue;
-                    }
-					S.Frame[i].nTicks = 0;
-					S.Frame[i].nCount = 0;
-					S.FrameExclusive[i] = 0;
-				}
-				for (uint32_t i = 0; i < PROFILE_MAX_GROUPS; ++i)
+				uint64_t nTick = nFrameEndCpu - nFrameStartCpu;
+				S.nFlipTicks = nTick;
+				S.nFlipAggregate += nTick;
+				S.nFlipMin = ProfileMin(S.nFlipMin, nTick);
+				S.nFlipMax = ProfileMax(S.nFlipMax, nTick);
+			}
+
+			for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
+			{
+				ProfileThreadLog* pLog = S.Pool[i];
+				if (!pLog)
 				{
-					pFrameGroup[i] = 0;
+					pFramePut->nLogStart[i] = 0;
 				}
-				for (uint32_t j = 0; j < PROFILE_META_MAX; ++j)
+				else
 				{
-					if (S.MetaCounters[j].pName && 0 != (S.nActiveBars & (P_DRAW_META_FIRST << j)))
+					uint32_t nPut = tfrg_atomic32_load_acquire(&pLog->nPut);
+					pFramePut->nLogStart[i] = nPut;
+					P_ASSERT(nPut < PROFILE_BUFFER_SIZE);
+					if (pLog->nGpu && pLog->Log && pFramePut->nFrameStartGpu[i] == 0)
 					{
-						auto& Meta = S.MetaCounters[j];
-						for (uint32_t i = 0; i < S.nTotalTimers; ++i)
-						{
-							Meta.nCounters[i] = 0;
-						}
+						uint32_t nPreviousPos = (nPut - 1) % PROFILE_BUFFER_SIZE;
+						pFramePut->nFrameStartGpu[i] = ProfileLogGetTick(pLog->Log[nPreviousPos]);
 					}
-				}
+					//need to keep last frame around to close timers. timers more than 1 frame old is ditched.
+					tfrg_atomic32_store_relaxed(&pLog->nGet, nPut);
 
-			}
-			{
-                PROFILER_SET_CPU_SCOPE("Profile", "ThreadLoop", 0x3355ee);
-				for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
-				{
-					ProfileThreadLog* pLog = S.Pool[i];
-					if (!pLog)
-						continue;
-
-					uint8_t* pGroupStackPos = &pLog->nGroupStackPos[0];
-					int64_t nGroupTicks[PROFILE_MAX_GROUPS] = { 0 };
-
-
-					uint32_t nPut = pFrameNext->nLogStart[i];
-					uint32_t nGet = pFrameCurrent->nLogStart[i];
-					uint32_t nRange[2][2] = { {0, 0}, {0, 0}, };
-					ProfileGetRange(nPut, nGet, nRange);
-
-
-					//fetch gpu results.
-					//if (pLog->nGpu)
-					//{
-					//	// Get current log's initial gpu tick
-					//	uint64_t nGPUTick = PROFILE_INVALID_TICK;
-					//	if (pFrameCurrent->nFrameStartGpuTimer != (uint32_t)-1) 
-					//		nGPUTick = ProfileGpuGetTimeStamp(pLog, pFrameCurrent->nFrameStartGpuTimer);
-					//	uint64_t nLastTick = (nGPUTick == PROFILE_INVALID_TICK) ? pFrameCurrent->nFrameStartGpu : nGPUTick;
-                    //
-					//	for (uint32_t j = 0; j < 2; ++j)
-					//	{
-					//		uint32_t nStart = nRange[j][0];
-					//		uint32_t nEnd = nRange[j][1];
-					//		for (uint32_t k = nStart; k < nEnd; ++k)
-					//		{
-					//			ProfileLogEntry L = pLog->Log[k];
-                    //
-					//			uint64_t Type = ProfileLogType(L);
-                    //
-					//			if (Type == P_LOG_ENTER || Type == P_LOG_LEAVE)
-					//			{
-					//				uint32_t nTimer = (uint32_t)ProfileLogGetTick(L);
-					//				uint64_t nTick = ProfileGpuGetTimeStamp(pLog, nTimer);
-                    //
-					//				if (nTick != PROFILE_INVALID_TICK)
-					//					nLastTick = nTick;
-                    //
-					//				pLog->Log[k] = ProfileLogSetTick(L, nLastTick);
-					//			}
-					//		}
-					//	}
-					//}
-
-
-					uint32_t* pStack = &pLog->nStack[0];
-					int64_t* pChildTickStack = &pLog->nChildTickStack[0];
-					uint32_t nStackPos = pLog->nStackPos;
-
-					for (uint32_t j = 0; j < 2; ++j)
-					{
-						uint32_t nStart = nRange[j][0];
-						uint32_t nEnd = nRange[j][1];
-						for (uint32_t k = nStart; k < nEnd; ++k)
-						{
-							ProfileLogEntry LE = pLog->Log[k];
-							uint64_t nType = ProfileLogType(LE);
-
-							if (P_LOG_ENTER == nType)
-							{
-								uint64_t nTimer = ProfileLogTimerIndex(LE);
-								uint8_t nGroup = pTimerToGroup[nTimer];
-								P_ASSERT(nStackPos < PROFILE_STACK_MAX);
-								P_ASSERT(nGroup < PROFILE_MAX_GROUPS);
-								pGroupStackPos[nGroup]++;
-								pStack[nStackPos++] = k;
-								pChildTickStack[nStackPos] = 0;
-
-							}
-							else if (P_LOG_META == nType)
-							{
-								if (nStackPos)
-								{
-									int64_t nMetaIndex = ProfileLogTimerIndex(LE);
-									int64_t nMetaCount = ProfileLogGetTick(LE);
-									P_ASSERT(nMetaIndex < PROFILE_META_MAX);
-									int64_t nCounter = ProfileLogTimerIndex(pLog->Log[pStack[nStackPos - 1]]);
-									S.MetaCounters[nMetaIndex].nCounters[nCounter] += nMetaCount;
-								}
-							}
-							else if (P_LOG_LEAVE == nType)
-							{
-								uint64_t nTimer = ProfileLogTimerIndex(LE);
-								uint8_t nGroup = pTimerToGroup[nTimer];
-								P_ASSERT(nGroup < PROFILE_MAX_GROUPS);
-								if (nStackPos)
-								{
-									int64_t nTickStart = pLog->Log[pStack[nStackPos - 1]];
-									int64_t nTicks = ProfileLogTickDifference(nTickStart, LE);
-									int64_t nChildTicks = pChildTickStack[nStackPos];
-									nStackPos--;
-									pChildTickStack[nStackPos] += nTicks;
-
-                                    if (!pLog->nGpu)
-                                    {
-									    uint32_t nTimerIndex = (uint32_t)ProfileLogTimerIndex(LE);
-                                        S.Frame[nTimerIndex].nTicks += nTicks;
-                                        S.FrameExclusive[nTimerIndex] += (nTicks - nChildTicks);
-                                        S.Frame[nTimerIndex].nCount += 1;
-                                    }
-									P_ASSERT(nGroup < PROFILE_MAX_GROUPS);
-									uint8_t nGroupStackPos = pGroupStackPos[nGroup];
-									if (nGroupStackPos)
-									{
-										nGroupStackPos--;
-										if (0 == nGroupStackPos)
-										{
-											nGroupTicks[nGroup] += nTicks;
-										}
-										pGroupStackPos[nGroup] = nGroupStackPos;
-									}
-								}
-							}
-						}
-					}
-					for (uint32_t i = 0; i < PROFILE_MAX_GROUPS; ++i)
+					if (pLog->Log)
 					{
-						pLog->nGroupTicks[i] += nGroupTicks[i];
-						pFrameGroup[i] += nGroupTicks[i];
+						F.Logs[F.nLogCount++] = pLog;
 					}
-					pLog->nStackPos = nStackPos;
 				}
 			}
+
+			bFrameAdvanced = true;
+			bParseLogs = S.nRunning != 0;
+		}
+	}
+
+	if (bParseLogs)
+	{
+		PROFILER_SET_CPU_SCOPE("Profile", "ThreadLoop", 0x3355ee);
+		const ProfileFrameState* pFrameCurrent = &S.Frames[nFrameCurrent];
+		const ProfileFrameState* pFrameNext = &S.Frames[nFrameNext];
+		for (uint32_t i = 0; i < F.nLogCount; ++i)
+		{
+			ProfileThreadLog* pLog = F.Logs[i];
+			ProfileFlipThreadLog(pLog, pFrameNext->nLogStart[pLog->nLogIndex], pFrameCurrent->nLogStart[pLog->nLogIndex], F.LogGroupTicks[i]);
+		}
+	}
+
+	MutexLock lock(ProfileMutex());
+
+	if (bParseLogs)
+	{
+		{
+			PROFILER_SET_CPU_SCOPE("Profile", "Publish", 0x3355ee);
+			// Swap the back buffers in and clear them for the next flip. Cost depends on the timer count only.
+			for (uint32_t i = 0; i < S.nTotalTimers; ++i)
 			{
-                PROFILER_SET_CPU_SCOPE("Profile", "Accumulate", 0x3355ee);
-				for (uint32_t i = 0; i < S.nTotalTimers; ++i)
+				if (S.GroupInfo[S.TimerInfo[i].nGroupIndex].Type != ProfileTokenTypeGpu)
 				{
-                    if (S.GroupInfo[S.TimerInfo[i].nGroupIndex].Type == ProfileTokenTypeGpu)
-                    {
-                        continue;
-                    }
-                     
-					S.AccumTimers[i].nTicks += S.Frame[i].nTicks;
-					S.AccumTimers[i].nCount += S.Frame[i].nCount;
-					S.AccumMaxTimers[i] = ProfileMax(S.AccumMaxTimers[i], S.Frame[i].nTicks);
-					S.AccumMinTimers[i] = ProfileMin(S.AccumMinTimers[i], S.Frame[i].nTicks);
-					S.AccumTimersExclusive[i] += S.FrameExclusive[i];
-					S.AccumMaxTimersExclusive[i] = ProfileMax(S.AccumMaxTimersExclusive[i], S.FrameExclusive[i]);
+					S.Frame[i] = F.Frame[i];
+					S.FrameExclusive[i] = F.FrameExclusive[i];
 				}
+			}
+			memset(&F.Frame[0], 0, sizeof(F.Frame[0]) * S.nTotalTimers);
+			memset(&F.FrameExclusive[0], 0, sizeof(F.FrameExclusive[0]) * S.nTotalTimers);
+			memcpy(&S.FrameGroup[0], &F.FrameGroup[0], sizeof(S.FrameGroup));
+			memset(&F.FrameGroup[0], 0, sizeof(F.FrameGroup));
 
-				for (uint32_t i = 0; i < PROFILE_MAX_GROUPS; ++i)
+			for (uint32_t i = 0; i < F.nLogCount; ++i)
+			{
+				ProfileThreadLog* pLog = F.Logs[i];
+				for (uint32_t j = 0; j < PROFILE_MAX_GROUPS; ++j)
 				{
-					S.AccumGroup[i] += pFrameGroup[i];
-					S.AccumGroupMax[i] = ProfileMax(S.AccumGroupMax[i], pFrameGroup[i]);
+					pLog->nGroupTicks[j] += F.LogGroupTicks[i][j];
 				}
+			}
 
-				for (uint32_t j = 0; j < PROFILE_META_MAX; ++j)
+			for (uint32_t j = 0; j < PROFILE_META_MAX; ++j)
+			{
+				if (S.MetaCounters[j].pName && 0 != (S.nActiveBars & (P_DRAW_META_FIRST << j)))
 				{
-					if (S.MetaCounters[j].pName && 0 != (S.nActiveBars & (P_DRAW_META_FIRST << j)))
-					{
-						auto& Meta = S.MetaCounters[j];
-						uint64_t nSum = 0;;
-						for (uint32_t i = 0; i < S.nTotalTimers; ++i)
-						{
-							uint64_t nCounter = Meta.nCounters[i];
-							Meta.nAccumMax[i] = ProfileMax(Meta.nAccumMax[i], nCounter);
-							Meta.nAccum[i] += nCounter;
-							nSum += nCounter;
-						}
-						Meta.nSumAccum += nSum;
-						Meta.nSumAccumMax = ProfileMax(Meta.nSumAccumMax, nSum);
-					}
+					memcpy(&S.MetaCounters[j].nCounters[0], &F.MetaCounters[j][0], sizeof(F.MetaCounters[j][0]) * S.nTotalTimers);
 				}
+				memset(&F.MetaCounters[j][0], 0, sizeof(F.MetaCounters[j][0]) * S.nTotalTimers);
 			}
-			for (uint32_t i = 0; i < PROFILE_MAX_GRAPHS; ++i)
+		}
+		{
+			PROFILER_SET_CPU_SCOPE("Profile", "Accumulate", 0x3355ee);
+			uint64_t* pFrameGroup = &S.FrameGroup[0];
+			for (uint32_t i = 0; i < S.nTotalTimers; ++i)
 			{
-				if (S.Graph[i].nToken != PROFILE_INVALID_TOKEN)
+				if (S.GroupInfo[S.TimerInfo[i].nGroupIndex].Type == ProfileTokenTypeGpu)
 				{
-					ProfileToken nToken = S.Graph[i].nToken;
-					S.Graph[i].nHistory[S.nGraphPut] = S.Frame[ProfileGetTimerIndex(nToken)].nTicks;
+					continue;
 				}
-			}
-			S.nGraphPut = (S.nGraphPut + 1) % PROFILE_GRAPH_HISTORY;
 
-		}
+				S.AccumTimers[i].nTicks += S.Frame[i].nTicks;
+				S.AccumTimers[i].nCount += S.Frame[i].nCount;
+				S.AccumMaxTimers[i] = ProfileMax(S.AccumMaxTimers[i], S.Frame[i].nTicks);
+				S.AccumMinTimers[i] = ProfileMin(S.AccumMinTimers[i], S.Frame[i].nTicks);
+				S.AccumTimersExclusive[i] += S.FrameExclusive[i];
+				S.AccumMaxTimersExclusive[i] = ProfileMax(S.AccumMaxTimersExclusive[i], S.FrameExclusive[i]);
+			}
 
+			for (uint32_t i = 0; i < PROFILE_MAX_GROUPS; ++i)
+			{
+				S.AccumGroup[i] += pFrameGroup[i];
+				S.AccumGroupMax[i] = ProfileMax(S.AccumGroupMax[i], pFrameGroup[i]);
+			}
 
-		if (S.nRunning && S.nAggregateFlip <= ++S.nAggregateFlipCount)
+			for (uint32_t j = 0; j < PROFILE_META_MAX; ++j)
+			{
+				if (S.MetaCounters[j].pName && 0 != (S.nActiveBars & (P_DRAW_META_FIRST << j)))
+				{
+					auto& Meta = S.MetaCounters[j];
+					uint64_t nSum = 0;;
+					for (uint32_t i = 0; i < S.nTotalTimers; ++i)
+					{
+						uint64_t nCounter = Meta.nCounters[i];
+						Meta.nAccumMax[i] = ProfileMax(Meta.nAccumMax[i], nCounter);
+						Meta.nAccum[i] += nCounter;
+						nSum += nCounter;
+					}
+					Meta.nSumAccum += nSum;
+					Meta.nSumAccumMax = ProfileMax(Meta.nSumAccumMax, nSum);
+				}
+			}
+		}
+		for (uint32_t i = 0; i < PROFILE_MAX_GRAPHS; ++i)
 		{
-			nAggregateFlip = 1;
-			if (S.nAggregateFlip) // if 0 accumulate indefinitely
+			if (S.Graph[i].nToken != PROFILE_INVALID_TOKEN)
 			{
-				nAggregateClear = 1;
+				ProfileToken nToken = S.Graph[i].nToken;
+				S.Graph[i].nHistory[S.nGraphPut] = S.Frame[ProfileGetTimerIndex(nToken)].nTicks;
 			}
 		}
+		S.nGraphPut = (S.nGraphPut + 1) % PROFILE_GRAPH_HISTORY;
+	}
+
+	// Recycle logs that were already retired when the flip started. Entries within the frame history
+	// that have not been parsed yet are dropped, as they were when a thread log used to be freed on exit.
+	for (uint32_t r = 0; r < F.nRetiredLogCount; ++r)
+	{
+		const uint32_t i = F.RetiredLogs[r];
+		S.Pool[i] = 0;
+		for (int j = 0; j < PROFILE_MAX_FRAME_HISTORY; ++j)
+		{
+			S.Frames[j].nLogStart[i] = 0;
+		}
+		tfrg_atomic32_store_release(&S.nPoolState[i], P_THREAD_LOG_FREE);
+	}
+
+	if (bFrameAdvanced && S.nRunning && S.nAggregateFlip <= ++S.nAggregateFlipCount)
+	{
+		nAggregateFlip = 1;
+		if (S.nAggregateFlip) // if 0 accumulate indefinitely
+		{
+			nAggregateClear = 1;
+		}
 	}
 	if (nAggregateFlip)
 	{
@@ -256,6 +256,10 @@ typedef uint16_t ProfileGroupId;
 #define PROFILE_PER_THREAD_BUFFER_SIZE (2048<<10)
 #endif
 
+#ifndef PROFILE_PREALLOCATED_THREAD_LOGS
+#define PROFILE_PREALLOCATED_THREAD_LOGS 8 //number of thread log buffers allocated up front in initProfiler
+#endif
+
 #ifndef PROFILE_PER_THREAD_GPU_BUFFER_SIZE
 #define PROFILE_PER_THREAD_GPU_BUFFER_SIZE (1024<<10)
 #endif
@@ -558,6 +562,13 @@ enum ProfileCounterFlags
 
 typedef uint64_t ProfileLogEntry;
 
+enum ProfileThreadLogState
+{
+	P_THREAD_LOG_FREE = 0,
+	P_THREAD_LOG_ACTIVE = 1,
+	P_THREAD_LOG_RETIRED = 2, //owner is gone, slot is recycled by the next flip
+};
+
 struct ProfileTimer
 {
 	uint64_t nTicks;
@@ -771,7 +782,10 @@ struct Profile
 
 	uint32_t				nThreadActive[PROFILE_MAX_THREADS];
 	ProfileThreadLog* 	Pool[PROFILE_MAX_THREADS];
-	uint32_t 				nMemUsage;
+	ProfileThreadLog		PoolStorage[PROFILE_MAX_THREADS];
+	tfrg_atomic32_t			nPoolState[PROFILE_MAX_THREADS];
+	ProfileLogEntry*		pPreallocatedLogs;
+	tfrg_atomic32_t			nMemUsage;
 
 	uint32_t 				nFrameCurrent;
 	uint32_t 				nFrameCurrentIndex;
@@ -24,9 +24,16 @@
 
 #include "IRenderer.h"
 #include "../OS/Interfaces/ILog.h"
+#include "../OS/Interfaces/IFileSystem.h"
+#include "../OS/Interfaces/IThread.h"
+
+#include "../ThirdParty/OpenSource/EASTL/unordered_map.h"
+#include "../ThirdParty/OpenSource/EASTL/vector.h"
 
 #include "../OS/Interfaces/IMemory.h"
 
+using namespace theforge;
+
 //This file contains shader reflection code that is the same for all platforms.
 //We know it's the same for all platforms since it only interacts with the
 // platform abstractions we created.
@@ -56,6 +63,20 @@ static bool ShaderResourceCmp(ShaderResource* a, ShaderResource* b)
 	return isSame;
 }
 
+// Hashes the fields compared by ShaderResourceCmp
+static uint64_t ShaderResourceHash(const ShaderResource* pResource)
+{
+	uint32_t key[3] = { (uint32_t)pResource->type, pResource->set, pResource->reg };
+	uint64_t hash = tf_mem_hash<uint8_t>((const uint8_t*)key, sizeof(key));
+#ifdef METAL
+	hash = tf_mem_hash<uint8_t>((const uint8_t*)&pResource->mtlArgumentDescriptors.mArgumentIndex, sizeof(uint32_t), (size_t)hash);
+#endif
+#ifdef RESOURCE_NAME_CHECK
+	hash = tf_mem_hash<uint8_t>((const uint8_t*)pResource->name, pResource->name_size, (size_t)hash);
+#endif
+	return hash;
+}
+
 static bool ShaderVariableCmp(ShaderVariable* a, ShaderVariable* b)
 {
 	bool isSame = true;
@@ -73,6 +94,33 @@ static bool ShaderVariableCmp(ShaderVariable* a, ShaderVariable* b)
 	return isSame;
 }
 
+// Hashes the fields compared by ShaderVariableCmp
+static uint64_t ShaderVariableHash(const ShaderVariable* pVariable)
+{
+	uint32_t key[2] = { pVariable->offset, pVariable->size };
+	uint64_t hash = tf_mem_hash<uint8_t>((const uint8_t*)key, sizeof(key));
+	return tf_mem_hash<uint8_t>((const uint8_t*)pVariable->name, pVariable->name_size, (size_t)hash);
+}
+
+// Returns the index of the resource equal to pResource, or ~0u. Hash collisions fall back to a linear search
+static uint32_t FindShaderResource(
+	const eastl::unordered_map<uint64_t, uint32_t>& indices, uint64_t hash, ShaderResource* pResource, ShaderResource** ppResources,
+	uint32_t resourceCount)
+{
+	eastl::unordered_map<uint64_t, uint32_t>::const_iterator it = indices.find(hash);
+	if (it == indices.end())
+		return ~0u;
+	if (ShaderResourceCmp(pResource, ppResources[it->second]))
+		return it->second;
+
+	for (uint32_t k = 0; k < resourceCount; ++k)
+	{
+		if (ShaderResourceCmp(pResource, ppResources[k]))
+			return k;
+	}
+	return ~0u;
+}
+
 void destroyShaderReflection(ShaderReflection* pReflection)
 {
 	if (pReflection == NULL)
@@ -128,12 +176,21 @@ void createPipelineReflection(ShaderReflection* pReflection, uint32_t stageCount
 	ShaderVariable* pVariables = NULL;
 	uint32_t        variableCount = 0;
 
-	//Should we be using dynamic arrays for these? Perhaps we can add std::vector
-	// like functionality?
-	ShaderResource* uniqueResources[512];
-	ShaderStage     shaderUsage[512];
-	ShaderVariable* uniqueVariable[512];
-	ShaderResource* uniqueVariableParent[512];
+	uint32_t totalResourceCount = 0;
+	uint32_t totalVariableCount = 0;
+	for (uint32_t i = 0; i < stageCount; ++i)
+	{
+		totalResourceCount += pReflection[i].mShaderResourceCount;
+		totalVariableCount += pReflection[i].mVariableCount;
+	}
+
+	// Resources and variables are looked up by hash so merging stays linear in the number of resources
+	eastl::vector<ShaderResource*>           uniqueResources(totalResourceCount);
+	eastl::vector<ShaderStage>               shaderUsage(totalResourceCount);
+	eastl::vector<ShaderVariable*>           uniqueVariable(totalVariableCount);
+	eastl::vector<ShaderResource*>           uniqueVariableParent(totalVariableCount);
+	eastl::unordered_map<uint64_t, uint32_t> resourceIndices;
+	eastl::unordered_map<uint64_t, uint32_t> variableIndices;
 	for (uint32_t i = 0; i < stageCount; ++i)
 	{
 		ShaderReflection* pSrcRef = pReflection + i;
@@ -165,53 +222,47 @@ void createPipelineReflection(ShaderReflection* pReflection, uint32_t stageCount
 		//Loop through all shader resources
 		for (uint32_t j = 0; j < pSrcRef->mShaderResourceCount; ++j)
 		{
-			bool unique = true;
+			ShaderResource* pResource = &pSrcRef->pShaderResources[j];
+			uint64_t        hash = ShaderResourceHash(pResource);
 
-			//Go through all already added shader resources to see if this shader
-			// resource was already added from a different shader stage. If we find a
-			// duplicate shader resource, we add the shader stage to the shader stage
-			// mask of that resource instead.
-			for (uint32_t k = 0; k < resourceCount; ++k)
+			//If this shader resource was already added from a different shader stage
+			// we add the shader stage to the shader stage mask of that resource instead.
+			uint32_t index = FindShaderResource(resourceIndices, hash, pResource, uniqueResources.data(), resourceCount);
+			if (index != ~0u)
 			{
-				unique = !ShaderResourceCmp(&pSrcRef->pShaderResources[j], uniqueResources[k]);
-				if (unique == false)
-				{
-					// update shader usage
-					// NOT SURE
-					//shaderUsage[k] = (ShaderStage)(shaderUsage[k] & pSrcRef->pShaderResources[j].used_stages);
-					shaderUsage[k] |= pSrcRef->pShaderResources[j].used_stages;
-					break;
-				}
+				shaderUsage[index] |= pResource->used_stages;
+				continue;
 			}
 
-			//If it's unique, we add it to the list of shader resourceas
-			if (unique == true)
-			{
-				shaderUsage[resourceCount] = pSrcRef->pShaderResources[j].used_stages;
-				uniqueResources[resourceCount] = &pSrcRef->pShaderResources[j];
-				resourceCount++;
-			}
+			//It's unique, we add it to the list of shader resources
+			shaderUsage[resourceCount] = pResource->used_stages;
+			uniqueResources[resourceCount] = pResource;
+			resourceIndices.insert(eastl::make_pair(hash, resourceCount));
+			resourceCount++;
 		}
 
 		//Loop through all shader variables (constant/uniform buffer members)
 		for (uint32_t j = 0; j < pSrcRef->mVariableCount; ++j)
 		{
+			ShaderVariable* pVariable = &pSrcRef->pVariables[j];
+			uint64_t        hash = ShaderVariableHash(pVariable);
+
+			//If this shader variable was already added from a different shader stage we don't add it.
 			bool unique = true;
-			//Go through all already added shader variables to see if this shader
-			// variable was already added from a different shader stage. If we find a
-			// duplicate shader variables, we don't add it.
-			for (uint32_t k = 0; k < variableCount; ++k)
+			eastl::unordered_map<uint64_t, uint32_t>::iterator it = variableIndices.find(hash);
+			if (it != variableIndices.end())
 			{
-				unique = !ShaderVariableCmp(&pSrcRef->pVariables[j], uniqueVariable[k]);
-				if (unique == false)
-					break;
+				unique = !ShaderVariableCmp(pVariable, uniqueVariable[it->second]);
+				for (uint32_t k = 0; unique && k < variableCount; ++k)
+					unique = !ShaderVariableCmp(pVariable, uniqueVariable[k]);
 			}
 
 			//If it's unique we add it to the list of shader variables
 			if (unique)
 			{
-				uniqueVariableParent[variableCount] = &pSrcRef->pShaderResources[pSrcRef->pVariables[j].parent_index];
-				uniqueVariable[variableCount] = &pSrcRef->pVariables[j];
+				uniqueVariableParent[variableCount] = &pSrcRef->pShaderResources[pVariable->parent_index];
+				uniqueVariable[variableCount] = pVariable;
+				variableIndices.insert(eastl::make_pair(hash, variableCount));
 				variableCount++;
 			}
 		}
@@ -237,16 +288,12 @@ void createPipelineReflection(ShaderReflection* pReflection, uint32_t stageCount
 		for (uint32_t i = 0; i < variableCount; ++i)
 		{
 			pVariables[i] = *uniqueVariable[i];
+			// look for parent, pResources has the same order as uniqueResources
 			ShaderResource* parentResource = uniqueVariableParent[i];
-			// look for parent
-			for (uint32_t j = 0; j < resourceCount; ++j)
-			{
-				if (ShaderResourceCmp(&pResources[j], parentResource))
-				{
-					pVariables[i].parent_index = j;
-					break;
-				}
-			}
+			uint32_t        index = FindShaderResource(
+				resourceIndices, ShaderResourceHash(parentResource), parentResource, uniqueResources.data(), resourceCount);
+			if (index != ~0u)
+				pVariables[i].parent_index = index;
 		}
 	}
 
@@ -279,3 +326,319 @@ void destroyPipelineReflection(PipelineReflection* pReflection)
 	tf_free(pReflection->pShaderResources);
 	tf_free(pReflection->pVariables);
 }
+
+/************************************************************************/
+// Reflection serialization
+/************************************************************************/
+// Blob layout: header, vertex inputs, resources, variables, name pool.
+// Name pointers are stored as offsets into the name pool
+typedef struct ShaderReflectionBlobHeader
+{
+	uint32_t mShaderStage;
+	uint32_t mNamePoolSize;
+	uint32_t mVertexInputsCount;
+	uint32_t mShaderResourceCount;
+	uint32_t mVariableCount;
+	uint32_t mNumThreadsPerGroup[3];
+	uint32_t mNumControlPoint;
+	uint32_t mEntryPointOffset;
+} ShaderReflectionBlobHeader;
+
+template <typename T>
+static T* util_name_to_offset(T* pItems, uint32_t count, const char* pNamePool)
+{
+	for (uint32_t i = 0; i < count; ++i)
+		pItems[i].name = (const char*)(uintptr_t)(pItems[i].name - pNamePool);
+	return pItems + count;
+}
+
+template <typename T>
+static bool util_offset_to_name(T* pItems, uint32_t count, const char* pNamePool, uint32_t namePoolSize)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uintptr_t offset = (uintptr_t)pItems[i].name;
+		if (offset + pItems[i].name_size >= namePoolSize)
+			return false;
+		pItems[i].name = pNamePool + offset;
+	}
+	return true;
+}
+
+void serializeShaderReflection(const ShaderReflection* pReflection, void** ppBlob, uint32_t* pBlobSize)
+{
+	ASSERT(pReflection);
+	ASSERT(ppBlob);
+	ASSERT(pBlobSize);
+
+	uint32_t size = sizeof(ShaderReflectionBlobHeader) + pReflection->mVertexInputsCount * sizeof(VertexInput) +
+					pReflection->mShaderResourceCount * sizeof(ShaderResource) + pReflection->mVariableCount * sizeof(ShaderVariable) +
+					pReflection->mNamePoolSize;
+
+	uint8_t*                    pBlob = (uint8_t*)tf_calloc(1, size);
+	ShaderReflectionBlobHeader* pHeader = (ShaderReflectionBlobHeader*)pBlob;
+	pHeader->mShaderStage = pReflection->mShaderStage;
+	pHeader->mNamePoolSize = pReflection->mNamePoolSize;
+	pHeader->mVertexInputsCount = pReflection->mVertexInputsCount;
+	pHeader->mShaderResourceCount = pReflection->mShaderResourceCount;
+	pHeader->mVariableCount = pReflection->mVariableCount;
+	memcpy(pHeader->mNumThreadsPerGroup, pReflection->mNumThreadsPerGroup, sizeof(pHeader->mNumThreadsPerGroup));
+	pHeader->mNumControlPoint = pReflection->mNumControlPoint;
+#if defined(VULKAN)
+	pHeader->mEntryPointOffset = pReflection->pEntryPoint ? (uint32_t)(pReflection->pEntryPoint - pReflection->pNamePool) : ~0u;
+#else
+	pHeader->mEntryPointOffset = ~0u;
+#endif
+
+	VertexInput* pVertexInputs = (VertexInput*)(pHeader + 1);
+	if (pReflection->mVertexInputsCount)
+		memcpy(pVertexInputs, pReflection->pVertexInputs, pReflection->mVertexInputsCount * sizeof(VertexInput));
+	ShaderResource* pResources = (ShaderResource*)util_name_to_offset(pVertexInputs, pReflection->mVertexInputsCount, pReflection->pNamePool);
+	if (pReflection->mShaderResourceCount)
+		memcpy(pResources, pReflection->pShaderResources, pReflection->mShaderResourceCount * sizeof(ShaderResource));
+	ShaderVariable* pVariables = (ShaderVariable*)util_name_to_offset(pResources, pReflection->mShaderResourceCount, pReflection->pNamePool);
+	if (pReflection->mVariableCount)
+		memcpy(pVariables, pReflection->pVariables, pReflection->mVariableCount * sizeof(ShaderVariable));
+	char* pNamePool = (char*)util_name_to_offset(pVariables, pReflection->mVariableCount, pReflection->pNamePool);
+	if (pReflection->mNamePoolSize)
+		memcpy(pNamePool, pReflection->pNamePool, pReflection->mNamePoolSize);
+
+	*ppBlob = pBlob;
+	*pBlobSize = size;
+}
+
+bool deserializeShaderReflection(const void* pBlob, uint32_t blobSize, ShaderReflection* pOutReflection)
+{
+	ASSERT(pBlob);
+	ASSERT(pOutReflection);
+
+	const ShaderReflectionBlobHeader* pHeader = (const ShaderReflectionBlobHeader*)pBlob;
+	if (blobSize < sizeof(ShaderReflectionBlobHeader))
+		return false;
+
+	uint64_t size = sizeof(ShaderReflectionBlobHeader) + (uint64_t)pHeader->mVertexInputsCount * sizeof(VertexInput) +
+					(uint64_t)pHeader->mShaderResourceCount * sizeof(ShaderResource) +
+					(uint64_t)pHeader->mVariableCount * sizeof(ShaderVariable) + pHeader->mNamePoolSize;
+	if (size != blobSize)
+		return false;
+
+	ShaderReflection reflection = {};
+	reflection.mShaderStage = (ShaderStage)pHeader->mShaderStage;
+	reflection.mNamePoolSize = pHeader->mNamePoolSize;
+	reflection.mVertexInputsCount = pHeader->mVertexInputsCount;
+	reflection.mShaderResourceCount = pHeader->mShaderResourceCount;
+	reflection.mVariableCount = pHeader->mVariableCount;
+	memcpy(reflection.mNumThreadsPerGroup, pHeader->mNumThreadsPerGroup, sizeof(reflection.mNumThreadsPerGroup));
+	reflection.mNumControlPoint = pHeader->mNumControlPoint;
+
+	const VertexInput*    pVertexInputs = (const VertexInput*)(pHeader + 1);
+	const ShaderResource* pResources = (const ShaderResource*)(pVertexInputs + reflection.mVertexInputsCount);
+	const ShaderVariable* pVariables = (const ShaderVariable*)(pResources + reflection.mShaderResourceCount);
+	const char*           pNamePool = (const char*)(pVariables + reflection.mVariableCount);
+
+	if (reflection.mNamePoolSize)
+	{
+		reflection.pNamePool = (char*)tf_malloc(reflection.mNamePoolSize);
+		memcpy(reflection.pNamePool, pNamePool, reflection.mNamePoolSize);
+	}
+	if (reflection.mVertexInputsCount)
+	{
+		reflection.pVertexInputs = (VertexInput*)tf_malloc(reflection.mVertexInputsCount * sizeof(VertexInput));
+		memcpy(reflection.pVertexInputs, pVertexInputs, reflection.mVertexInputsCount * sizeof(VertexInput));
+	}
+	if (reflection.mShaderResourceCount)
+	{
+		reflection.pShaderResources = (ShaderResource*)tf_malloc(reflection.mShaderResourceCount * sizeof(ShaderResource));
+		memcpy(reflection.pShaderResources, pResources, reflection.mShaderResourceCount * sizeof(ShaderResource));
+	}
+	if (reflection.mVariableCount)
+	{
+		reflection.pVariables = (ShaderVariable*)tf_malloc(reflection.mVariableCount * sizeof(ShaderVariable));
+		memcpy(reflection.pVariables, pVariables, reflection.mVariableCount * sizeof(ShaderVariable));
+	}
+
+	bool valid =
+		util_offset_to_name(reflection.pVertexInputs, reflection.mVertexInputsCount, reflection.pNamePool, reflection.mNamePoolSize) &&
+		util_offset_to_name(reflection.pShaderResources, reflection.mShaderResourceCount, reflection.pNamePool, reflection.mNamePoolSize) &&
+		util_offset_to_name(reflection.pVariables, reflection.mVariableCount, reflection.pNamePool, reflection.mNamePoolSize);
+#if defined(VULKAN)
+	if (pHeader->mEntryPointOffset != ~0u)
+	{
+		valid = valid && pHeader->mEntryPointOffset < reflection.mNamePoolSize;
+		if (valid)
+			reflection.pEntryPoint = reflection.pNamePool + pHeader->mEntryPointOffset;
+	}
+#endif
+
+	if (!valid)
+	{
+		destroyShaderReflection(&reflection);
+		return false;
+	}
+
+	*pOutReflection = reflection;
+	return true;
+}
+
+/************************************************************************/
+// Reflection cache
+/************************************************************************/
+// Stage reflections of every shader seen so far, stored next to the shader binaries and addressed by the hash of the byte code
+#define SHADER_REFLECTION_CACHE_FILE_NAME "ShaderReflection.bin"
+#define SHADER_REFLECTION_CACHE_FILE_MAGIC 0x46525346u    // "FSRF"
+// Bump when the reflection code changes what it extracts from the byte code
+#define SHADER_REFLECTION_CACHE_FILE_VERSION 2u
+
+typedef struct ShaderReflectionCacheHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mEntryCount;
+	// Blobs contain the reflection structs as they are laid out in this build
+	uint32_t mLayoutSize;
+} ShaderReflectionCacheHeader;
+
+// Followed by the blobs of all entries
+typedef struct ShaderReflectionCacheEntry
+{
+	uint64_t mKey;
+	uint64_t mOffset;
+	uint64_t mSize;
+} ShaderReflectionCacheEntry;
+
+struct ShaderReflectionCacheItem
+{
+	uint32_t       mSize;
+	const uint8_t* pBlob;    // Inside the cache file, or owned by the item for reflections created in this run
+	bool           mOwned;
+};
+
+struct ShaderReflectionCache
+{
+	uint8_t*                                                  pData;
+	bool                                                      mDirty;
+	eastl::unordered_map<uint64_t, ShaderReflectionCacheItem> mItems;
+	Mutex                                                     mMutex;
+};
+
+static ShaderReflectionCache gShaderReflectionCache;
+
+static const uint32_t gShaderReflectionLayoutSize =
+	(uint32_t)(sizeof(ShaderReflectionBlobHeader) + sizeof(VertexInput) + sizeof(ShaderResource) + sizeof(ShaderVariable));
+
+// The byte code size in the upper bits keeps byte code of different sizes apart, the hash is only 32 bit
+static uint64_t util_reflection_key(const void* pByteCode, uint32_t byteCodeSize, ShaderStage stage)
+{
+	size_t hash = tf_mem_hash<uint8_t>((const uint8_t*)pByteCode, byteCodeSize);
+	hash = tf_mem_hash<uint8_t>((const uint8_t*)&stage, sizeof(stage), hash);
+	return ((uint64_t)byteCodeSize << 32) | (uint32_t)hash;
+}
+
+void initShaderReflectionCache()
+{
+	gShaderReflectionCache.mMutex.Init();
+
+	FileStream fh = {};
+	if (!fsOpenStreamFromPath(RD_SHADER_BINARIES, SHADER_REFLECTION_CACHE_FILE_NAME, FM_READ_BINARY, &fh))
+		return;
+
+	size_t size = (size_t)fsGetStreamFileSize(&fh);
+	gShaderReflectionCache.pData = (uint8_t*)tf_malloc(size);
+	size_t readSize = fsReadFromStream(&fh, gShaderReflectionCache.pData, size);
+	fsCloseStream(&fh);
+
+	const ShaderReflectionCacheHeader* pHeader = (const ShaderReflectionCacheHeader*)gShaderReflectionCache.pData;
+	bool valid = readSize == size && size >= sizeof(ShaderReflectionCacheHeader) && SHADER_REFLECTION_CACHE_FILE_MAGIC == pHeader->mMagic &&
+				 SHADER_REFLECTION_CACHE_FILE_VERSION == pHeader->mVersion && gShaderReflectionLayoutSize == pHeader->mLayoutSize &&
+				 size >= sizeof(ShaderReflectionCacheHeader) + pHeader->mEntryCount * sizeof(ShaderReflectionCacheEntry);
+
+	const ShaderReflectionCacheEntry* pEntries = (const ShaderReflectionCacheEntry*)(pHeader + 1);
+	for (uint32_t i = 0; valid && i < pHeader->mEntryCount; ++i)
+	{
+		const ShaderReflectionCacheEntry& entry = pEntries[i];
+		valid = entry.mOffset <= size && entry.mSize <= size - entry.mOffset;
+		gShaderReflectionCache.mItems[entry.mKey] = { (uint32_t)entry.mSize, gShaderReflectionCache.pData + entry.mOffset, false };
+	}
+
+	if (!valid)
+	{
+		LOGF(LogLevel::eWARNING, "Ignoring outdated or corrupted shader reflection cache %s", SHADER_REFLECTION_CACHE_FILE_NAME);
+		gShaderReflectionCache.mItems.clear();
+	}
+}
+
+void exitShaderReflectionCache()
+{
+	if (gShaderReflectionCache.mDirty)
+	{
+		size_t size = sizeof(ShaderReflectionCacheHeader) + gShaderReflectionCache.mItems.size() * sizeof(ShaderReflectionCacheEntry);
+		for (const eastl::pair<const uint64_t, ShaderReflectionCacheItem>& it : gShaderReflectionCache.mItems)
+			size += round_up_64(it.second.mSize, 8);
+
+		uint8_t*                     pData = (uint8_t*)tf_calloc(1, size);
+		ShaderReflectionCacheHeader* pHeader = (ShaderReflectionCacheHeader*)pData;
+		ShaderReflectionCacheEntry*  pEntries = (ShaderReflectionCacheEntry*)(pHeader + 1);
+		*pHeader = { SHADER_REFLECTION_CACHE_FILE_MAGIC, SHADER_REFLECTION_CACHE_FILE_VERSION,
+					 (uint32_t)gShaderReflectionCache.mItems.size(), gShaderReflectionLayoutSize };
+
+		uint64_t offset = sizeof(ShaderReflectionCacheHeader) + gShaderReflectionCache.mItems.size() * sizeof(ShaderReflectionCacheEntry);
+		for (const eastl::pair<const uint64_t, ShaderReflectionCacheItem>& it : gShaderReflectionCache.mItems)
+		{
+			*pEntries++ = { it.first, offset, it.second.mSize };
+			memcpy(pData + offset, it.second.pBlob, it.second.mSize);
+			offset += round_up_64(it.second.mSize, 8);
+		}
+
+		FileStream fh = {};
+		if (fsOpenStreamFromPath(RD_SHADER_BINARIES, SHADER_REFLECTION_CACHE_FILE_NAME, FM_WRITE_BINARY, &fh))
+		{
+			fsWriteToStream(&fh, pData, size);
+			fsCloseStream(&fh);
+		}
+		else
+		{
+			LOGF(LogLevel::eWARNING, "Failed to write shader reflection cache %s", SHADER_REFLECTION_CACHE_FILE_NAME);
+		}
+		tf_free(pData);
+	}
+
+	for (const eastl::pair<const uint64_t, ShaderReflectionCacheItem>& it : gShaderReflectionCache.mItems)
+		if (it.second.mOwned)
+			tf_free((void*)it.second.pBlob);
+
+	tf_free(gShaderReflectionCache.pData);
+	gShaderReflectionCache.mItems.clear();
+	gShaderReflectionCache.mMutex.Destroy();
+	gShaderReflectionCache.pData = NULL;
+	gShaderReflectionCache.mDirty = false;
+}
+
+bool loadCachedShaderReflection(const void* pByteCode, uint32_t byteCodeSize, ShaderStage stage, ShaderReflection* pOutReflection)
+{
+	uint64_t key = util_reflection_key(pByteCode, byteCodeSize, stage);
+
+	MutexLock lock(gShaderReflectionCache.mMutex);
+
+	eastl::unordered_map<uint64_t, ShaderReflectionCacheItem>::iterator it = gShaderReflectionCache.mItems.find(key);
+	if (it == gShaderReflectionCache.mItems.end())
+		return false;
+
+	return deserializeShaderReflection(it->second.pBlob, it->second.mSize, pOutReflection);
+}
+
+void addCachedShaderReflection(const void* pByteCode, uint32_t byteCodeSize, const ShaderReflection* pReflection)
+{
+	uint64_t key = util_reflection_key(pByteCode, byteCodeSize, pReflection->mShaderStage);
+
+	void*    pBlob = NULL;
+	uint32_t blobSize = 0;
+	serializeShaderReflection(pReflection, &pBlob, &blobSize);
+
+	MutexLock lock(gShaderReflectionCache.mMutex);
+
+	ShaderReflectionCacheItem& item = gShaderReflectionCache.mItems[key];
+	if (item.mOwned)
+		tf_free((void*)item.pBlob);
+	item = { blobSize, (const uint8_t*)pBlob, true };
+	gShaderReflectionCache.mDirty = true;
+}
@@ -1288,6 +1288,8 @@ void removeRenderer(Renderer* pRenderer)
 {
 	ASSERT(pRenderer);
 
+	exitGPUConfig();
+
 	remove_default_resources(pRenderer);
 
 	RemoveDevice(pRenderer);
@@ -3067,6 +3069,15 @@ const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const
 	}
 }
 
+uint32_t getDescriptorIndexFromName(const RootSignature* pRootSignature, const char* pName)
+{
+	ASSERT(pRootSignature);
+	ASSERT(pName);
+
+	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, pName);
+	return pDesc ? (uint32_t)(pDesc - pRootSignature->pDescriptors) : (uint32_t)-1;
+}
+
 typedef struct CBV
 {
 	ID3D11Buffer* pHandle;
@@ -3185,7 +3196,24 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 	{
 		const DescriptorData* pParam = pParams + i;
 		uint32_t paramIndex = pParam->mIndex;
-		const DescriptorInfo* pDesc = (paramIndex != -1) ? (pRootSignature->pDescriptors + paramIndex) : get_descriptor(pRootSignature, pParam->pName);
+
+		VALIDATE_DESCRIPTOR(pParam->pName || (paramIndex != -1), "DescriptorData has NULL name and invalid index");
+
+		const DescriptorInfo* pDesc = NULL;
+		if (paramIndex != -1)
+		{
+			// Indices from getDescriptorIndexFromName are only valid for the root signature they were resolved on
+			VALIDATE_DESCRIPTOR(paramIndex < pRootSignature->mDescriptorCount, "Invalid descriptor with param index (%u)", paramIndex);
+			pDesc = pRootSignature->pDescriptors + paramIndex;
+			VALIDATE_DESCRIPTOR(!pParam->pName || !strcmp(pParam->pName, pDesc->pName),
+				"Descriptor param index (%u) refers to (%s) instead of (%s) in this root signature", paramIndex, pDesc->pName, pParam->pName);
+		}
+		else
+		{
+			pDesc = get_descriptor(pRootSignature, pParam->pName);
+			VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param name (%s)", pParam->pName);
+		}
+
 		paramIndex = pDesc->mHandleIndex;
 		const DescriptorType type = (DescriptorType)pDesc->mType;
 		const uint32_t arrayCount = max(1U, pParam->mCount);
@@ -3355,6 +3383,15 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 		}
 	}
 }
+
+void updateDescriptorSets(Renderer* pRenderer, uint32_t count, const DescriptorSetUpdateDesc* pDescs)
+{
+	ASSERT(pDescs || !count);
+
+	// Descriptors are only recorded here and bound in cmdBindDescriptorSet so there is no driver call to batch
+	for (uint32_t i = 0; i < count; ++i)
+		updateDescriptorSet(pRenderer, pDescs[i].mIndex, pDescs[i].pDescriptorSet, pDescs[i].mParamCount, pDescs[i].pParams);
+}
 /************************************************************************/
 // Command buffer Functions
 /************************************************************************/
@@ -4229,8 +4266,19 @@ void queueSubmit(
 					{
 						sub = { update.pSrcBuffer->pCpuMappedAddress, 0, 0 };
 					}
+					D3D11_BOX regionBox = {};
+					const bool updateRegion = pSubresource.mRegionWidth && pSubresource.mRegionHeight;
+					if (updateRegion)
+					{
+						regionBox.left = pSubresource.mRegionX;
+						regionBox.top = pSubresource.mRegionY;
+						regionBox.front = 0;
+						regionBox.right = pSubresource.mRegionX + pSubresource.mRegionWidth;
+						regionBox.bottom = pSubresource.mRegionY + pSubresource.mRegionHeight;
+						regionBox.back = 1;
+					}
 					pContext->UpdateSubresource(
-						update.pTexture->pDxResource, subresource, NULL, (uint8_t*)sub.pData + pSubresource.mSrcOffset,
+						update.pTexture->pDxResource, subresource, updateRegion ? &regionBox : NULL, (uint8_t*)sub.pData + pSubresource.mSrcOffset,
 						pSubresource.mRowPitch, pSubresource.mSlicePitch);
 					if (!update.pSrcBuffer->pCpuMappedAddress)
 					{
@@ -219,6 +219,10 @@ struct SubresourceDataDesc
 	uint32_t mArrayLayer;
 	uint32_t mRowPitch;
 	uint32_t mSlicePitch;
+	uint32_t mRegionX;
+	uint32_t mRegionY;
+	uint32_t mRegionWidth;
+	uint32_t mRegionHeight;
 };
 
 struct UpdateSubresourcesCmd
@@ -571,6 +571,15 @@ const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const
 		return NULL;
 	}
 }
+
+uint32_t getDescriptorIndexFromName(const RootSignature* pRootSignature, const char* pName)
+{
+	ASSERT(pRootSignature);
+	ASSERT(pName);
+
+	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, pName);
+	return pDesc ? (uint32_t)(pDesc - pRootSignature->pDescriptors) : (uint32_t)-1;
+}
 /************************************************************************/
 // Globals
 /************************************************************************/
@@ -1899,6 +1908,8 @@ void removeRenderer(Renderer* pRenderer)
 {
 	ASSERT(pRenderer);
 
+	exitGPUConfig();
+
 	for (uint32_t i = 0; i < pRenderer->mBuiltinShaderDefinesCount; ++i)
 		pRenderer->pBuiltinShaderDefines[i].~ShaderMacro();
 	SAFE_FREE(pRenderer->pBuiltinShaderDefines);
@@ -4145,13 +4156,18 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 
 		VALIDATE_DESCRIPTOR(pParam->pName || (paramIndex != -1), "DescriptorData has NULL name and invalid index");
 
-		const DescriptorInfo* pDesc = (paramIndex != -1) ? (pRootSignature->pDescriptors + paramIndex) : get_descriptor(pRootSignature, pParam->pName);
+		const DescriptorInfo* pDesc = NULL;
 		if (paramIndex != -1)
 		{
-			VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param index (%u)", paramIndex);
+			// Indices from getDescriptorIndexFromName are only valid for the root signature they were resolved on
+			VALIDATE_DESCRIPTOR(paramIndex < pRootSignature->mDescriptorCount, "Invalid descriptor with param index (%u)", paramIndex);
+			pDesc = pRootSignature->pDescriptors + paramIndex;
+			VALIDATE_DESCRIPTOR(!pParam->pName || !strcmp(pParam->pName, pDesc->pName),
+				"Descriptor param index (%u) refers to (%s) instead of (%s) in this root signature", paramIndex, pDesc->pName, pParam->pName);
 		}
 		else
 		{
+			pDesc = get_descriptor(pRootSignature, pParam->pName);
 			VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param name (%s)", pParam->pName);
 		}
 
@@ -4320,6 +4336,15 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 	}
 }
 
+void updateDescriptorSets(Renderer* pRenderer, uint32_t count, const DescriptorSetUpdateDesc* pDescs)
+{
+	ASSERT(pDescs || !count);
+
+	// Descriptors are copied into the shader visible heap directly so there is no driver call to batch
+	for (uint32_t i = 0; i < count; ++i)
+		updateDescriptorSet(pRenderer, pDescs[i].mIndex, pDescs[i].pDescriptorSet, pDescs[i].mParamCount, pDescs[i].pParams);
+}
+
 bool reset_root_signature(Cmd* pCmd, PipelineType type, ID3D12RootSignature* pRootSignature)
 {
 	// Set root signature if the current one differs from pRootSignature
@@ -5353,6 +5378,10 @@ typedef struct SubresourceDataDesc
 	uint64_t                           mSrcOffset;
 	uint32_t                           mMipLevel;
 	uint32_t                           mArrayLayer;
+	uint32_t                           mRegionX;
+	uint32_t                           mRegionY;
+	uint32_t                           mRegionWidth;
+	uint32_t                           mRegionHeight;
 } SubresourceDataDesc;
 
 void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pSrcBuffer, const SubresourceDataDesc* pDesc)
@@ -5372,10 +5401,24 @@ void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pSrcBuffer, cons
 	dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
 	dst.pResource = pTexture->pDxResource;
 	dst.SubresourceIndex = subresource;
+
+	UINT dstX = 0;
+	UINT dstY = 0;
+	if (pDesc->mRegionWidth && pDesc->mRegionHeight)
+	{
+		// The staging data only holds the region, rows are packed with the placement pitch alignment
+		const uint32_t blockSize = TinyImageFormat_BitSizeOfBlock((TinyImageFormat)pTexture->mFormat) / 8;
+		src.PlacedFootprint.Footprint.Width = pDesc->mRegionWidth;
+		src.PlacedFootprint.Footprint.Height = pDesc->mRegionHeight;
+		src.PlacedFootprint.Footprint.Depth = 1;
+		src.PlacedFootprint.Footprint.RowPitch = round_up(pDesc->mRegionWidth * blockSize, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+		dstX = pDesc->mRegionX;
+		dstY = pDesc->mRegionY;
+	}
 #if defined(XBOX)
-	pCmd->mDma.pDxCmdList->CopyTextureRegion(&dst, 0, 0, 0, &src, NULL);
+	pCmd->mDma.pDxCmdList->CopyTextureRegion(&dst, dstX, dstY, 0, &src, NULL);
 #else
-	pCmd->pDxCmdList->CopyTextureRegion(&dst, 0, 0, 0, &src, NULL);
+	pCmd->pDxCmdList->CopyTextureRegion(&dst, dstX, dstY, 0, &src, NULL);
 #endif
 }
 /************************************************************************/
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include "IResourceLoader.h"
+
+// Layout of geometry container files, written by the AssetPipeline (ProcessGeometry) and loaded with addResource(GeometryLoadDesc*).
+//
+// GeometryFileHeader
+// GeometryFileAttribute attributes[mAttributeCount]
+// GeometryFileDraw      draws[mDrawCount]
+// Meshlet               meshlets[mMeshletCount]     Sorted by draw, the triangles of each meshlet are contiguous in the index data
+// uint8_t               indices[round_up(mIndexDataSize, 4)]
+//                                                   Already offset by the first vertex of their draw
+// uint8_t               stream[round_up(mDataSize, 4)] for each attribute, in the order of the attributes
+//
+// Indices and vertices are ordered for vertex cache, overdraw and vertex fetch efficiency.
+// The index data is compressed with meshopt_encodeIndexBuffer and every vertex stream with meshopt_encodeVertexBuffer.
+// Decoding them gives mIndexCount indices of mIndexStride bytes and mVertexCount elements of mStride bytes.
+
+const uint32_t GEOMETRY_FILE_MAGIC = 0x4D4F4547;    // "GEOM"
+const uint32_t GEOMETRY_FILE_VERSION = 2;
+
+// Extension of geometry container files
+#define GEOMETRY_FILE_EXTENSION "geom"
+
+struct GeometryFileHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mVertexCount;
+	uint32_t mIndexCount;
+	uint32_t mIndexStride;      // 2 or 4
+	uint32_t mIndexDataSize;    // Size in bytes of the compressed index data
+	uint32_t mDrawCount;
+	uint32_t mMeshletCount;
+	uint32_t mAttributeCount;
+};
+
+struct GeometryFileAttribute
+{
+	uint32_t mSemantic;    // ShaderSemantic
+	uint32_t mFormat;      // TinyImageFormat of the stored values
+	uint32_t mStride;      // Size in bytes of one element of the stream
+	uint32_t mDataSize;    // Size in bytes of the compressed stream
+};
+
+struct GeometryFileDraw
+{
+	uint32_t mStartIndex;
+	uint32_t mIndexCount;
+	uint32_t mStartMeshlet;
+	uint32_t mMeshletCount;
+};
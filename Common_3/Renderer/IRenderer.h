@@ -71,6 +71,7 @@ typedef enum RendererApi
 	RENDERER_API_D3D11,
 	RENDERER_API_ORBIS,
 	RENDERER_API_PROSPERO,
+	RENDERER_API_NULL,
 } RendererApi;
 
 typedef enum LogType
@@ -861,7 +862,8 @@ typedef struct RootSignatureDesc
 
 typedef struct DescriptorData
 {
-	/// User can either set name of descriptor or index (index in pRootSignature->pDescriptors array)
+	/// User can either set name of descriptor or index (index in pRootSignature->pDescriptors array, see getDescriptorIndexFromName)
+	/// With ENABLE_GRAPHICS_DEBUG, setting both checks that the index refers to the named descriptor
 	/// Name of descriptor
 	const char* pName;
 	union
@@ -1342,6 +1344,15 @@ typedef struct DescriptorSetDesc
 	uint32_t                   mNodeIndex;
 } DescriptorSetDesc;
 
+typedef struct DescriptorSetUpdateDesc
+{
+	DescriptorSet*        pDescriptorSet;
+	const DescriptorData* pParams;
+	/// Index of the set in pDescriptorSet
+	uint32_t              mIndex;
+	uint32_t              mParamCount;
+} DescriptorSetUpdateDesc;
+
 typedef struct QueueSubmitDesc
 {
 	uint32_t    mCmdCount;
@@ -1422,6 +1433,12 @@ API_INTERFACE void FORGE_CALLCONV removePipelineCache(Renderer* pRenderer, Pipel
 API_INTERFACE void FORGE_CALLCONV addDescriptorSet(Renderer* pRenderer, const DescriptorSetDesc* pDesc, DescriptorSet** pDescriptorSet);
 API_INTERFACE void FORGE_CALLCONV removeDescriptorSet(Renderer* pRenderer, DescriptorSet* pDescriptorSet);
 API_INTERFACE void FORGE_CALLCONV updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDescriptorSet, uint32_t count, const DescriptorData* pParams);
+/// Same as calling updateDescriptorSet for every desc, but backends which support it write all the changed sets with a single driver call.
+/// Use it to update the sets of a frame together instead of one at a time
+API_INTERFACE void FORGE_CALLCONV updateDescriptorSets(Renderer* pRenderer, uint32_t count, const DescriptorSetUpdateDesc* pDescs);
+/// Resolves a descriptor name to its index in the root signature, or (uint32_t)-1 if there is none.
+/// Resolve names once at load time and pass the index as DescriptorData::mIndex or to cmdBindPushConstantsByIndex to skip the name lookup
+API_INTERFACE uint32_t FORGE_CALLCONV getDescriptorIndexFromName(const RootSignature* pRootSignature, const char* pName);
 
 // command buffer functions
 API_INTERFACE void FORGE_CALLCONV resetCmdPool(Renderer* pRenderer, CmdPool* pCmdPool);
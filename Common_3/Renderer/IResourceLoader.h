@@ -84,6 +84,32 @@ typedef struct TextureLoadDesc
 	TextureContainerType mContainer;
 } TextureLoadDesc;
 
+/// Small cluster of triangles with bounds for culling, generated offline by the AssetPipeline
+typedef struct Meshlet
+{
+	/// Bounding sphere in object space
+	float                       mCenter[3];
+	float                       mRadius;
+	/// Normal cone. The meshlet faces away from a camera at position p when dot(normalize(mConeApex - p), mConeAxis) >= mConeCutoff
+	float                       mConeApex[3];
+	float                       mConeCutoff;
+	float                       mConeAxis[3];
+	/// First index of the meshlet triangles in the index buffer of the geometry
+	uint32_t                    mStartIndex;
+	uint32_t                    mTriangleCount;
+	uint32_t                    mVertexCount;
+	/// Index of the draw argument the meshlet belongs to
+	uint32_t                    mDrawIndex;
+	uint32_t                    mPad;
+} Meshlet;
+static_assert(sizeof(Meshlet) == 64, "Meshlet is stored as is in geometry files");
+
+typedef struct MeshletRange
+{
+	uint32_t                    mStartMeshlet;
+	uint32_t                    mMeshletCount;
+} MeshletRange;
+
 typedef struct Geometry
 {
 	struct Hair
@@ -112,6 +138,10 @@ typedef struct Geometry
 	mat4*                       pInverseBindPoses;
 	/// The array of data to remap skin batch local joint ids to global joint ids
 	uint32_t*                   pJointRemaps;
+	/// The array of meshlets, sorted by draw argument. Only geometry loaded from a container written by the AssetPipeline has them
+	Meshlet*                    pMeshlets;
+	/// The meshlets of each draw argument, indexing pMeshlets. Only set when the geometry has meshlets
+	MeshletRange*               pDrawMeshlets;
 	/// Hair data
 	Hair                        mHair;
 
@@ -127,11 +157,11 @@ typedef struct Geometry
 	uint32_t                    mIndexCount;
 	/// Number of vertices in the geometry
 	uint32_t                    mVertexCount;
+	/// Number of meshlets in the geometry
+	uint32_t                    mMeshletCount;
 
+#if !defined(_WINDOWS) || defined(_WIN64)
 	uint32_t                    mPadA;
-	uint32_t                    mPadB;
-#if defined(_WINDOWS) && !defined(_WIN64)
-	uint32_t                    mPadC;
 #endif
 } Geometry;
 static_assert(sizeof(Geometry) % 16 == 0, "GLTFContainer size must be a multiple of 16");
@@ -149,7 +179,7 @@ typedef struct GeometryLoadDesc
 {
 	/// Output geometry
 	Geometry**        ppGeometry;
-	/// Filename of geometry container
+	/// Filename of geometry container (gltf, glb or geom written by the AssetPipeline)
 	const char*       pFileName;
 	/// Loading flags
 	GeometryLoadFlags mFlags;
@@ -196,6 +226,13 @@ typedef struct TextureUpdateDesc
 	Texture*              pTexture;
 	uint32_t              mMipLevel;
 	uint32_t              mArrayLayer;
+	/// Optional region of the mip to update, in pixels. Only supported for 2D textures with uncompressed formats.
+	/// Leave mRegionWidth or mRegionHeight at zero to update the whole mip.
+	/// When set, pMappedData, mRowCount and the strides below describe the region instead of the whole mip
+	uint32_t              mRegionX;
+	uint32_t              mRegionY;
+	uint32_t              mRegionWidth;
+	uint32_t              mRegionHeight;
 
 	/// To be filled by the caller
 	/// Example:
@@ -273,6 +310,11 @@ typedef struct ResourceLoaderDesc
 {
 	uint64_t mBufferSize;
 	uint32_t mBufferCount;
+	// Threads decoding the compressed streams of geometry containers in parallel. 0 decodes them on the streaming thread
+	uint32_t mDecodeThreadCount;
+	// Threads reading, parsing and transcoding textures and geometry ahead of the streaming thread, which only records their copies.
+	// 0 loads them on the streaming thread
+	uint32_t mLoadThreadCount;
 } ResourceLoaderDesc;
 
 extern ResourceLoaderDesc gDefaultResourceLoaderDesc;
@@ -327,6 +369,9 @@ void waitForToken(const SyncToken* token);
 /// Either loads the cached shader bytecode or compiles the shader to create new bytecode depending on whether source is newer than binary
 void addShader(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** pShader);
 
+/// Adds shaderCount independent shaders, loading, compiling and creating them in parallel on threads started for this call
+void addShaders(Renderer* pRenderer, uint32_t shaderCount, const ShaderLoadDesc* pDescs, Shader** ppShaders);
+
 /// Save/Load pipeline cache from disk
 void addPipelineCache(Renderer* pRenderer, const PipelineCacheLoadDesc* pDesc, PipelineCache** ppPipelineCache);
 void savePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache, PipelineCacheSaveDesc* pDesc);
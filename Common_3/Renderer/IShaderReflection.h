@@ -173,5 +173,13 @@ void destroyShaderReflection(ShaderReflection* pReflection);
 void createPipelineReflection(ShaderReflection* pReflection, uint32_t stageCount, PipelineReflection* pOutReflection);
 void destroyPipelineReflection(PipelineReflection* pReflection);
 
-//void serializeReflection(File* pInFile, Reflection* pReflection);
-//void deserializeReflection(File* pOutFile, Reflection* pReflection);
+// Writes the reflection of one stage to a compact blob allocated with tf_malloc
+void serializeShaderReflection(const ShaderReflection* pReflection, void** ppBlob, uint32_t* pBlobSize);
+// Creates a reflection from a blob written by serializeShaderReflection, it must be destroyed with destroyShaderReflection
+bool deserializeShaderReflection(const void* pBlob, uint32_t blobSize, ShaderReflection* pOutReflection);
+
+// Persistent cache of stage reflections keyed by the hash of the byte code, so reflecting a shader only happens once
+void initShaderReflectionCache();
+void exitShaderReflectionCache();
+bool loadCachedShaderReflection(const void* pByteCode, uint32_t byteCodeSize, ShaderStage stage, ShaderReflection* pOutReflection);
+void addCachedShaderReflection(const void* pByteCode, uint32_t byteCodeSize, const ShaderReflection* pReflection);
@@ -296,6 +296,15 @@ const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const
 		return NULL;
 	}
 }
+
+uint32_t getDescriptorIndexFromName(const RootSignature* pRootSignature, const char* pName)
+{
+	ASSERT(pRootSignature);
+	ASSERT(pName);
+
+	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, pName);
+	return pDesc ? (uint32_t)(pDesc - pRootSignature->pDescriptors) : (uint32_t)-1;
+}
 /************************************************************************/
 // Misc
 /************************************************************************/
@@ -653,7 +662,16 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 		
 		if (paramIndex != (uint32_t)-1)
 		{
+			// Indices from getDescriptorIndexFromName are only valid for the root signature they were resolved on
+			ASSERT(paramIndex < pRootSignature->mDescriptorCount);
 			pDesc = &pRootSignature->pDescriptors[paramIndex];
+#if defined(ENABLE_GRAPHICS_DEBUG)
+			if (pParam->pName && strcmp(pParam->pName, pDesc->pName))
+			{
+				LOGF(LogLevel::eERROR, "Descriptor param index (%u) refers to (%s) instead of (%s) in this root signature", paramIndex, pDesc->pName, pParam->pName);
+				ASSERT(false);
+			}
+#endif
 		}
 		else
 		{
@@ -838,6 +856,15 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 		}
 	}
 }
+
+void updateDescriptorSets(Renderer* pRenderer, uint32_t count, const DescriptorSetUpdateDesc* pDescs)
+{
+	ASSERT(pDescs || !count);
+
+	// Argument buffers are encoded directly so there is no driver call to batch
+	for (uint32_t i = 0; i < count; ++i)
+		updateDescriptorSet(pRenderer, pDescs[i].mIndex, pDescs[i].pDescriptorSet, pDescs[i].mParamCount, pDescs[i].pParams);
+}
 /************************************************************************/
 // Logging
 /************************************************************************/
@@ -1920,6 +1947,8 @@ void initRenderer(const char* appName, const RendererDesc* settings, Renderer**
 void removeRenderer(Renderer* pRenderer)
 {
 	ASSERT(pRenderer);
+
+	exitGPUConfig();
 	
 	remove_default_resources(pRenderer);
 
@@ -4275,6 +4304,10 @@ typedef struct SubresourceDataDesc
 	uint32_t mArrayLayer;
 	uint32_t mRowPitch;
 	uint32_t mSlicePitch;
+	uint32_t mRegionX;
+	uint32_t mRegionY;
+	uint32_t mRegionWidth;
+	uint32_t mRegionHeight;
 } SubresourceDataDesc;
 
 void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pIntermediate, const SubresourceDataDesc* pSubresourceDesc)
@@ -4297,6 +4330,13 @@ void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pIntermediate, c
 	}
 #endif
 	
+	MTLOrigin destinationOrigin = MTLOriginMake(0, 0, 0);
+	if (pSubresourceDesc->mRegionWidth && pSubresourceDesc->mRegionHeight)
+	{
+		sourceSize = MTLSizeMake(pSubresourceDesc->mRegionWidth, pSubresourceDesc->mRegionHeight, 1);
+		destinationOrigin = MTLOriginMake(pSubresourceDesc->mRegionX, pSubresourceDesc->mRegionY, 0);
+	}
+
 	if (!pCmd->mtlBlitEncoder)
 	{
 		util_end_current_encoders(pCmd, false);
@@ -4312,7 +4352,7 @@ void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pIntermediate, c
 							   toTexture:pTexture->mtlTexture
 						destinationSlice:pSubresourceDesc->mArrayLayer
 						destinationLevel:pSubresourceDesc->mMipLevel
-					   destinationOrigin:MTLOriginMake(0, 0, 0)
+					   destinationOrigin:destinationOrigin
 								 options:MTLBlitOptionNone];
 }
 
@@ -0,0 +1,1172 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#ifdef NULL_RENDERER
+
+// Null renderer backend
+// Buffers and textures live in system memory, commands are executed (copies) or dropped (draws, dispatches)
+// at record time and every submission completes immediately. Together with the headless runner this lets the
+// CPU side of a sample run on machines without a GPU, so loader, animation and culling work can be profiled
+// deterministically.
+
+#define RENDERER_IMPLEMENTATION
+
+#include <string.h>
+
+#include "../Renderer.h"
+
+#include "../../ThirdParty/OpenSource/tinyimageformat/tinyimageformat_base.h"
+#include "../../ThirdParty/OpenSource/tinyimageformat/tinyimageformat_query.h"
+
+#include "../../OS/Interfaces/ILog.h"
+#include "../../OS/Core/Atomics.h"
+
+#include "../../OS/Interfaces/IMemory.h"
+
+#define SAFE_FREE(p_var)         \
+	if (p_var)                   \
+	{                            \
+		tf_free((void*)p_var); \
+	}
+
+// Alignment of system memory backing buffers and textures. Matches the cache line size so CPU access patterns
+// resemble those on mapped GPU memory
+#define NULL_RESOURCE_ALIGNMENT 64
+
+// Internal utility functions (may become external one day)
+typedef struct SubresourceDataDesc
+{
+	uint64_t mSrcOffset;
+	uint32_t mMipLevel;
+	uint32_t mArrayLayer;
+	uint32_t mRowPitch;
+	uint32_t mSlicePitch;
+	uint32_t mRegionX;
+	uint32_t mRegionY;
+	uint32_t mRegionWidth;
+	uint32_t mRegionHeight;
+} SubresourceDataDesc;
+
+// clang-format off
+void addBuffer(Renderer* pRenderer, const BufferDesc* pDesc, Buffer** ppBuffer);
+void removeBuffer(Renderer* pRenderer, Buffer* pBuffer);
+void addTexture(Renderer* pRenderer, const TextureDesc* pDesc, Texture** ppTexture);
+void removeTexture(Renderer* pRenderer, Texture* pTexture);
+// clang-format on
+
+static tfrg_atomic64_t gNullAllocatedBytes = 0;
+/************************************************************************/
+// Memory Utils
+/************************************************************************/
+static void* null_alloc_resource_memory(uint64_t size)
+{
+	void* pMemory = tf_memalign(NULL_RESOURCE_ALIGNMENT, (size_t)size);
+	ASSERT(pMemory);
+	memset(pMemory, 0, (size_t)size);
+	tfrg_atomic64_add_relaxed(&gNullAllocatedBytes, (int64_t)size);
+	return pMemory;
+}
+
+static void null_free_resource_memory(void* pMemory, uint64_t size)
+{
+	if (!pMemory)
+		return;
+
+	tfrg_atomic64_add_relaxed(&gNullAllocatedBytes, -(int64_t)size);
+	tf_free(pMemory);
+}
+
+static inline uint32_t null_mip_extent(uint32_t extent, uint32_t mip) { return max(1u, extent >> mip); }
+
+// Size of one tightly packed mip slice of one array layer
+static uint64_t null_get_subresource_size(TinyImageFormat fmt, uint32_t width, uint32_t height, uint32_t depth)
+{
+	const uint32_t blockWidth = TinyImageFormat_WidthOfBlock(fmt);
+	const uint32_t blockHeight = TinyImageFormat_HeightOfBlock(fmt);
+	const uint32_t blockBytes = TinyImageFormat_BitSizeOfBlock(fmt) >> 3;
+
+	const uint64_t rowBytes = (uint64_t)((width + blockWidth - 1) / blockWidth) * blockBytes;
+	const uint64_t numRows = (height + blockHeight - 1) / blockHeight;
+	return rowBytes * numRows * depth;
+}
+
+// Subresources are stored layer by layer, mip by mip inside each layer
+static uint64_t null_get_subresource_offset(const Texture* pTexture, uint32_t mipLevel, uint32_t arrayLayer)
+{
+	const TinyImageFormat fmt = (TinyImageFormat)pTexture->mFormat;
+	uint64_t layerSize = 0;
+	uint64_t mipOffset = 0;
+	for (uint32_t mip = 0; mip < pTexture->mMipLevels; ++mip)
+	{
+		const uint64_t mipSize = null_get_subresource_size(fmt,
+			null_mip_extent(pTexture->mWidth, mip),
+			null_mip_extent(pTexture->mHeight, mip),
+			null_mip_extent(pTexture->mDepth, mip));
+		if (mip == mipLevel)
+			mipOffset = layerSize;
+		layerSize += mipSize;
+	}
+
+	return layerSize * arrayLayer + mipOffset;
+}
+/************************************************************************/
+// Renderer Init Remove
+/************************************************************************/
+void initRenderer(const char* appName, const RendererDesc* pDesc, Renderer** ppRenderer)
+{
+	ASSERT(appName);
+	ASSERT(pDesc);
+	ASSERT(ppRenderer);
+
+	Renderer* pRenderer = (Renderer*)tf_calloc_memalign(1, alignof(Renderer), sizeof(Renderer));
+	ASSERT(pRenderer);
+
+	pRenderer->mGpuMode = GPU_MODE_SINGLE;
+	pRenderer->mLinkedNodeCount = 1;
+	// Shaders are never compiled so every target is accepted
+	pRenderer->mShaderTarget = shader_target_6_3;
+	pRenderer->mEnableGpuBasedValidation = false;
+	pRenderer->mApi = RENDERER_API_NULL;
+
+	pRenderer->pName = (char*)tf_calloc(strlen(appName) + 1, sizeof(char));
+	strcpy(pRenderer->pName, appName);
+
+	// Report a capable device so samples take their regular code paths
+	pRenderer->pActiveGpuSettings = (GPUSettings*)tf_calloc(1, sizeof(GPUSettings));
+	GPUSettings* pSettings = pRenderer->pActiveGpuSettings;
+	pSettings->mUniformBufferAlignment = 256;
+	pSettings->mUploadBufferTextureAlignment = 16;
+	pSettings->mUploadBufferTextureRowAlignment = 1;
+	pSettings->mMaxVertexInputBindings = MAX_VERTEX_BINDINGS;
+	pSettings->mMaxRootSignatureDWORDS = 64;
+	pSettings->mWaveLaneCount = 32;
+	pSettings->mWaveOpsSupportFlags = WAVE_OPS_SUPPORT_FLAG_ALL;
+	pSettings->mMultiDrawIndirect = 1;
+	pSettings->mROVsSupported = 1;
+	pSettings->mTessellationSupported = 1;
+	pSettings->mGeometryShaderSupported = 1;
+	pSettings->mGpuVendorPreset.mPresetLevel = GPU_PRESET_ULTRA;
+	strncpy(pSettings->mGpuVendorPreset.mVendorId, "0x0000", MAX_GPU_VENDOR_STRING_LENGTH);
+	strncpy(pSettings->mGpuVendorPreset.mModelId, "0x0000", MAX_GPU_VENDOR_STRING_LENGTH);
+	strncpy(pSettings->mGpuVendorPreset.mRevisionId, "0x00", MAX_GPU_VENDOR_STRING_LENGTH);
+	strncpy(pSettings->mGpuVendorPreset.mGpuName, "Null Device", MAX_GPU_VENDOR_STRING_LENGTH);
+
+	pRenderer->pCapBits = (GPUCapBits*)tf_calloc(1, sizeof(GPUCapBits));
+	for (uint32_t i = 0; i < TinyImageFormat_Count; ++i)
+	{
+		pRenderer->pCapBits->canShaderReadFrom[i] = true;
+		pRenderer->pCapBits->canShaderWriteTo[i] = true;
+		pRenderer->pCapBits->canRenderTargetWriteTo[i] = true;
+	}
+
+	pRenderer->mBuiltinShaderDefinesCount = 0;
+	pRenderer->pBuiltinShaderDefines = NULL;
+
+	LOGF(LogLevel::eINFO, "Null renderer initialized. No GPU work will be executed");
+
+	// Renderer is good!
+	*ppRenderer = pRenderer;
+}
+
+void removeRenderer(Renderer* pRenderer)
+{
+	ASSERT(pRenderer);
+
+	if (tfrg_atomic64_load_relaxed(&gNullAllocatedBytes) != 0)
+	{
+		LOGF(LogLevel::eWARNING, "Null renderer removed with %llu bytes of resource memory still allocated",
+			(unsigned long long)tfrg_atomic64_load_relaxed(&gNullAllocatedBytes));
+	}
+
+	SAFE_FREE(pRenderer->pCapBits);
+	SAFE_FREE(pRenderer->pActiveGpuSettings);
+	SAFE_FREE(pRenderer->pName);
+	SAFE_FREE(pRenderer);
+}
+/************************************************************************/
+// Resource Creation Functions
+/************************************************************************/
+void addFence(Renderer* pRenderer, Fence** ppFence)
+{
+	ASSERT(pRenderer);
+	ASSERT(ppFence);
+
+	Fence* pFence = (Fence*)tf_calloc(1, sizeof(Fence));
+	ASSERT(pFence);
+	pFence->mSubmitted = false;
+
+	*ppFence = pFence;
+}
+
+void removeFence(Renderer* pRenderer, Fence* pFence)
+{
+	ASSERT(pRenderer);
+	ASSERT(pFence);
+
+	SAFE_FREE(pFence);
+}
+
+void addSemaphore(Renderer* pRenderer, Semaphore** ppSemaphore)
+{
+	ASSERT(pRenderer);
+	ASSERT(ppSemaphore);
+
+	Semaphore* pSemaphore = (Semaphore*)tf_calloc(1, sizeof(Semaphore));
+	ASSERT(pSemaphore);
+	pSemaphore->mSignaled = false;
+
+	*ppSemaphore = pSemaphore;
+}
+
+void removeSemaphore(Renderer* pRenderer, Semaphore* pSemaphore)
+{
+	ASSERT(pRenderer);
+	ASSERT(pSemaphore);
+
+	SAFE_FREE(pSemaphore);
+}
+
+void addQueue(Renderer* pRenderer, QueueDesc* pDesc, Queue** ppQueue)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppQueue);
+
+	Queue* pQueue = (Queue*)tf_calloc(1, sizeof(Queue));
+	ASSERT(pQueue);
+
+	pQueue->mType = pDesc->mType;
+	pQueue->mNodeIndex = pDesc->mNodeIndex;
+	pQueue->mFlags = pDesc->mFlag;
+	pQueue->mSubmitCount = 0;
+
+	*ppQueue = pQueue;
+}
+
+void removeQueue(Renderer* pRenderer, Queue* pQueue)
+{
+	ASSERT(pRenderer);
+	ASSERT(pQueue);
+
+	SAFE_FREE(pQueue);
+}
+
+void addCmdPool(Renderer* pRenderer, const CmdPoolDesc* pDesc, CmdPool** ppCmdPool)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppCmdPool);
+
+	CmdPool* pCmdPool = (CmdPool*)tf_calloc(1, sizeof(CmdPool));
+	ASSERT(pCmdPool);
+
+	pCmdPool->pQueue = pDesc->pQueue;
+
+	*ppCmdPool = pCmdPool;
+}
+
+void removeCmdPool(Renderer* pRenderer, CmdPool* pCmdPool)
+{
+	ASSERT(pRenderer);
+	ASSERT(pCmdPool);
+
+	SAFE_FREE(pCmdPool);
+}
+
+void addCmd(Renderer* pRenderer, const CmdDesc* pDesc, Cmd** ppCmd)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppCmd);
+
+	Cmd* pCmd = (Cmd*)tf_calloc_memalign(1, alignof(Cmd), sizeof(Cmd));
+	ASSERT(pCmd);
+
+	pCmd->pRenderer = pRenderer;
+	pCmd->pQueue = pDesc->pPool->pQueue;
+	pCmd->pCmdPool = pDesc->pPool;
+	pCmd->mType = pDesc->pPool->pQueue->mType;
+	pCmd->mNodeIndex = pDesc->pPool->pQueue->mNodeIndex;
+
+	*ppCmd = pCmd;
+}
+
+void removeCmd(Renderer* pRenderer, Cmd* pCmd)
+{
+	ASSERT(pRenderer);
+	ASSERT(pCmd);
+
+	SAFE_FREE(pCmd);
+}
+
+void addCmd_n(Renderer* pRenderer, const CmdDesc* pDesc, uint32_t cmdCount, Cmd*** pppCmd)
+{
+	//verify that ***cmd is valid
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(cmdCount);
+	ASSERT(pppCmd);
+
+	Cmd** ppCmds = (Cmd**)tf_calloc(cmdCount, sizeof(Cmd*));
+	ASSERT(ppCmds);
+
+	//add n new cmds to given pool
+	for (uint32_t i = 0; i < cmdCount; ++i)
+	{
+		::addCmd(pRenderer, pDesc, &ppCmds[i]);
+	}
+
+	*pppCmd = ppCmds;
+}
+
+void removeCmd_n(Renderer* pRenderer, uint32_t cmdCount, Cmd** ppCmds)
+{
+	//verify that given command list is valid
+	ASSERT(ppCmds);
+
+	//remove every given cmd in array
+	for (uint32_t i = 0; i < cmdCount; ++i)
+	{
+		removeCmd(pRenderer, ppCmds[i]);
+	}
+
+	SAFE_FREE(ppCmds);
+}
+
+void addSwapChain(Renderer* pRenderer, const SwapChainDesc* pDesc, SwapChain** ppSwapChain)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppSwapChain);
+	ASSERT(pDesc->mImageCount <= MAX_SWAPCHAIN_IMAGES);
+
+	const uint32_t imageCount = pDesc->mImageCount ? pDesc->mImageCount : 2;
+
+	SwapChain* pSwapChain = (SwapChain*)tf_calloc(1, sizeof(SwapChain) + imageCount * sizeof(RenderTarget*));
+	ASSERT(pSwapChain);
+	pSwapChain->ppRenderTargets = (RenderTarget**)(pSwapChain + 1);
+
+	RenderTargetDesc descColor = {};
+	descColor.mWidth = pDesc->mWidth;
+	descColor.mHeight = pDesc->mHeight;
+	descColor.mDepth = 1;
+	descColor.mArraySize = 1;
+	descColor.mFormat = pDesc->mColorFormat;
+	descColor.mClearValue = pDesc->mColorClearValue;
+	descColor.mSampleCount = SAMPLE_COUNT_1;
+	descColor.mSampleQuality = 0;
+	descColor.mStartState = RESOURCE_STATE_PRESENT;
+
+	for (uint32_t i = 0; i < imageCount; ++i)
+	{
+		addRenderTarget(pRenderer, &descColor, &pSwapChain->ppRenderTargets[i]);
+	}
+
+	pSwapChain->mImageCount = imageCount;
+	pSwapChain->mEnableVsync = pDesc->mEnableVsync;
+	pSwapChain->mIndex = imageCount - 1;
+
+	*ppSwapChain = pSwapChain;
+}
+
+void removeSwapChain(Renderer* pRenderer, SwapChain* pSwapChain)
+{
+	ASSERT(pRenderer);
+	ASSERT(pSwapChain);
+
+	for (uint32_t i = 0; i < pSwapChain->mImageCount; ++i)
+	{
+		removeRenderTarget(pRenderer, pSwapChain->ppRenderTargets[i]);
+	}
+
+	SAFE_FREE(pSwapChain);
+}
+
+void addBuffer(Renderer* pRenderer, const BufferDesc* pDesc, Buffer** ppBuffer)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(pDesc->mSize > 0);
+	ASSERT(ppBuffer);
+
+	Buffer* pBuffer = (Buffer*)tf_calloc_memalign(1, alignof(Buffer), sizeof(Buffer));
+	ASSERT(pBuffer);
+
+	uint64_t allocationSize = pDesc->mSize;
+	// Align the buffer size to multiples of the dynamic uniform buffer minimum size
+	if (pDesc->mDescriptors & DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+	{
+		uint64_t minAlignment = pRenderer->pActiveGpuSettings->mUniformBufferAlignment;
+		allocationSize = round_up_64(allocationSize, minAlignment);
+	}
+
+	pBuffer->pNullMemory = null_alloc_resource_memory(allocationSize);
+
+	// Same behavior as the GPU backends - only CPU visible memory can be persistently mapped
+	if ((pDesc->mFlags & BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT) && pDesc->mMemoryUsage != RESOURCE_MEMORY_USAGE_GPU_ONLY)
+	{
+		pBuffer->pCpuMappedAddress = pBuffer->pNullMemory;
+	}
+
+	pBuffer->mSize = (uint32_t)pDesc->mSize;
+	pBuffer->mMemoryUsage = pDesc->mMemoryUsage;
+	pBuffer->mNodeIndex = pDesc->mNodeIndex;
+	pBuffer->mDescriptors = pDesc->mDescriptors;
+
+	*ppBuffer = pBuffer;
+}
+
+void removeBuffer(Renderer* pRenderer, Buffer* pBuffer)
+{
+	ASSERT(pRenderer);
+	ASSERT(pBuffer);
+
+	uint64_t allocationSize = pBuffer->mSize;
+	if (pBuffer->mDescriptors & DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+	{
+		allocationSize = round_up_64(allocationSize, pRenderer->pActiveGpuSettings->mUniformBufferAlignment);
+	}
+
+	null_free_resource_memory(pBuffer->pNullMemory, allocationSize);
+	SAFE_FREE(pBuffer);
+}
+
+static void add_texture(Renderer* pRenderer, const TextureDesc* pDesc, Texture** ppTexture, bool allocateMemory)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc && pDesc->mWidth && pDesc->mHeight && (pDesc->mDepth || pDesc->mArraySize));
+	ASSERT(ppTexture);
+
+	Texture* pTexture = (Texture*)tf_calloc_memalign(1, alignof(Texture), sizeof(Texture));
+	ASSERT(pTexture);
+
+	pTexture->mNodeIndex = pDesc->mNodeIndex;
+	pTexture->mWidth = pDesc->mWidth;
+	pTexture->mHeight = pDesc->mHeight;
+	pTexture->mDepth = max(1U, pDesc->mDepth);
+	pTexture->mMipLevels = max(1U, pDesc->mMipLevels);
+	pTexture->mUav = pDesc->mDescriptors & DESCRIPTOR_TYPE_RW_TEXTURE;
+	pTexture->mArraySizeMinusOne = max(1U, pDesc->mArraySize) - 1;
+	pTexture->mFormat = pDesc->mFormat;
+	pTexture->mOwnsImage = !pDesc->pNativeHandle;
+
+	// Render targets are never read back on the CPU so they do not need backing memory
+	if (allocateMemory && pTexture->mOwnsImage)
+	{
+		pTexture->mNullMemorySize = null_get_subresource_offset(pTexture, 0, pTexture->mArraySizeMinusOne + 1);
+		pTexture->pNullMemory = null_alloc_resource_memory(pTexture->mNullMemorySize);
+	}
+
+	*ppTexture = pTexture;
+}
+
+void addTexture(Renderer* pRenderer, const TextureDesc* pDesc, Texture** ppTexture)
+{
+	add_texture(pRenderer, pDesc, ppTexture, true);
+}
+
+void addVirtualTexture(Cmd* pCmd, const TextureDesc* pDesc, Texture** ppTexture, void* pImageData)
+{
+	ASSERT(pCmd);
+	UNREF_PARAM(pImageData);
+
+	// Sparse residency is not emulated. The texture is created fully resident with no page table
+	LOGF(LogLevel::eWARNING, "Virtual textures are not supported by the null renderer. Creating a regular texture instead");
+	add_texture(pCmd->pRenderer, pDesc, ppTexture, true);
+}
+
+void removeTexture(Renderer* pRenderer, Texture* pTexture)
+{
+	ASSERT(pRenderer);
+	ASSERT(pTexture);
+
+	null_free_resource_memory(pTexture->pNullMemory, pTexture->mNullMemorySize);
+	SAFE_FREE(pTexture);
+}
+
+void addRenderTarget(Renderer* pRenderer, const RenderTargetDesc* pDesc, RenderTarget** ppRenderTarget)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppRenderTarget);
+
+	RenderTarget* pRenderTarget = (RenderTarget*)tf_calloc_memalign(1, alignof(RenderTarget), sizeof(RenderTarget));
+	ASSERT(pRenderTarget);
+
+	TextureDesc textureDesc = {};
+	textureDesc.mArraySize = pDesc->mArraySize;
+	textureDesc.mClearValue = pDesc->mClearValue;
+	textureDesc.mDepth = pDesc->mDepth;
+	textureDesc.mFlags = pDesc->mFlags;
+	textureDesc.mFormat = pDesc->mFormat;
+	textureDesc.mHeight = pDesc->mHeight;
+	textureDesc.mMipLevels = max(1U, pDesc->mMipLevels);
+	textureDesc.mSampleCount = pDesc->mSampleCount;
+	textureDesc.mSampleQuality = pDesc->mSampleQuality;
+	textureDesc.mWidth = pDesc->mWidth;
+	textureDesc.pNativeHandle = pDesc->pNativeHandle;
+	textureDesc.mNodeIndex = pDesc->mNodeIndex;
+	textureDesc.mStartState = pDesc->mStartState;
+	textureDesc.mDescriptors = pDesc->mDescriptors | DESCRIPTOR_TYPE_TEXTURE;
+	textureDesc.pName = pDesc->pName;
+
+	add_texture(pRenderer, &textureDesc, &pRenderTarget->pTexture, false);
+
+	pRenderTarget->mWidth = pDesc->mWidth;
+	pRenderTarget->mHeight = pDesc->mHeight;
+	pRenderTarget->mArraySize = pDesc->mArraySize;
+	pRenderTarget->mDepth = pDesc->mDepth;
+	pRenderTarget->mMipLevels = textureDesc.mMipLevels;
+	pRenderTarget->mSampleCount = pDesc->mSampleCount;
+	pRenderTarget->mSampleQuality = pDesc->mSampleQuality;
+	pRenderTarget->mFormat = pDesc->mFormat;
+	pRenderTarget->mClearValue = pDesc->mClearValue;
+	pRenderTarget->mDescriptors = pDesc->mDescriptors;
+
+	*ppRenderTarget = pRenderTarget;
+}
+
+void removeRenderTarget(Renderer* pRenderer, RenderTarget* pRenderTarget)
+{
+	ASSERT(pRenderer);
+	ASSERT(pRenderTarget);
+
+	::removeTexture(pRenderer, pRenderTarget->pTexture);
+	SAFE_FREE(pRenderTarget);
+}
+
+void addSampler(Renderer* pRenderer, const SamplerDesc* pDesc, Sampler** ppSampler)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppSampler);
+
+	Sampler* pSampler = (Sampler*)tf_calloc_memalign(1, alignof(Sampler), sizeof(Sampler));
+	ASSERT(pSampler);
+
+	*ppSampler = pSampler;
+}
+
+void removeSampler(Renderer* pRenderer, Sampler* pSampler)
+{
+	ASSERT(pRenderer);
+	ASSERT(pSampler);
+
+	SAFE_FREE(pSampler);
+}
+/************************************************************************/
+// Buffer Functions
+/************************************************************************/
+void mapBuffer(Renderer* pRenderer, Buffer* pBuffer, ReadRange* pRange)
+{
+	ASSERT(pBuffer->mMemoryUsage != RESOURCE_MEMORY_USAGE_GPU_ONLY && "Trying to map non-cpu accessible resource");
+
+	pBuffer->pCpuMappedAddress = pBuffer->pNullMemory;
+
+	if (pRange)
+	{
+		pBuffer->pCpuMappedAddress = ((uint8_t*)pBuffer->pCpuMappedAddress + pRange->mOffset);
+	}
+}
+
+void unmapBuffer(Renderer* pRenderer, Buffer* pBuffer)
+{
+	ASSERT(pBuffer->mMemoryUsage != RESOURCE_MEMORY_USAGE_GPU_ONLY && "Trying to unmap non-cpu accessible resource");
+
+	pBuffer->pCpuMappedAddress = NULL;
+}
+/************************************************************************/
+// Shader Functions
+/************************************************************************/
+void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader** ppShaderProgram)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppShaderProgram);
+
+	Shader* pShaderProgram = (Shader*)tf_calloc(1, sizeof(Shader));
+	ASSERT(pShaderProgram);
+
+	// No byte code and no reflection. Root signatures created from these shaders have no descriptors
+	pShaderProgram->mStages = pDesc->mStages;
+	pShaderProgram->pReflection = NULL;
+
+	*ppShaderProgram = pShaderProgram;
+}
+
+void removeShader(Renderer* pRenderer, Shader* pShaderProgram)
+{
+	ASSERT(pRenderer);
+	ASSERT(pShaderProgram);
+
+	SAFE_FREE(pShaderProgram);
+}
+/************************************************************************/
+// Root Signature Functions
+/************************************************************************/
+void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatureDesc, RootSignature** ppRootSignature)
+{
+	ASSERT(pRenderer);
+	ASSERT(pRootSignatureDesc);
+	ASSERT(ppRootSignature);
+
+	RootSignature* pRootSignature = (RootSignature*)tf_calloc_memalign(1, alignof(RootSignature), sizeof(RootSignature));
+	ASSERT(pRootSignature);
+
+	pRootSignature->mPipelineType = PIPELINE_TYPE_GRAPHICS;
+	for (uint32_t sh = 0; sh < pRootSignatureDesc->mShaderCount; ++sh)
+	{
+		if (pRootSignatureDesc->ppShaders[sh]->mStages & SHADER_STAGE_COMP)
+			pRootSignature->mPipelineType = PIPELINE_TYPE_COMPUTE;
+	}
+
+	pRootSignature->mDescriptorCount = 0;
+	pRootSignature->pDescriptors = NULL;
+	pRootSignature->pDescriptorNameToIndexMap = NULL;
+
+	*ppRootSignature = pRootSignature;
+}
+
+void removeRootSignature(Renderer* pRenderer, RootSignature* pRootSignature)
+{
+	ASSERT(pRenderer);
+	ASSERT(pRootSignature);
+
+	SAFE_FREE(pRootSignature);
+}
+/************************************************************************/
+// Pipeline State Functions
+/************************************************************************/
+void addPipeline(Renderer* pRenderer, const PipelineDesc* pDesc, Pipeline** ppPipeline)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppPipeline);
+
+	Pipeline* pPipeline = (Pipeline*)tf_calloc_memalign(1, alignof(Pipeline), sizeof(Pipeline));
+	ASSERT(pPipeline);
+
+	pPipeline->mType = pDesc->mType;
+
+	*ppPipeline = pPipeline;
+}
+
+void removePipeline(Renderer* pRenderer, Pipeline* pPipeline)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipeline);
+
+	SAFE_FREE(pPipeline);
+}
+
+void addPipelineCache(Renderer* pRenderer, const PipelineCacheDesc* pDesc, PipelineCache** ppPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppPipelineCache);
+
+	PipelineCache* pPipelineCache = (PipelineCache*)tf_calloc(1, sizeof(PipelineCache));
+	ASSERT(pPipelineCache);
+
+	*ppPipelineCache = pPipelineCache;
+}
+
+void getPipelineCacheData(Renderer* pRenderer, PipelineCache* pPipelineCache, size_t* pSize, void* pData)
+{
+	ASSERT(pSize);
+	UNREF_PARAM(pData);
+
+	*pSize = 0;
+}
+
+void removePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipelineCache);
+
+	SAFE_FREE(pPipelineCache);
+}
+/************************************************************************/
+// Descriptor Set Functions
+/************************************************************************/
+void addDescriptorSet(Renderer* pRenderer, const DescriptorSetDesc* pDesc, DescriptorSet** ppDescriptorSet)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppDescriptorSet);
+
+	DescriptorSet* pDescriptorSet = (DescriptorSet*)tf_calloc_memalign(1, alignof(DescriptorSet), sizeof(DescriptorSet));
+	ASSERT(pDescriptorSet);
+
+	pDescriptorSet->pRootSignature = pDesc->pRootSignature;
+	pDescriptorSet->mMaxSets = pDesc->mMaxSets;
+	pDescriptorSet->mUpdateFrequency = (uint8_t)pDesc->mUpdateFrequency;
+	pDescriptorSet->mNodeIndex = (uint8_t)pDesc->mNodeIndex;
+
+	*ppDescriptorSet = pDescriptorSet;
+}
+
+void removeDescriptorSet(Renderer* pRenderer, DescriptorSet* pDescriptorSet)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDescriptorSet);
+
+	SAFE_FREE(pDescriptorSet);
+}
+
+void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDescriptorSet, uint32_t count, const DescriptorData* pParams)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDescriptorSet);
+	ASSERT(index < pDescriptorSet->mMaxSets);
+	ASSERT(!count || pParams);
+}
+
+void updateDescriptorSets(Renderer* pRenderer, uint32_t count, const DescriptorSetUpdateDesc* pDescs)
+{
+	ASSERT(pDescs || !count);
+
+	for (uint32_t i = 0; i < count; ++i)
+		updateDescriptorSet(pRenderer, pDescs[i].mIndex, pDescs[i].pDescriptorSet, pDescs[i].mParamCount, pDescs[i].pParams);
+}
+/************************************************************************/
+// Command buffer Functions
+/************************************************************************/
+void resetCmdPool(Renderer* pRenderer, CmdPool* pCmdPool)
+{
+	ASSERT(pRenderer);
+	ASSERT(pCmdPool);
+}
+
+void beginCmd(Cmd* pCmd)
+{
+	ASSERT(pCmd);
+
+	pCmd->mRecording = true;
+	pCmd->pBoundPipeline = NULL;
+	pCmd->mDrawCount = 0;
+	pCmd->mDispatchCount = 0;
+}
+
+void endCmd(Cmd* pCmd)
+{
+	ASSERT(pCmd);
+	ASSERT(pCmd->mRecording);
+
+	pCmd->mRecording = false;
+}
+
+void cmdBindRenderTargets(
+	Cmd* pCmd, uint32_t renderTargetCount, RenderTarget** ppRenderTargets, RenderTarget* pDepthStencil,
+	const LoadActionsDesc* pLoadActions /* = NULL*/, uint32_t* pColorArraySlices, uint32_t* pColorMipSlices, uint32_t depthArraySlice,
+	uint32_t depthMipSlice)
+{
+	ASSERT(pCmd);
+	ASSERT(!renderTargetCount || ppRenderTargets);
+}
+
+void cmdSetViewport(Cmd* pCmd, float x, float y, float width, float height, float minDepth, float maxDepth) { ASSERT(pCmd); }
+
+void cmdSetScissor(Cmd* pCmd, uint32_t x, uint32_t y, uint32_t width, uint32_t height) { ASSERT(pCmd); }
+
+void cmdBindPipeline(Cmd* pCmd, Pipeline* pPipeline)
+{
+	ASSERT(pCmd);
+	ASSERT(pPipeline);
+
+	pCmd->pBoundPipeline = pPipeline;
+}
+
+void cmdBindDescriptorSet(Cmd* pCmd, uint32_t index, DescriptorSet* pDescriptorSet)
+{
+	ASSERT(pCmd);
+	ASSERT(pDescriptorSet);
+	ASSERT(index < pDescriptorSet->mMaxSets);
+}
+
+uint32_t getDescriptorIndexFromName(const RootSignature* pRootSignature, const char* pName)
+{
+	ASSERT(pRootSignature);
+	ASSERT(pName);
+	return (uint32_t)-1;
+}
+
+void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, const char* pName, const void* pConstants)
+{
+	ASSERT(pCmd);
+	ASSERT(pConstants);
+	ASSERT(pRootSignature);
+	ASSERT(pName);
+}
+
+void cmdBindPushConstantsByIndex(Cmd* pCmd, RootSignature* pRootSignature, uint32_t paramIndex, const void* pConstants)
+{
+	ASSERT(pCmd);
+	ASSERT(pConstants);
+	ASSERT(pRootSignature);
+}
+
+void cmdBindIndexBuffer(Cmd* pCmd, Buffer* pBuffer, uint32_t indexType, uint64_t offset)
+{
+	ASSERT(pCmd);
+	ASSERT(pBuffer);
+	ASSERT(offset <= pBuffer->mSize);
+}
+
+void cmdBindVertexBuffer(Cmd* pCmd, uint32_t bufferCount, Buffer** ppBuffers, const uint32_t* pStrides, const uint64_t* pOffsets)
+{
+	ASSERT(pCmd);
+	ASSERT(0 != bufferCount);
+	ASSERT(ppBuffers);
+}
+
+void cmdDraw(Cmd* pCmd, uint32_t vertexCount, uint32_t firstVertex)
+{
+	ASSERT(pCmd);
+	++pCmd->mDrawCount;
+}
+
+void cmdDrawInstanced(Cmd* pCmd, uint32_t vertexCount, uint32_t firstVertex, uint32_t instanceCount, uint32_t firstInstance)
+{
+	ASSERT(pCmd);
+	++pCmd->mDrawCount;
+}
+
+void cmdDrawIndexed(Cmd* pCmd, uint32_t indexCount, uint32_t firstIndex, uint32_t firstVertex)
+{
+	ASSERT(pCmd);
+	++pCmd->mDrawCount;
+}
+
+void cmdDrawIndexedInstanced(
+	Cmd* pCmd, uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+	ASSERT(pCmd);
+	++pCmd->mDrawCount;
+}
+
+void cmdDispatch(Cmd* pCmd, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+	ASSERT(pCmd);
+	++pCmd->mDispatchCount;
+}
+
+void cmdResourceBarrier(Cmd* pCmd,
+	uint32_t numBufferBarriers, BufferBarrier* pBufferBarriers,
+	uint32_t numTextureBarriers, TextureBarrier* pTextureBarriers,
+	uint32_t numRtBarriers, RenderTargetBarrier* pRtBarriers)
+{
+	ASSERT(pCmd);
+}
+
+void cmdUpdateVirtualTexture(Cmd* pCmd, Texture* pTexture)
+{
+	ASSERT(pCmd);
+	ASSERT(pTexture);
+}
+
+// Copies execute at record time. The resource loader fills staging memory before recording the copy,
+// so the data is final by the time we get here
+void cmdUpdateBuffer(Cmd* pCmd, Buffer* pBuffer, uint64_t dstOffset, Buffer* pSrcBuffer, uint64_t srcOffset, uint64_t size)
+{
+	ASSERT(pCmd);
+	ASSERT(pSrcBuffer);
+	ASSERT(pSrcBuffer->pNullMemory);
+	ASSERT(pBuffer);
+	ASSERT(pBuffer->pNullMemory);
+	ASSERT(srcOffset + size <= pSrcBuffer->mSize);
+	ASSERT(dstOffset + size <= pBuffer->mSize);
+
+	memcpy((uint8_t*)pBuffer->pNullMemory + dstOffset, (const uint8_t*)pSrcBuffer->pNullMemory + srcOffset, (size_t)size);
+}
+
+void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pSrcBuffer, const SubresourceDataDesc* pSubresourceDesc)
+{
+	ASSERT(pCmd);
+	ASSERT(pTexture);
+	ASSERT(pSrcBuffer && pSrcBuffer->pNullMemory);
+
+	if (!pTexture->pNullMemory)
+		return;
+
+	const uint32_t        mip = pSubresourceDesc->mMipLevel;
+	const uint32_t        width = null_mip_extent(pTexture->mWidth, mip);
+	const uint32_t        height = null_mip_extent(pTexture->mHeight, mip);
+	const uint32_t        depth = null_mip_extent(pTexture->mDepth, mip);
+	const TinyImageFormat fmt = (TinyImageFormat)pTexture->mFormat;
+	const uint32_t        blockHeight = TinyImageFormat_HeightOfBlock(fmt);
+	const uint32_t        blockWidth = TinyImageFormat_WidthOfBlock(fmt);
+	const uint32_t        dstRowSize = ((width + blockWidth - 1) / blockWidth) * (TinyImageFormat_BitSizeOfBlock(fmt) >> 3);
+	const uint32_t        numRows = (height + blockHeight - 1) / blockHeight;
+	const uint64_t        dstSliceSize = (uint64_t)dstRowSize * numRows;
+
+	ASSERT(pSubresourceDesc->mRowPitch >= dstRowSize);
+
+	uint8_t*       pDst = (uint8_t*)pTexture->pNullMemory + null_get_subresource_offset(pTexture, mip, pSubresourceDesc->mArrayLayer);
+	const uint8_t* pSrc = (const uint8_t*)pSrcBuffer->pNullMemory + pSubresourceDesc->mSrcOffset;
+
+	for (uint32_t z = 0; z < depth; ++z)
+	{
+		for (uint32_t r = 0; r < numRows; ++r)
+		{
+			memcpy(pDst + z * dstSliceSize + r * dstRowSize,
+				pSrc + (uint64_t)z * pSubresourceDesc->mSlicePitch + (uint64_t)r * pSubresourceDesc->mRowPitch, dstRowSize);
+		}
+	}
+}
+/************************************************************************/
+// Queue Fence Semaphore Functions
+/************************************************************************/
+void acquireNextImage(Renderer* pRenderer, SwapChain* pSwapChain, Semaphore* pSignalSemaphore, Fence* pFence, uint32_t* pImageIndex)
+{
+	ASSERT(pRenderer);
+	ASSERT(pSwapChain);
+	ASSERT(pImageIndex);
+
+	pSwapChain->mIndex = (pSwapChain->mIndex + 1) % pSwapChain->mImageCount;
+	*pImageIndex = pSwapChain->mIndex;
+
+	if (pSignalSemaphore)
+		pSignalSemaphore->mSignaled = true;
+	if (pFence)
+		pFence->mSubmitted = true;
+}
+
+void queueSubmit(Queue* pQueue, const QueueSubmitDesc* pDesc)
+{
+	ASSERT(pQueue);
+	ASSERT(pDesc);
+	ASSERT(pDesc->mCmdCount > 0);
+	ASSERT(pDesc->ppCmds);
+
+	for (uint32_t i = 0; i < pDesc->mCmdCount; ++i)
+	{
+		ASSERT(!pDesc->ppCmds[i]->mRecording && "Submitting a command buffer that is still recording");
+	}
+
+	// All work was executed at record time. Consume waits and publish signals right away
+	for (uint32_t i = 0; i < pDesc->mWaitSemaphoreCount; ++i)
+		pDesc->ppWaitSemaphores[i]->mSignaled = false;
+
+	for (uint32_t i = 0; i < pDesc->mSignalSemaphoreCount; ++i)
+		pDesc->ppSignalSemaphores[i]->mSignaled = true;
+
+	if (pDesc->pSignalFence)
+		pDesc->pSignalFence->mSubmitted = true;
+
+	pQueue->mSubmitCount += pDesc->mCmdCount;
+}
+
+void queuePresent(Queue* pQueue, const QueuePresentDesc* pDesc)
+{
+	ASSERT(pQueue);
+	ASSERT(pDesc);
+
+	for (uint32_t i = 0; i < pDesc->mWaitSemaphoreCount; ++i)
+		pDesc->ppWaitSemaphores[i]->mSignaled = false;
+}
+
+void waitQueueIdle(Queue* pQueue) { ASSERT(pQueue); }
+
+void getFenceStatus(Renderer* pRenderer, Fence* pFence, FenceStatus* pFenceStatus)
+{
+	ASSERT(pFence);
+	ASSERT(pFenceStatus);
+
+	// Submissions complete immediately so a submitted fence is always signaled
+	*pFenceStatus = pFence->mSubmitted ? FENCE_STATUS_COMPLETE : FENCE_STATUS_NOTSUBMITTED;
+	pFence->mSubmitted = false;
+}
+
+void waitForFences(Renderer* pRenderer, uint32_t fenceCount, Fence** ppFences)
+{
+	ASSERT(ppFences || !fenceCount);
+
+	for (uint32_t i = 0; i < fenceCount; ++i)
+		ppFences[i]->mSubmitted = false;
+}
+
+void toggleVSync(Renderer* pRenderer, SwapChain** ppSwapChain)
+{
+	ASSERT(ppSwapChain && *ppSwapChain);
+
+	(*ppSwapChain)->mEnableVsync = !(*ppSwapChain)->mEnableVsync;
+}
+
+TinyImageFormat getRecommendedSwapchainFormat(bool hintHDR) { return TinyImageFormat_B8G8R8A8_UNORM; }
+/************************************************************************/
+// Indirect draw functions
+/************************************************************************/
+void addIndirectCommandSignature(Renderer* pRenderer, const CommandSignatureDesc* pDesc, CommandSignature** ppCommandSignature)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppCommandSignature);
+
+	CommandSignature* pCommandSignature = (CommandSignature*)tf_calloc(1, sizeof(CommandSignature));
+	ASSERT(pCommandSignature);
+
+	for (uint32_t i = 0; i < pDesc->mIndirectArgCount; ++i)    // counting for all types;
+	{
+		switch (pDesc->pArgDescs[i].mType)
+		{
+			case INDIRECT_DRAW:
+				pCommandSignature->mDrawType = INDIRECT_DRAW;
+				pCommandSignature->mStride += sizeof(IndirectDrawArguments);
+				break;
+			case INDIRECT_DRAW_INDEX:
+				pCommandSignature->mDrawType = INDIRECT_DRAW_INDEX;
+				pCommandSignature->mStride += sizeof(IndirectDrawIndexArguments);
+				break;
+			case INDIRECT_DISPATCH:
+				pCommandSignature->mDrawType = INDIRECT_DISPATCH;
+				pCommandSignature->mStride += sizeof(IndirectDispatchArguments);
+				break;
+			default: break;
+		}
+	}
+
+	if (!pDesc->mPacked)
+	{
+		pCommandSignature->mStride = round_up(pCommandSignature->mStride, 16);
+	}
+
+	*ppCommandSignature = pCommandSignature;
+}
+
+void removeIndirectCommandSignature(Renderer* pRenderer, CommandSignature* pCommandSignature)
+{
+	ASSERT(pCommandSignature);
+
+	SAFE_FREE(pCommandSignature);
+}
+
+void cmdExecuteIndirect(
+	Cmd* pCmd, CommandSignature* pCommandSignature, uint maxCommandCount, Buffer* pIndirectBuffer, uint64_t bufferOffset,
+	Buffer* pCounterBuffer, uint64_t counterBufferOffset)
+{
+	ASSERT(pCmd);
+	ASSERT(pCommandSignature);
+	ASSERT(pIndirectBuffer);
+
+	if (pCommandSignature->mDrawType == INDIRECT_DISPATCH)
+		++pCmd->mDispatchCount;
+	else
+		++pCmd->mDrawCount;
+}
+/************************************************************************/
+// Query Heap Implementation
+/************************************************************************/
+void getTimestampFrequency(Queue* pQueue, double* pFrequency)
+{
+	ASSERT(pQueue);
+	ASSERT(pFrequency);
+
+	// Nanosecond ticks, same unit the CPU profiler reports in
+	*pFrequency = 1e9;
+}
+
+void addQueryPool(Renderer* pRenderer, const QueryPoolDesc* pDesc, QueryPool** ppQueryPool)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppQueryPool);
+
+	QueryPool* pQueryPool = (QueryPool*)tf_calloc(1, sizeof(QueryPool));
+	ASSERT(pQueryPool);
+
+	pQueryPool->mType = pDesc->mType;
+	pQueryPool->mCount = pDesc->mQueryCount;
+
+	*ppQueryPool = pQueryPool;
+}
+
+void removeQueryPool(Renderer* pRenderer, QueryPool* pQueryPool)
+{
+	ASSERT(pRenderer);
+	ASSERT(pQueryPool);
+
+	SAFE_FREE(pQueryPool);
+}
+
+void cmdResetQueryPool(Cmd* pCmd, QueryPool* pQueryPool, uint32_t startQuery, uint32_t queryCount) { ASSERT(pCmd); }
+
+void cmdBeginQuery(Cmd* pCmd, QueryPool* pQueryPool, QueryDesc* pQuery) { ASSERT(pCmd); }
+
+void cmdEndQuery(Cmd* pCmd, QueryPool* pQueryPool, QueryDesc* pQuery) { ASSERT(pCmd); }
+
+void cmdResolveQuery(Cmd* pCmd, QueryPool* pQueryPool, Buffer* pReadbackBuffer, uint32_t startQuery, uint32_t queryCount)
+{
+	ASSERT(pCmd);
+	ASSERT(pReadbackBuffer);
+
+	// Report zero elapsed time for every query
+	if (pReadbackBuffer->pNullMemory)
+	{
+		const uint64_t size = min((uint64_t)queryCount * sizeof(uint64_t), (uint64_t)pReadbackBuffer->mSize);
+		memset(pReadbackBuffer->pNullMemory, 0, (size_t)size);
+	}
+}
+/************************************************************************/
+// Memory Stats Implementation
+/************************************************************************/
+void calculateMemoryStats(Renderer* pRenderer, char** stats)
+{
+	ASSERT(stats);
+
+	char* pStats = (char*)tf_calloc(128, sizeof(char));
+	snprintf(pStats, 128, "Null renderer resource memory: %llu bytes",
+		(unsigned long long)tfrg_atomic64_load_relaxed(&gNullAllocatedBytes));
+	*stats = pStats;
+}
+
+void calculateMemoryUse(Renderer* pRenderer, uint64_t* usedBytes, uint64_t* totalAllocatedBytes)
+{
+	const uint64_t allocated = (uint64_t)tfrg_atomic64_load_relaxed(&gNullAllocatedBytes);
+	if (usedBytes)
+		*usedBytes = allocated;
+	if (totalAllocatedBytes)
+		*totalAllocatedBytes = allocated;
+}
+
+void freeMemoryStats(Renderer* pRenderer, char* stats) { SAFE_FREE(stats); }
+/************************************************************************/
+// Debug Marker Implementation
+/************************************************************************/
+void cmdBeginDebugMarker(Cmd* pCmd, float r, float g, float b, const char* pName) { ASSERT(pCmd); }
+
+void cmdEndDebugMarker(Cmd* pCmd) { ASSERT(pCmd); }
+
+void cmdAddDebugMarker(Cmd* pCmd, float r, float g, float b, const char* pName) { ASSERT(pCmd); }
+/************************************************************************/
+// Resource Debug Naming Interface
+/************************************************************************/
+void setBufferName(Renderer* pRenderer, Buffer* pBuffer, const char* pName) {}
+
+void setTextureName(Renderer* pRenderer, Texture* pTexture, const char* pName) {}
+
+void setRenderTargetName(Renderer* pRenderer, RenderTarget* pRenderTarget, const char* pName) {}
+
+void setPipelineName(Renderer* pRenderer, Pipeline* pPipeline, const char* pName) {}
+#endif
@@ -156,6 +156,10 @@ typedef struct QueryPool
 	uint32_t          mType;
 	uint32_t          mCount;
 #endif
+#if defined(NULL_RENDERER)
+	QueryType         mType;
+	uint32_t          mCount;
+#endif
 } QueryPool;
 
 typedef struct DEFINE_ALIGNED(Buffer, 64)
@@ -205,6 +209,11 @@ typedef struct DEFINE_ALIGNED(Buffer, 64)
 #endif
 #if defined(PROSPERO)
 	ProsperoBuffer                   mStruct;
+#endif
+#if defined(NULL_RENDERER)
+	/// System memory backing the buffer. pCpuMappedAddress points into this while mapped
+	void*                            pNullMemory;
+	uint64_t                         mPadA[5];
 #endif
 	uint64_t                         mSize : 32;
 	uint64_t                         mDescriptors : 20;
@@ -347,6 +356,12 @@ typedef struct DEFINE_ALIGNED(Texture, 64)
 #endif
 #if defined(PROSPERO)
 	ProsperoTexture              mStruct;
+#endif
+#if defined(NULL_RENDERER)
+	/// System memory backing all subresources, tightly packed layer by layer, mip by mip
+	void*                        pNullMemory;
+	uint64_t                     mNullMemorySize;
+	uint64_t                     mPadA[3];
 #endif
 	VirtualTexture* pSvt;
 	/// Current state of the buffer
@@ -446,6 +461,9 @@ typedef struct DEFINE_ALIGNED(Sampler, 16)
 #if defined(PROSPERO)
 	ProsperoSampler             mStruct;
 #endif
+#if defined(NULL_RENDERER)
+	uint64_t                    mPadA;
+#endif
 } Sampler;
 #if defined(DIRECT3D12)
 COMPILE_ASSERT(sizeof(Sampler) == 8 * sizeof(uint64_t));
@@ -490,7 +508,10 @@ typedef struct DEFINE_ALIGNED(RootSignature, 64)
 	void** pUpdateTemplateData[DESCRIPTOR_UPDATE_FREQ_COUNT];
 	uint32_t                   mVkPushConstantCount;
 	uint32_t                   mPadA;
-	uint64_t                   mPadB[7];
+	/// Template entries kept around so batched updates can be expressed as VkWriteDescriptorSet
+	VkDescriptorUpdateTemplateEntry* pUpdateTemplateEntries[DESCRIPTOR_UPDATE_FREQ_COUNT];
+	uint16_t                   mVkUpdateTemplateEntryCounts[DESCRIPTOR_UPDATE_FREQ_COUNT];
+	uint64_t                   mPadB[2];
 #endif
 #if defined(METAL)
 	NSMutableArray<MTLArgumentDescriptor*>* mArgumentDescriptors[DESCRIPTOR_UPDATE_FREQ_COUNT] API_AVAILABLE(macos(10.13), ios(11.0));
@@ -555,7 +576,14 @@ typedef struct DEFINE_ALIGNED(DescriptorSet, 64)
 	const RootSignature* pRootSignature;
 	/// Values passed to vkUpdateDescriptorSetWithTemplate. Initialized to default descriptor values.
 	union DescriptorUpdateData** ppUpdateData;
+	/// Copy of ppUpdateData at the last write of each set. Updates which don't change the contents are skipped
+	union DescriptorUpdateData** ppWrittenData;
+	/// Whether ppWrittenData of a set is valid. Cleared when a resource the set references is removed
+	bool* pWritten;
 	struct SizeOffset* pDynamicSizeOffsets;
+	/// Links of the list of all descriptor sets, which removed resources are looked up in
+	struct DescriptorSet* pNextSet;
+	struct DescriptorSet* pPrevSet;
 	uint32_t                      mMaxSets;
 	uint8_t                       mDynamicOffsetCount;
 	uint8_t                       mUpdateFrequency;
@@ -585,6 +613,11 @@ typedef struct DEFINE_ALIGNED(DescriptorSet, 64)
 	OrbisDescriptorSet            mStruct;
 #elif defined(PROSPERO)
 	ProsperoDescriptorSet         mStruct;
+#elif defined(NULL_RENDERER)
+	const RootSignature* pRootSignature;
+	uint32_t                      mMaxSets;
+	uint8_t                       mUpdateFrequency;
+	uint8_t                       mNodeIndex;
 #endif
 } DescriptorSet;
 
@@ -668,6 +701,17 @@ typedef struct DEFINE_ALIGNED(Cmd, 64)
 #endif
 #if defined(PROSPERO)
 	ProsperoCmd                  mStruct;
+#endif
+#if defined(NULL_RENDERER)
+	Pipeline* pBoundPipeline;
+	uint32_t                     mNodeIndex : 4;
+	uint32_t                     mType : 3;
+	uint32_t                     mRecording : 1;
+	uint32_t                     mPadA;
+	CmdPool* pCmdPool;
+	/// Draw and dispatch counters so CPU-only runs can verify the workload they submitted
+	uint32_t                     mDrawCount;
+	uint32_t                     mDispatchCount;
 #endif
 	Renderer* pRenderer;
 	Queue* pQueue;
@@ -709,6 +753,12 @@ typedef struct Fence
 #if defined(PROSPERO)
 	ProsperoFence        mStruct;
 #endif
+#if defined(NULL_RENDERER)
+	uint32_t             mSubmitted : 1;
+	uint32_t             mPadA;
+	uint64_t             mPadB;
+	uint64_t             mPadC;
+#endif
 } Fence;
 
 typedef struct Semaphore
@@ -754,6 +804,12 @@ typedef struct Semaphore
 #if defined(PROSPERO)
 	ProsperoSemaphore    mStruct;
 #endif
+#if defined(NULL_RENDERER)
+	uint32_t             mSignaled : 1;
+	uint32_t             mPadA;
+	uint64_t             mPadB;
+	uint64_t             mPadC;
+#endif
 } Semaphore;
 
 typedef struct Queue
@@ -800,6 +856,13 @@ typedef struct Queue
 	uint32_t             mType : 3;
 	uint32_t             mNodeIndex : 4;
 #endif
+#if defined(NULL_RENDERER)
+	uint32_t             mType : 3;
+	uint32_t             mNodeIndex : 4;
+	uint32_t             mFlags;
+	/// Number of command buffers submitted to this queue
+	uint64_t             mSubmitCount;
+#endif
 } Queue;
 
 typedef struct Shader
@@ -905,6 +968,11 @@ typedef struct DEFINE_ALIGNED(Pipeline, 64)
 #if defined(PROSPERO)
 	ProsperoPipeline            mStruct;
 #endif
+#if defined(NULL_RENDERER)
+	PipelineType                mType;
+	uint32_t                    mPadA;
+	uint64_t                    mPadB[7];
+#endif
 } Pipeline;
 #if defined(DIRECT3D11) || defined(ORBIS)
 // Requires more cache lines due to no concept of an encapsulated pipeline state object
@@ -977,7 +1045,8 @@ typedef struct SwapChain
 	uint32_t                 mPresentQueueFamilyIndex : 5;
 	uint32_t                 mImageCount : 3;
 	uint32_t                 mEnableVsync : 1;
-	uint32_t                 mPadA;
+	/// Image returned by the next acquireNextImage when there is no VkSwapchainKHR (headless)
+	uint32_t                 mHeadlessImageIndex;
 #endif
 #if defined(METAL)
 #if defined(TARGET_IOS)
@@ -1002,6 +1071,11 @@ typedef struct SwapChain
 	uint32_t                 mImageCount : 3;
 	uint32_t                 mEnableVsync : 1;
 #endif
+#if defined(NULL_RENDERER)
+	uint32_t                 mImageCount : 3;
+	uint32_t                 mEnableVsync : 1;
+	uint32_t                 mIndex;
+#endif
 } SwapChain;
 
 typedef struct DEFINE_ALIGNED(Renderer, 64)
@@ -1119,4 +1193,8 @@ typedef struct CommandSignature
 	IndirectArgumentType    mDrawType;
 	uint32_t                mStride;
 #endif
+#if defined(NULL_RENDERER)
+	IndirectArgumentType    mDrawType;
+	uint32_t                mStride;
+#endif
 } CommandSignature;
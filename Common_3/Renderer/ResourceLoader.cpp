@@ -35,10 +35,19 @@
 #define CGLTF_IMPLEMENTATION
 #include "../ThirdParty/OpenSource/cgltf/cgltf.h"
 
+// Only the decoders of meshoptimizer are needed at runtime.
+// Just include the cpp here so we don't have to add it to all the projects
+#include "../ThirdParty/OpenSource/meshoptimizer/src/vertexcodec.cpp"
+#include "../ThirdParty/OpenSource/meshoptimizer/src/indexcodec.cpp"
+
 #include "Renderer.h"
 #include "IResourceLoader.h"
+#include "GeometryFormat.h"
+#include "VertexPacking.h"
 #include "../OS/Interfaces/ILog.h"
 #include "../OS/Interfaces/IThread.h"
+#include "../OS/Interfaces/ITime.h"
+#include "../OS/Core/ThreadSystem.h"
 
 #if defined(__ANDROID__)
 #include <shaderc/shaderc.h>
@@ -46,6 +55,8 @@
 
 #include "../OS/Core/TextureContainers.h"
 
+#include "../ThirdParty/OpenSource/EASTL/unordered_map.h"
+
 #include "../OS/Interfaces/IMemory.h"
 
 #ifdef NX64
@@ -54,15 +65,25 @@
 
 using namespace theforge;
 
+// Shader byte code is cached in a single content addressed pack file. Consoles keep loading their binaries as loose files
+#if !defined(NX64) && !defined(ORBIS) && !defined(PROSPERO)
+#define ENABLE_SHADER_PACK
+#endif
+
 struct SubresourceDataDesc
 {
 	uint64_t                           mSrcOffset;
 	uint32_t                           mMipLevel;
 	uint32_t                           mArrayLayer;
-#if defined(DIRECT3D11) || defined(METAL) || defined(VULKAN)
+#if defined(DIRECT3D11) || defined(METAL) || defined(VULKAN) || defined(NULL_RENDERER)
 	uint32_t                           mRowPitch;
 	uint32_t                           mSlicePitch;
 #endif
+	// Region of the subresource to copy. Zero width means the whole subresource
+	uint32_t                           mRegionX;
+	uint32_t                           mRegionY;
+	uint32_t                           mRegionWidth;
+	uint32_t                           mRegionHeight;
 };
 
 #define MIP_REDUCE(s, mip) (max(1u, (uint32_t)((s) >> (mip))))
@@ -101,7 +122,7 @@ extern void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pSrcBuffe
 Mutex gContextLock;
 #endif
 
-ResourceLoaderDesc gDefaultResourceLoaderDesc = { 8ull << 20, 2 };
+ResourceLoaderDesc gDefaultResourceLoaderDesc = { 8ull << 20, 2, 4, 4 };
 /************************************************************************/
 // Surface Utils
 /************************************************************************/
@@ -218,94 +239,6 @@ static inline constexpr TinyImageFormat util_cgltf_type_to_image_format(cgltf_ty
 	}
 }
 
-#define F16_EXPONENT_BITS 0x1F
-#define F16_EXPONENT_SHIFT 10
-#define F16_EXPONENT_BIAS 15
-#define F16_MANTISSA_BITS 0x3ff
-#define F16_MANTISSA_SHIFT (23 - F16_EXPONENT_SHIFT)
-#define F16_MAX_EXPONENT (F16_EXPONENT_BITS << F16_EXPONENT_SHIFT)
-
-static inline uint16_t util_float_to_half(float val)
-{
-	uint32_t           f32 = (*(uint32_t*)&val);
-	uint16_t           f16 = 0;
-	/* Decode IEEE 754 little-endian 32-bit floating-point value */
-	int sign = (f32 >> 16) & 0x8000;
-	/* Map exponent to the range [-127,128] */
-	int exponent = ((f32 >> 23) & 0xff) - 127;
-	int mantissa = f32 & 0x007fffff;
-	if (exponent == 128)
-	{ /* Infinity or NaN */
-		f16 = (uint16_t)(sign | F16_MAX_EXPONENT);
-		if (mantissa)
-			f16 |= (mantissa & F16_MANTISSA_BITS);
-	}
-	else if (exponent > 15)
-	{ /* Overflow - flush to Infinity */
-		f16 = (unsigned short)(sign | F16_MAX_EXPONENT);
-	}
-	else if (exponent > -15)
-	{ /* Representable value */
-		exponent += F16_EXPONENT_BIAS;
-		mantissa >>= F16_MANTISSA_SHIFT;
-		f16 = (unsigned short)(sign | exponent << F16_EXPONENT_SHIFT | mantissa);
-	}
-	else
-	{
-		f16 = (unsigned short)sign;
-	}
-	return f16;
-}
-
-static inline void util_pack_float2_to_half2(uint32_t count, uint32_t stride, uint32_t offset, const uint8_t* src, uint8_t* dst)
-{
-	struct f2 { float x; float y; };
-	f2* f = (f2*)src;
-	for (uint32_t e = 0; e < count; ++e)
-	{
-		*(uint32_t*)(dst + e * sizeof(uint32_t) + offset) = (
-			(util_float_to_half(f[e].x) & 0x0000FFFF) | ((util_float_to_half(f[e].y) << 16) & 0xFFFF0000));
-	}
-}
-
-static inline uint32_t util_float2_to_unorm2x16(const float* v)
-{
-	uint32_t x = (uint32_t)round(clamp(v[0], 0, 1) * 65535.0f);
-	uint32_t y = (uint32_t)round(clamp(v[1], 0, 1) * 65535.0f);
-	return ((uint32_t)0x0000FFFF & x) | ((y << 16) & (uint32_t)0xFFFF0000);
-}
-
-#define OCT_WRAP(v, w) ((1.0f - abs((w))) * ((v) >= 0.0f ? 1.0f : -1.0f))
-
-static inline void util_pack_float3_direction_to_half2(uint32_t count, uint32_t stride, uint32_t offset, const uint8_t* src, uint8_t* dst)
-{
-	struct f3 { float x; float y; float z; };
-	for (uint32_t e = 0; e < count; ++e)
-	{
-		f3 f = *(f3*)(src + e * stride);
-		float absLength = (abs(f.x) + abs(f.y) + abs(f.z));
-		f3 enc = {};
-		if (absLength)
-		{
-			enc.x = f.x / absLength;
-			enc.y = f.y / absLength;
-			enc.z = f.z / absLength;
-			if (enc.z < 0)
-			{
-				float oldX = enc.x;
-				enc.x = OCT_WRAP(enc.x, enc.y);
-				enc.y = OCT_WRAP(enc.y, oldX);
-			}
-			enc.x = enc.x * 0.5f + 0.5f;
-			enc.y = enc.y * 0.5f + 0.5f;
-			*(uint32_t*)(dst + e * sizeof(uint32_t) + offset) = util_float2_to_unorm2x16(&enc.x);
-		}
-		else
-		{
-			*(uint32_t*)(dst + e * sizeof(uint32_t) + offset) = 0;
-		}
-	}
-}
 /************************************************************************/
 // Internal Structures
 /************************************************************************/
@@ -322,6 +255,11 @@ typedef struct TextureUpdateDescInternal
 	uint32_t          mLayerCount;
 	PreMipStepFn      pPreMipFunc;
 	bool              mMipsAfterSlice;
+	// Optional region, only used by beginUpdateResource/endUpdateResource
+	uint32_t          mRegionX;
+	uint32_t          mRegionY;
+	uint32_t          mRegionWidth;
+	uint32_t          mRegionHeight;
 } TextureUpdateDescInternal;
 
 typedef struct CopyResourceSet
@@ -415,6 +353,13 @@ struct ResourceLoader
 	uint32_t                     mNextSet;
 	uint32_t                     mSubmittedSets;
 
+	ThreadSystem*                pDecodeThreadSystem;
+	Mutex                        mDecodeMutex;
+	ConditionVariable            mDecodeCond;
+	ThreadSystem*                pLoadThreadSystem;
+	Mutex                        mPreparedLoadMutex;
+	ConditionVariable            mPreparedLoadCond;
+
 #if defined(NX64)
 	ThreadTypeNX                 mThreadType;
 	void*                        mThreadStackPtr;
@@ -662,7 +607,9 @@ static UploadFunctionResult updateTexture(Renderer* pRenderer, CopyEngine* pCopy
 		texUpdateDesc.mBaseArrayLayer, texUpdateDesc.mLayerCount);
 
 #if defined(VULKAN)
-	TextureBarrier barrier = { texture, RESOURCE_STATE_UNDEFINED, RESOURCE_STATE_COPY_DEST };
+	// Region updates keep the rest of the texture so its contents cannot be discarded
+	const bool keepContents = texUpdateDesc.mRegionWidth && texUpdateDesc.mRegionHeight;
+	TextureBarrier barrier = { texture, keepContents ? RESOURCE_STATE_SHADER_RESOURCE : RESOURCE_STATE_UNDEFINED, RESOURCE_STATE_COPY_DEST };
 	cmdResourceBarrier(cmd, 0, NULL, 1, &barrier, 0, NULL);
 #endif
 
@@ -722,6 +669,13 @@ static UploadFunctionResult updateTexture(Renderer* pRenderer, CopyEngine* pCopy
 				uint32_t h = MIP_REDUCE(texture->mHeight, mip);
 				uint32_t d = MIP_REDUCE(texture->mDepth, mip);
 
+				const bool updateRegion = texUpdateDesc.mRegionWidth && texUpdateDesc.mRegionHeight;
+				if (updateRegion)
+				{
+					w = texUpdateDesc.mRegionWidth;
+					h = texUpdateDesc.mRegionHeight;
+				}
+
 				uint32_t numBytes = 0;
 				uint32_t rowBytes = 0;
 				uint32_t numRows = 0;
@@ -758,10 +712,17 @@ static UploadFunctionResult updateTexture(Renderer* pRenderer, CopyEngine* pCopy
 				subresourceDesc.mArrayLayer = layer;
 				subresourceDesc.mMipLevel = mip;
 				subresourceDesc.mSrcOffset = upload.mOffset + offset;
-#if defined(DIRECT3D11) || defined(METAL) || defined(VULKAN)
+#if defined(DIRECT3D11) || defined(METAL) || defined(VULKAN) || defined(NULL_RENDERER)
 				subresourceDesc.mRowPitch = subRowPitch;
 				subresourceDesc.mSlicePitch = subSlicePitch;
 #endif
+				if (updateRegion)
+				{
+					subresourceDesc.mRegionX = texUpdateDesc.mRegionX;
+					subresourceDesc.mRegionY = texUpdateDesc.mRegionY;
+					subresourceDesc.mRegionWidth = w;
+					subresourceDesc.mRegionHeight = h;
+				}
 				cmdUpdateSubresource(cmd, texture, upload.pBuffer, &subresourceDesc);
 				offset += subDepth * subSlicePitch;
 			}
@@ -781,17 +742,18 @@ static UploadFunctionResult updateTexture(Renderer* pRenderer, CopyEngine* pCopy
 	return UPLOAD_FUNCTION_RESULT_COMPLETED;
 }
 
-static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, const UpdateRequest& pTextureUpdate)
+// CPU side of a texture load. Opens and parses the texture file and creates the texture, the copy of its data is left to updateTexture.
+// When readIntoMemory is set the texture data is read into memory as well, so the streamer thread no longer touches the file
+static UploadFunctionResult prepareTexture(Renderer* pRenderer, const TextureLoadDesc* pTextureDesc, bool readIntoMemory, TextureUpdateDescInternal* pUpdateDesc)
 {
-	const TextureLoadDesc* pTextureDesc = &pTextureUpdate.texLoadDesc;
-
 	if (pTextureDesc->pFileName)
 	{
 		FileStream stream = {};
 		char fileName[FS_MAX_PATH] = {};
 		bool success = false;
+		bool inMemory = false;
 
-		TextureUpdateDescInternal updateDesc = {};
+		TextureUpdateDescInternal& updateDesc = *pUpdateDesc;
 		TextureContainerType container = pTextureDesc->mContainer;
 		static const char* extensions[] = { NULL, "dds", "ktx", "gnf", "basis", "svt" };
 
@@ -872,6 +834,7 @@ static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEn
 				{
 					fsCloseStream(&stream);
 					fsOpenStreamFromMemory(data, dataSize, FM_READ_BINARY, true, &stream);
+					inMemory = true;
 				}
 			}
 			break;
@@ -895,6 +858,24 @@ static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEn
 			break;
 		}
 
+		if (success && readIntoMemory && !inMemory)
+		{
+			ssize_t dataSize = fsGetStreamFileSize(&stream) - fsGetStreamSeekPosition(&stream);
+			void* data = tf_malloc(dataSize);
+			success = fsReadFromStream(&stream, data, dataSize) == (size_t)dataSize;
+			fsCloseStream(&stream);
+			if (success)
+			{
+				fsOpenStreamFromMemory(data, dataSize, FM_READ_BINARY, true, &stream);
+			}
+			else
+			{
+				LOGF(eERROR, "Failed to read texture data from %s", fileName);
+				tf_free(data);
+				return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+			}
+		}
+
 		if (success)
 		{
 			textureDesc.mStartState = RESOURCE_STATE_COMMON;
@@ -909,121 +890,152 @@ static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEn
 			updateDesc.mBaseArrayLayer = 0;
 			updateDesc.mLayerCount = textureDesc.mArraySize;
 
-			return updateTexture(pRenderer, pCopyEngine, activeSet, updateDesc);
+			return UPLOAD_FUNCTION_RESULT_COMPLETED;
 		}
-		/************************************************************************/
-		// Sparse Tetxtures
-		/************************************************************************/
+		else if (stream.pIO)
+		{
+			fsCloseStream(&stream);
+		}
+	}
+
+	return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+}
+
+/************************************************************************/
+// Sparse Tetxtures
+/************************************************************************/
 #if defined(DIRECT3D12) || defined(VULKAN)
-		if (TEXTURE_CONTAINER_SVT == container)
+static UploadFunctionResult loadSparseTexture(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, const TextureLoadDesc* pTextureDesc)
+{
+	FileStream stream = {};
+	char fileName[FS_MAX_PATH] = {};
+	bool success = false;
+
+	TextureDesc textureDesc = {};
+	textureDesc.pName = pTextureDesc->pFileName;
+
+	fsReplacePathExtension(pTextureDesc->pFileName, "svt", fileName);
+
+	if (fsOpenStreamFromPath(RD_TEXTURES, fileName, FM_READ_BINARY, &stream))
+	{
+		success = loadSVTTextureDesc(&stream, &textureDesc);
+		if (success)
 		{
-			if (fsOpenStreamFromPath(RD_TEXTURES, fileName, FM_READ_BINARY, &stream))
-			{
-				success = loadSVTTextureDesc(&stream, &textureDesc);
-				if (success)
-				{
-					ssize_t dataSize = fsGetStreamFileSize(&stream) - fsGetStreamSeekPosition(&stream);
-					void* data = tf_malloc(dataSize);
-					fsReadFromStream(&stream, data, dataSize);
-
-					textureDesc.mStartState = RESOURCE_STATE_COPY_DEST;
-					textureDesc.mFlags |= pTextureDesc->mCreationFlag;
-					textureDesc.mNodeIndex = pTextureDesc->mNodeIndex;
-					addVirtualTexture(acquireCmd(pCopyEngine, activeSet), &textureDesc, pTextureDesc->ppTexture, data);
-					/************************************************************************/
-					// Create visibility buffer
-					/************************************************************************/
-					eastl::vector<VirtualTexturePage>* pPageTable = (eastl::vector<VirtualTexturePage>*)(*pTextureDesc->ppTexture)->pSvt->pPages;
-
-					if (pPageTable == NULL)
-						return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
-
-					BufferLoadDesc visDesc = {};
-					visDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
-					visDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_GPU_ONLY;
-					visDesc.mDesc.mStructStride = sizeof(uint);
-					visDesc.mDesc.mElementCount = (uint64_t)pPageTable->size();
-					visDesc.mDesc.mSize = visDesc.mDesc.mStructStride * visDesc.mDesc.mElementCount;
-					visDesc.mDesc.mStartState = RESOURCE_STATE_COMMON;
-					visDesc.mDesc.pName = "Vis Buffer for Sparse Texture";
-					visDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mVisibility;
-					addResource(&visDesc, NULL);
-
-					BufferLoadDesc prevVisDesc = {};
-					prevVisDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
-					prevVisDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_GPU_ONLY;
-					prevVisDesc.mDesc.mStructStride = sizeof(uint);
-					prevVisDesc.mDesc.mElementCount = (uint64_t)pPageTable->size();
-					prevVisDesc.mDesc.mSize = prevVisDesc.mDesc.mStructStride * prevVisDesc.mDesc.mElementCount;
-					prevVisDesc.mDesc.mStartState = RESOURCE_STATE_COMMON;
-					prevVisDesc.mDesc.pName = "Prev Vis Buffer for Sparse Texture";
-					prevVisDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mPrevVisibility;
-					addResource(&prevVisDesc, NULL);
-
-					BufferLoadDesc alivePageDesc = {};
-					alivePageDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
-					alivePageDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
+			ssize_t dataSize = fsGetStreamFileSize(&stream) - fsGetStreamSeekPosition(&stream);
+			void* data = tf_malloc(dataSize);
+			fsReadFromStream(&stream, data, dataSize);
+
+			textureDesc.mStartState = RESOURCE_STATE_COPY_DEST;
+			textureDesc.mFlags |= pTextureDesc->mCreationFlag;
+			textureDesc.mNodeIndex = pTextureDesc->mNodeIndex;
+			addVirtualTexture(acquireCmd(pCopyEngine, activeSet), &textureDesc, pTextureDesc->ppTexture, data);
+			/************************************************************************/
+			// Create visibility buffer
+			/************************************************************************/
+			eastl::vector<VirtualTexturePage>* pPageTable = (eastl::vector<VirtualTexturePage>*)(*pTextureDesc->ppTexture)->pSvt->pPages;
+
+			if (pPageTable == NULL)
+				return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+
+			BufferLoadDesc visDesc = {};
+			visDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
+			visDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_GPU_ONLY;
+			visDesc.mDesc.mStructStride = sizeof(uint);
+			visDesc.mDesc.mElementCount = (uint64_t)pPageTable->size();
+			visDesc.mDesc.mSize = visDesc.mDesc.mStructStride * visDesc.mDesc.mElementCount;
+			visDesc.mDesc.mStartState = RESOURCE_STATE_COMMON;
+			visDesc.mDesc.pName = "Vis Buffer for Sparse Texture";
+			visDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mVisibility;
+			addResource(&visDesc, NULL);
+
+			BufferLoadDesc prevVisDesc = {};
+			prevVisDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
+			prevVisDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_GPU_ONLY;
+			prevVisDesc.mDesc.mStructStride = sizeof(uint);
+			prevVisDesc.mDesc.mElementCount = (uint64_t)pPageTable->size();
+			prevVisDesc.mDesc.mSize = prevVisDesc.mDesc.mStructStride * prevVisDesc.mDesc.mElementCount;
+			prevVisDesc.mDesc.mStartState = RESOURCE_STATE_COMMON;
+			prevVisDesc.mDesc.pName = "Prev Vis Buffer for Sparse Texture";
+			prevVisDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mPrevVisibility;
+			addResource(&prevVisDesc, NULL);
+
+			BufferLoadDesc alivePageDesc = {};
+			alivePageDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
+			alivePageDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
 #if defined(DIRECT3D12)
-					alivePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
+			alivePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
 #elif defined(VULKAN)
-					alivePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT;
+			alivePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT;
 #else
-					alivePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
-#endif
-					alivePageDesc.mDesc.mStructStride = sizeof(uint);
-					alivePageDesc.mDesc.mElementCount = (uint64_t)pPageTable->size();
-					alivePageDesc.mDesc.mSize = alivePageDesc.mDesc.mStructStride * alivePageDesc.mDesc.mElementCount;
-					alivePageDesc.mDesc.pName = "Alive pages buffer for Sparse Texture";
-					alivePageDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mAlivePage;
-					addResource(&alivePageDesc, NULL);
-
-					BufferLoadDesc removePageDesc = {};
-					removePageDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
-					removePageDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
+			alivePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
+#endif
+			alivePageDesc.mDesc.mStructStride = sizeof(uint);
+			alivePageDesc.mDesc.mElementCount = (uint64_t)pPageTable->size();
+			alivePageDesc.mDesc.mSize = alivePageDesc.mDesc.mStructStride * alivePageDesc.mDesc.mElementCount;
+			alivePageDesc.mDesc.pName = "Alive pages buffer for Sparse Texture";
+			alivePageDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mAlivePage;
+			addResource(&alivePageDesc, NULL);
+
+			BufferLoadDesc removePageDesc = {};
+			removePageDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
+			removePageDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
 #if defined(DIRECT3D12)
-					removePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
+			removePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
 #elif defined(VULKAN)
-					removePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT;
+			removePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT;
 #else
-					removePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
-#endif
-					removePageDesc.mDesc.mStructStride = sizeof(uint);
-					removePageDesc.mDesc.mElementCount = (uint64_t)pPageTable->size();
-					removePageDesc.mDesc.mSize = removePageDesc.mDesc.mStructStride * removePageDesc.mDesc.mElementCount;
-					removePageDesc.mDesc.pName = "Remove pages buffer for Sparse Texture";
-					removePageDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mRemovePage;
-					addResource(&removePageDesc, NULL);
-
-					BufferLoadDesc pageCountsDesc = {};
-					pageCountsDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
-					pageCountsDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
+			removePageDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
+#endif
+			removePageDesc.mDesc.mStructStride = sizeof(uint);
+			removePageDesc.mDesc.mElementCount = (uint64_t)pPageTable->size();
+			removePageDesc.mDesc.mSize = removePageDesc.mDesc.mStructStride * removePageDesc.mDesc.mElementCount;
+			removePageDesc.mDesc.pName = "Remove pages buffer for Sparse Texture";
+			removePageDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mRemovePage;
+			addResource(&removePageDesc, NULL);
+
+			BufferLoadDesc pageCountsDesc = {};
+			pageCountsDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_RW_BUFFER;
+			pageCountsDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
 #if defined(DIRECT3D12)
-					pageCountsDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
+			pageCountsDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
 #elif defined(VULKAN)
-					pageCountsDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT;
+			pageCountsDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT;
 #else
-					pageCountsDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
+			pageCountsDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
 #endif
-					pageCountsDesc.mDesc.mStructStride = sizeof(uint);
-					pageCountsDesc.mDesc.mElementCount = 4;
-					pageCountsDesc.mDesc.mSize = pageCountsDesc.mDesc.mStructStride * pageCountsDesc.mDesc.mElementCount;
-					pageCountsDesc.mDesc.pName = "Page count buffer for Sparse Texture";
-					pageCountsDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mPageCounts;
-					addResource(&pageCountsDesc, NULL);
+			pageCountsDesc.mDesc.mStructStride = sizeof(uint);
+			pageCountsDesc.mDesc.mElementCount = 4;
+			pageCountsDesc.mDesc.mSize = pageCountsDesc.mDesc.mStructStride * pageCountsDesc.mDesc.mElementCount;
+			pageCountsDesc.mDesc.pName = "Page count buffer for Sparse Texture";
+			pageCountsDesc.ppBuffer = &(*pTextureDesc->ppTexture)->pSvt->mPageCounts;
+			addResource(&pageCountsDesc, NULL);
 
-					fsCloseStream(&stream);
-
-					return UPLOAD_FUNCTION_RESULT_COMPLETED;
-				}
-			}
+			fsCloseStream(&stream);
 
-			return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+			return UPLOAD_FUNCTION_RESULT_COMPLETED;
 		}
-#endif
 	}
 
 	return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
 }
+#endif
+
+static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, const UpdateRequest& pTextureUpdate)
+{
+	const TextureLoadDesc* pTextureDesc = &pTextureUpdate.texLoadDesc;
+
+#if defined(DIRECT3D12) || defined(VULKAN)
+	if (pTextureDesc->pFileName && TEXTURE_CONTAINER_SVT == pTextureDesc->mContainer)
+		return loadSparseTexture(pRenderer, pCopyEngine, activeSet, pTextureDesc);
+#endif
+
+	TextureUpdateDescInternal updateDesc = {};
+	UploadFunctionResult result = prepareTexture(pRenderer, pTextureDesc, false, &updateDesc);
+	if (UPLOAD_FUNCTION_RESULT_COMPLETED != result || !updateDesc.pTexture)
+		return result;
+
+	return updateTexture(pRenderer, pCopyEngine, activeSet, updateDesc);
+}
 
 static UploadFunctionResult updateBuffer(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, const BufferUpdateDesc& bufUpdateDesc)
 {
@@ -1039,13 +1051,434 @@ static UploadFunctionResult updateBuffer(Renderer* pRenderer, CopyEngine* pCopyE
 	return UPLOAD_FUNCTION_RESULT_COMPLETED;
 }
 
-static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, UpdateRequest& pGeometryLoad)
+// Creates the index and vertex buffers of geometry and maps the memory their data is written to.
+// Without stagingMemory the data is written to system memory instead and moved to staging memory later by stageGeometryBuffers,
+// as staging memory can only be allocated on the streamer thread
+static void addGeometryBuffers(
+	Renderer* pRenderer, const GeometryLoadDesc* pDesc, Geometry* geom, uint32_t indexStride, const uint32_t* vertexStrides,
+	bool stagingMemory, BufferUpdateDesc* pIndexUpdateDesc, BufferUpdateDesc* pVertexUpdateDescs)
+{
+	const uint32_t indexCount = geom->mIndexCount;
+	const uint32_t vertexCount = geom->mVertexCount;
+
+	// Allocate buffer memory
+	const bool structuredBuffers = (pDesc->mFlags & GEOMETRY_LOAD_FLAG_STRUCTURED_BUFFERS);
+
+	// Index buffer
+	BufferDesc indexBufferDesc = {};
+	indexBufferDesc.mDescriptors = DESCRIPTOR_TYPE_INDEX_BUFFER |
+		(structuredBuffers ?
+		(DESCRIPTOR_TYPE_BUFFER | DESCRIPTOR_TYPE_RW_BUFFER) :
+			(DESCRIPTOR_TYPE_BUFFER_RAW | DESCRIPTOR_TYPE_RW_BUFFER_RAW));
+	indexBufferDesc.mSize = indexStride * indexCount;
+	indexBufferDesc.mElementCount = indexBufferDesc.mSize / (structuredBuffers ? indexStride : sizeof(uint32_t));
+	indexBufferDesc.mStructStride = indexStride;
+	indexBufferDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_GPU_ONLY;
+	addBuffer(pRenderer, &indexBufferDesc, &geom->pIndexBuffer);
+
+	pIndexUpdateDesc->mSize = indexCount * indexStride;
+	pIndexUpdateDesc->pBuffer = geom->pIndexBuffer;
+#if UMA
+	pIndexUpdateDesc->mInternal.mMappedRange = { (uint8_t*)geom->pIndexBuffer->pCpuMappedAddress };
+#else
+	pIndexUpdateDesc->mInternal.mMappedRange = stagingMemory ? allocateStagingMemory(pIndexUpdateDesc->mSize, RESOURCE_BUFFER_ALIGNMENT)
+															 : MappedMemoryRange{ (uint8_t*)tf_malloc(pIndexUpdateDesc->mSize) };
+#endif
+	pIndexUpdateDesc->pMappedData = pIndexUpdateDesc->mInternal.mMappedRange.pData;
+
+	uint32_t bufferCounter = 0;
+	for (uint32_t i = 0; i < MAX_VERTEX_BINDINGS; ++i)
+	{
+		if (!vertexStrides[i])
+			continue;
+
+		BufferDesc vertexBufferDesc = {};
+		vertexBufferDesc.mDescriptors = DESCRIPTOR_TYPE_VERTEX_BUFFER |
+			(structuredBuffers ?
+			(DESCRIPTOR_TYPE_BUFFER | DESCRIPTOR_TYPE_RW_BUFFER) :
+				(DESCRIPTOR_TYPE_BUFFER_RAW | DESCRIPTOR_TYPE_RW_BUFFER_RAW));
+		vertexBufferDesc.mSize = vertexStrides[i] * vertexCount;
+		vertexBufferDesc.mElementCount = vertexBufferDesc.mSize / (structuredBuffers ? vertexStrides[i] : sizeof(uint32_t));
+		vertexBufferDesc.mStructStride = vertexStrides[i];
+		vertexBufferDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_GPU_ONLY;
+		addBuffer(pRenderer, &vertexBufferDesc, &geom->pVertexBuffers[bufferCounter]);
+
+		geom->mVertexStrides[bufferCounter] = vertexStrides[i];
+
+		pVertexUpdateDescs[i].pBuffer = geom->pVertexBuffers[bufferCounter];
+		pVertexUpdateDescs[i].mSize = vertexBufferDesc.mSize;
+#if UMA
+		pVertexUpdateDescs[i].mInternal.mMappedRange = { (uint8_t*)geom->pVertexBuffers[bufferCounter]->pCpuMappedAddress, 0 };
+#else
+		pVertexUpdateDescs[i].mInternal.mMappedRange = stagingMemory ? allocateStagingMemory(pVertexUpdateDescs[i].mSize, RESOURCE_BUFFER_ALIGNMENT)
+																	 : MappedMemoryRange{ (uint8_t*)tf_malloc(pVertexUpdateDescs[i].mSize) };
+#endif
+		pVertexUpdateDescs[i].pMappedData = pVertexUpdateDescs[i].mInternal.mMappedRange.pData;
+		++bufferCounter;
+	}
+}
+
+// Undoes addGeometryBuffers for geometry whose data could not be loaded
+static void removeGeometryBuffers(
+	Renderer* pRenderer, Geometry* geom, bool stagingMemory, BufferUpdateDesc* pIndexUpdateDesc, BufferUpdateDesc* pVertexUpdateDescs)
+{
+#if !UMA
+	// Staging memory is recycled with the copy engine, only the system memory has to be freed here
+	if (!stagingMemory)
+	{
+		tf_free(pIndexUpdateDesc->mInternal.mMappedRange.pData);
+		for (uint32_t i = 0; i < MAX_VERTEX_BINDINGS; ++i)
+			tf_free(pVertexUpdateDescs[i].mInternal.mMappedRange.pData);
+	}
+#else
+	UNREF_PARAM(stagingMemory);
+#endif
+	*pIndexUpdateDesc = {};
+	for (uint32_t i = 0; i < MAX_VERTEX_BINDINGS; ++i)
+		pVertexUpdateDescs[i] = {};
+
+	removeBuffer(pRenderer, geom->pIndexBuffer);
+	for (uint32_t i = 0; i < geom->mVertexBufferCount; ++i)
+		removeBuffer(pRenderer, geom->pVertexBuffers[i]);
+}
+
+static UploadFunctionResult uploadGeometryBuffers(
+	Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, const BufferUpdateDesc& indexUpdateDesc,
+	const BufferUpdateDesc* pVertexUpdateDescs)
+{
+	UploadFunctionResult uploadResult = UPLOAD_FUNCTION_RESULT_COMPLETED;
+#if !UMA
+	uploadResult = updateBuffer(pRenderer, pCopyEngine, activeSet, indexUpdateDesc);
+
+	for (uint32_t i = 0; i < MAX_VERTEX_BINDINGS; ++i)
+	{
+		if (pVertexUpdateDescs[i].pMappedData)
+		{
+			uploadResult = updateBuffer(pRenderer, pCopyEngine, activeSet, pVertexUpdateDescs[i]);
+		}
+	}
+#endif
+	return uploadResult;
+}
+
+#if !UMA
+// Moves geometry data written to system memory by addGeometryBuffers to staging memory
+static void stageGeometryBuffers(BufferUpdateDesc* pIndexUpdateDesc, BufferUpdateDesc* pVertexUpdateDescs)
+{
+	for (uint32_t i = 0; i < MAX_VERTEX_BINDINGS + 1; ++i)
+	{
+		BufferUpdateDesc* pUpdateDesc = i ? &pVertexUpdateDescs[i - 1] : pIndexUpdateDesc;
+		if (!pUpdateDesc->pMappedData)
+			continue;
+
+		MappedMemoryRange range = allocateStagingMemory(pUpdateDesc->mSize, RESOURCE_BUFFER_ALIGNMENT);
+		memcpy(range.pData, pUpdateDesc->pMappedData, pUpdateDesc->mSize);
+		tf_free(pUpdateDesc->pMappedData);
+		pUpdateDesc->mInternal.mMappedRange = range;
+		pUpdateDesc->pMappedData = range.pData;
+	}
+}
+#endif
+
+// One compressed stream of a geometry container. The streams are decoded in parallel on the decode threads of the resource loader
+struct GeometryDecodeJob
+{
+	const uint8_t*  pSrc;
+	size_t          mSrcSize;
+	uint32_t        mCount;
+	uint32_t        mStride;            // Size of one decoded element
+	bool            mIndices;
+	// Where the stream is decoded to. NULL decodes into scratch memory
+	uint8_t*        pDecoded;
+	// Conversion from the decoded stream to the buffer, skipped when pDecoded already is the buffer
+	uint8_t*        pDst;
+	uint32_t        mDstStride;
+	uint32_t        mDstOffset;
+	bool            mInterleaved;
+	PackingFunction pPacking;
+	int             mResult;
+	// Jobs of the same load left to decode when they run on the decode threads
+	tfrg_atomic32_t* pRemaining;
+};
+
+static void decodeGeometryStream(void* pUser, uintptr_t index)
+{
+	GeometryDecodeJob* pJob = (GeometryDecodeJob*)pUser + index;
+	const uint32_t count = pJob->mCount;
+	const uint32_t stride = pJob->mStride;
+
+	uint8_t* decoded = pJob->pDecoded ? pJob->pDecoded : (uint8_t*)tf_malloc(count * stride);
+	pJob->mResult = pJob->mIndices ? meshopt_decodeIndexBuffer(decoded, count, stride, pJob->pSrc, pJob->mSrcSize)
+								   : meshopt_decodeVertexBuffer(decoded, count, stride, pJob->pSrc, pJob->mSrcSize);
+
+	if (0 == pJob->mResult && decoded != pJob->pDst)
+	{
+		uint8_t* dst = pJob->pDst;
+		if (pJob->pPacking)
+			pJob->pPacking(count, stride, pJob->mDstStride, pJob->mDstOffset, decoded, dst);
+		else if (!pJob->mInterleaved)
+			memcpy(dst, decoded, count * stride);
+		else
+			for (uint32_t e = 0; e < count; ++e)
+				memcpy(dst + e * pJob->mDstStride + pJob->mDstOffset, decoded + e * stride, stride);
+	}
+
+	if (!pJob->pDecoded)
+		tf_free(decoded);
+
+	if (pJob->pRemaining && 1 == tfrg_atomic32_add_relaxed(pJob->pRemaining, -1))
+	{
+		pResourceLoader->mDecodeMutex.Acquire();
+		pResourceLoader->mDecodeMutex.Release();
+		pResourceLoader->mDecodeCond.WakeAll();
+	}
+}
+
+// Loads a geometry container written by the AssetPipeline. The compressed index data and vertex streams are read at once and
+// decoded in parallel. Streams that need no conversion are decoded straight into the upload memory
+static UploadFunctionResult loadGeometryContainer(
+	Renderer* pRenderer, GeometryLoadDesc* pDesc, bool stagingMemory, BufferUpdateDesc* pIndexUpdateDesc, BufferUpdateDesc* pVertexUpdateDescs)
 {
-	GeometryLoadDesc* pDesc = &pGeometryLoad.geomLoadDesc;
+	FileStream file = {};
+	if (!fsOpenStreamFromPath(RD_MESHES, pDesc->pFileName, FM_READ_BINARY, &file))
+	{
+		LOGF(eERROR, "Failed to open geometry file %s", pDesc->pFileName);
+		ASSERT(false);
+		return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+	}
+
+	GeometryFileHeader header = {};
+	fsReadFromStream(&file, &header, sizeof(header));
+	if (header.mMagic != GEOMETRY_FILE_MAGIC || header.mVersion != GEOMETRY_FILE_VERSION || header.mAttributeCount > MAX_VERTEX_ATTRIBS)
+	{
+		LOGF(eERROR, "Geometry file %s was not written by this version of the AssetPipeline", pDesc->pFileName);
+		ASSERT(false);
+		fsCloseStream(&file);
+		return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+	}
+
+	GeometryFileAttribute fileAttribs[MAX_VERTEX_ATTRIBS] = {};
+	fsReadFromStream(&file, fileAttribs, header.mAttributeCount * sizeof(GeometryFileAttribute));
+
+	const uint32_t indexCount = header.mIndexCount;
+	const uint32_t vertexCount = header.mVertexCount;
+	const uint32_t indexStride = header.mIndexStride;
+
+	// The compressed vertex streams follow the index data, in the order of the attributes
+	const GeometryFileAttribute* semanticAttribs[SEMANTIC_TEXCOORD9 + 1] = {};
+	uint32_t dataOffsets[SEMANTIC_TEXCOORD9 + 1] = {};
+	uint32_t dataSize = round_up(header.mIndexDataSize, 4);
+	for (uint32_t i = 0; i < header.mAttributeCount; ++i)
+	{
+		if (fileAttribs[i].mSemantic > SEMANTIC_TEXCOORD9)
+		{
+			LOGF(eERROR, "Geometry file %s has a vertex stream with unknown semantic %u", pDesc->pFileName, fileAttribs[i].mSemantic);
+			ASSERT(false);
+			fsCloseStream(&file);
+			return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+		}
+		semanticAttribs[fileAttribs[i].mSemantic] = &fileAttribs[i];
+		dataOffsets[fileAttribs[i].mSemantic] = dataSize;
+		dataSize += round_up(fileAttribs[i].mDataSize, 4);
+	}
+
+	// Determine vertex stride for each binding
+	uint32_t vertexStrides[MAX_VERTEX_BINDINGS] = {};
+	uint32_t vertexAttribCount[MAX_VERTEX_BINDINGS] = {};
+	PackingFunction vertexPacking[MAX_VERTEX_ATTRIBS] = {};
+	uint32_t vertexBufferCount = 0;
+	for (uint32_t i = 0; i < pDesc->pVertexLayout->mAttribCount; ++i)
+	{
+		const VertexAttrib* attr = &pDesc->pVertexLayout->mAttribs[i];
+		const GeometryFileAttribute* fileAttr = semanticAttribs[attr->mSemantic];
+		if (!fileAttr)
+		{
+			LOGF(eERROR, "Geometry file %s has no vertex stream with semantic %u", pDesc->pFileName, (uint32_t)attr->mSemantic);
+			ASSERT(false);
+			fsCloseStream(&file);
+			return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+		}
+
+		const TinyImageFormat srcFormat = (TinyImageFormat)fileAttr->mFormat;
+		const TinyImageFormat dstFormat = attr->mFormat == TinyImageFormat_UNDEFINED ? srcFormat : attr->mFormat;
+		const uint32_t dstFormatSize = TinyImageFormat_BitSizeOfBlock(dstFormat) >> 3;
 
+		vertexStrides[attr->mBinding] += dstFormatSize;
+		++vertexAttribCount[attr->mBinding];
+
+		if (dstFormat != srcFormat)
+		{
+			vertexPacking[i] = util_select_packing_function(attr->mSemantic, srcFormat, dstFormat);
+			ASSERT(vertexPacking[i] && "No packing function from the stored vertex format to the vertex layout format");
+		}
+	}
+
+	for (uint32_t i = 0; i < MAX_VERTEX_BINDINGS; ++i)
+		if (vertexStrides[i])
+			++vertexBufferCount;
+
+	uint32_t totalSize = 0;
+	totalSize += round_up(sizeof(Geometry), 16);
+	totalSize += round_up(header.mDrawCount * sizeof(IndirectDrawIndexArguments), 16);
+	totalSize += round_up(header.mMeshletCount * sizeof(Meshlet), 16);
+	totalSize += round_up(header.mDrawCount * sizeof(MeshletRange), 16);
+
+	Geometry* geom = (Geometry*)tf_calloc(1, totalSize);
+	ASSERT(geom);
+
+	geom->pDrawArgs = (IndirectDrawIndexArguments*)(geom + 1);
+	geom->pMeshlets = (Meshlet*)((uint8_t*)geom->pDrawArgs + round_up(header.mDrawCount * sizeof(*geom->pDrawArgs), 16));
+	geom->pDrawMeshlets = header.mMeshletCount
+		? (MeshletRange*)((uint8_t*)geom->pMeshlets + round_up(header.mMeshletCount * sizeof(*geom->pMeshlets), 16))
+		: NULL;
+
+	geom->mVertexBufferCount = vertexBufferCount;
+	geom->mDrawArgCount = header.mDrawCount;
+	geom->mIndexCount = indexCount;
+	geom->mVertexCount = vertexCount;
+	geom->mMeshletCount = header.mMeshletCount;
+	geom->mIndexType = (sizeof(uint16_t) == indexStride) ? INDEX_TYPE_UINT16 : INDEX_TYPE_UINT32;
+
+	// Draw arguments and meshlets
+	GeometryFileDraw* draws = (GeometryFileDraw*)tf_malloc(header.mDrawCount * sizeof(GeometryFileDraw));
+	fsReadFromStream(&file, draws, header.mDrawCount * sizeof(GeometryFileDraw));
+	for (uint32_t i = 0; i < header.mDrawCount; ++i)
+	{
+		geom->pDrawArgs[i].mIndexCount = draws[i].mIndexCount;
+		geom->pDrawArgs[i].mInstanceCount = 1;
+		geom->pDrawArgs[i].mStartIndex = draws[i].mStartIndex;
+		geom->pDrawArgs[i].mStartInstance = 0;
+		geom->pDrawArgs[i].mVertexOffset = 0;
+
+		if (geom->pDrawMeshlets)
+		{
+			geom->pDrawMeshlets[i].mStartMeshlet = draws[i].mStartMeshlet;
+			geom->pDrawMeshlets[i].mMeshletCount = draws[i].mMeshletCount;
+		}
+	}
+	tf_free(draws);
+
+	fsReadFromStream(&file, geom->pMeshlets, header.mMeshletCount * sizeof(Meshlet));
+
+	// All the compressed data in one read
+	uint8_t* data = (uint8_t*)tf_malloc(dataSize);
+	fsReadFromStream(&file, data, dataSize);
+	fsCloseStream(&file);
+
+	const GeometryFileAttribute* positionAttr = semanticAttribs[SEMANTIC_POSITION];
+	if (pDesc->mFlags & GEOMETRY_LOAD_FLAG_SHADOWED)
+	{
+		ASSERT(positionAttr);
+		uint32_t shadowSize = indexCount * indexStride + positionAttr->mStride * vertexCount;
+
+		geom->pShadow = (Geometry::ShadowData*)tf_calloc(1, sizeof(Geometry::ShadowData) + shadowSize);
+		geom->pShadow->pIndices = geom->pShadow + 1;
+		geom->pShadow->pAttributes[SEMANTIC_POSITION] = (uint8_t*)geom->pShadow->pIndices + (indexCount * indexStride);
+	}
+
+	BufferUpdateDesc& indexUpdateDesc = *pIndexUpdateDesc;
+	BufferUpdateDesc* vertexUpdateDesc = pVertexUpdateDescs;
+	addGeometryBuffers(pRenderer, pDesc, geom, indexStride, vertexStrides, stagingMemory, &indexUpdateDesc, vertexUpdateDesc);
+
+	// One job for the indices and one for every attribute of the vertex layout
+	GeometryDecodeJob jobs[MAX_VERTEX_ATTRIBS + 1] = {};
+	uint32_t jobCount = 0;
+
+	// Indices are decoded exactly as the index buffer expects them
+	GeometryDecodeJob* indexJob = &jobs[jobCount++];
+	indexJob->pSrc = data;
+	indexJob->mSrcSize = header.mIndexDataSize;
+	indexJob->mCount = indexCount;
+	indexJob->mStride = indexStride;
+	indexJob->mIndices = true;
+	indexJob->pDst = (uint8_t*)indexUpdateDesc.pMappedData;
+	indexJob->pDecoded = geom->pShadow ? (uint8_t*)geom->pShadow->pIndices : indexJob->pDst;
+
+	for (uint32_t i = 0; i < pDesc->pVertexLayout->mAttribCount; ++i)
+	{
+		const VertexAttrib* attr = &pDesc->pVertexLayout->mAttribs[i];
+		const GeometryFileAttribute* fileAttr = semanticAttribs[attr->mSemantic];
+		const uint32_t binding = attr->mBinding;
+		const bool interleaved = vertexAttribCount[binding] > 1;
+
+		GeometryDecodeJob* job = &jobs[jobCount++];
+		job->pSrc = data + dataOffsets[attr->mSemantic];
+		job->mSrcSize = fileAttr->mDataSize;
+		job->mCount = vertexCount;
+		job->mStride = fileAttr->mStride;
+		job->pDst = (uint8_t*)vertexUpdateDesc[binding].pMappedData;
+		job->mDstStride = vertexStrides[binding];
+		job->mDstOffset = interleaved ? attr->mOffset : 0;
+		job->mInterleaved = interleaved;
+		job->pPacking = vertexPacking[i];
+
+		if (geom->pShadow && SEMANTIC_POSITION == attr->mSemantic)
+			job->pDecoded = (uint8_t*)geom->pShadow->pAttributes[SEMANTIC_POSITION];
+		else if (!interleaved && !vertexPacking[i])
+			// Not interleaved with any other attribute and already in the right format, decode straight into the buffer
+			job->pDecoded = job->pDst;
+	}
+
+	ThreadSystem* pThreadSystem = pResourceLoader->pDecodeThreadSystem;
+	if (pThreadSystem && jobCount > 1)
+	{
+		// Other loads share the decode threads, so only the jobs of this load are waited for
+		tfrg_atomic32_t remaining = jobCount;
+		for (uint32_t i = 0; i < jobCount; ++i)
+			jobs[i].pRemaining = &remaining;
+
+		addThreadSystemRangeTask(pThreadSystem, decodeGeometryStream, jobs, jobCount);
+		// Decode on this thread as well instead of only waiting for the decode threads
+		while (tfrg_atomic32_load_acquire(&remaining) && assistThreadSystem(pThreadSystem))
+			;
+		if (tfrg_atomic32_load_acquire(&remaining))
+		{
+			MutexLock lock(pResourceLoader->mDecodeMutex);
+			while (tfrg_atomic32_load_acquire(&remaining))
+				pResourceLoader->mDecodeCond.Wait(pResourceLoader->mDecodeMutex);
+		}
+	}
+	else
+	{
+		for (uint32_t i = 0; i < jobCount; ++i)
+			decodeGeometryStream(jobs, i);
+	}
+
+	tf_free(data);
+
+	for (uint32_t i = 0; i < jobCount; ++i)
+	{
+		if (jobs[i].mResult)
+		{
+			LOGF(eERROR, "Geometry file %s is corrupted, failed to decode stream %u (error %d)", pDesc->pFileName, i, jobs[i].mResult);
+			ASSERT(false);
+
+			removeGeometryBuffers(pRenderer, geom, stagingMemory, pIndexUpdateDesc, pVertexUpdateDescs);
+			tf_free(geom->pShadow);
+			tf_free(geom);
+			tf_free(pDesc->pVertexLayout);
+			return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+		}
+	}
+
+	tf_free(pDesc->pVertexLayout);
+
+	*pDesc->ppGeometry = geom;
+
+	return UPLOAD_FUNCTION_RESULT_COMPLETED;
+}
+
+// CPU side of a geometry load. Parses the geometry file, creates its buffers and fills the memory the buffers are uploaded from
+static UploadFunctionResult prepareGeometry(
+	Renderer* pRenderer, GeometryLoadDesc* pDesc, bool stagingMemory, BufferUpdateDesc* pIndexUpdateDesc, BufferUpdateDesc* pVertexUpdateDescs)
+{
 	char iext[FS_MAX_PATH] = { 0 };
 	fsGetPathExtension(pDesc->pFileName, iext);
 
+	// Geometry in container written by the AssetPipeline
+	if (iext[0] != 0 && _stricmp(iext, GEOMETRY_FILE_EXTENSION) == 0)
+		return loadGeometryContainer(pRenderer, pDesc, stagingMemory, pIndexUpdateDesc, pVertexUpdateDescs);
+
 	// Geometry in gltf container
 	if (iext[0] != 0 && (_stricmp(iext, "gltf") == 0 || _stricmp(iext, "glb") == 0))
 	{
@@ -1122,8 +1555,6 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 			return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
 		}
 
-		typedef void (*PackingFunction)(uint32_t count, uint32_t stride, uint32_t offset, const uint8_t* src, uint8_t* dst);
-
 		uint32_t vertexStrides[SEMANTIC_TEXCOORD9 + 1] = {};
 		uint32_t vertexAttribCount[SEMANTIC_TEXCOORD9 + 1] = {};
 		uint32_t vertexOffsets[SEMANTIC_TEXCOORD9 + 1] = {};
@@ -1171,37 +1602,12 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 			++vertexAttribCount[attr->mBinding];
 
 			// Compare vertex attrib format to the gltf attrib type
-			// Select a packing function if dst format is packed version
-			// Texcoords - Pack float2 to half2
-			// Directions - Pack float3 to float2 to unorm2x16 (Normal, Tangent)
-			// Position - No packing yet
+			// Select appropriate packing function which will be used when filling the vertex buffer
 			const TinyImageFormat srcFormat = util_cgltf_type_to_image_format(cgltfAttr->data->type, cgltfAttr->data->component_type);
 			const TinyImageFormat dstFormat = attr->mFormat == TinyImageFormat_UNDEFINED ? srcFormat : attr->mFormat;
 
 			if (dstFormat != srcFormat)
-			{
-				// Select appropriate packing function which will be used when filling the vertex buffer
-				switch (cgltfAttr->type)
-				{
-				case cgltf_attribute_type_texcoord:
-				{
-					if (sizeof(uint32_t) == dstFormatSize && sizeof(float[2]) == srcFormatSize)
-						vertexPacking[attr->mSemantic] = util_pack_float2_to_half2;
-					// #TODO: Add more variations if needed
-					break;
-				}
-				case cgltf_attribute_type_normal:
-				case cgltf_attribute_type_tangent:
-				{
-					if (sizeof(uint32_t) == dstFormatSize && (sizeof(float[3]) == srcFormatSize || sizeof(float[4]) == srcFormatSize))
-						vertexPacking[attr->mSemantic] = util_pack_float3_direction_to_half2;
-					// #TODO: Add more variations if needed
-					break;
-				}
-				default:
-					break;
-				}
-			}
+				vertexPacking[attr->mSemantic] = util_select_packing_function(attr->mSemantic, srcFormat, dstFormat);
 		}
 
 		// Determine number of vertex buffers needed based on number of unique bindings found
@@ -1250,62 +1656,9 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 		geom->mIndexType = (sizeof(uint16_t) == indexStride) ? INDEX_TYPE_UINT16 : INDEX_TYPE_UINT32;
 		geom->mJointCount = jointCount;
 
-		// Allocate buffer memory
-		const bool structuredBuffers = (pDesc->mFlags & GEOMETRY_LOAD_FLAG_STRUCTURED_BUFFERS);
-
-		// Index buffer
-		BufferDesc indexBufferDesc = {};
-		indexBufferDesc.mDescriptors = DESCRIPTOR_TYPE_INDEX_BUFFER |
-			(structuredBuffers ?
-			(DESCRIPTOR_TYPE_BUFFER | DESCRIPTOR_TYPE_RW_BUFFER) :
-				(DESCRIPTOR_TYPE_BUFFER_RAW | DESCRIPTOR_TYPE_RW_BUFFER_RAW));
-		indexBufferDesc.mSize = indexStride * indexCount;
-		indexBufferDesc.mElementCount = indexBufferDesc.mSize / (structuredBuffers ? indexStride : sizeof(uint32_t));
-		indexBufferDesc.mStructStride = indexStride;
-		indexBufferDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_GPU_ONLY;
-		addBuffer(pRenderer, &indexBufferDesc, &geom->pIndexBuffer);
-
-		BufferUpdateDesc indexUpdateDesc = {};
-		BufferUpdateDesc vertexUpdateDesc[MAX_VERTEX_BINDINGS] = {};
-
-		indexUpdateDesc.mSize = indexCount * indexStride;
-		indexUpdateDesc.pBuffer = geom->pIndexBuffer;
-#if UMA
-		indexUpdateDesc.mInternal.mMappedRange = { (uint8_t*)geom->pIndexBuffer->pCpuMappedAddress };
-#else
-		indexUpdateDesc.mInternal.mMappedRange = allocateStagingMemory(indexUpdateDesc.mSize, RESOURCE_BUFFER_ALIGNMENT);
-#endif
-		indexUpdateDesc.pMappedData = indexUpdateDesc.mInternal.mMappedRange.pData;
-
-		uint32_t bufferCounter = 0;
-		for (uint32_t i = 0; i < MAX_VERTEX_BINDINGS; ++i)
-		{
-			if (!vertexStrides[i])
-				continue;
-
-			BufferDesc vertexBufferDesc = {};
-			vertexBufferDesc.mDescriptors = DESCRIPTOR_TYPE_VERTEX_BUFFER |
-				(structuredBuffers ?
-				(DESCRIPTOR_TYPE_BUFFER | DESCRIPTOR_TYPE_RW_BUFFER) :
-					(DESCRIPTOR_TYPE_BUFFER_RAW | DESCRIPTOR_TYPE_RW_BUFFER_RAW));
-			vertexBufferDesc.mSize = vertexStrides[i] * vertexCount;
-			vertexBufferDesc.mElementCount = vertexBufferDesc.mSize / (structuredBuffers ? vertexStrides[i] : sizeof(uint32_t));
-			vertexBufferDesc.mStructStride = vertexStrides[i];
-			vertexBufferDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_GPU_ONLY;
-			addBuffer(pRenderer, &vertexBufferDesc, &geom->pVertexBuffers[bufferCounter]);
-
-			geom->mVertexStrides[bufferCounter] = vertexStrides[i];
-
-			vertexUpdateDesc[i].pBuffer = geom->pVertexBuffers[bufferCounter];
-			vertexUpdateDesc[i].mSize = vertexBufferDesc.mSize;
-#if UMA
-			vertexUpdateDesc[i].mInternal.mMappedRange = { (uint8_t*)geom->pVertexBuffers[bufferCounter]->pCpuMappedAddress, 0 };
-#else
-			vertexUpdateDesc[i].mInternal.mMappedRange = allocateStagingMemory(vertexUpdateDesc[i].mSize, RESOURCE_BUFFER_ALIGNMENT);
-#endif
-			vertexUpdateDesc[i].pMappedData = vertexUpdateDesc[i].mInternal.mMappedRange.pData;
-			++bufferCounter;
-		}
+		BufferUpdateDesc& indexUpdateDesc = *pIndexUpdateDesc;
+		BufferUpdateDesc* vertexUpdateDesc = pVertexUpdateDescs;
+		addGeometryBuffers(pRenderer, pDesc, geom, indexStride, vertexStrides, stagingMemory, &indexUpdateDesc, vertexUpdateDesc);
 
 		indexCount = 0;
 		vertexCount = 0;
@@ -1352,7 +1705,7 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 						{
 							uint8_t* dst = (uint8_t*)vertexUpdateDesc[binding].pMappedData + vertexCount * stride;
 							if (vertexPacking[index])
-								vertexPacking[index]((uint32_t)attr->data->count, (uint32_t)attr->data->stride, 0, src, dst);
+								vertexPacking[index]((uint32_t)attr->data->count, (uint32_t)attr->data->stride, stride, 0, src, dst);
 							else
 								memcpy(dst, src, attr->data->count * attr->data->stride);
 						}
@@ -1363,7 +1716,7 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 							// Example:
 							// [ POSITION | NORMAL | TEXCOORD ] => [ 0 | 12 | 24 ], [ 32 | 44 | 52 ], ... (vertex stride of 32 => 12 + 12 + 8)
 							if (vertexPacking[index])
-								vertexPacking[index]((uint32_t)attr->data->count, (uint32_t)attr->data->stride, offset, src, dst);
+								vertexPacking[index]((uint32_t)attr->data->count, (uint32_t)attr->data->stride, stride, offset, src, dst);
 							else
 								for (uint32_t e = 0; e < attr->data->count; ++e)
 									memcpy(dst + e * stride + offset, src + e * attr->data->stride, attr->data->stride);
@@ -1388,19 +1741,6 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 			}
 		}
 
-		UploadFunctionResult uploadResult = UPLOAD_FUNCTION_RESULT_COMPLETED;
-#if !UMA
-		uploadResult = updateBuffer(pRenderer, pCopyEngine, activeSet, indexUpdateDesc);
-
-		for (uint32_t i = 0; i < MAX_VERTEX_BINDINGS; ++i)
-		{
-			if (vertexUpdateDesc[i].pMappedData)
-			{
-				uploadResult = updateBuffer(pRenderer, pCopyEngine, activeSet, vertexUpdateDesc[i]);
-			}
-		}
-#endif
-
 		// Load the remap joint indices generated in the offline process
 		uint32_t remapCount = 0;
 		for (uint32_t i = 0; i < data->skins_count; ++i)
@@ -1486,11 +1826,87 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 
 		*pDesc->ppGeometry = geom;
 
-		return uploadResult;
+		return UPLOAD_FUNCTION_RESULT_COMPLETED;
 	}
 
 	return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
 }
+
+static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, UpdateRequest& pGeometryLoad)
+{
+	BufferUpdateDesc indexUpdateDesc = {};
+	BufferUpdateDesc vertexUpdateDesc[MAX_VERTEX_BINDINGS] = {};
+	UploadFunctionResult result = prepareGeometry(pRenderer, &pGeometryLoad.geomLoadDesc, true, &indexUpdateDesc, vertexUpdateDesc);
+	if (UPLOAD_FUNCTION_RESULT_COMPLETED != result)
+		return result;
+
+	return uploadGeometryBuffers(pRenderer, pCopyEngine, activeSet, indexUpdateDesc, vertexUpdateDesc);
+}
+// Texture or geometry load whose CPU side runs on the load threads while the streamer thread records the copies of earlier requests
+struct PreparedLoad
+{
+	UpdateRequest*            pRequest;
+	UploadFunctionResult      mResult;
+	TextureUpdateDescInternal mTextureUpdateDesc;
+	BufferUpdateDesc          mIndexUpdateDesc;
+	BufferUpdateDesc          mVertexUpdateDescs[MAX_VERTEX_BINDINGS];
+	tfrg_atomic32_t           mDone;
+};
+
+static bool isPreparable(const UpdateRequest& request)
+{
+	if (UPDATE_REQUEST_LOAD_GEOMETRY == request.mType)
+		return true;
+	// Sparse textures record commands while they are created
+	return UPDATE_REQUEST_LOAD_TEXTURE == request.mType && TEXTURE_CONTAINER_SVT != request.texLoadDesc.mContainer;
+}
+
+static void prepareLoad(void* pUser, uintptr_t index)
+{
+	PreparedLoad* pLoad = (PreparedLoad*)pUser + index;
+	UpdateRequest& request = *pLoad->pRequest;
+	Renderer* pRenderer = pResourceLoader->pRenderer;
+
+	if (UPDATE_REQUEST_LOAD_TEXTURE == request.mType)
+		pLoad->mResult = prepareTexture(pRenderer, &request.texLoadDesc, true, &pLoad->mTextureUpdateDesc);
+	else
+		pLoad->mResult = prepareGeometry(pRenderer, &request.geomLoadDesc, false, &pLoad->mIndexUpdateDesc, pLoad->mVertexUpdateDescs);
+
+	pResourceLoader->mPreparedLoadMutex.Acquire();
+	tfrg_atomic32_store_release(&pLoad->mDone, 1);
+	pResourceLoader->mPreparedLoadMutex.Release();
+	pResourceLoader->mPreparedLoadCond.WakeAll();
+}
+
+// Records the copies of a load prepared on the load threads. Called in request order on the streamer thread
+static UploadFunctionResult uploadPreparedLoad(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, PreparedLoad* pLoad)
+{
+	// Help the load threads while there are loads left to start, then sleep until the thread preparing this one is done
+	while (!tfrg_atomic32_load_acquire(&pLoad->mDone) && assistThreadSystem(pResourceLoader->pLoadThreadSystem))
+		;
+	if (!tfrg_atomic32_load_acquire(&pLoad->mDone))
+	{
+		MutexLock lock(pResourceLoader->mPreparedLoadMutex);
+		while (!tfrg_atomic32_load_acquire(&pLoad->mDone))
+			pResourceLoader->mPreparedLoadCond.Wait(pResourceLoader->mPreparedLoadMutex);
+	}
+
+	if (UPLOAD_FUNCTION_RESULT_COMPLETED != pLoad->mResult)
+		return pLoad->mResult;
+
+	if (UPDATE_REQUEST_LOAD_TEXTURE == pLoad->pRequest->mType)
+	{
+		if (!pLoad->mTextureUpdateDesc.pTexture)
+			return UPLOAD_FUNCTION_RESULT_COMPLETED;
+		return updateTexture(pRenderer, pCopyEngine, activeSet, pLoad->mTextureUpdateDesc);
+	}
+
+#if !UMA
+	stageGeometryBuffers(&pLoad->mIndexUpdateDesc, pLoad->mVertexUpdateDescs);
+#endif
+	return uploadGeometryBuffers(pRenderer, pCopyEngine, activeSet, pLoad->mIndexUpdateDesc, pLoad->mVertexUpdateDescs);
+}
+
 /************************************************************************/
 // Internal Resource Loader Implementation
 /************************************************************************/
@@ -1564,11 +1980,35 @@ static void streamerThreadFunc(void* pThreadData)
 			eastl::swap(requestQueue, activeQueue);
 			pLoader->mQueueMutex.Release();
 
-			size_t requestCount = activeQueue.size();
+			size_t requestCount = activeQueue.size();
+
+			// Texture and geometry loads are parsed, transcoded and packed on the load threads ahead of the streamer thread.
+			// Their copies are still recorded here in request order so the tokens complete in the same order as before
+			PreparedLoad* pPreparedLoads = NULL;
+			uint32_t preparedCount = 0;
+			uint32_t nextPreparedLoad = 0;
+			if (pLoader->pLoadThreadSystem)
+			{
+				for (size_t j = 0; j < requestCount; ++j)
+					if (isPreparable(activeQueue[j]))
+						++preparedCount;
+
+				if (preparedCount)
+				{
+					pPreparedLoads = (PreparedLoad*)tf_calloc(preparedCount, sizeof(PreparedLoad));
+					for (size_t j = 0, k = 0; j < requestCount; ++j)
+						if (isPreparable(activeQueue[j]))
+							pPreparedLoads[k++].pRequest = &activeQueue[j];
+
+					addThreadSystemRangeTask(pLoader->pLoadThreadSystem, prepareLoad, pPreparedLoads, preparedCount);
+				}
+			}
 
 			for (size_t j = 0; j < requestCount; ++j)
 			{
 				UpdateRequest updateState = activeQueue[j];
+				PreparedLoad* pPreparedLoad = (nextPreparedLoad < preparedCount && pPreparedLoads[nextPreparedLoad].pRequest == &activeQueue[j])
+					? &pPreparedLoads[nextPreparedLoad++] : NULL;
 
 				UploadFunctionResult result = UPLOAD_FUNCTION_RESULT_COMPLETED;
 				switch (updateState.mType)
@@ -1588,10 +2028,12 @@ static void streamerThreadFunc(void* pThreadData)
 					result = UPLOAD_FUNCTION_RESULT_COMPLETED;
 					break;
 				case UPDATE_REQUEST_LOAD_TEXTURE:
-					result = loadTexture(pLoader->pRenderer, &copyEngine, pLoader->mNextSet, updateState);
+					result = pPreparedLoad ? uploadPreparedLoad(pLoader->pRenderer, &copyEngine, pLoader->mNextSet, pPreparedLoad)
+										   : loadTexture(pLoader->pRenderer, &copyEngine, pLoader->mNextSet, updateState);
 					break;
 				case UPDATE_REQUEST_LOAD_GEOMETRY:
-					result = loadGeometry(pLoader->pRenderer, &copyEngine, pLoader->mNextSet, updateState);
+					result = pPreparedLoad ? uploadPreparedLoad(pLoader->pRenderer, &copyEngine, pLoader->mNextSet, pPreparedLoad)
+										   : loadGeometry(pLoader->pRenderer, &copyEngine, pLoader->mNextSet, updateState);
 					break;
 				case UPDATE_REQUEST_INVALID:
 					break;
@@ -1616,6 +2058,13 @@ static void streamerThreadFunc(void* pThreadData)
 				ASSERT(result != UPLOAD_FUNCTION_RESULT_STAGING_BUFFER_FULL);
 			}
 
+			if (pPreparedLoads)
+			{
+				// Every load was waited for above, this only makes sure no load thread still touches the array
+				waitThreadSystemIdle(pLoader->pLoadThreadSystem);
+				tf_free(pPreparedLoads);
+			}
+
 			if (completionMask != 0)
 			{
 				for (uint32_t nodeIndex = 0; nodeIndex < linkedGPUCount; ++nodeIndex)
@@ -1649,6 +2098,8 @@ static void addResourceLoader(Renderer* pRenderer, ResourceLoaderDesc* pDesc, Re
 	pLoader->mRun = true;
 	pLoader->mDesc = pDesc ? *pDesc : gDefaultResourceLoaderDesc;
 
+	util_init_packing_functions();
+
 	pLoader->mQueueMutex.Init();
 	pLoader->mTokenMutex.Init();
 	pLoader->mQueueCond.Init();
@@ -1663,6 +2114,18 @@ static void addResourceLoader(Renderer* pRenderer, ResourceLoaderDesc* pDesc, Re
 		setupCopyEngine(pLoader->pRenderer, &pLoader->pCopyEngines[i], i, pLoader->mDesc.mBufferSize, pLoader->mDesc.mBufferCount);
 	}
 
+	pLoader->pDecodeThreadSystem = NULL;
+	if (pLoader->mDesc.mDecodeThreadCount)
+		initThreadSystem(&pLoader->pDecodeThreadSystem, pLoader->mDesc.mDecodeThreadCount, 0, true, "ResourceLoaderDecode");
+
+	pLoader->pLoadThreadSystem = NULL;
+	if (pLoader->mDesc.mLoadThreadCount)
+		initThreadSystem(&pLoader->pLoadThreadSystem, pLoader->mDesc.mLoadThreadCount, 0, true, "ResourceLoaderLoad");
+	pLoader->mPreparedLoadMutex.Init();
+	pLoader->mPreparedLoadCond.Init();
+	pLoader->mDecodeMutex.Init();
+	pLoader->mDecodeCond.Init();
+
 	pLoader->mThreadDesc.pFunc = streamerThreadFunc;
 	pLoader->mThreadDesc.pData = pLoader;
 
@@ -1683,6 +2146,14 @@ static void removeResourceLoader(ResourceLoader* pLoader)
 	pLoader->mRun = false;
 	pLoader->mQueueCond.WakeOne();
 	destroy_thread(pLoader->mThread);
+	if (pLoader->pLoadThreadSystem)
+		shutdownThreadSystem(pLoader->pLoadThreadSystem);
+	if (pLoader->pDecodeThreadSystem)
+		shutdownThreadSystem(pLoader->pDecodeThreadSystem);
+	pLoader->mDecodeCond.Destroy();
+	pLoader->mDecodeMutex.Destroy();
+	pLoader->mPreparedLoadCond.Destroy();
+	pLoader->mPreparedLoadMutex.Destroy();
 	pLoader->mQueueCond.Destroy();
 	pLoader->mTokenCond.Destroy();
 	pLoader->mQueueMutex.Destroy();
@@ -1794,17 +2265,38 @@ static void waitForToken(ResourceLoader* pLoader, const SyncToken* token)
 /************************************************************************/
 // Resource Loader Interfae Implementation
 /************************************************************************/
+#if !defined(NX64)
+static void load_shader_dependencies();
+static void save_shader_dependencies();
+#endif
+#if defined(ENABLE_SHADER_PACK)
+static void load_shader_pack();
+static void save_shader_pack();
+#endif
+
 void initResourceLoaderInterface(Renderer* pRenderer, ResourceLoaderDesc* pDesc)
 {
 #ifdef DIRECT3D11
 	gContextLock.Init();
 #endif
 	addResourceLoader(pRenderer, pDesc, &pResourceLoader);
+#if !defined(NX64)
+	load_shader_dependencies();
+#endif
+#if defined(ENABLE_SHADER_PACK)
+	load_shader_pack();
+#endif
 }
 
 void exitResourceLoaderInterface(Renderer* pRenderer)
 {
 	removeResourceLoader(pResourceLoader);
+#if !defined(NX64)
+	save_shader_dependencies();
+#endif
+#if defined(ENABLE_SHADER_PACK)
+	save_shader_pack();
+#endif
 #ifdef DIRECT3D11
 	gContextLock.Destroy();
 #endif
@@ -2002,9 +2494,22 @@ void beginUpdateResource(TextureUpdateDesc* pTextureUpdate)
 	const TinyImageFormat fmt = (TinyImageFormat)texture->mFormat;
 	const uint32_t alignment = util_get_texture_subresource_alignment(pResourceLoader->pRenderer, fmt);
 
+	uint32_t width = MIP_REDUCE(texture->mWidth, pTextureUpdate->mMipLevel);
+	uint32_t height = MIP_REDUCE(texture->mHeight, pTextureUpdate->mMipLevel);
+	uint32_t depth = MIP_REDUCE(texture->mDepth, pTextureUpdate->mMipLevel);
+	if (pTextureUpdate->mRegionWidth && pTextureUpdate->mRegionHeight)
+	{
+		ASSERT(depth == 1 && "Region updates are only supported for 2D textures");
+		ASSERT(TinyImageFormat_WidthOfBlock(fmt) == 1 && TinyImageFormat_HeightOfBlock(fmt) == 1 && "Region updates do not support block compressed formats");
+		ASSERT(pTextureUpdate->mRegionX + pTextureUpdate->mRegionWidth <= width);
+		ASSERT(pTextureUpdate->mRegionY + pTextureUpdate->mRegionHeight <= height);
+		width = pTextureUpdate->mRegionWidth;
+		height = pTextureUpdate->mRegionHeight;
+	}
+
 	bool success = util_get_surface_info(
-		MIP_REDUCE(texture->mWidth, pTextureUpdate->mMipLevel),
-		MIP_REDUCE(texture->mHeight, pTextureUpdate->mMipLevel),
+		width,
+		height,
 		fmt,
 		&pTextureUpdate->mSrcSliceStride,
 		&pTextureUpdate->mSrcRowStride,
@@ -2015,9 +2520,7 @@ void beginUpdateResource(TextureUpdateDesc* pTextureUpdate)
 	pTextureUpdate->mDstRowStride = round_up(pTextureUpdate->mSrcRowStride, util_get_texture_row_alignment(pResourceLoader->pRenderer));
 	pTextureUpdate->mDstSliceStride = round_up(pTextureUpdate->mDstRowStride * pTextureUpdate->mRowCount, alignment);
 
-	const ssize_t requiredSize = round_up(
-		MIP_REDUCE(texture->mDepth, pTextureUpdate->mMipLevel) * pTextureUpdate->mDstRowStride * pTextureUpdate->mRowCount,
-		alignment);
+	const ssize_t requiredSize = round_up(depth * pTextureUpdate->mDstRowStride * pTextureUpdate->mRowCount, alignment);
 
 	// We need to use a staging buffer.
 	pTextureUpdate->mInternal.mMappedRange = allocateUploadMemory(pResourceLoader->pRenderer, requiredSize, alignment);
@@ -2034,6 +2537,13 @@ void endUpdateResource(TextureUpdateDesc* pTextureUpdate, SyncToken* token)
 	desc.mMipLevels = 1;
 	desc.mBaseArrayLayer = pTextureUpdate->mArrayLayer;
 	desc.mLayerCount = 1;
+	if (pTextureUpdate->mRegionWidth && pTextureUpdate->mRegionHeight)
+	{
+		desc.mRegionX = pTextureUpdate->mRegionX;
+		desc.mRegionY = pTextureUpdate->mRegionY;
+		desc.mRegionWidth = pTextureUpdate->mRegionWidth;
+		desc.mRegionHeight = pTextureUpdate->mRegionHeight;
+	}
 	queueTextureUpdate(pResourceLoader, &desc, token);
 
 	// Restore the state to before the beginUpdateResource call.
@@ -2358,37 +2868,59 @@ extern bool prospero_compileShader(
 	const char* pEntryPoint);
 #endif
 
-static eastl::string fsReadFromStreamSTLLine(FileStream* stream)
+// Reads the next line of any length, returns false at the end of the stream
+static bool fsReaderReadSTLLine(FileStreamReader* pReader, eastl::string& outLine)
+{
+	char    chunk[256];
+	bool    partial = false;
+	ssize_t length = fsReaderReadLine(pReader, chunk, sizeof(chunk), &partial);
+	if (length < 0)
+		return false;
+
+	outLine.assign(chunk, chunk + length);
+	while (partial && (length = fsReaderReadLine(pReader, chunk, sizeof(chunk), &partial)) >= 0)
+		outLine.append(chunk, chunk + length);
+
+	return true;
+}
+
+#if !defined(NX64)
+// Returns the file name of the quoted #include directive on this line, if the line has one that is not commented out
+static bool util_get_include_file_name(const eastl::string& line, eastl::string& outFileName)
 {
-	eastl::string result;
+	const eastl::string pIncludeDirective = "#include";
+	size_t        filePos = line.find(pIncludeDirective, 0);
+	const size_t  commentPosCpp = line.find("//", 0);
+	const size_t  commentPosC = line.find("/*", 0);
+
+	const bool bLineHasIncludeDirective = filePos != eastl::string::npos;
+	const bool bLineIsCommentedOut = (commentPosCpp != eastl::string::npos && commentPosCpp < filePos) ||
+		(commentPosC != eastl::string::npos && commentPosC < filePos);
+
+	if (!bLineHasIncludeDirective || bLineIsCommentedOut)
+		return false;
+
+	// get the include file name
+	size_t currentPos = filePos + pIncludeDirective.length();
+	while (currentPos < line.size() && line.at(currentPos++) == ' ')
+		;    // skip empty spaces
+	if (currentPos >= line.size())
+		return false;
+	if (line.at(currentPos - 1) != '\"')
+		return false;
 
-	while (!fsStreamAtEnd(stream))
+	// read char by char until we have the include file name
+	outFileName.clear();
+	while (currentPos < line.size() && line.at(currentPos) != '\"')
 	{
-		char nextChar = 0;
-		fsReadFromStream(stream, &nextChar, sizeof(nextChar));
-		if (nextChar == 0 || nextChar == '\n')
-		{
-			break;
-		}
-		if (nextChar == '\r')
-		{
-			char newLine = 0;
-			fsReadFromStream(stream, &newLine, sizeof(newLine));
-			if (newLine == '\n')
-			{
-				break;
-			}
-			else
-			{
-				// We're not looking at a "\r\n" sequence, so add the '\r' to the buffer.
-				fsSeekStream(stream, SBO_CURRENT_POSITION, -1);
-			}
-		}
-		result.push_back(nextChar);
+		outFileName.push_back(line.at(currentPos));
+		++currentPos;
 	}
 
-	return result;
+	// disregard brackets
+	return !outFileName.empty() && outFileName.at(0) != '<';
 }
+#endif
 
 // Function to generate the timestamp of this shader source file considering all include file timestamp
 #if !defined(NX64)
@@ -2407,48 +2939,21 @@ static bool process_source_file(const char* pAppName, FileStream* original, cons
 		return true; // The source file is missing, but we may still be able to use the shader binary.
 	}
 
+	FileStreamReader reader = {};
+	if (!fsInitStreamReader(file, 0, NULL, &reader))
+		return false;
+
 	const eastl::string pIncludeDirective = "#include";
-	while (!fsStreamAtEnd(file))
+	eastl::string       line;
+	while (fsReaderReadSTLLine(&reader, line))
 	{
-		eastl::string line = fsReadFromStreamSTLLine(file);
-
-		size_t        filePos = line.find(pIncludeDirective, 0);
-		const size_t  commentPosCpp = line.find("//", 0);
-		const size_t  commentPosC = line.find("/*", 0);
 
 		// if we have an "#include \"" in our current line
-		const bool bLineHasIncludeDirective = filePos != eastl::string::npos;
-		const bool bLineIsCommentedOut = (commentPosCpp != eastl::string::npos && commentPosCpp < filePos) ||
-			(commentPosC != eastl::string::npos && commentPosC < filePos);
-
-		if (bLineHasIncludeDirective && !bLineIsCommentedOut)
-		{
-			// get the include file name
-			size_t        currentPos = filePos + pIncludeDirective.length();
-			eastl::string fileName;
-			while (line.at(currentPos++) == ' ')
-				;    // skip empty spaces
-			if (currentPos >= line.size())
-				continue;
-			if (line.at(currentPos - 1) != '\"')
-				continue;
-			else
-			{
-				// read char by char until we have the include file name
-				while (line.at(currentPos) != '\"')
-				{
-					fileName.push_back(line.at(currentPos));
-					++currentPos;
-				}
-			}
-
-			// get the include file path
-			//TODO: Remove Comments
-
-			if (fileName.at(0) == '<')    // disregard bracketsauthop
-				continue;
-
+		const bool bLineHasIncludeDirective = line.find(pIncludeDirective, 0) != eastl::string::npos;
 
+		eastl::string fileName;
+		if (bLineHasIncludeDirective && util_get_include_file_name(line, fileName))
+		{
 			// open the include file
 			FileStream fHandle = {};
 			char includePath[FS_MAX_PATH] = {};
@@ -2467,6 +2972,7 @@ static bool process_source_file(const char* pAppName, FileStream* original, cons
 			if (!process_source_file(pAppName, original, includePath, &fHandle, outTimeStamp, outCode))
 			{
 				fsCloseStream(&fHandle);
+				fsExitStreamReader(&reader);
 				return false;
 			}
 
@@ -2497,8 +3003,404 @@ static bool process_source_file(const char* pAppName, FileStream* original, cons
 #endif
 	}
 
+	fsExitStreamReader(&reader);
+	return true;
+}
+#endif
+
+#if !defined(NX64)
+/************************************************************************/
+// Shader include dependency cache
+/************************************************************************/
+// The direct includes and the content hash of every shader source, persisted next to the shader binaries. Finding the newest timestamp
+// or the combined hash of a shader and its includes then only needs the timestamps of the files, a file is read again only when its
+// own timestamp changed
+#define SHADER_DEPENDENCY_FILE_NAME "ShaderDependencies.bin"
+#define SHADER_DEPENDENCY_FILE_MAGIC 0x44535446u    // "FTSD"
+#define SHADER_DEPENDENCY_FILE_VERSION 4u
+
+struct ShaderDependencies
+{
+	time_t                       mTimeStamp;
+	uint64_t                     mHash;
+	eastl::vector<eastl::string> mIncludes;
+};
+
+static eastl::unordered_map<eastl::string, ShaderDependencies> gShaderDependencies;
+static Mutex                                                   gShaderDependencyMutex;
+static bool                                                    gShaderDependenciesDirty = false;
+
+static bool util_read_dependency_string(FileStream* pStream, eastl::string& outString)
+{
+	uint32_t length = 0;
+	if (fsReadFromStream(pStream, &length, sizeof(length)) != sizeof(length) || length >= FS_MAX_PATH)
+		return false;
+	outString.resize(length);
+	return fsReadFromStream(pStream, outString.begin(), length) == length;
+}
+
+static void util_write_dependency_string(FileStream* pStream, const eastl::string& string)
+{
+	uint32_t length = (uint32_t)string.size();
+	fsWriteToStream(pStream, &length, sizeof(length));
+	fsWriteToStream(pStream, string.data(), length);
+}
+
+static void load_shader_dependencies()
+{
+	gShaderDependencyMutex.Init();
+
+	FileStream fh = {};
+	if (!fsOpenStreamFromPath(RD_SHADER_BINARIES, SHADER_DEPENDENCY_FILE_NAME, FM_READ_BINARY, &fh))
+		return;
+
+	uint32_t header[3] = {};
+	bool     valid = fsReadFromStream(&fh, header, sizeof(header)) == sizeof(header) && SHADER_DEPENDENCY_FILE_MAGIC == header[0] &&
+				 SHADER_DEPENDENCY_FILE_VERSION == header[1];
+
+	for (uint32_t i = 0; valid && i < header[2]; ++i)
+	{
+		eastl::string      path;
+		int64_t            timeStamp = 0;
+		uint32_t           includeCount = 0;
+		ShaderDependencies dependencies = {};
+		valid = util_read_dependency_string(&fh, path) && fsReadFromStream(&fh, &timeStamp, sizeof(timeStamp)) == sizeof(timeStamp) &&
+				fsReadFromStream(&fh, &dependencies.mHash, sizeof(dependencies.mHash)) == sizeof(dependencies.mHash) &&
+				fsReadFromStream(&fh, &includeCount, sizeof(includeCount)) == sizeof(includeCount);
+
+		dependencies.mTimeStamp = (time_t)timeStamp;
+		dependencies.mIncludes.resize(valid ? includeCount : 0);
+		for (uint32_t j = 0; valid && j < includeCount; ++j)
+			valid = util_read_dependency_string(&fh, dependencies.mIncludes[j]);
+
+		if (valid && dependencies.mTimeStamp != 0)
+			gShaderDependencies[path] = eastl::move(dependencies);
+	}
+	fsCloseStream(&fh);
+
+	if (!valid)
+	{
+		LOGF(LogLevel::eWARNING, "Ignoring outdated or corrupted shader dependency file %s", SHADER_DEPENDENCY_FILE_NAME);
+		gShaderDependencies.clear();
+	}
+}
+
+static void save_shader_dependencies()
+{
+	FileStream fh = {};
+	if (gShaderDependenciesDirty && fsOpenStreamFromPath(RD_SHADER_BINARIES, SHADER_DEPENDENCY_FILE_NAME, FM_WRITE_BINARY, &fh))
+	{
+		uint32_t header[3] = { SHADER_DEPENDENCY_FILE_MAGIC, SHADER_DEPENDENCY_FILE_VERSION, (uint32_t)gShaderDependencies.size() };
+		fsWriteToStream(&fh, header, sizeof(header));
+		for (const eastl::pair<const eastl::string, ShaderDependencies>& it : gShaderDependencies)
+		{
+			int64_t  timeStamp = (int64_t)it.second.mTimeStamp;
+			uint32_t includeCount = (uint32_t)it.second.mIncludes.size();
+			util_write_dependency_string(&fh, it.first);
+			fsWriteToStream(&fh, &timeStamp, sizeof(timeStamp));
+			fsWriteToStream(&fh, &it.second.mHash, sizeof(it.second.mHash));
+			fsWriteToStream(&fh, &includeCount, sizeof(includeCount));
+			for (const eastl::string& include : it.second.mIncludes)
+				util_write_dependency_string(&fh, include);
+		}
+		fsCloseStream(&fh);
+	}
+
+	gShaderDependencies.clear();
+	gShaderDependenciesDirty = false;
+	gShaderDependencyMutex.Destroy();
+}
+
+// Reads the source in one go, hashes it and collects the paths of the files it includes
+static void scan_source_includes(const char* filePath, uint64_t* pOutHash, eastl::vector<eastl::string>& outIncludes)
+{
+	*pOutHash = 0;
+
+	FileStream fh = {};
+	if (!fsOpenStreamFromPath(RD_SHADER_SOURCES, filePath, FM_READ_BINARY, &fh))
+		return;
+
+	eastl::string source;
+	source.resize((size_t)fsGetStreamFileSize(&fh));
+	fsReadFromStream(&fh, source.begin(), source.size());
+	fsCloseStream(&fh);
+
+	*pOutHash = tf_mem_hash64(source.data(), source.size());
+
+	char parentPath[FS_MAX_PATH] = {};
+	fsGetParentPath(filePath, parentPath);
+
+	size_t directivePos = source.find("#include");
+	while (directivePos != eastl::string::npos)
+	{
+		size_t lineStart = source.rfind('\n', directivePos);
+		lineStart = lineStart == eastl::string::npos ? 0 : lineStart + 1;
+		size_t lineEnd = source.find('\n', directivePos);
+		lineEnd = lineEnd == eastl::string::npos ? source.size() : lineEnd;
+
+		eastl::string fileName;
+		if (util_get_include_file_name(source.substr(lineStart, lineEnd - lineStart), fileName))
+		{
+			char includePath[FS_MAX_PATH] = {};
+			fsAppendPathComponent(parentPath, fileName.c_str(), includePath);
+			outIncludes.push_back(includePath);
+		}
+
+		directivePos = source.find("#include", lineEnd);
+	}
+}
+
+// Newest timestamp and combined content hash of the source and everything it includes. Sources are only scanned when they are not in
+// the dependency cache yet or their timestamp changed
+static void get_source_dependencies(const char* filePath, eastl::vector<eastl::string>& visited, time_t* pTimeStamp, uint64_t* pHash)
+{
+	if (eastl::find(visited.begin(), visited.end(), filePath) != visited.end())
+		return;
+	visited.push_back(filePath);
+
+	time_t timeStamp = fsGetLastModifiedTime(RD_SHADER_SOURCES, filePath);
+	uint64_t hash = 0;
+
+	eastl::vector<eastl::string> includes;
+	gShaderDependencyMutex.Acquire();
+	eastl::unordered_map<eastl::string, ShaderDependencies>::iterator it = gShaderDependencies.find(filePath);
+	// Bundled sources report no timestamp, an entry cannot tell whether they changed so they are always scanned
+	const bool cached = timeStamp != 0 && it != gShaderDependencies.end() && it->second.mTimeStamp == timeStamp;
+	if (cached)
+	{
+		hash = it->second.mHash;
+		includes = it->second.mIncludes;
+	}
+	gShaderDependencyMutex.Release();
+
+	if (!cached)
+	{
+		scan_source_includes(filePath, &hash, includes);
+	}
+
+	if (!cached && timeStamp != 0)
+	{
+		gShaderDependencyMutex.Acquire();
+		ShaderDependencies& dependencies = gShaderDependencies[filePath];
+		dependencies.mTimeStamp = timeStamp;
+		dependencies.mHash = hash;
+		dependencies.mIncludes = includes;
+		gShaderDependenciesDirty = true;
+		gShaderDependencyMutex.Release();
+	}
+
+	*pTimeStamp = max(*pTimeStamp, timeStamp);
+	*pHash = tf_mem_hash64(filePath, strlen(filePath), *pHash);
+	*pHash = tf_mem_hash64(&hash, sizeof(hash), *pHash);
+
+	for (const eastl::string& include : includes)
+		get_source_dependencies(include.c_str(), visited, pTimeStamp, pHash);
+}
+
+#if defined(ENABLE_SHADER_PACK)
+/************************************************************************/
+// Shader byte code pack
+/************************************************************************/
+// All shader byte code lives in one pack file next to the shader binaries. Entries are addressed by a key combining the content hash of
+// the source and its includes with the macros, target, renderer and compiler revision, so a pack built on another machine or in CI
+// stays valid as long as the sources match. The name key leaves out the content and finds the byte code when no sources are shipped
+#define SHADER_PACK_FILE_NAME "ShaderCache.bin"
+#define SHADER_PACK_FILE_MAGIC 0x4B505346u    // "FSPK"
+#define SHADER_PACK_FILE_VERSION 3u
+// Bump when a compiler or compiler option change makes existing byte code invalid
+#define SHADER_COMPILER_REVISION 1u
+
+typedef struct ShaderPackHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mEntryCount;
+	uint32_t mPadding;
+} ShaderPackHeader;
+
+// Followed by the byte code of all entries
+typedef struct ShaderPackEntry
+{
+	uint64_t mKey;
+	uint64_t mNameKey;
+	uint64_t mOffset;
+	uint64_t mSize;
+} ShaderPackEntry;
+
+struct ShaderPackItem
+{
+	uint64_t       mNameKey;
+	uint64_t       mSize;
+	const uint8_t* pByteCode;    // Inside the pack, or owned by the item for byte code compiled in this run
+	bool           mOwned;
+};
+
+struct ShaderPack
+{
+	uint8_t*                                       pData;
+	size_t                                         mSize;
+	bool                                           mMapped;
+	bool                                           mDirty;
+	eastl::unordered_map<uint64_t, ShaderPackItem> mItems;
+	eastl::unordered_map<uint64_t, uint64_t>       mNameKeys;
+	Mutex                                          mMutex;
+};
+
+static ShaderPack gShaderPack;
+
+static void load_shader_pack()
+{
+	gShaderPack.mMutex.Init();
+
+	FileStream fh = {};
+	if (!fsOpenStreamFromPath(RD_SHADER_BINARIES, SHADER_PACK_FILE_NAME, FM_READ_BINARY, &fh))
+		return;
+
+	gShaderPack.mSize = (size_t)fsGetStreamFileSize(&fh);
+	gShaderPack.mMapped = fsMapStream(&fh, (void**)&gShaderPack.pData);
+	if (!gShaderPack.mMapped)
+	{
+		gShaderPack.pData = (uint8_t*)tf_malloc(gShaderPack.mSize);
+		fsReadFromStream(&fh, gShaderPack.pData, gShaderPack.mSize);
+	}
+	fsCloseStream(&fh);
+
+	const ShaderPackHeader* pHeader = (const ShaderPackHeader*)gShaderPack.pData;
+	bool valid = gShaderPack.mSize >= sizeof(ShaderPackHeader) && SHADER_PACK_FILE_MAGIC == pHeader->mMagic &&
+				 SHADER_PACK_FILE_VERSION == pHeader->mVersion &&
+				 gShaderPack.mSize >= sizeof(ShaderPackHeader) + pHeader->mEntryCount * sizeof(ShaderPackEntry);
+
+	const ShaderPackEntry* pEntries = (const ShaderPackEntry*)(pHeader + 1);
+	for (uint32_t i = 0; valid && i < pHeader->mEntryCount; ++i)
+	{
+		const ShaderPackEntry& entry = pEntries[i];
+		valid = entry.mOffset <= gShaderPack.mSize && entry.mSize <= gShaderPack.mSize - entry.mOffset;
+		gShaderPack.mItems[entry.mKey] = { entry.mNameKey, entry.mSize, gShaderPack.pData + entry.mOffset, false };
+		gShaderPack.mNameKeys[entry.mNameKey] = entry.mKey;
+	}
+
+	if (!valid)
+	{
+		LOGF(LogLevel::eWARNING, "Ignoring outdated or corrupted shader pack %s", SHADER_PACK_FILE_NAME);
+		gShaderPack.mItems.clear();
+		gShaderPack.mNameKeys.clear();
+	}
+}
+
+static void save_shader_pack()
+{
+	if (gShaderPack.mDirty)
+	{
+		// The pack is built in memory first since the new file replaces the one the existing entries are read from
+		size_t size = sizeof(ShaderPackHeader) + gShaderPack.mItems.size() * sizeof(ShaderPackEntry);
+		for (const eastl::pair<const uint64_t, ShaderPackItem>& it : gShaderPack.mItems)
+			size += round_up_64(it.second.mSize, 16);
+
+		uint8_t* pData = (uint8_t*)tf_calloc(1, size);
+		ShaderPackHeader* pHeader = (ShaderPackHeader*)pData;
+		ShaderPackEntry* pEntries = (ShaderPackEntry*)(pHeader + 1);
+		*pHeader = { SHADER_PACK_FILE_MAGIC, SHADER_PACK_FILE_VERSION, (uint32_t)gShaderPack.mItems.size(), 0 };
+
+		uint64_t offset = sizeof(ShaderPackHeader) + gShaderPack.mItems.size() * sizeof(ShaderPackEntry);
+		for (const eastl::pair<const uint64_t, ShaderPackItem>& it : gShaderPack.mItems)
+		{
+			*pEntries++ = { it.first, it.second.mNameKey, offset, it.second.mSize };
+			memcpy(pData + offset, it.second.pByteCode, it.second.mSize);
+			offset += round_up_64(it.second.mSize, 16);
+		}
+
+		// Release the old pack before it gets overwritten
+		if (gShaderPack.mMapped)
+			fsUnmapStream(gShaderPack.pData, gShaderPack.mSize);
+		else
+			tf_free(gShaderPack.pData);
+		gShaderPack.pData = NULL;
+
+		FileStream fh = {};
+		if (fsOpenStreamFromPath(RD_SHADER_BINARIES, SHADER_PACK_FILE_NAME, FM_WRITE_BINARY, &fh))
+		{
+			fsWriteToStream(&fh, pData, size);
+			fsCloseStream(&fh);
+		}
+		else
+		{
+			LOGF(LogLevel::eWARNING, "Failed to write shader pack %s", SHADER_PACK_FILE_NAME);
+		}
+		tf_free(pData);
+	}
+
+	for (const eastl::pair<const uint64_t, ShaderPackItem>& it : gShaderPack.mItems)
+		if (it.second.mOwned)
+			tf_free((void*)it.second.pByteCode);
+
+	if (gShaderPack.pData)
+	{
+		if (gShaderPack.mMapped)
+			fsUnmapStream(gShaderPack.pData, gShaderPack.mSize);
+		else
+			tf_free(gShaderPack.pData);
+	}
+
+	gShaderPack.mItems.clear();
+	gShaderPack.mNameKeys.clear();
+	gShaderPack.mMutex.Destroy();
+	gShaderPack.pData = NULL;
+	gShaderPack.mSize = 0;
+	gShaderPack.mMapped = false;
+	gShaderPack.mDirty = false;
+}
+
+// Looks the byte code up by key, or by name key when the key is zero because the sources are not available
+static bool load_packed_byte_code(uint64_t key, uint64_t nameKey, BinaryShaderStageDesc* pOut)
+{
+	MutexLock lock(gShaderPack.mMutex);
+
+	if (!key)
+	{
+		eastl::unordered_map<uint64_t, uint64_t>::iterator nameIt = gShaderPack.mNameKeys.find(nameKey);
+		if (nameIt == gShaderPack.mNameKeys.end())
+			return false;
+		key = nameIt->second;
+	}
+
+	eastl::unordered_map<uint64_t, ShaderPackItem>::iterator it = gShaderPack.mItems.find(key);
+	if (it == gShaderPack.mItems.end() || !it->second.mSize || it->second.mNameKey != nameKey)
+		return false;
+
+	pOut->mByteCodeSize = (uint32_t)it->second.mSize;
+	pOut->pByteCode = tf_memalign(256, it->second.mSize);
+	memcpy((void*)pOut->pByteCode, it->second.pByteCode, it->second.mSize);
 	return true;
 }
+
+// Adds freshly compiled byte code, replacing the entry it supersedes
+static void add_packed_byte_code(uint64_t key, uint64_t nameKey, const BinaryShaderStageDesc* pByteCode)
+{
+	void* pData = tf_malloc(pByteCode->mByteCodeSize);
+	memcpy(pData, pByteCode->pByteCode, pByteCode->mByteCodeSize);
+
+	MutexLock lock(gShaderPack.mMutex);
+
+	eastl::unordered_map<uint64_t, uint64_t>::iterator nameIt = gShaderPack.mNameKeys.find(nameKey);
+	if (nameIt != gShaderPack.mNameKeys.end() && nameIt->second != key)
+	{
+		eastl::unordered_map<uint64_t, ShaderPackItem>::iterator oldIt = gShaderPack.mItems.find(nameIt->second);
+		if (oldIt != gShaderPack.mItems.end())
+		{
+			if (oldIt->second.mOwned)
+				tf_free((void*)oldIt->second.pByteCode);
+			gShaderPack.mItems.erase(oldIt);
+		}
+	}
+
+	ShaderPackItem& item = gShaderPack.mItems[key];
+	if (item.mOwned)
+		tf_free((void*)item.pByteCode);
+	item = { nameKey, pByteCode->mByteCodeSize, (const uint8_t*)pData, true };
+	gShaderPack.mNameKeys[nameKey] = key;
+	gShaderPack.mDirty = true;
+}
+#endif
 #endif
 
 // Loads the bytecode from file if the binary shader file is newer than the source
@@ -2560,6 +3462,17 @@ bool load_shader_stage_byte_code(
 {
 	UNREF_PARAM(loadDesc.mFlags);
 
+#if defined(NULL_RENDERER)
+	// The null backend never consumes byte code so skip source processing and compilation
+	UNREF_PARAM(target);
+	UNREF_PARAM(stage);
+	UNREF_PARAM(allStages);
+	UNREF_PARAM(macroCount);
+	UNREF_PARAM(pMacros);
+	pOut->pByteCode = NULL;
+	pOut->mByteCodeSize = 0;
+	return true;
+#else
 	eastl::string code;
 #if !defined(NX64)
 	time_t          timeStamp = 0;
@@ -2569,12 +3482,7 @@ bool load_shader_stage_byte_code(
 	FileStream sourceFileStream = {};
 	bool sourceExists = fsOpenStreamFromPath(RD_SHADER_SOURCES, loadDesc.pFileName, FM_READ_BINARY, &sourceFileStream);
 	ASSERT(sourceExists);
-
-	if (!process_source_file(pRenderer->pName, &sourceFileStream, loadDesc.pFileName, &sourceFileStream, timeStamp, code))
-	{
-		fsCloseStream(&sourceFileStream);
-		return false;
-	}
+	const char* sourcePath = loadDesc.pFileName;
 #elif defined(NX64)
 	eastl::string shaderDefines;
 	for (uint32_t i = 0; i < macroCount; ++i)
@@ -2616,14 +3524,16 @@ bool load_shader_stage_byte_code(
 	FileStream sourceFileStream = {};
 	bool sourceExists = fsOpenStreamFromPath(RD_SHADER_SOURCES, metalShaderPath, FM_READ_BINARY, &sourceFileStream);
 	ASSERT(sourceExists);
-	if (!process_source_file(pRenderer->pName, &sourceFileStream, metalShaderPath, &sourceFileStream, timeStamp, code))
-	{
-		fsCloseStream(&sourceFileStream);
-		return false;
-	}
+	const char* sourcePath = metalShaderPath;
 #endif
 
 #ifndef NX64
+	uint64_t sourceHash = 0;
+	{
+		eastl::vector<eastl::string> visited;
+		get_source_dependencies(sourcePath, visited, &timeStamp, &sourceHash);
+	}
+
 	eastl::string shaderDefines;
 	// Apply user specified macros
 	for (uint32_t i = 0; i < macroCount; ++i)
@@ -2665,8 +3575,26 @@ bool load_shader_stage_byte_code(
 #endif
 		".bin";
 
+#if defined(ENABLE_SHADER_PACK)
+	uint64_t nameKey = tf_mem_hash64(loadDesc.pFileName, strlen(loadDesc.pFileName));
+	nameKey = tf_mem_hash64(shaderDefines.data(), shaderDefines.size(), nameKey);
+	nameKey = tf_mem_hash64(rendererApi.data(), rendererApi.size(), nameKey);
+	if (loadDesc.pEntryPointName)
+		nameKey = tf_mem_hash64(loadDesc.pEntryPointName, strlen(loadDesc.pEntryPointName), nameKey);
+	const uint32_t keyParams[] = { (uint32_t)target, (uint32_t)loadDesc.mFlags, SHADER_COMPILER_REVISION,
+#ifdef DIRECT3D11
+		(uint32_t)pRenderer->mFeatureLevel,
+#endif
+	};
+	nameKey = tf_mem_hash64(keyParams, sizeof(keyParams), nameKey);
+	// Without sources the byte code can only be found by its name key
+	const uint64_t key = sourceExists ? tf_mem_hash64(&sourceHash, sizeof(sourceHash), nameKey) : 0;
+
+	if (!load_packed_byte_code(key, nameKey, pOut))
+#else
 	// Shader source is newer than binary
 	if (!check_for_byte_code(pRenderer, binaryShaderComponent.c_str(), timeStamp, pOut))
+#endif
 	{
 		if (!sourceExists)
 		{
@@ -2674,6 +3602,13 @@ bool load_shader_stage_byte_code(
 			return false;
 		}
 
+		// The source itself is only needed when it has to be compiled
+		if (!process_source_file(pRenderer->pName, &sourceFileStream, sourcePath, &sourceFileStream, timeStamp, code))
+		{
+			fsCloseStream(&sourceFileStream);
+			return false;
+		}
+
 #if defined(ORBIS)
 		orbis_compileShader(pRenderer,
 			stage, allStages,
@@ -2729,6 +3664,9 @@ bool load_shader_stage_byte_code(
 			ASSERT(false);
 			return false;
 		}
+#endif
+#if defined(ENABLE_SHADER_PACK)
+		add_packed_byte_code(key, nameKey, pOut);
 #endif
 	}
 #else
@@ -2736,6 +3674,7 @@ bool load_shader_stage_byte_code(
 
 	fsCloseStream(&sourceFileStream);
 	return true;
+#endif
 }
 #ifdef TARGET_IOS
 bool find_shader_stage(const char* fileName, ShaderDesc* pDesc, ShaderStageDesc** pOutStage, ShaderStage* pStage)
@@ -2996,6 +3935,43 @@ void addShader(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** ppShad
 	addShader(pRenderer, &desc, ppShader);
 #endif
 }
+
+struct ShaderLoadTask
+{
+	Renderer*             pRenderer;
+	const ShaderLoadDesc* pDescs;
+	Shader**              ppShaders;
+};
+
+static void addShaderTask(void* pUser, uintptr_t index)
+{
+	ShaderLoadTask* pTask = (ShaderLoadTask*)pUser;
+	addShader(pTask->pRenderer, &pTask->pDescs[index], &pTask->ppShaders[index]);
+}
+
+void addShaders(Renderer* pRenderer, uint32_t shaderCount, const ShaderLoadDesc* pDescs, Shader** ppShaders)
+{
+	if (shaderCount < 2)
+	{
+		for (uint32_t i = 0; i < shaderCount; ++i)
+			addShader(pRenderer, &pDescs[i], &ppShaders[i]);
+		return;
+	}
+
+	// Threads of their own, so compiles never occupy the load threads the streamer thread relies on. This thread loads shaders
+	// as well, hence one thread less than there are shaders
+	ThreadSystem* pThreadSystem = NULL;
+	initThreadSystem(&pThreadSystem, shaderCount - 1, 0, true, "ShaderLoad");
+
+	ShaderLoadTask task = { pRenderer, pDescs, ppShaders };
+	addThreadSystemRangeTask(pThreadSystem, addShaderTask, &task, shaderCount);
+	while (assistThreadSystem(pThreadSystem))
+		;
+	waitThreadSystemIdle(pThreadSystem);
+
+	shutdownThreadSystem(pThreadSystem);
+}
+
 /************************************************************************/
 // Pipeline cache save, load
 /************************************************************************/
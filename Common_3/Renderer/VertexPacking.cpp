@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include "VertexPacking.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define VERTEX_PACKING_SSE
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define VERTEX_PACKING_TARGET(features)
+#else
+#include <cpuid.h>
+#define VERTEX_PACKING_TARGET(features) __attribute__((target(features)))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define VERTEX_PACKING_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(VERTEX_PACKING_SSE)
+/************************************************************************/
+// SSE2 / F16C / AVX2 packing
+// The conversions round to nearest even, half floats keep denormals
+/************************************************************************/
+static inline void util_store_4x32_sse2(__m128i v, uint32_t dstStride, uint8_t* dst)
+{
+	if (sizeof(uint32_t) == dstStride)
+	{
+		_mm_storeu_si128((__m128i*)dst, v);
+		return;
+	}
+
+	*(uint32_t*)(dst) = (uint32_t)_mm_cvtsi128_si32(v);
+	*(uint32_t*)(dst + dstStride) = (uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 1, 1, 1)));
+	*(uint32_t*)(dst + dstStride * 2) = (uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 2, 2)));
+	*(uint32_t*)(dst + dstStride * 3) = (uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+
+// x and y of two float2 elements
+static inline __m128 util_load_2x2_sse2(const uint8_t* src, uint32_t srcStride)
+{
+	return _mm_loadh_pi(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)src)), (const __m64*)(src + srcStride));
+}
+
+static inline __m128 util_select_sse2(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+static inline __m128 util_saturate_sse2(__m128 v) { return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f)); }
+
+static inline __m128i util_encode_octahedral_sse2(__m128 x, __m128 y, __m128 z)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+	__m128 absLength = _mm_add_ps(_mm_add_ps(_mm_and_ps(x, absMask), _mm_and_ps(y, absMask)), _mm_and_ps(z, absMask));
+	__m128 valid = _mm_cmpgt_ps(absLength, zero);
+	__m128 invLength = _mm_and_ps(valid, _mm_div_ps(one, absLength));
+	__m128 ex = _mm_mul_ps(x, invLength);
+	__m128 ey = _mm_mul_ps(y, invLength);
+
+	// Fold the lower hemisphere over the diagonals, same as OCT_WRAP
+	__m128 signX = util_select_sse2(_mm_cmpge_ps(ex, zero), one, _mm_set1_ps(-1.0f));
+	__m128 signY = util_select_sse2(_mm_cmpge_ps(ey, zero), one, _mm_set1_ps(-1.0f));
+	__m128 wrapX = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(ey, absMask)), signX);
+	__m128 wrapY = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(ex, absMask)), signY);
+	__m128 lower = _mm_cmplt_ps(z, zero);
+	ex = util_select_sse2(lower, wrapX, ex);
+	ey = util_select_sse2(lower, wrapY, ey);
+
+	const __m128 scale = _mm_set1_ps(65535.0f);
+	__m128i ux = _mm_cvtps_epi32(_mm_mul_ps(util_saturate_sse2(_mm_add_ps(_mm_mul_ps(ex, half), half)), scale));
+	__m128i uy = _mm_cvtps_epi32(_mm_mul_ps(util_saturate_sse2(_mm_add_ps(_mm_mul_ps(ey, half), half)), scale));
+	return _mm_and_si128(_mm_or_si128(ux, _mm_slli_epi32(uy, 16)), _mm_castps_si128(valid));
+}
+
+static void util_pack_float3_direction_to_half2_sse2(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	uint32_t e = 0;
+	for (; e + 4 <= count; e += 4)
+	{
+		const float* f0 = (const float*)(src + e * srcStride);
+		const float* f1 = (const float*)((const uint8_t*)f0 + srcStride);
+		const float* f2 = (const float*)((const uint8_t*)f1 + srcStride);
+		const float* f3 = (const float*)((const uint8_t*)f2 + srcStride);
+		__m128 x = _mm_setr_ps(f0[0], f1[0], f2[0], f3[0]);
+		__m128 y = _mm_setr_ps(f0[1], f1[1], f2[1], f3[1]);
+		__m128 z = _mm_setr_ps(f0[2], f1[2], f2[2], f3[2]);
+		util_store_4x32_sse2(util_encode_octahedral_sse2(x, y, z), dstStride, dst + e * dstStride + offset);
+	}
+	util_pack_float3_direction_to_half2(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+
+static void util_pack_float2_to_unorm2x16_sse2(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	const __m128 scale = _mm_set1_ps(65535.0f);
+	uint32_t e = 0;
+	for (; e + 4 <= count; e += 4)
+	{
+		const uint8_t* s = src + e * srcStride;
+		__m128i u01 = _mm_cvtps_epi32(_mm_mul_ps(util_saturate_sse2(util_load_2x2_sse2(s, srcStride)), scale));
+		__m128i u23 = _mm_cvtps_epi32(_mm_mul_ps(util_saturate_sse2(util_load_2x2_sse2(s + srcStride * 2, srcStride)), scale));
+		// x | y << 16 in the low half of every 64 bit lane, then gather the low halves
+		u01 = _mm_shuffle_epi32(_mm_or_si128(u01, _mm_srli_epi64(u01, 16)), _MM_SHUFFLE(3, 1, 2, 0));
+		u23 = _mm_shuffle_epi32(_mm_or_si128(u23, _mm_srli_epi64(u23, 16)), _MM_SHUFFLE(3, 1, 2, 0));
+		util_store_4x32_sse2(_mm_unpacklo_epi64(u01, u23), dstStride, dst + e * dstStride + offset);
+	}
+	util_pack_float2_to_unorm2x16(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+
+static void util_pack_float4_to_unorm4x8_sse2(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	const __m128 scale = _mm_set1_ps(255.0f);
+	uint32_t e = 0;
+	for (; e + 4 <= count; e += 4)
+	{
+		const uint8_t* s = src + e * srcStride;
+		__m128i u0 = _mm_cvtps_epi32(_mm_mul_ps(util_saturate_sse2(_mm_loadu_ps((const float*)(s))), scale));
+		__m128i u1 = _mm_cvtps_epi32(_mm_mul_ps(util_saturate_sse2(_mm_loadu_ps((const float*)(s + srcStride))), scale));
+		__m128i u2 = _mm_cvtps_epi32(_mm_mul_ps(util_saturate_sse2(_mm_loadu_ps((const float*)(s + srcStride * 2))), scale));
+		__m128i u3 = _mm_cvtps_epi32(_mm_mul_ps(util_saturate_sse2(_mm_loadu_ps((const float*)(s + srcStride * 3))), scale));
+		__m128i u = _mm_packus_epi16(_mm_packs_epi32(u0, u1), _mm_packs_epi32(u2, u3));
+		util_store_4x32_sse2(u, dstStride, dst + e * dstStride + offset);
+	}
+	util_pack_float4_to_unorm4x8(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+
+VERTEX_PACKING_TARGET("avx,f16c")
+static void util_pack_float2_to_half2_f16c(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	uint32_t e = 0;
+	for (; e + 4 <= count; e += 4)
+	{
+		const uint8_t* s = src + e * srcStride;
+		__m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(util_load_2x2_sse2(s, srcStride)), util_load_2x2_sse2(s + srcStride * 2, srcStride), 1);
+		util_store_4x32_sse2(_mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT), dstStride, dst + e * dstStride + offset);
+	}
+	util_pack_float2_to_half2(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+
+VERTEX_PACKING_TARGET("avx,f16c")
+static void util_pack_float3_to_half4_f16c(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	uint32_t e = 0;
+	for (; e + 2 <= count; e += 2)
+	{
+		const float* f0 = (const float*)(src + e * srcStride);
+		const float* f1 = (const float*)((const uint8_t*)f0 + srcStride);
+		__m128i h = _mm256_cvtps_ph(_mm256_setr_ps(f0[0], f0[1], f0[2], 1.0f, f1[0], f1[1], f1[2], 1.0f), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storel_epi64((__m128i*)(dst + e * dstStride + offset), h);
+		_mm_storel_epi64((__m128i*)(dst + (e + 1) * dstStride + offset), _mm_unpackhi_epi64(h, h));
+	}
+	util_pack_float3_to_half4(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+
+VERTEX_PACKING_TARGET("avx2")
+static void util_pack_float3_direction_to_half2_avx2(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 minusOne = _mm256_set1_ps(-1.0f);
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 scale = _mm256_set1_ps(65535.0f);
+	const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+	// Byte offsets of the 8 elements gathered per iteration
+	const __m256i gatherOffsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int)srcStride));
+
+	uint32_t e = 0;
+	for (; e + 8 <= count; e += 8)
+	{
+		const float* f = (const float*)(src + e * srcStride);
+		__m256 x = _mm256_i32gather_ps(f, gatherOffsets, 1);
+		__m256 y = _mm256_i32gather_ps(f + 1, gatherOffsets, 1);
+		__m256 z = _mm256_i32gather_ps(f + 2, gatherOffsets, 1);
+
+		__m256 absLength = _mm256_add_ps(_mm256_add_ps(_mm256_and_ps(x, absMask), _mm256_and_ps(y, absMask)), _mm256_and_ps(z, absMask));
+		__m256 valid = _mm256_cmp_ps(absLength, zero, _CMP_GT_OQ);
+		__m256 invLength = _mm256_and_ps(valid, _mm256_div_ps(one, absLength));
+		__m256 ex = _mm256_mul_ps(x, invLength);
+		__m256 ey = _mm256_mul_ps(y, invLength);
+
+		// Fold the lower hemisphere over the diagonals, same as OCT_WRAP
+		__m256 signX = _mm256_blendv_ps(minusOne, one, _mm256_cmp_ps(ex, zero, _CMP_GE_OQ));
+		__m256 signY = _mm256_blendv_ps(minusOne, one, _mm256_cmp_ps(ey, zero, _CMP_GE_OQ));
+		__m256 wrapX = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_and_ps(ey, absMask)), signX);
+		__m256 wrapY = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_and_ps(ex, absMask)), signY);
+		__m256 lower = _mm256_cmp_ps(z, zero, _CMP_LT_OQ);
+		ex = _mm256_blendv_ps(ex, wrapX, lower);
+		ey = _mm256_blendv_ps(ey, wrapY, lower);
+
+		ex = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(_mm256_mul_ps(ex, half), half), zero), one);
+		ey = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(_mm256_mul_ps(ey, half), half), zero), one);
+		__m256i ux = _mm256_cvtps_epi32(_mm256_mul_ps(ex, scale));
+		__m256i uy = _mm256_cvtps_epi32(_mm256_mul_ps(ey, scale));
+		__m256i u = _mm256_and_si256(_mm256_or_si256(ux, _mm256_slli_epi32(uy, 16)), _mm256_castps_si256(valid));
+
+		uint8_t* d = dst + e * dstStride + offset;
+		if (sizeof(uint32_t) == dstStride)
+		{
+			_mm256_storeu_si256((__m256i*)d, u);
+		}
+		else
+		{
+			util_store_4x32_sse2(_mm256_castsi256_si128(u), dstStride, d);
+			util_store_4x32_sse2(_mm256_extracti128_si256(u, 1), dstStride, d + dstStride * 4);
+		}
+	}
+	util_pack_float3_direction_to_half2_sse2(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+
+static inline void util_cpuid(uint32_t leaf, uint32_t* pInfo)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	__cpuidex((int*)pInfo, (int)leaf, 0);
+#else
+	__cpuid_count(leaf, 0, pInfo[0], pInfo[1], pInfo[2], pInfo[3]);
+#endif
+}
+
+// Register state the OS saves on context switches
+static inline uint64_t util_xgetbv()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	return _xgetbv(0);
+#else
+	uint32_t eax = 0;
+	uint32_t edx = 0;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((uint64_t)edx << 32) | eax;
+#endif
+}
+#endif
+
+#if defined(VERTEX_PACKING_NEON)
+/************************************************************************/
+// NEON packing
+// The conversions round to nearest even, half floats keep denormals
+/************************************************************************/
+static inline void util_store_4x32_neon(uint32x4_t v, uint32_t dstStride, uint8_t* dst)
+{
+	if (sizeof(uint32_t) == dstStride)
+	{
+		vst1q_u32((uint32_t*)dst, v);
+		return;
+	}
+
+	vst1q_lane_u32((uint32_t*)(dst), v, 0);
+	vst1q_lane_u32((uint32_t*)(dst + dstStride), v, 1);
+	vst1q_lane_u32((uint32_t*)(dst + dstStride * 2), v, 2);
+	vst1q_lane_u32((uint32_t*)(dst + dstStride * 3), v, 3);
+}
+
+// x and y of two float2 elements
+static inline float32x4_t util_load_2x2_neon(const uint8_t* src, uint32_t srcStride)
+{
+	return vcombine_f32(vld1_f32((const float*)src), vld1_f32((const float*)(src + srcStride)));
+}
+
+static inline float32x4_t util_saturate_neon(float32x4_t v) { return vminq_f32(vmaxq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f)); }
+
+static void util_pack_float2_to_half2_neon(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	uint32_t e = 0;
+	for (; e + 4 <= count; e += 4)
+	{
+		const uint8_t* s = src + e * srcStride;
+		uint32x2_t h01 = vreinterpret_u32_f16(vcvt_f16_f32(util_load_2x2_neon(s, srcStride)));
+		uint32x2_t h23 = vreinterpret_u32_f16(vcvt_f16_f32(util_load_2x2_neon(s + srcStride * 2, srcStride)));
+		util_store_4x32_neon(vcombine_u32(h01, h23), dstStride, dst + e * dstStride + offset);
+	}
+	util_pack_float2_to_half2(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+
+static void util_pack_float3_to_half4_neon(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	for (uint32_t e = 0; e < count; ++e)
+	{
+		const float* f = (const float*)(src + e * srcStride);
+		float32x4_t v = vcombine_f32(vld1_f32(f), vset_lane_f32(1.0f, vdup_n_f32(f[2]), 1));
+		vst1_u16((uint16_t*)(dst + e * dstStride + offset), vreinterpret_u16_f16(vcvt_f16_f32(v)));
+	}
+}
+
+static void util_pack_float3_direction_to_half2_neon(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t minusOne = vdupq_n_f32(-1.0f);
+	const float32x4_t half = vdupq_n_f32(0.5f);
+	const float32x4_t scale = vdupq_n_f32(65535.0f);
+
+	uint32_t e = 0;
+	for (; e + 4 <= count; e += 4)
+	{
+		const uint8_t* s = src + e * srcStride;
+		float32x4_t x, y, z;
+		if (sizeof(float[3]) == srcStride)
+		{
+			float32x4x3_t v = vld3q_f32((const float*)s);
+			x = v.val[0];
+			y = v.val[1];
+			z = v.val[2];
+		}
+		else if (sizeof(float[4]) == srcStride)
+		{
+			float32x4x4_t v = vld4q_f32((const float*)s);
+			x = v.val[0];
+			y = v.val[1];
+			z = v.val[2];
+		}
+		else
+		{
+			float xyz[3][4];
+			for (uint32_t i = 0; i < 4; ++i)
+				for (uint32_t c = 0; c < 3; ++c)
+					xyz[c][i] = ((const float*)(s + i * srcStride))[c];
+			x = vld1q_f32(xyz[0]);
+			y = vld1q_f32(xyz[1]);
+			z = vld1q_f32(xyz[2]);
+		}
+
+		float32x4_t absLength = vaddq_f32(vaddq_f32(vabsq_f32(x), vabsq_f32(y)), vabsq_f32(z));
+		uint32x4_t valid = vcgtq_f32(absLength, zero);
+		float32x4_t ex = vdivq_f32(x, absLength);
+		float32x4_t ey = vdivq_f32(y, absLength);
+
+		// Fold the lower hemisphere over the diagonals, same as OCT_WRAP
+		float32x4_t wrapX = vmulq_f32(vsubq_f32(one, vabsq_f32(ey)), vbslq_f32(vcgeq_f32(ex, zero), one, minusOne));
+		float32x4_t wrapY = vmulq_f32(vsubq_f32(one, vabsq_f32(ex)), vbslq_f32(vcgeq_f32(ey, zero), one, minusOne));
+		uint32x4_t lower = vcltq_f32(z, zero);
+		ex = vbslq_f32(lower, wrapX, ex);
+		ey = vbslq_f32(lower, wrapY, ey);
+
+		uint32x4_t ux = vcvtnq_u32_f32(vmulq_f32(util_saturate_neon(vaddq_f32(vmulq_f32(ex, half), half)), scale));
+		uint32x4_t uy = vcvtnq_u32_f32(vmulq_f32(util_saturate_neon(vaddq_f32(vmulq_f32(ey, half), half)), scale));
+		// Zero length directions give NaNs above, they are written as 0 like the scalar version does
+		uint32x4_t u = vandq_u32(vorrq_u32(ux, vshlq_n_u32(uy, 16)), valid);
+		util_store_4x32_neon(u, dstStride, dst + e * dstStride + offset);
+	}
+	util_pack_float3_direction_to_half2(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+
+static void util_pack_float2_to_unorm2x16_neon(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	const float32x4_t scale = vdupq_n_f32(65535.0f);
+	uint32_t e = 0;
+	for (; e + 4 <= count; e += 4)
+	{
+		const uint8_t* s = src + e * srcStride;
+		uint16x4_t u01 = vmovn_u32(vcvtnq_u32_f32(vmulq_f32(util_saturate_neon(util_load_2x2_neon(s, srcStride)), scale)));
+		uint16x4_t u23 = vmovn_u32(vcvtnq_u32_f32(vmulq_f32(util_saturate_neon(util_load_2x2_neon(s + srcStride * 2, srcStride)), scale)));
+		util_store_4x32_neon(vreinterpretq_u32_u16(vcombine_u16(u01, u23)), dstStride, dst + e * dstStride + offset);
+	}
+	util_pack_float2_to_unorm2x16(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+
+static void util_pack_float4_to_unorm4x8_neon(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	const float32x4_t scale = vdupq_n_f32(255.0f);
+	uint32_t e = 0;
+	for (; e + 4 <= count; e += 4)
+	{
+		const uint8_t* s = src + e * srcStride;
+		uint16x4_t u0 = vmovn_u32(vcvtnq_u32_f32(vmulq_f32(util_saturate_neon(vld1q_f32((const float*)(s))), scale)));
+		uint16x4_t u1 = vmovn_u32(vcvtnq_u32_f32(vmulq_f32(util_saturate_neon(vld1q_f32((const float*)(s + srcStride))), scale)));
+		uint16x4_t u2 = vmovn_u32(vcvtnq_u32_f32(vmulq_f32(util_saturate_neon(vld1q_f32((const float*)(s + srcStride * 2))), scale)));
+		uint16x4_t u3 = vmovn_u32(vcvtnq_u32_f32(vmulq_f32(util_saturate_neon(vld1q_f32((const float*)(s + srcStride * 3))), scale)));
+		uint8x16_t u = vcombine_u8(vmovn_u16(vcombine_u16(u0, u1)), vmovn_u16(vcombine_u16(u2, u3)));
+		util_store_4x32_neon(vreinterpretq_u32_u8(u), dstStride, dst + e * dstStride + offset);
+	}
+	util_pack_float4_to_unorm4x8(count - e, srcStride, dstStride, offset, src + e * srcStride, dst + e * dstStride);
+}
+#endif
+
+PackingFunctions gPackingFunctions = {
+	util_pack_float2_to_half2,         util_pack_float3_to_half4,    util_pack_float3_direction_to_half2,
+	util_pack_float2_to_unorm2x16,     util_pack_float4_to_unorm4x8,
+};
+
+void util_init_packing_functions()
+{
+#if defined(VERTEX_PACKING_SSE)
+	// SSE2 is part of x64
+	gPackingFunctions.pFloat3DirectionToHalf2 = util_pack_float3_direction_to_half2_sse2;
+	gPackingFunctions.pFloat2ToUnorm2x16 = util_pack_float2_to_unorm2x16_sse2;
+	gPackingFunctions.pFloat4ToUnorm4x8 = util_pack_float4_to_unorm4x8_sse2;
+
+	uint32_t info[4] = {};
+	util_cpuid(0, info);
+	const uint32_t maxLeaf = info[0];
+
+	util_cpuid(1, info);
+	// F16C and AVX2 need AVX and an OS saving the YMM registers
+	const bool osxsave = (info[2] & (1u << 27)) != 0;
+	const bool avx = osxsave && (info[2] & (1u << 28)) && (util_xgetbv() & 0x6) == 0x6;
+	if (avx && (info[2] & (1u << 29)))
+	{
+		gPackingFunctions.pFloat2ToHalf2 = util_pack_float2_to_half2_f16c;
+		gPackingFunctions.pFloat3ToHalf4 = util_pack_float3_to_half4_f16c;
+	}
+
+	if (avx && maxLeaf >= 7)
+	{
+		util_cpuid(7, info);
+		if (info[1] & (1u << 5))
+			gPackingFunctions.pFloat3DirectionToHalf2 = util_pack_float3_direction_to_half2_avx2;
+	}
+#elif defined(VERTEX_PACKING_NEON)
+	gPackingFunctions.pFloat2ToHalf2 = util_pack_float2_to_half2_neon;
+	gPackingFunctions.pFloat3ToHalf4 = util_pack_float3_to_half4_neon;
+	gPackingFunctions.pFloat3DirectionToHalf2 = util_pack_float3_direction_to_half2_neon;
+	gPackingFunctions.pFloat2ToUnorm2x16 = util_pack_float2_to_unorm2x16_neon;
+	gPackingFunctions.pFloat4ToUnorm4x8 = util_pack_float4_to_unorm4x8_neon;
+#endif
+}
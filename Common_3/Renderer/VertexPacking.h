@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+// Packing of vertex attributes into the formats vertex layouts ask for, used by the resource loader when filling vertex buffers.
+// Every packing function has a scalar version. SSE2, F16C and AVX2 versions on x64 and NEON versions on ARM64 replace them
+// once util_init_packing_functions has checked what the CPU supports. Examples_3/Unit_Tests/src/CoreTests checks them against
+// the scalar versions and times them.
+
+#include "IRenderer.h"
+#include "../OS/Math/MathTypes.h"
+#include "../ThirdParty/OpenSource/tinyimageformat/tinyimageformat_base.h"
+#include "../ThirdParty/OpenSource/tinyimageformat/tinyimageformat_query.h"
+
+// Packs count elements read every srcStride bytes from src into the elements of dst, found at offset in every dstStride bytes
+typedef void (*PackingFunction)(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst);
+
+/************************************************************************/
+// Scalar packing
+/************************************************************************/
+#define F16_EXPONENT_BITS 0x1F
+#define F16_EXPONENT_SHIFT 10
+#define F16_EXPONENT_BIAS 15
+#define F16_MANTISSA_BITS 0x3ff
+#define F16_MANTISSA_SHIFT (23 - F16_EXPONENT_SHIFT)
+#define F16_MAX_EXPONENT (F16_EXPONENT_BITS << F16_EXPONENT_SHIFT)
+
+static inline uint16_t util_float_to_half(float val)
+{
+	uint32_t           f32 = (*(uint32_t*)&val);
+	uint16_t           f16 = 0;
+	/* Decode IEEE 754 little-endian 32-bit floating-point value */
+	int sign = (f32 >> 16) & 0x8000;
+	/* Map exponent to the range [-127,128] */
+	int exponent = ((f32 >> 23) & 0xff) - 127;
+	int mantissa = f32 & 0x007fffff;
+	if (exponent == 128)
+	{ /* Infinity or NaN */
+		f16 = (uint16_t)(sign | F16_MAX_EXPONENT);
+		if (mantissa)
+			f16 |= (mantissa & F16_MANTISSA_BITS);
+	}
+	else if (exponent > 15)
+	{ /* Overflow - flush to Infinity */
+		f16 = (unsigned short)(sign | F16_MAX_EXPONENT);
+	}
+	else if (exponent > -15)
+	{ /* Representable value */
+		exponent += F16_EXPONENT_BIAS;
+		mantissa >>= F16_MANTISSA_SHIFT;
+		f16 = (unsigned short)(sign | exponent << F16_EXPONENT_SHIFT | mantissa);
+	}
+	else
+	{
+		f16 = (unsigned short)sign;
+	}
+	return f16;
+}
+
+static inline uint32_t util_float2_to_unorm2x16(const float* v)
+{
+	uint32_t x = (uint32_t)round(clamp(v[0], 0, 1) * 65535.0f);
+	uint32_t y = (uint32_t)round(clamp(v[1], 0, 1) * 65535.0f);
+	return ((uint32_t)0x0000FFFF & x) | ((y << 16) & (uint32_t)0xFFFF0000);
+}
+
+#define OCT_WRAP(v, w) ((1.0f - abs((w))) * ((v) >= 0.0f ? 1.0f : -1.0f))
+
+static inline uint32_t util_float3_direction_to_unorm2x16(const float* v)
+{
+	float absLength = (abs(v[0]) + abs(v[1]) + abs(v[2]));
+	if (!absLength)
+		return 0;
+
+	float enc[3] = { v[0] / absLength, v[1] / absLength, v[2] / absLength };
+	if (enc[2] < 0)
+	{
+		float oldX = enc[0];
+		enc[0] = OCT_WRAP(enc[0], enc[1]);
+		enc[1] = OCT_WRAP(enc[1], oldX);
+	}
+	enc[0] = enc[0] * 0.5f + 0.5f;
+	enc[1] = enc[1] * 0.5f + 0.5f;
+	return util_float2_to_unorm2x16(enc);
+}
+
+static inline void util_pack_float2_to_half2(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	for (uint32_t e = 0; e < count; ++e)
+	{
+		const float* f = (const float*)(src + e * srcStride);
+		*(uint32_t*)(dst + e * dstStride + offset) = (
+			(util_float_to_half(f[0]) & 0x0000FFFF) | ((util_float_to_half(f[1]) << 16) & 0xFFFF0000));
+	}
+}
+
+// W is set to 1
+static inline void util_pack_float3_to_half4(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	for (uint32_t e = 0; e < count; ++e)
+	{
+		const float* f = (const float*)(src + e * srcStride);
+		uint16_t* h = (uint16_t*)(dst + e * dstStride + offset);
+		h[0] = util_float_to_half(f[0]);
+		h[1] = util_float_to_half(f[1]);
+		h[2] = util_float_to_half(f[2]);
+		h[3] = util_float_to_half(1.0f);
+	}
+}
+
+// Octahedral encoding
+static inline void util_pack_float3_direction_to_half2(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	for (uint32_t e = 0; e < count; ++e)
+		*(uint32_t*)(dst + e * dstStride + offset) = util_float3_direction_to_unorm2x16((const float*)(src + e * srcStride));
+}
+
+static inline void util_pack_float2_to_unorm2x16(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	for (uint32_t e = 0; e < count; ++e)
+		*(uint32_t*)(dst + e * dstStride + offset) = util_float2_to_unorm2x16((const float*)(src + e * srcStride));
+}
+
+static inline void util_pack_float4_to_unorm4x8(uint32_t count, uint32_t srcStride, uint32_t dstStride, uint32_t offset, const uint8_t* src, uint8_t* dst)
+{
+	for (uint32_t e = 0; e < count; ++e)
+	{
+		const float* f = (const float*)(src + e * srcStride);
+		uint8_t* u = dst + e * dstStride + offset;
+		for (uint32_t c = 0; c < 4; ++c)
+			u[c] = (uint8_t)round(clamp(f[c], 0, 1) * 255.0f);
+	}
+}
+
+/************************************************************************/
+// Runtime selection
+/************************************************************************/
+typedef struct PackingFunctions
+{
+	PackingFunction pFloat2ToHalf2;
+	PackingFunction pFloat3ToHalf4;
+	PackingFunction pFloat3DirectionToHalf2;
+	PackingFunction pFloat2ToUnorm2x16;
+	PackingFunction pFloat4ToUnorm4x8;
+} PackingFunctions;
+
+extern PackingFunctions gPackingFunctions;
+
+// Replaces the scalar packing functions with the fastest versions the CPU supports
+void util_init_packing_functions();
+
+// Select a packing function if dst format is packed version of the src format
+// Position - Pack float3 to half4 (w = 1)
+// Directions - Pack float3 to float2 to unorm2x16 (Normal, Tangent)
+// Colors, Weights - Pack float4 to unorm4x8
+// Texcoords - Pack float2 to half2 or unorm2x16
+static inline PackingFunction util_select_packing_function(ShaderSemantic semantic, TinyImageFormat srcFormat, TinyImageFormat dstFormat)
+{
+	const uint32_t dstFormatSize = TinyImageFormat_BitSizeOfBlock(dstFormat) >> 3;
+
+	switch (semantic)
+	{
+	case SEMANTIC_POSITION:
+	{
+		if (TinyImageFormat_R16G16B16A16_SFLOAT == dstFormat &&
+			(TinyImageFormat_R32G32B32_SFLOAT == srcFormat || TinyImageFormat_R32G32B32A32_SFLOAT == srcFormat))
+			return gPackingFunctions.pFloat3ToHalf4;
+		break;
+	}
+	case SEMANTIC_NORMAL:
+	case SEMANTIC_TANGENT:
+	{
+		if (sizeof(uint32_t) == dstFormatSize &&
+			(TinyImageFormat_R32G32B32_SFLOAT == srcFormat || TinyImageFormat_R32G32B32A32_SFLOAT == srcFormat))
+			return gPackingFunctions.pFloat3DirectionToHalf2;
+		break;
+	}
+	case SEMANTIC_COLOR:
+	case SEMANTIC_WEIGHTS:
+	{
+		if (TinyImageFormat_R8G8B8A8_UNORM == dstFormat && TinyImageFormat_R32G32B32A32_SFLOAT == srcFormat)
+			return gPackingFunctions.pFloat4ToUnorm4x8;
+		break;
+	}
+	case SEMANTIC_TEXCOORD0:
+	case SEMANTIC_TEXCOORD1:
+	case SEMANTIC_TEXCOORD2:
+	case SEMANTIC_TEXCOORD3:
+	case SEMANTIC_TEXCOORD4:
+	case SEMANTIC_TEXCOORD5:
+	case SEMANTIC_TEXCOORD6:
+	case SEMANTIC_TEXCOORD7:
+	case SEMANTIC_TEXCOORD8:
+	case SEMANTIC_TEXCOORD9:
+	{
+		if (TinyImageFormat_R32G32_SFLOAT != srcFormat)
+			break;
+		if (TinyImageFormat_R16G16_UNORM == dstFormat)
+			return gPackingFunctions.pFloat2ToUnorm2x16;
+		if (sizeof(uint32_t) == dstFormatSize)
+			return gPackingFunctions.pFloat2ToHalf2;
+		break;
+	}
+	default:
+		break;
+	}
+
+	return NULL;
+}
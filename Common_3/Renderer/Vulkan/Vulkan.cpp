@@ -400,6 +400,13 @@ void addTexture(Renderer* pRenderer, const TextureDesc* pDesc, Texture** ppTextu
 void removeTexture(Renderer* pRenderer, Texture* pTexture);
 // clang-format on
 
+// Number of descriptor set writes sent to the driver and skipped because the contents did not change
+static tfrg_atomic64_t gDescriptorSetWriteCount = 0;
+static tfrg_atomic64_t gDescriptorSetSkipCount = 0;
+// All descriptor sets, a removed resource clears the written state of the sets referencing it
+static Mutex          gDescriptorSetListMutex;
+static DescriptorSet* pDescriptorSetList = NULL;
+
 //+1 for Acceleration Structure
 #define FORGE_DESCRIPTOR_TYPE_RANGE_SIZE (VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT + 2)
 static uint32_t gDescriptorTypeRangeSize = (FORGE_DESCRIPTOR_TYPE_RANGE_SIZE - 1);
@@ -553,6 +560,36 @@ struct SizeOffset
 	uint32_t mSize;
 	uint32_t mOffset;
 };
+
+// The driver can hand the handles of removed objects out again. A set still holding a removed handle must not skip the write when it
+// is updated with a new object that got the same handle, so the written state of every set referencing one of the handles is cleared.
+// Resources are not removed while sets referencing them are updated, so the written data is read without locking the sets
+static void invalidate_descriptor_set_written_data(const uint64_t* pHandles, uint32_t handleCount)
+{
+	MutexLock lock(gDescriptorSetListMutex);
+	for (DescriptorSet* pDescriptorSet = pDescriptorSetList; pDescriptorSet; pDescriptorSet = pDescriptorSet->pNextSet)
+	{
+		const uint32_t descriptorCount = pDescriptorSet->pRootSignature->mVkCumulativeDescriptorCounts[pDescriptorSet->mUpdateFrequency];
+		// Handles are 64 bit on all platforms and 8 byte aligned in every member of DescriptorUpdateData
+		const uint32_t wordCount = (uint32_t)(descriptorCount * sizeof(DescriptorUpdateData) / sizeof(uint64_t));
+
+		for (uint32_t i = 0; i < pDescriptorSet->mMaxSets; ++i)
+		{
+			const uint64_t* pWords = (const uint64_t*)pDescriptorSet->ppWrittenData[i];
+			for (uint32_t w = 0; pDescriptorSet->pWritten[i] && w < wordCount; ++w)
+			{
+				for (uint32_t h = 0; h < handleCount; ++h)
+				{
+					if (pWords[w] == pHandles[h])
+					{
+						pDescriptorSet->pWritten[i] = false;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
 /************************************************************************/
 // Descriptor Set Structure
 /************************************************************************/
@@ -574,6 +611,15 @@ static const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature,
 		return NULL;
 	}
 }
+
+uint32_t getDescriptorIndexFromName(const RootSignature* pRootSignature, const char* pName)
+{
+	ASSERT(pRootSignature);
+	ASSERT(pName);
+
+	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, pName);
+	return pDesc ? (uint32_t)(pDesc - pRootSignature->pDescriptors) : (uint32_t)-1;
+}
 /************************************************************************/
 // Render Pass Implementation
 /************************************************************************/
@@ -613,6 +659,9 @@ typedef struct FrameBuffer
 	uint32_t      mWidth;
 	uint32_t      mHeight;
 	uint32_t      mArraySize;
+	/// Ids of the attached render targets, the frame buffer is evicted when one of them is removed
+	uint32_t      mRenderTargetIds[MAX_RENDER_TARGET_ATTACHMENTS + 1];
+	uint32_t      mRenderTargetIdCount;
 } FrameBuffer;
 
 static void add_render_pass(Renderer* pRenderer, const RenderPassDesc* pDesc, RenderPass** ppRenderPass)
@@ -764,6 +813,11 @@ static void add_framebuffer(Renderer* pRenderer, const FrameBufferDesc* pDesc, F
 		pFrameBuffer->mArraySize = pDesc->ppRenderTargets[0]->mDepth;
 	}
 
+	for (uint32_t i = 0; i < colorAttachmentCount; ++i)
+		pFrameBuffer->mRenderTargetIds[pFrameBuffer->mRenderTargetIdCount++] = pDesc->ppRenderTargets[i]->mId;
+	if (pDesc->pDepthStencil)
+		pFrameBuffer->mRenderTargetIds[pFrameBuffer->mRenderTargetIdCount++] = pDesc->pDepthStencil->mId;
+
 	/************************************************************************/
 	// Add frame buffer
 	/************************************************************************/
@@ -854,10 +908,10 @@ static void remove_framebuffer(Renderer* pRenderer, FrameBuffer* pFrameBuffer)
 	SAFE_FREE(pFrameBuffer);
 }
 /************************************************************************/
-// Per Thread Render Pass synchronization logic
+// Render Pass and Frame Buffer caches
 /************************************************************************/
 /// Render-passes are not exposed to the app code since they are not available on all apis
-/// This map takes care of hashing a render pass based on the render targets passed to cmdBeginRender
+/// These maps take care of hashing a render pass based on the render targets passed to cmdBeginRender
 using RenderPassMap = eastl::hash_map<uint64_t, struct RenderPass*>;
 using RenderPassMapNode = RenderPassMap::value_type;
 using RenderPassMapIt = RenderPassMap::iterator;
@@ -865,40 +919,122 @@ using FrameBufferMap = eastl::hash_map<uint64_t, struct FrameBuffer*>;
 using FrameBufferMapNode = FrameBufferMap::value_type;
 using FrameBufferMapIt = FrameBufferMap::iterator;
 
-// RenderPass map per thread (this will make lookups lock free and we only need a lock when inserting a RenderPass Map for the first time)
-eastl::hash_map<ThreadID, RenderPassMap>* gRenderPassMap;
-// FrameBuffer map per thread (this will make lookups lock free and we only need a lock when inserting a FrameBuffer map for the first time)
-eastl::hash_map<ThreadID, FrameBufferMap>* gFrameBufferMap;
-Mutex*                                    pRenderPassMutex;
+// Render passes and frame buffers are shared by all threads. The maps are split in shards
+// so threads only contend when they miss their thread cache on the same shard
+#define RENDER_PASS_CACHE_SHARD_COUNT 16
+typedef struct RenderPassCacheShard
+{
+	Mutex          mMutex;
+	RenderPassMap  mRenderPasses;
+	FrameBufferMap mFrameBuffers;
+} RenderPassCacheShard;
+RenderPassCacheShard* pRenderPassCacheShards;
+
+// Bumped whenever cached objects are destroyed, threads then drop everything in their thread cache
+static tfrg_atomic32_t gRenderPassCacheEpoch = 0;
+
+// Direct mapped cache of the lookups done by one thread, hits don't take any lock
+#define RENDER_PASS_THREAD_CACHE_SIZE 64
+typedef struct RenderPassThreadCache
+{
+	uint32_t     mEpoch;
+	uint64_t     mRenderPassHashes[RENDER_PASS_THREAD_CACHE_SIZE];
+	RenderPass*  pRenderPasses[RENDER_PASS_THREAD_CACHE_SIZE];
+	uint64_t     mFrameBufferHashes[RENDER_PASS_THREAD_CACHE_SIZE];
+	FrameBuffer* pFrameBuffers[RENDER_PASS_THREAD_CACHE_SIZE];
+} RenderPassThreadCache;
+static thread_local RenderPassThreadCache gRenderPassThreadCache;
 
-static RenderPassMap& get_render_pass_map()
+static RenderPassThreadCache* get_render_pass_thread_cache()
 {
-	// Only need a lock when creating a new renderpass map for this thread
-	MutexLock lock(*pRenderPassMutex);
-	eastl::hash_map<ThreadID, RenderPassMap>::iterator it = gRenderPassMap->find(Thread::GetCurrentThreadID());
-	if (it == gRenderPassMap->end())
+	RenderPassThreadCache* pCache = &gRenderPassThreadCache;
+	const uint32_t         epoch = tfrg_atomic32_load_acquire(&gRenderPassCacheEpoch);
+	if (pCache->mEpoch != epoch)
 	{
-		return gRenderPassMap->insert(Thread::GetCurrentThreadID()).first->second;
+		memset(pCache, 0, sizeof(*pCache));
+		pCache->mEpoch = epoch;
 	}
-	else
+	return pCache;
+}
+
+static uint32_t get_render_pass_cache_shard_index(uint64_t hash)
+{
+	// The hashes only have 32 bits and the thread cache indexes with the low bits, so the high half is folded in
+	return (uint32_t)(hash ^ (hash >> 16)) % RENDER_PASS_CACHE_SHARD_COUNT;
+}
+
+static RenderPassCacheShard& get_render_pass_cache_shard(uint64_t hash)
+{
+	return pRenderPassCacheShards[get_render_pass_cache_shard_index(hash)];
+}
+
+static void add_render_pass_cache()
+{
+	pRenderPassCacheShards = (RenderPassCacheShard*)tf_malloc(sizeof(RenderPassCacheShard) * RENDER_PASS_CACHE_SHARD_COUNT);
+	for (uint32_t i = 0; i < RENDER_PASS_CACHE_SHARD_COUNT; ++i)
 	{
-		return it->second;
+		tf_placement_new<RenderPassCacheShard>(&pRenderPassCacheShards[i]);
+		pRenderPassCacheShards[i].mMutex.Init();
 	}
+
+#if defined(_DEBUG)
+	// Hashes built like the lookup hashes have to reach every shard, otherwise all threads contend on a few locks
+	bool shardUsed[RENDER_PASS_CACHE_SHARD_COUNT] = {};
+	for (uint32_t i = 0; i < RENDER_PASS_CACHE_SHARD_COUNT * 8; ++i)
+		shardUsed[get_render_pass_cache_shard_index(tf_mem_hash<uint32_t>(&i, 1))] = true;
+	for (uint32_t i = 0; i < RENDER_PASS_CACHE_SHARD_COUNT; ++i)
+		ASSERT(shardUsed[i] && "Render pass cache hashes don't spread across all shards");
+#endif
 }
 
-static FrameBufferMap& get_frame_buffer_map()
+static void remove_render_pass_cache(Renderer* pRenderer)
 {
-	// Only need a lock when creating a new framebuffer map for this thread
-	MutexLock lock(*pRenderPassMutex);
-	eastl::hash_map<ThreadID, FrameBufferMap>::iterator it = gFrameBufferMap->find(Thread::GetCurrentThreadID());
-	if (it == gFrameBufferMap->end())
+	for (uint32_t i = 0; i < RENDER_PASS_CACHE_SHARD_COUNT; ++i)
 	{
-		return gFrameBufferMap->insert(Thread::GetCurrentThreadID()).first->second;
+		RenderPassCacheShard& shard = pRenderPassCacheShards[i];
+		for (RenderPassMapNode& it : shard.mRenderPasses)
+			remove_render_pass(pRenderer, it.second);
+		for (FrameBufferMapNode& it : shard.mFrameBuffers)
+			remove_framebuffer(pRenderer, it.second);
+
+		shard.mMutex.Destroy();
+		shard.~RenderPassCacheShard();
 	}
-	else
+	SAFE_FREE(pRenderPassCacheShards);
+
+	tfrg_atomic32_add_relaxed(&gRenderPassCacheEpoch, 1);
+}
+
+// Destroys the frame buffers using a render target that is being removed
+static void evict_render_target_frame_buffers(Renderer* pRenderer, uint32_t renderTargetId)
+{
+	bool evicted = false;
+	for (uint32_t i = 0; i < RENDER_PASS_CACHE_SHARD_COUNT; ++i)
 	{
-		return it->second;
+		RenderPassCacheShard& shard = pRenderPassCacheShards[i];
+		MutexLock             lock(shard.mMutex);
+		for (FrameBufferMapIt it = shard.mFrameBuffers.begin(); it != shard.mFrameBuffers.end();)
+		{
+			FrameBuffer* pFrameBuffer = it->second;
+			bool         used = false;
+			for (uint32_t j = 0; j < pFrameBuffer->mRenderTargetIdCount && !used; ++j)
+				used = pFrameBuffer->mRenderTargetIds[j] == renderTargetId;
+
+			if (used)
+			{
+				remove_framebuffer(pRenderer, pFrameBuffer);
+				it = shard.mFrameBuffers.erase(it);
+				evicted = true;
+			}
+			else
+			{
+				++it;
+			}
+		}
 	}
+
+	if (evicted)
+		tfrg_atomic32_add_relaxed(&gRenderPassCacheEpoch, 1);
 }
 /************************************************************************/
 // Logging, Validation layer implementation
@@ -2803,10 +2939,8 @@ void initRenderer(const char* appName, const RendererDesc* pDesc, Renderer** ppR
 	}
 #endif
 	add_descriptor_pool(pRenderer, 8192, (VkDescriptorPoolCreateFlags)0, descriptorPoolSizes, gDescriptorTypeRangeSize, &pRenderer->pDescriptorPool);
-	pRenderPassMutex = (Mutex*)tf_calloc(1, sizeof(Mutex));
-	pRenderPassMutex->Init();
-	gRenderPassMap = tf_placement_new<eastl::hash_map<ThreadID, RenderPassMap> >(tf_malloc(sizeof(*gRenderPassMap)));
-	gFrameBufferMap = tf_placement_new<eastl::hash_map<ThreadID, FrameBufferMap> >(tf_malloc(sizeof(*gFrameBufferMap)));
+	add_render_pass_cache();
+	gDescriptorSetListMutex.Init();
 
 	VkPhysicalDeviceFeatures2KHR gpuFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR };
 	vkGetPhysicalDeviceFeatures2KHR(pRenderer->pVkActiveGPU, &gpuFeatures);
@@ -2835,6 +2969,8 @@ void initRenderer(const char* appName, const RendererDesc* pDesc, Renderer** ppR
 
 	add_default_resources(pRenderer);
 
+	initShaderReflectionCache();
+
 	// Renderer is good!
 	*ppRenderer = pRenderer;
 }
@@ -2843,18 +2979,19 @@ void removeRenderer(Renderer* pRenderer)
 {
 	ASSERT(pRenderer);
 
+	exitShaderReflectionCache();
+	exitGPUConfig();
+
+	LOGF(LogLevel::eINFO, "Descriptor set updates: %llu written, %llu skipped since contents did not change",
+		(unsigned long long)tfrg_atomic64_load_relaxed(&gDescriptorSetWriteCount), (unsigned long long)tfrg_atomic64_load_relaxed(&gDescriptorSetSkipCount));
+
 	remove_default_resources(pRenderer);
 
 	remove_descriptor_pool(pRenderer, pRenderer->pDescriptorPool);
 
 	// Remove the renderpasses
-	for (eastl::hash_map<ThreadID, RenderPassMap>::value_type& t : *gRenderPassMap)
-		for (RenderPassMapNode& it : t.second)
-			remove_render_pass(pRenderer, it.second);
-
-	for (eastl::hash_map<ThreadID, FrameBufferMap>::value_type& t : *gFrameBufferMap)
-		for (FrameBufferMapNode& it : t.second)
-			remove_framebuffer(pRenderer, it.second);
+	remove_render_pass_cache(pRenderer);
+	gDescriptorSetListMutex.Destroy();
 
 	// Destroy the Vulkan bits
 	vmaDestroyAllocator(pRenderer->pVmaAllocator);
@@ -2868,14 +3005,6 @@ void removeRenderer(Renderer* pRenderer)
 	nvapiExit();
 	agsExit();
 
-	pRenderPassMutex->Destroy();
-	gRenderPassMap->clear(true);
-	gFrameBufferMap->clear(true);
-
-	SAFE_FREE(pRenderPassMutex);
-	SAFE_FREE(gRenderPassMap);
-	SAFE_FREE(gFrameBufferMap);
-
 	for (uint32_t i = 0; i < pRenderer->mLinkedNodeCount; ++i)
 	{
 		SAFE_FREE(pRenderer->pAvailableQueueCount[i]);
@@ -3127,6 +3256,83 @@ void toggleVSync(Renderer* pRenderer, SwapChain** ppSwapChain)
 	addSwapChain(pRenderer, &desc, ppSwapChain);
 }
 
+static void transition_swapchain_render_targets(Renderer* pRenderer, uint32_t imageCount, RenderTarget** ppRenderTargets)
+{
+	RenderTargetBarrier barriers[MAX_SWAPCHAIN_IMAGES] = {};
+	for (uint32_t i = 0; i < imageCount; ++i)
+	{
+		barriers[i] = { ppRenderTargets[i], RESOURCE_STATE_UNDEFINED, RESOURCE_STATE_PRESENT };
+	}
+
+	Queue* queue = NULL;
+	CmdPool* cmdPool = NULL;
+	Cmd* cmd = NULL;
+	Fence* fence = NULL;
+	QueueDesc queueDesc = {};
+	queueDesc.mType = QUEUE_TYPE_GRAPHICS;
+	addQueue(pRenderer, &queueDesc, &queue);
+	CmdPoolDesc cmdPoolDesc = {};
+	cmdPoolDesc.pQueue = queue;
+	addCmdPool(pRenderer, &cmdPoolDesc, &cmdPool);
+	CmdDesc cmdDesc = {};
+	cmdDesc.pPool = cmdPool;
+	addCmd(pRenderer, &cmdDesc, &cmd);
+	addFence(pRenderer, &fence);
+	beginCmd(cmd);
+	cmdResourceBarrier(cmd, 0, NULL, 0, NULL, imageCount, barriers);
+	endCmd(cmd);
+	QueueSubmitDesc submitDesc = {};
+	submitDesc.mCmdCount = 1;
+	submitDesc.ppCmds = &cmd;
+	submitDesc.pSignalFence = fence;
+	queueSubmit(queue, &submitDesc);
+	waitForFences(pRenderer, 1, &fence);
+	removeFence(pRenderer, fence);
+	removeCmd(pRenderer, cmd);
+	removeCmdPool(pRenderer, cmdPool);
+	removeQueue(pRenderer, queue);
+}
+
+#if defined(VK_USE_PLATFORM_XLIB_KHR) || defined(VK_USE_PLATFORM_XCB_KHR)
+// Headless runs have no display to create a surface for. The swapchain is backed by plain render targets
+// that are cycled by acquireNextImage and never presented.
+static void add_headless_swapchain(Renderer* pRenderer, const SwapChainDesc* pDesc, SwapChain** ppSwapChain)
+{
+	const uint32_t imageCount = pDesc->mImageCount ? pDesc->mImageCount : 2;
+
+	SwapChain* pSwapChain = (SwapChain*)tf_calloc(1, sizeof(SwapChain) + imageCount * sizeof(RenderTarget*) + sizeof(SwapChainDesc));
+	ASSERT(pSwapChain);
+	pSwapChain->ppRenderTargets = (RenderTarget**)(pSwapChain + 1);
+	pSwapChain->pDesc = (SwapChainDesc*)(pSwapChain->ppRenderTargets + imageCount);
+
+	*pSwapChain->pDesc = *pDesc;
+	pSwapChain->pDesc->mImageCount = imageCount;
+	if (TinyImageFormat_UNDEFINED == pSwapChain->pDesc->mColorFormat)
+		pSwapChain->pDesc->mColorFormat = TinyImageFormat_B8G8R8A8_UNORM;
+
+	RenderTargetDesc descColor = {};
+	descColor.mWidth = pDesc->mWidth;
+	descColor.mHeight = pDesc->mHeight;
+	descColor.mDepth = 1;
+	descColor.mArraySize = 1;
+	descColor.mFormat = pSwapChain->pDesc->mColorFormat;
+	descColor.mClearValue = pDesc->mColorClearValue;
+	descColor.mSampleCount = SAMPLE_COUNT_1;
+	descColor.mSampleQuality = 0;
+	for (uint32_t i = 0; i < imageCount; ++i)
+	{
+		addRenderTarget(pRenderer, &descColor, &pSwapChain->ppRenderTargets[i]);
+	}
+
+	transition_swapchain_render_targets(pRenderer, imageCount, pSwapChain->ppRenderTargets);
+
+	pSwapChain->mEnableVsync = pDesc->mEnableVsync;
+	pSwapChain->mImageCount = imageCount;
+	pSwapChain->mHeadlessImageIndex = imageCount - 1;
+	*ppSwapChain = pSwapChain;
+}
+#endif
+
 void addSwapChain(Renderer* pRenderer, const SwapChainDesc* pDesc, SwapChain** ppSwapChain)
 {
 	ASSERT(pRenderer);
@@ -3134,6 +3340,20 @@ void addSwapChain(Renderer* pRenderer, const SwapChainDesc* pDesc, SwapChain** p
 	ASSERT(ppSwapChain);
 	ASSERT(pDesc->mImageCount <= MAX_SWAPCHAIN_IMAGES);
 
+#if defined(VK_USE_PLATFORM_XLIB_KHR)
+	if (!pDesc->mWindowHandle.display)
+	{
+		add_headless_swapchain(pRenderer, pDesc, ppSwapChain);
+		return;
+	}
+#elif defined(VK_USE_PLATFORM_XCB_KHR)
+	if (!pDesc->mWindowHandle.connection)
+	{
+		add_headless_swapchain(pRenderer, pDesc, ppSwapChain);
+		return;
+	}
+#endif
+
 	/************************************************************************/
 	// Create surface
 	/************************************************************************/
@@ -3433,43 +3653,14 @@ void addSwapChain(Renderer* pRenderer, const SwapChainDesc* pDesc, SwapChain** p
 	descColor.mSampleCount = SAMPLE_COUNT_1;
 	descColor.mSampleQuality = 0;
 
-	RenderTargetBarrier barriers[MAX_SWAPCHAIN_IMAGES] = {};
-
 	// Populate the vk_image field and add the Vulkan texture objects
 	for (uint32_t i = 0; i < imageCount; ++i)
 	{
 		descColor.pNativeHandle = (void*)images[i];
 		addRenderTarget(pRenderer, &descColor, &pSwapChain->ppRenderTargets[i]);
-		barriers[i] = { pSwapChain->ppRenderTargets[i], RESOURCE_STATE_UNDEFINED, RESOURCE_STATE_PRESENT };
 	}
 
-	Queue* queue = NULL;
-	CmdPool* cmdPool = NULL;
-	Cmd* cmd = NULL;
-	Fence* fence = NULL;
-	QueueDesc queueDesc = {};
-	queueDesc.mType = QUEUE_TYPE_GRAPHICS;
-	addQueue(pRenderer, &queueDesc, &queue);
-	CmdPoolDesc cmdPoolDesc = {};
-	cmdPoolDesc.pQueue = queue;
-	addCmdPool(pRenderer, &cmdPoolDesc, &cmdPool);
-	CmdDesc cmdDesc = {};
-	cmdDesc.pPool = cmdPool;
-	addCmd(pRenderer, &cmdDesc, &cmd);
-	addFence(pRenderer, &fence);
-	beginCmd(cmd);
-	cmdResourceBarrier(cmd, 0, NULL, 0, NULL, imageCount, barriers);
-	endCmd(cmd);
-	QueueSubmitDesc submitDesc = {};
-	submitDesc.mCmdCount = 1;
-	submitDesc.ppCmds = &cmd;
-	submitDesc.pSignalFence = fence;
-	queueSubmit(queue, &submitDesc);
-	waitForFences(pRenderer, 1, &fence);
-	removeFence(pRenderer, fence);
-	removeCmd(pRenderer, cmd);
-	removeCmdPool(pRenderer, cmdPool);
-	removeQueue(pRenderer, queue);
+	transition_swapchain_render_targets(pRenderer, imageCount, pSwapChain->ppRenderTargets);
 	/************************************************************************/
 	/************************************************************************/
 	*pSwapChain->pDesc = *pDesc;
@@ -3650,6 +3841,14 @@ void removeBuffer(Renderer* pRenderer, Buffer* pBuffer)
 	ASSERT(VK_NULL_HANDLE != pRenderer->pVkDevice);
 	ASSERT(VK_NULL_HANDLE != pBuffer->pVkBuffer);
 
+	uint64_t handles[3] = { (uint64_t)pBuffer->pVkBuffer };
+	uint32_t handleCount = 1;
+	if (pBuffer->pVkUniformTexelView)
+		handles[handleCount++] = (uint64_t)pBuffer->pVkUniformTexelView;
+	if (pBuffer->pVkStorageTexelView)
+		handles[handleCount++] = (uint64_t)pBuffer->pVkStorageTexelView;
+	invalidate_descriptor_set_written_data(handles, handleCount);
+
 	if (pBuffer->pVkUniformTexelView)
 	{
 		vkDestroyBufferView(pRenderer->pVkDevice, pBuffer->pVkUniformTexelView, &gVkAllocationCallbacks);
@@ -3960,6 +4159,16 @@ void removeTexture(Renderer* pRenderer, Texture* pTexture)
 	ASSERT(VK_NULL_HANDLE != pRenderer->pVkDevice);
 	ASSERT(VK_NULL_HANDLE != pTexture->pVkImage);
 
+	uint64_t* pHandles = (uint64_t*)alloca((2 + pTexture->mMipLevels) * sizeof(uint64_t));
+	uint32_t  handleCount = 0;
+	if (VK_NULL_HANDLE != pTexture->pVkSRVDescriptor)
+		pHandles[handleCount++] = (uint64_t)pTexture->pVkSRVDescriptor;
+	if (VK_NULL_HANDLE != pTexture->pVkSRVStencilDescriptor)
+		pHandles[handleCount++] = (uint64_t)pTexture->pVkSRVStencilDescriptor;
+	for (uint32_t i = 0; pTexture->pVkUAVDescriptors && i < pTexture->mMipLevels; ++i)
+		pHandles[handleCount++] = (uint64_t)pTexture->pVkUAVDescriptors[i];
+	invalidate_descriptor_set_written_data(pHandles, handleCount);
+
 	if (pTexture->mOwnsImage)
 		vmaDestroyImage(pRenderer->pVmaAllocator, pTexture->pVkImage, pTexture->pVkAllocation);
 
@@ -4120,6 +4329,8 @@ void addRenderTarget(Renderer* pRenderer, const RenderTargetDesc* pDesc, RenderT
 
 void removeRenderTarget(Renderer* pRenderer, RenderTarget* pRenderTarget)
 {
+	evict_render_target_frame_buffers(pRenderer, pRenderTarget->mId);
+
 	::removeTexture(pRenderer, pRenderTarget->pTexture);
 
 	vkDestroyImageView(pRenderer->pVkDevice, pRenderTarget->pVkDescriptor, &gVkAllocationCallbacks);
@@ -4183,6 +4394,9 @@ void removeSampler(Renderer* pRenderer, Sampler* pSampler)
 	ASSERT(VK_NULL_HANDLE != pRenderer->pVkDevice);
 	ASSERT(VK_NULL_HANDLE != pSampler->pVkSampler);
 
+	const uint64_t handle = (uint64_t)pSampler->pVkSampler;
+	invalidate_descriptor_set_written_data(&handle, 1);
+
 	vkDestroySampler(pRenderer->pVkDevice, pSampler->pVkSampler, &gVkAllocationCallbacks);
 
 	SAFE_FREE(pSampler);
@@ -4229,8 +4443,9 @@ void addDescriptorSet(Renderer* pRenderer, const DescriptorSetDesc* pDesc, Descr
 	if (VK_NULL_HANDLE != pRootSignature->mVkDescriptorSetLayouts[updateFreq])
 	{
 		totalSize += pDesc->mMaxSets * sizeof(VkDescriptorSet);
-		totalSize += pDesc->mMaxSets * sizeof(DescriptorUpdateData*);
-		totalSize += pDesc->mMaxSets * descriptorCount * sizeof(DescriptorUpdateData);
+		totalSize += pDesc->mMaxSets * sizeof(DescriptorUpdateData*) * 2;
+		totalSize += pDesc->mMaxSets * descriptorCount * sizeof(DescriptorUpdateData) * 2;
+		totalSize += pDesc->mMaxSets * sizeof(bool);
 	}
 	if (dynamicOffsetCount)
 	{
@@ -4256,6 +4471,9 @@ void addDescriptorSet(Renderer* pRenderer, const DescriptorSetDesc* pDesc, Descr
 		pDescriptorSet->ppUpdateData = (DescriptorUpdateData**)pMem;
 		pMem += pDesc->mMaxSets * sizeof(DescriptorUpdateData*);
 
+		pDescriptorSet->ppWrittenData = (DescriptorUpdateData**)pMem;
+		pMem += pDesc->mMaxSets * sizeof(DescriptorUpdateData*);
+
 		VkDescriptorSetLayout* pLayouts = (VkDescriptorSetLayout*)alloca(pDesc->mMaxSets * sizeof(VkDescriptorSetLayout));
 		VkDescriptorSet** pHandles = (VkDescriptorSet**)alloca(pDesc->mMaxSets * sizeof(VkDescriptorSet*));
 
@@ -4269,6 +4487,12 @@ void addDescriptorSet(Renderer* pRenderer, const DescriptorSetDesc* pDesc, Descr
 			memcpy(pDescriptorSet->ppUpdateData[i], pRootSignature->pUpdateTemplateData[updateFreq][pDescriptorSet->mNodeIndex], descriptorCount * sizeof(DescriptorUpdateData));
 		}
 
+		for (uint32_t i = 0; i < pDesc->mMaxSets; ++i)
+		{
+			pDescriptorSet->ppWrittenData[i] = (DescriptorUpdateData*)pMem;
+			pMem += descriptorCount * sizeof(DescriptorUpdateData);
+		}
+
 		consume_descriptor_sets(pRenderer->pDescriptorPool, pLayouts, pHandles, pDesc->mMaxSets);
 	}
 	else
@@ -4284,6 +4508,19 @@ void addDescriptorSet(Renderer* pRenderer, const DescriptorSetDesc* pDesc, Descr
 		pMem += pDescriptorSet->mMaxSets * sizeof(SizeOffset);
 	}
 
+	if (pDescriptorSet->ppWrittenData)
+	{
+		// No set was written yet
+		pDescriptorSet->pWritten = (bool*)pMem;
+		pMem += pDescriptorSet->mMaxSets * sizeof(bool);
+
+		MutexLock lock(gDescriptorSetListMutex);
+		pDescriptorSet->pNextSet = pDescriptorSetList;
+		if (pDescriptorSetList)
+			pDescriptorSetList->pPrevSet = pDescriptorSet;
+		pDescriptorSetList = pDescriptorSet;
+	}
+
 	*ppDescriptorSet = pDescriptorSet;
 }
 
@@ -4292,10 +4529,22 @@ void removeDescriptorSet(Renderer* pRenderer, DescriptorSet* pDescriptorSet)
 	ASSERT(pRenderer);
 	ASSERT(pDescriptorSet);
 
+	if (pDescriptorSet->ppWrittenData)
+	{
+		MutexLock lock(gDescriptorSetListMutex);
+		if (pDescriptorSet->pPrevSet)
+			pDescriptorSet->pPrevSet->pNextSet = pDescriptorSet->pNextSet;
+		else
+			pDescriptorSetList = pDescriptorSet->pNextSet;
+		if (pDescriptorSet->pNextSet)
+			pDescriptorSet->pNextSet->pPrevSet = pDescriptorSet->pPrevSet;
+	}
+
 	SAFE_FREE(pDescriptorSet);
 }
 
-void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDescriptorSet, uint32_t count, const DescriptorData* pParams)
+// Fills the update data of the set from pParams. Returns false if nothing has to be written through the update template
+static bool fill_descriptor_set_update_data(Renderer* pRenderer, uint32_t index, DescriptorSet* pDescriptorSet, uint32_t count, const DescriptorData* pParams)
 {
 #if defined(ENABLE_GRAPHICS_DEBUG)
 #define VALIDATE_DESCRIPTOR(descriptor,...)																\
@@ -4339,13 +4588,18 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 
 		VALIDATE_DESCRIPTOR(pParam->pName || (paramIndex != -1), "DescriptorData has NULL name and invalid index");
 
-		const DescriptorInfo* pDesc = (paramIndex != -1) ? (pRootSignature->pDescriptors + paramIndex) : get_descriptor(pRootSignature, pParam->pName);
+		const DescriptorInfo* pDesc = NULL;
 		if (paramIndex != -1)
 		{
-			VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param index (%u)", paramIndex);
+			// Indices from getDescriptorIndexFromName are only valid for the root signature they were resolved on
+			VALIDATE_DESCRIPTOR(paramIndex < pRootSignature->mDescriptorCount, "Invalid descriptor with param index (%u)", paramIndex);
+			pDesc = pRootSignature->pDescriptors + paramIndex;
+			VALIDATE_DESCRIPTOR(!pParam->pName || !strcmp(pParam->pName, pDesc->pName),
+				"Descriptor param index (%u) refers to (%s) instead of (%s) in this root signature", paramIndex, pDesc->pName, pParam->pName);
 		}
 		else
 		{
+			pDesc = get_descriptor(pRootSignature, pParam->pName);
 			VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param name (%s)", pParam->pName);
 		}
 
@@ -4560,16 +4814,126 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 		}
 	}
 
-	// If this was called to just update a dynamic offset skip the update
-	if (update)
-		vkUpdateDescriptorSetWithTemplateKHR(pRenderer->pVkDevice, pDescriptorSet->pHandles[index],
-			pRootSignature->mUpdateTemplates[updateFreq], pUpdateData);
-
 #ifdef ENABLE_RAYTRACING
 	// Raytracing Update Descriptor Set since it does not support update template
 	if (raytracingWriteCount)
 		vkUpdateDescriptorSets(pRenderer->pVkDevice, raytracingWriteCount, raytracingWrites, 0, NULL);
 #endif
+
+	// If this was called to just update a dynamic offset skip the update
+	return update;
+}
+
+// Compares the update data of the set with what was last written to it. Returns true and keeps a copy if it differs
+static bool update_descriptor_set_written_data(DescriptorSet* pDescriptorSet, uint32_t index)
+{
+	const uint32_t descriptorCount = pDescriptorSet->pRootSignature->mVkCumulativeDescriptorCounts[pDescriptorSet->mUpdateFrequency];
+	const size_t   size = descriptorCount * sizeof(DescriptorUpdateData);
+
+	if (pDescriptorSet->pWritten[index] && !memcmp(pDescriptorSet->ppWrittenData[index], pDescriptorSet->ppUpdateData[index], size))
+	{
+		tfrg_atomic64_add_relaxed(&gDescriptorSetSkipCount, 1);
+		return false;
+	}
+
+	memcpy(pDescriptorSet->ppWrittenData[index], pDescriptorSet->ppUpdateData[index], size);
+	pDescriptorSet->pWritten[index] = true;
+	tfrg_atomic64_add_relaxed(&gDescriptorSetWriteCount, 1);
+	return true;
+}
+
+void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDescriptorSet, uint32_t count, const DescriptorData* pParams)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDescriptorSet);
+
+	if (fill_descriptor_set_update_data(pRenderer, index, pDescriptorSet, count, pParams) && update_descriptor_set_written_data(pDescriptorSet, index))
+	{
+		const RootSignature* pRootSignature = pDescriptorSet->pRootSignature;
+		vkUpdateDescriptorSetWithTemplateKHR(pRenderer->pVkDevice, pDescriptorSet->pHandles[index],
+			pRootSignature->mUpdateTemplates[pDescriptorSet->mUpdateFrequency], pDescriptorSet->ppUpdateData[index]);
+	}
+}
+
+void updateDescriptorSets(Renderer* pRenderer, uint32_t count, const DescriptorSetUpdateDesc* pDescs)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDescs || !count);
+
+	// Every template entry writes at least one descriptor so the descriptor count bounds the write count
+	uint32_t maxWriteCount = 0;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const DescriptorSet* pDescriptorSet = pDescs[i].pDescriptorSet;
+		maxWriteCount += pDescriptorSet->pRootSignature->mVkCumulativeDescriptorCounts[pDescriptorSet->mUpdateFrequency];
+	}
+
+	VkWriteDescriptorSet* pWrites = (VkWriteDescriptorSet*)tf_malloc(maxWriteCount * sizeof(VkWriteDescriptorSet));
+	uint32_t              writeCount = 0;
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const DescriptorSetUpdateDesc* pDesc = pDescs + i;
+		DescriptorSet*                 pDescriptorSet = pDesc->pDescriptorSet;
+		const uint32_t                 index = pDesc->mIndex;
+
+		if (!fill_descriptor_set_update_data(pRenderer, index, pDescriptorSet, pDesc->mParamCount, pDesc->pParams) ||
+			!update_descriptor_set_written_data(pDescriptorSet, index))
+			continue;
+
+		// Same writes as the update template would do, the update data stays alive until the set is removed
+		const RootSignature*                   pRootSignature = pDescriptorSet->pRootSignature;
+		const uint32_t                         updateFreq = pDescriptorSet->mUpdateFrequency;
+		const VkDescriptorUpdateTemplateEntry* pEntries = pRootSignature->pUpdateTemplateEntries[updateFreq];
+		const uint8_t*                         pUpdateData = (const uint8_t*)pDescriptorSet->ppUpdateData[index];
+
+		for (uint32_t e = 0; e < pRootSignature->mVkUpdateTemplateEntryCounts[updateFreq]; ++e)
+		{
+			const VkDescriptorUpdateTemplateEntry* pEntry = pEntries + e;
+			const bool texelBuffer = pEntry->descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER ||
+									 pEntry->descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+			// Image and buffer infos have the same size as DescriptorUpdateData so whole arrays can be written at once.
+			// Buffer views are smaller so they are written one by one
+			const uint32_t writesPerEntry = texelBuffer ? pEntry->descriptorCount : 1;
+
+			for (uint32_t w = 0; w < writesPerEntry; ++w)
+			{
+				const DescriptorUpdateData* pData = (const DescriptorUpdateData*)(pUpdateData + pEntry->offset) + w;
+				VkWriteDescriptorSet*       pWrite = pWrites + writeCount++;
+
+				*pWrite = {};
+				pWrite->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				pWrite->dstSet = pDescriptorSet->pHandles[index];
+				pWrite->dstBinding = pEntry->dstBinding;
+				pWrite->dstArrayElement = pEntry->dstArrayElement + w;
+				pWrite->descriptorCount = texelBuffer ? 1 : pEntry->descriptorCount;
+				pWrite->descriptorType = pEntry->descriptorType;
+
+				switch (pEntry->descriptorType)
+				{
+				case VK_DESCRIPTOR_TYPE_SAMPLER:
+				case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+				case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+				case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+				case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+					pWrite->pImageInfo = &pData->mImageInfo;
+					break;
+				case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+				case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+					pWrite->pTexelBufferView = &pData->mBuferView;
+					break;
+				default:
+					pWrite->pBufferInfo = &pData->mBufferInfo;
+					break;
+				}
+			}
+		}
+	}
+
+	if (writeCount)
+		vkUpdateDescriptorSets(pRenderer->pVkDevice, writeCount, pWrites, 0, NULL);
+
+	tf_free(pWrites);
 }
 
 void cmdBindDescriptorSet(Cmd* pCmd, uint32_t index, DescriptorSet* pDescriptorSet)
@@ -5272,7 +5636,8 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 			createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
 			CHECK_VKRESULT(vkCreateDescriptorUpdateTemplateKHR(pRenderer->pVkDevice, &createInfo, &gVkAllocationCallbacks, &pRootSignature->mUpdateTemplates[setIndex]));
 
-			tf_free(pEntries);
+			pRootSignature->pUpdateTemplateEntries[setIndex] = pEntries;
+			pRootSignature->mVkUpdateTemplateEntryCounts[setIndex] = (uint16_t)entryCount;
 		}
 		else if (VK_NULL_HANDLE != pRootSignature->mVkDescriptorSetLayouts[setIndex])
 		{
@@ -5298,6 +5663,7 @@ void removeRootSignature(Renderer* pRenderer, RootSignature* pRootSignature)
 				SAFE_FREE(pRootSignature->pUpdateTemplateData[i][nodeIndex]);
 
 		SAFE_FREE(pRootSignature->pUpdateTemplateData[i]);
+		SAFE_FREE(pRootSignature->pUpdateTemplateEntries[i]);
 	}
 
 	// Need delete since the destructor frees allocated memory
@@ -5826,72 +6192,93 @@ void cmdBindRenderTargets(
 
 	SampleCount sampleCount = SAMPLE_COUNT_1;
 
-	RenderPassMap&  renderPassMap = get_render_pass_map();
-	FrameBufferMap& frameBufferMap = get_frame_buffer_map();
-
-	const RenderPassMapIt  pNode = renderPassMap.find(renderPassHash);
-	const FrameBufferMapIt pFrameBufferNode = frameBufferMap.find(frameBufferHash);
+	RenderPassThreadCache* pThreadCache = get_render_pass_thread_cache();
+	const uint32_t         renderPassSlot = (uint32_t)(renderPassHash % RENDER_PASS_THREAD_CACHE_SIZE);
+	const uint32_t         frameBufferSlot = (uint32_t)(frameBufferHash % RENDER_PASS_THREAD_CACHE_SIZE);
 
 	RenderPass*  pRenderPass = NULL;
 	FrameBuffer* pFrameBuffer = NULL;
 
+	if (pThreadCache->pRenderPasses[renderPassSlot] && pThreadCache->mRenderPassHashes[renderPassSlot] == renderPassHash)
+		pRenderPass = pThreadCache->pRenderPasses[renderPassSlot];
+	if (pThreadCache->pFrameBuffers[frameBufferSlot] && pThreadCache->mFrameBufferHashes[frameBufferSlot] == frameBufferHash)
+		pFrameBuffer = pThreadCache->pFrameBuffers[frameBufferSlot];
+
 	// If a render pass of this combination already exists just use it or create a new one
-	if (pNode != renderPassMap.end())
+	if (!pRenderPass)
 	{
-		pRenderPass = pNode->second;
-	}
-	else
-	{
-		TinyImageFormat colorFormats[MAX_RENDER_TARGET_ATTACHMENTS] = {};
-		TinyImageFormat depthStencilFormat = TinyImageFormat_UNDEFINED;
-		for (uint32_t i = 0; i < renderTargetCount; ++i)
-		{
-			colorFormats[i] = ppRenderTargets[i]->mFormat;
-		}
-		if (pDepthStencil)
+		RenderPassCacheShard& shard = get_render_pass_cache_shard(renderPassHash);
+		MutexLock             lock(shard.mMutex);
+
+		const RenderPassMapIt pNode = shard.mRenderPasses.find(renderPassHash);
+		if (pNode != shard.mRenderPasses.end())
 		{
-			depthStencilFormat = pDepthStencil->mFormat;
-			sampleCount = pDepthStencil->mSampleCount;
+			pRenderPass = pNode->second;
 		}
-		else if (renderTargetCount)
+		else
 		{
-			sampleCount = ppRenderTargets[0]->mSampleCount;
-		}
+			TinyImageFormat colorFormats[MAX_RENDER_TARGET_ATTACHMENTS] = {};
+			TinyImageFormat depthStencilFormat = TinyImageFormat_UNDEFINED;
+			for (uint32_t i = 0; i < renderTargetCount; ++i)
+			{
+				colorFormats[i] = ppRenderTargets[i]->mFormat;
+			}
+			if (pDepthStencil)
+			{
+				depthStencilFormat = pDepthStencil->mFormat;
+				sampleCount = pDepthStencil->mSampleCount;
+			}
+			else if (renderTargetCount)
+			{
+				sampleCount = ppRenderTargets[0]->mSampleCount;
+			}
+
+			RenderPassDesc renderPassDesc = {};
+			renderPassDesc.mRenderTargetCount = renderTargetCount;
+			renderPassDesc.mSampleCount = sampleCount;
+			renderPassDesc.pColorFormats = colorFormats;
+			renderPassDesc.mDepthStencilFormat = depthStencilFormat;
+			renderPassDesc.pLoadActionsColor = pLoadActions ? pLoadActions->mLoadActionsColor : NULL;
+			renderPassDesc.mLoadActionDepth = pLoadActions ? pLoadActions->mLoadActionDepth : LOAD_ACTION_DONTCARE;
+			renderPassDesc.mLoadActionStencil = pLoadActions ? pLoadActions->mLoadActionStencil : LOAD_ACTION_DONTCARE;
+			add_render_pass(pCmd->pRenderer, &renderPassDesc, &pRenderPass);
 
-		RenderPassDesc renderPassDesc = {};
-		renderPassDesc.mRenderTargetCount = renderTargetCount;
-		renderPassDesc.mSampleCount = sampleCount;
-		renderPassDesc.pColorFormats = colorFormats;
-		renderPassDesc.mDepthStencilFormat = depthStencilFormat;
-		renderPassDesc.pLoadActionsColor = pLoadActions ? pLoadActions->mLoadActionsColor : NULL;
-		renderPassDesc.mLoadActionDepth = pLoadActions ? pLoadActions->mLoadActionDepth : LOAD_ACTION_DONTCARE;
-		renderPassDesc.mLoadActionStencil = pLoadActions ? pLoadActions->mLoadActionStencil : LOAD_ACTION_DONTCARE;
-		add_render_pass(pCmd->pRenderer, &renderPassDesc, &pRenderPass);
+			shard.mRenderPasses.insert({{ renderPassHash, pRenderPass }});
+		}
 
-		// No need of a lock here since this map is per thread
-		renderPassMap.insert({{ renderPassHash, pRenderPass }});
+		pThreadCache->mRenderPassHashes[renderPassSlot] = renderPassHash;
+		pThreadCache->pRenderPasses[renderPassSlot] = pRenderPass;
 	}
 
 	// If a frame buffer of this combination already exists just use it or create a new one
-	if (pFrameBufferNode != frameBufferMap.end())
+	if (!pFrameBuffer)
 	{
-		pFrameBuffer = pFrameBufferNode->second;
-	}
-	else
-	{
-		FrameBufferDesc desc = { 0 };
-		desc.mRenderTargetCount = renderTargetCount;
-		desc.pDepthStencil = pDepthStencil;
-		desc.ppRenderTargets = ppRenderTargets;
-		desc.pRenderPass = pRenderPass;
-		desc.pColorArraySlices = pColorArraySlices;
-		desc.pColorMipSlices = pColorMipSlices;
-		desc.mDepthArraySlice = depthArraySlice;
-		desc.mDepthMipSlice = depthMipSlice;
-		add_framebuffer(pCmd->pRenderer, &desc, &pFrameBuffer);
+		RenderPassCacheShard& shard = get_render_pass_cache_shard(frameBufferHash);
+		MutexLock             lock(shard.mMutex);
+
+		const FrameBufferMapIt pFrameBufferNode = shard.mFrameBuffers.find(frameBufferHash);
+		if (pFrameBufferNode != shard.mFrameBuffers.end())
+		{
+			pFrameBuffer = pFrameBufferNode->second;
+		}
+		else
+		{
+			FrameBufferDesc desc = { 0 };
+			desc.mRenderTargetCount = renderTargetCount;
+			desc.pDepthStencil = pDepthStencil;
+			desc.ppRenderTargets = ppRenderTargets;
+			desc.pRenderPass = pRenderPass;
+			desc.pColorArraySlices = pColorArraySlices;
+			desc.pColorMipSlices = pColorMipSlices;
+			desc.mDepthArraySlice = depthArraySlice;
+			desc.mDepthMipSlice = depthMipSlice;
+			add_framebuffer(pCmd->pRenderer, &desc, &pFrameBuffer);
 
-		// No need of a lock here since this map is per thread
-		frameBufferMap.insert({{ frameBufferHash, pFrameBuffer }});
+			shard.mFrameBuffers.insert({{ frameBufferHash, pFrameBuffer }});
+		}
+
+		pThreadCache->mFrameBufferHashes[frameBufferSlot] = frameBufferHash;
+		pThreadCache->pFrameBuffers[frameBufferSlot] = pFrameBuffer;
 	}
 
 	DECLARE_ZERO(VkRect2D, render_area);
@@ -6289,6 +6676,10 @@ typedef struct SubresourceDataDesc
 	uint32_t mArrayLayer;
 	uint32_t mRowPitch;
 	uint32_t mSlicePitch;
+	uint32_t mRegionX;
+	uint32_t mRegionY;
+	uint32_t mRegionWidth;
+	uint32_t mRegionHeight;
 } SubresourceDataDesc;
 
 void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pSrcBuffer, const SubresourceDataDesc* pSubresourceDesc)
@@ -6315,6 +6706,14 @@ void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pSrcBuffer, cons
 	copy.imageExtent.height = height;
 	copy.imageExtent.depth = depth;
 
+	if (pSubresourceDesc->mRegionWidth && pSubresourceDesc->mRegionHeight)
+	{
+		copy.imageOffset.x = (int32_t)pSubresourceDesc->mRegionX;
+		copy.imageOffset.y = (int32_t)pSubresourceDesc->mRegionY;
+		copy.imageExtent.width = pSubresourceDesc->mRegionWidth;
+		copy.imageExtent.height = pSubresourceDesc->mRegionHeight;
+	}
+
 	vkCmdCopyBufferToImage(pCmd->pVkCmdBuf, pSrcBuffer->pVkBuffer, pTexture->pVkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
 }
 /************************************************************************/
@@ -6324,9 +6723,18 @@ void acquireNextImage(Renderer* pRenderer, SwapChain* pSwapChain, Semaphore* pSi
 {
 	ASSERT(pRenderer);
 	ASSERT(VK_NULL_HANDLE != pRenderer->pVkDevice);
-	ASSERT(VK_NULL_HANDLE != pSwapChain->pSwapChain);
 	ASSERT(pSignalSemaphore || pFence);
 
+	if (VK_NULL_HANDLE == pSwapChain->pSwapChain)
+	{
+		// Headless swapchain, the images are always available so nothing gets signaled and nothing waits
+		pSwapChain->mHeadlessImageIndex = (pSwapChain->mHeadlessImageIndex + 1) % pSwapChain->mImageCount;
+		*pImageIndex = pSwapChain->mHeadlessImageIndex;
+		if (pSignalSemaphore)
+			pSignalSemaphore->mSignaled = false;
+		return;
+	}
+
 	VkResult vk_res = {};
 
 	if (pFence != NULL)
@@ -6511,6 +6919,27 @@ void queuePresent(Queue* pQueue, const QueuePresentDesc* pDesc)
 			}
 		}
 
+		if (VK_NULL_HANDLE == pSwapChain->pSwapChain)
+		{
+			// Headless swapchain, consume the wait semaphores so they can be signaled again next frame
+			if (waitCount)
+			{
+				VkPipelineStageFlags* wait_masks = (VkPipelineStageFlags*)alloca(waitCount * sizeof(VkPipelineStageFlags));
+				for (uint32_t i = 0; i < waitCount; ++i)
+					wait_masks[i] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+				DECLARE_ZERO(VkSubmitInfo, submit_info);
+				submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+				submit_info.waitSemaphoreCount = waitCount;
+				submit_info.pWaitSemaphores = wait_semaphores;
+				submit_info.pWaitDstStageMask = wait_masks;
+
+				MutexLock lock(*pQueue->pSubmitMutex);
+				CHECK_VKRESULT(vkQueueSubmit(pQueue->pVkQueue, 1, &submit_info, VK_NULL_HANDLE));
+			}
+			return;
+		}
+
 		uint32_t presentIndex = pDesc->mIndex;
 
 		DECLARE_ZERO(VkPresentInfoKHR, present_info);
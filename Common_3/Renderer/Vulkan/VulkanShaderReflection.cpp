@@ -75,6 +75,9 @@ void vk_createShaderReflection(const uint8_t* shaderCode, uint32_t shaderSize, S
 		return;    // TODO: error msg
 	}
 
+	if (loadCachedShaderReflection(shaderCode, shaderSize, shaderStage, pOutReflection))
+		return;
+
 	CrossCompiler cc;
 
 	CreateCrossCompiler((const uint32_t*)shaderCode, shaderSize / sizeof(uint32_t), &cc);
@@ -260,5 +263,7 @@ void vk_createShaderReflection(const uint8_t* shaderCode, uint32_t shaderSize, S
 
 	pOutReflection->pVariables = pVariables;
 	pOutReflection->mVariableCount = variablesCount;
+
+	addCachedShaderReflection(shaderCode, shaderSize, pOutReflection);
 }
 #endif    // #ifdef VULKAN
\ No newline at end of file
@@ -980,6 +980,16 @@ static inline size_t tf_mem_hash(const T* mem, size_t size, size_t prev = 216613
 	return (size_t)result;
 }
 
+// 64 bit FNV-1a, for keys that have to stay unique across many more items than tf_mem_hash can tell apart
+static inline uint64_t tf_mem_hash64(const void* mem, size_t size, uint64_t prev = 14695981039346656037ull)
+{
+	const uint8_t* bytes = (const uint8_t*)mem;
+	uint64_t       result = prev;
+	while (size--)
+		result = (result ^ *bytes++) * 1099511628211ull;
+	return result;
+}
+
 //----------------------------------------------------------------------------
 // Color conversions / packing / unpacking
 //----------------------------------------------------------------------------
@@ -74,6 +74,8 @@ namespace SoLoud
 		unsigned int mDataLength;
 		unsigned int mOffset;
 		bool mDataOwned;
+		// mDataPtr is a file mapping created by openToMem
+		bool mDataMapped;
 
 		virtual int eof();
 		virtual unsigned int read(unsigned char *aDst, unsigned int aBytes);
@@ -86,6 +88,8 @@ namespace SoLoud
 		result openMem(unsigned char *aData, unsigned int aDataLength, bool aCopy=false, bool aTakeOwnership=true);
 		result openToMem(const char *aFilename);
 		result openFileToMem(File *aFile);
+	private:
+		void release();
 	};
 };
 
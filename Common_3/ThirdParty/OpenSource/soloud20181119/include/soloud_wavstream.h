@@ -27,6 +27,8 @@ freely, subject to the following restrictions:
 
 #include <stdio.h>
 #include "soloud.h"
+#include "../../../../OS/Interfaces/IThread.h"
+#include "../../../../OS/Core/Atomics.h"
 
 struct stb_vorbis;
 #ifndef dr_flac_h
@@ -46,8 +48,16 @@ namespace SoLoud
 
 	class WavStreamInstance : public AudioSourceInstance
 	{
+		enum
+		{
+			// Decoded blocks kept ahead of the mixer, must be a power of two
+			DECODE_BLOCK_COUNT = 8,
+			DECODE_BLOCK_SIZE = SAMPLE_GRANULARITY
+		};
+
 		WavStream *mParent;
 		unsigned int mOffset;
+		unsigned int mDecodeOffset;
 		File *mFile;
 		union codec
 		{
@@ -59,6 +69,25 @@ namespace SoLoud
 		unsigned int mOggFrameSize;
 		unsigned int mOggFrameOffset;
 		float **mOggOutputs;
+
+		// Decode-ahead ring filled by the shared decode worker and drained by getAudio.
+		// Block i holds mDecodeFrames[i] frames, one plane of DECODE_BLOCK_SIZE floats per channel
+		float *mDecodeBuffer;
+		unsigned int mDecodeFrames[DECODE_BLOCK_COUNT];
+		tfrg_atomic32_t mDecodeRead;
+		tfrg_atomic32_t mDecodeWrite;
+		unsigned int mDecodeReadFrame;
+		tfrg_atomic32_t mDecodeEnded;
+		// Guards the codec and the decode state above except for mDecodeRead and mDecodeEnded
+		theforge::Mutex mCodecMutex;
+		// Link in the job queue of the decode worker, guarded by its mutex
+		WavStreamInstance *mDecodeNext;
+		bool mDecodeQueued;
+
+		unsigned int decode(float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize);
+		bool decodeBlock();
+		void queueDecode();
+		static void decodeThreadFunc(void *aData);
 	public:
 		WavStreamInstance(WavStream *aParent);
 		virtual unsigned int getAudio(float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize);
@@ -87,6 +116,8 @@ namespace SoLoud
 		File *mMemFile;
 		File *mStreamFile;
 		unsigned int mSampleCount;
+		// Instances decode on a worker thread shared by all streams ahead of the mixer, enabled by default
+		bool mDecodeAhead;
 
 		WavStream();
 		virtual ~WavStream();
@@ -95,6 +126,8 @@ namespace SoLoud
 		result loadToMem(const char *aFilename);
 		result loadFile(File *aFile);
 		result loadFileToMem(File *aFile);		
+		// Set whether instances created after this call decode on a worker thread
+		void setDecodeAhead(bool aDecodeAhead);
 		virtual AudioSourceInstance *createInstance();
 		time getLength();
 
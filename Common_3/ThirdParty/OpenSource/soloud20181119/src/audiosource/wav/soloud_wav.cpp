@@ -296,10 +296,11 @@ namespace SoLoud
 		if (aFilename == 0)
 			return INVALID_PARAMETER;
 		stop();
-		DiskFile dr;
-		int res = dr.open(aFilename);
+		// Decode straight from the file mapping instead of copying the encoded file
+		MemoryFile mr;
+		int res = mr.openToMem(aFilename);
 		if (res == SO_NO_ERROR)
-			return loadFile(&dr);
+			return testAndLoadFile(&mr);
 		return FILE_LOAD_FAILED;
 	}
 
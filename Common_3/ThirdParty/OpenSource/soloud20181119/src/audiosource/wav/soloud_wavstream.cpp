@@ -81,10 +81,70 @@ namespace SoLoud
 		return 1;
 	}
 
+	// One thread decodes ahead for all streaming instances. An instance is queued whenever its ring has room for another block,
+	// each job decodes a single block so all streams make progress
+	struct WavStreamDecodeWorker
+	{
+		theforge::Mutex mMutex;
+		// Signalled when a job is queued or the thread has to quit
+		theforge::ConditionVariable mQueueCond;
+		// Signalled whenever the thread finished a job
+		theforge::ConditionVariable mIdleCond;
+		WavStreamInstance *mQueueHead;
+		WavStreamInstance *mQueueTail;
+		// Instance the thread is decoding, it must not be destroyed until the job is done
+		WavStreamInstance *mCurrent;
+		bool mQuit;
+
+		// Serializes starting and joining the thread, held while the last instance waits for it to exit
+		theforge::Mutex mThreadMutex;
+		unsigned int mInstanceCount;
+		theforge::ThreadDesc mThreadDesc;
+		theforge::ThreadHandle mThread;
+
+		WavStreamDecodeWorker()
+		{
+			mMutex.Init();
+			mQueueCond.Init();
+			mIdleCond.Init();
+			mThreadMutex.Init();
+			mQueueHead = 0;
+			mQueueTail = 0;
+			mCurrent = 0;
+			mQuit = false;
+			mInstanceCount = 0;
+			mThreadDesc = {};
+			mThread = 0;
+		}
+
+		~WavStreamDecodeWorker()
+		{
+			mThreadMutex.Destroy();
+			mIdleCond.Destroy();
+			mQueueCond.Destroy();
+			mMutex.Destroy();
+		}
+	};
+
+	// Instances are created outside the audio mutex, the function local static makes the first use thread safe
+	static WavStreamDecodeWorker& getDecodeWorker()
+	{
+		static WavStreamDecodeWorker worker;
+		return worker;
+	}
+
 	WavStreamInstance::WavStreamInstance(WavStream *aParent)
 	{
 		mParent = aParent;
 		mOffset = 0;
+		mDecodeOffset = 0;
+		mDecodeBuffer = 0;
+		mDecodeRead = 0;
+		mDecodeWrite = 0;
+		mDecodeReadFrame = 0;
+		mDecodeEnded = 0;
+		mDecodeNext = 0;
+		mDecodeQueued = false;
 		mCodec.mOgg = 0;
 		mCodec.mFlac = 0;
 		mCodec.mMp3 = 0;
@@ -175,10 +235,65 @@ namespace SoLoud
 				return;
 			}
 		}
+
+		// A shared stream file is seeked by every instance, so only private files are decoded ahead
+		if (mFile && mFile != mParent->mStreamFile && mParent->mDecodeAhead)
+		{
+			// init() assigns the same value later, the decode worker needs it right away
+			mChannels = mParent->mChannels;
+			mDecodeBuffer = (float*)tf_malloc(sizeof(float) * DECODE_BLOCK_COUNT * DECODE_BLOCK_SIZE * mChannels);
+			mCodecMutex.Init();
+
+			WavStreamDecodeWorker &worker = getDecodeWorker();
+			worker.mThreadMutex.Acquire();
+			if (0 == worker.mInstanceCount++)
+			{
+				worker.mThreadDesc.pFunc = decodeThreadFunc;
+				worker.mThreadDesc.pData = &worker;
+				worker.mThread = theforge::create_thread(&worker.mThreadDesc);
+			}
+			worker.mThreadMutex.Release();
+
+			queueDecode();
+		}
 	}
 
 	WavStreamInstance::~WavStreamInstance()
 	{
+		if (mDecodeBuffer)
+		{
+			WavStreamDecodeWorker &worker = getDecodeWorker();
+			theforge::MutexLock threadLock(worker.mThreadMutex);
+
+			worker.mMutex.Acquire();
+			// Wait first, the job requeues the instance when it is done
+			while (worker.mCurrent == this)
+				worker.mIdleCond.Wait(worker.mMutex);
+			if (mDecodeQueued)
+			{
+				WavStreamInstance *prev = 0;
+				for (WavStreamInstance *it = worker.mQueueHead; it != this; prev = it, it = it->mDecodeNext)
+					;
+				(prev ? prev->mDecodeNext : worker.mQueueHead) = mDecodeNext;
+				if (worker.mQueueTail == this)
+					worker.mQueueTail = prev;
+			}
+			const bool last = 0 == --worker.mInstanceCount;
+			worker.mQuit = last;
+			worker.mMutex.Release();
+
+			if (last)
+			{
+				worker.mQueueCond.WakeOne();
+				theforge::join_thread(worker.mThread);
+				worker.mThread = 0;
+				worker.mQuit = false;
+			}
+
+			mCodecMutex.Destroy();
+			tf_free(mDecodeBuffer);
+		}
+
 		switch (mParent->mFiletype)
 		{
 		case WAVSTREAM_OGG:
@@ -233,11 +348,9 @@ namespace SoLoud
 
 	
 
-	unsigned int WavStreamInstance::getAudio(float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize)
+	unsigned int WavStreamInstance::decode(float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize)
 	{			
 		unsigned int offset = 0;
-		if (mFile == NULL)
-			return 0;
 		switch (mParent->mFiletype)
 		{
 		case WAVSTREAM_FLAC:
@@ -254,11 +367,11 @@ namespace SoLoud
 					{
 						for (k = 0; k < mChannels; k++)
 						{
-							aBuffer[k * aSamplesToRead + i + j] = tmp[j * mCodec.mFlac->channels + k];
+							aBuffer[k * aBufferSize + i + j] = tmp[j * mCodec.mFlac->channels + k];
 						}
 					}
 				}
-				mOffset += offset;
+				mDecodeOffset += offset;
 				return offset;
 			}
 			break;
@@ -276,11 +389,11 @@ namespace SoLoud
 					{
 						for (k = 0; k < mChannels; k++)
 						{
-							aBuffer[k * aSamplesToRead + i + j] = tmp[j * mCodec.mMp3->channels + k];
+							aBuffer[k * aBufferSize + i + j] = tmp[j * mCodec.mMp3->channels + k];
 						}
 					}
 				}
-				mOffset += offset;
+				mDecodeOffset += offset;
 				return offset;
 			}
 		break;
@@ -289,7 +402,7 @@ namespace SoLoud
 				if (mOggFrameOffset < mOggFrameSize)
 				{
 					int b = getOggData(mOggOutputs, aBuffer, aSamplesToRead, aBufferSize, mOggFrameSize, mOggFrameOffset, mChannels);
-					mOffset += b;
+					mDecodeOffset += b;
 					offset += b;
 					mOggFrameOffset += b;
 				}
@@ -299,13 +412,13 @@ namespace SoLoud
 					mOggFrameSize = stb_vorbis_get_frame_float(mCodec.mOgg, NULL, &mOggOutputs);
 					mOggFrameOffset = 0;
 					int b = getOggData(mOggOutputs, aBuffer + offset, aSamplesToRead - offset, aBufferSize, mOggFrameSize, mOggFrameOffset, mChannels);
-					mOffset += b;
+					mDecodeOffset += b;
 					offset += b;
 					mOggFrameOffset += b;
 
-					if (mOffset >= mParent->mSampleCount || b == 0)
+					if (mDecodeOffset >= mParent->mSampleCount || b == 0)
 					{
-						mOffset += offset;
+						mDecodeOffset += offset;
 						return offset;
 					}
 				}
@@ -325,11 +438,11 @@ namespace SoLoud
 					{
 						for (k = 0; k < mChannels; k++)
 						{
-							aBuffer[k * aSamplesToRead + i + j] = tmp[j * mCodec.mWav->channels + k];
+							aBuffer[k * aBufferSize + i + j] = tmp[j * mCodec.mWav->channels + k];
 						}
 					}
 				}
-				mOffset += offset;
+				mDecodeOffset += offset;
 				return offset;
 			}
 			break;
@@ -337,8 +450,169 @@ namespace SoLoud
 		return aSamplesToRead;
 	}
 
+	// Decodes the next block into the ring. Returns whether there is room for another one
+	bool WavStreamInstance::decodeBlock()
+	{
+		theforge::MutexLock lock(mCodecMutex);
+
+		unsigned int write = mDecodeWrite;
+		unsigned int read = tfrg_atomic32_load_acquire(&mDecodeRead);
+		if (tfrg_atomic32_load_relaxed(&mDecodeEnded) || write - read == DECODE_BLOCK_COUNT)
+			return false;
+
+		unsigned int block = write & (DECODE_BLOCK_COUNT - 1);
+		float *dst = mDecodeBuffer + block * DECODE_BLOCK_SIZE * mChannels;
+		unsigned int frames = decode(dst, DECODE_BLOCK_SIZE, DECODE_BLOCK_SIZE);
+		if (frames > DECODE_BLOCK_SIZE)
+			frames = DECODE_BLOCK_SIZE;
+		if (frames < DECODE_BLOCK_SIZE)
+			tfrg_atomic32_store_release(&mDecodeEnded, 1);
+		mDecodeFrames[block] = frames;
+		tfrg_atomic32_store_release(&mDecodeWrite, write + 1);
+
+		return frames == DECODE_BLOCK_SIZE && write + 1 - tfrg_atomic32_load_acquire(&mDecodeRead) < DECODE_BLOCK_COUNT;
+	}
+
+	// Queues a job on the decode worker unless one is pending already
+	void WavStreamInstance::queueDecode()
+	{
+		WavStreamDecodeWorker &worker = getDecodeWorker();
+		worker.mMutex.Acquire();
+		const bool queue = !mDecodeQueued;
+		if (queue)
+		{
+			mDecodeQueued = true;
+			mDecodeNext = 0;
+			(worker.mQueueTail ? worker.mQueueTail->mDecodeNext : worker.mQueueHead) = this;
+			worker.mQueueTail = this;
+		}
+		worker.mMutex.Release();
+		if (queue)
+			worker.mQueueCond.WakeOne();
+	}
+
+	void WavStreamInstance::decodeThreadFunc(void *aData)
+	{
+		WavStreamDecodeWorker *worker = (WavStreamDecodeWorker*)aData;
+
+		worker->mMutex.Acquire();
+		while (!worker->mQuit)
+		{
+			WavStreamInstance *instance = worker->mQueueHead;
+			if (!instance)
+			{
+				worker->mQueueCond.Wait(worker->mMutex);
+				continue;
+			}
+
+			worker->mQueueHead = instance->mDecodeNext;
+			if (!worker->mQueueHead)
+				worker->mQueueTail = 0;
+			instance->mDecodeQueued = false;
+			worker->mCurrent = instance;
+			worker->mMutex.Release();
+
+			const bool room = instance->decodeBlock();
+
+			worker->mMutex.Acquire();
+			worker->mCurrent = 0;
+			// Back to the end of the queue, so the other streams get their block first
+			if (room && !instance->mDecodeQueued)
+			{
+				instance->mDecodeQueued = true;
+				instance->mDecodeNext = 0;
+				(worker->mQueueTail ? worker->mQueueTail->mDecodeNext : worker->mQueueHead) = instance;
+				worker->mQueueTail = instance;
+			}
+			worker->mIdleCond.WakeAll();
+		}
+		worker->mMutex.Release();
+	}
+
+	unsigned int WavStreamInstance::getAudio(float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize)
+	{
+		if (mFile == NULL)
+			return 0;
+
+		if (!mDecodeBuffer)
+		{
+			unsigned int samples = decode(aBuffer, aSamplesToRead, aBufferSize);
+			if (samples < aSamplesToRead)
+				tfrg_atomic32_store_release(&mDecodeEnded, 1);
+			mOffset += samples;
+			return samples;
+		}
+
+		unsigned int offset = 0;
+		unsigned int silence = 0;
+		while (offset < aSamplesToRead)
+		{
+			unsigned int read = mDecodeRead;
+			if (read != tfrg_atomic32_load_acquire(&mDecodeWrite))
+			{
+				unsigned int block = read & (DECODE_BLOCK_COUNT - 1);
+				unsigned int frames = mDecodeFrames[block];
+				unsigned int samples = frames - mDecodeReadFrame;
+				if (samples > aSamplesToRead - offset)
+					samples = aSamplesToRead - offset;
+
+				const float *src = mDecodeBuffer + block * DECODE_BLOCK_SIZE * mChannels + mDecodeReadFrame;
+				for (unsigned int k = 0; k < mChannels; k++)
+				{
+					memcpy(aBuffer + k * aBufferSize + offset, src + k * DECODE_BLOCK_SIZE, sizeof(float) * samples);
+				}
+				offset += samples;
+				mDecodeReadFrame += samples;
+
+				if (mDecodeReadFrame == frames)
+				{
+					mDecodeReadFrame = 0;
+					tfrg_atomic32_store_release(&mDecodeRead, read + 1);
+					queueDecode();
+					// A partial block is the end of the stream
+					if (frames < DECODE_BLOCK_SIZE)
+						break;
+				}
+				continue;
+			}
+
+			// Underrun, decode the rest here unless the decode worker published a block meanwhile. The mixer must not wait for the
+			// worker, while it holds the codec the rest is silent. The full count is returned, a short read would loop the voice
+			if (!mCodecMutex.TryAcquire())
+			{
+				silence = aSamplesToRead - offset;
+				for (unsigned int k = 0; k < mChannels; k++)
+				{
+					memset(aBuffer + k * aBufferSize + offset, 0, sizeof(float) * silence);
+				}
+				break;
+			}
+			if (read != mDecodeWrite)
+			{
+				mCodecMutex.Release();
+				continue;
+			}
+			if (!tfrg_atomic32_load_relaxed(&mDecodeEnded))
+			{
+				unsigned int requested = aSamplesToRead - offset;
+				unsigned int samples = decode(aBuffer + offset, requested, aBufferSize);
+				if (samples < requested)
+					tfrg_atomic32_store_release(&mDecodeEnded, 1);
+				offset += samples;
+			}
+			mCodecMutex.Release();
+			break;
+		}
+
+		mOffset += offset;
+		return offset + silence;
+	}
+
 	result WavStreamInstance::rewind()
 	{
+		if (mDecodeBuffer)
+			mCodecMutex.Acquire();
+
 		switch (mParent->mFiletype)
 		{
 		case WAVSTREAM_OGG:
@@ -367,7 +641,18 @@ namespace SoLoud
 			break;
 		}
 		mOffset = 0;
+		mDecodeOffset = 0;
 		mStreamPosition = 0.0f;
+		tfrg_atomic32_store_release(&mDecodeEnded, 0);
+
+		if (mDecodeBuffer)
+		{
+			// Drop the blocks decoded before the seek
+			mDecodeReadFrame = 0;
+			tfrg_atomic32_store_release(&mDecodeWrite, mDecodeRead);
+			mCodecMutex.Release();
+			queueDecode();
+		}
 		return 0;
 	}
 
@@ -377,6 +662,11 @@ namespace SoLoud
 		{
 			return 1;
 		}
+		// The codec ran out before the sample count estimate and everything decoded was mixed
+		if (tfrg_atomic32_load_acquire(&mDecodeEnded) && mDecodeRead == tfrg_atomic32_load_acquire(&mDecodeWrite))
+		{
+			return 1;
+		}
 		return 0;
 	}
 
@@ -387,6 +677,7 @@ namespace SoLoud
 		mFiletype = WAVSTREAM_WAV;
 		mMemFile = 0;
 		mStreamFile = 0;
+		mDecodeAhead = true;
 	}
 	
 	WavStream::~WavStream()
@@ -554,12 +845,31 @@ namespace SoLoud
 
 	result WavStream::loadToMem(const char *aFilename)
 	{
-		DiskFile df;
-		int res = df.open(aFilename);
-		if (res == SO_NO_ERROR)
+		tf_free(mFilename);
+		tf_delete(mMemFile);
+		mStreamFile = 0;
+		mMemFile = 0;
+		mFilename = 0;
+		mSampleCount = 0;
+
+		MemoryFile *mf = tf_new(MemoryFile);
+		int res = mf->openToMem(aFilename);
+		if (res != SO_NO_ERROR)
+		{
+			tf_delete(mf);
+			return res;
+		}
+
+		res = parse(mf);
+
+		if (res != SO_NO_ERROR)
 		{
-			res = loadFileToMem(&df);
+			tf_delete(mf);
+			return res;
 		}
+
+		mMemFile = mf;
+
 		return res;
 	}
 
@@ -615,6 +925,11 @@ namespace SoLoud
 	}
 
 
+	void WavStream::setDecodeAhead(bool aDecodeAhead)
+	{
+		mDecodeAhead = aDecodeAhead;
+	}
+
 	result WavStream::parse(File *aFile)
 	{
 		int tag = aFile->read32();
@@ -147,8 +147,7 @@ namespace SoLoud
 
 	MemoryFile::~MemoryFile()
 	{
-		if (mDataOwned)
-			tf_free(mDataPtr);
+		release();
 	}
 
 	MemoryFile::MemoryFile()
@@ -157,17 +156,28 @@ namespace SoLoud
 		mDataLength = 0;
 		mOffset = 0;
 		mDataOwned = false;
+		mDataMapped = false;
 	}
 
-	result MemoryFile::openMem(unsigned char *aData, unsigned int aDataLength, bool aCopy, bool aTakeOwnership)
+	void MemoryFile::release()
 	{
-		if (aData == NULL || aDataLength == 0)
-			return INVALID_PARAMETER;
-
+		if (mDataMapped)
+			fsUnmapStream(mDataPtr, mDataLength);
+		else
 		if (mDataOwned)
 			tf_free(mDataPtr);
 		mDataPtr = 0;
 		mOffset = 0;
+		mDataOwned = false;
+		mDataMapped = false;
+	}
+
+	result MemoryFile::openMem(unsigned char *aData, unsigned int aDataLength, bool aCopy, bool aTakeOwnership)
+	{
+		if (aData == NULL || aDataLength == 0)
+			return INVALID_PARAMETER;
+
+		release();
 
 		mDataLength = aDataLength;
 
@@ -190,21 +200,33 @@ namespace SoLoud
 	{
 		if (!aFile)
 			return INVALID_PARAMETER;
-		if (mDataOwned)
-			tf_free(mDataPtr);
-		mDataPtr = 0;
-		mOffset = 0;
+		release();
+
+		FileStream fh = {};
+		if (!fsOpenStreamFromPath(RD_AUDIO, aFile, FM_READ_BINARY, &fh))
+			return FILE_NOT_FOUND;
 
-		DiskFile df;
-		int res = df.open(aFile);
-		if (res != SO_NO_ERROR)
-			return res;
+		mDataLength = (unsigned int)fsGetStreamFileSize(&fh);
+
+		// Plain files are mapped so the encoded data is never copied.
+		// Zipped and bundled streams cannot be mapped and are read into memory instead
+		void* pMapped = NULL;
+		if (fsMapStream(&fh, &pMapped))
+		{
+			fsCloseStream(&fh);
+			mDataPtr = (unsigned char*)pMapped;
+			mDataMapped = true;
+			return SO_NO_ERROR;
+		}
 
-		mDataLength = df.length();
 		mDataPtr = (unsigned char*)tf_calloc(mDataLength, sizeof(unsigned char));
 		if (mDataPtr == NULL)
+		{
+			fsCloseStream(&fh);
 			return OUT_OF_MEMORY;
-		df.read(mDataPtr, mDataLength);
+		}
+		fsReadFromStream(&fh, mDataPtr, mDataLength);
+		fsCloseStream(&fh);
 		mDataOwned = true;
 		return SO_NO_ERROR;
 	}
@@ -213,10 +235,7 @@ namespace SoLoud
 	{
 		if (!aFile)
 			return INVALID_PARAMETER;
-		if (mDataOwned)
-			tf_free(mDataPtr);
-		mDataPtr = 0;
-		mOffset = 0;
+		release();
 
 		mDataLength = aFile->length();
 		mDataPtr = (unsigned char*)tf_calloc(mDataLength, sizeof(unsigned char));
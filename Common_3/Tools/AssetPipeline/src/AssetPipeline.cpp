@@ -31,6 +31,7 @@
 #include "../../../ThirdParty/OpenSource/EASTL/string.h"
 #include "../../../ThirdParty/OpenSource/EASTL/vector.h"
 #include "../../../ThirdParty/OpenSource/EASTL/unordered_map.h"
+#include "../../../ThirdParty/OpenSource/EASTL/sort.h"
 
 // OZZ
 //#include "../../../ThirdParty/OpenSource/ozz-animation/include/ozz/base/io/stream.h"
@@ -45,6 +46,8 @@
 // TressFX
 #include "../../../ThirdParty/OpenSource/TressFX/TressFXAsset.h"
 
+#include "../../../ThirdParty/OpenSource/meshoptimizer/src/meshoptimizer.h"
+
 #define CGLTF_WRITE_IMPLEMENTATION
 #define CGLTF_IMPLEMENTATION
 #include "../../../ThirdParty/OpenSource/cgltf/cgltf_write.h"
@@ -58,6 +61,14 @@
 
 #include "../../FileSystem/IToolFileSystem.h"
 
+#include "../../../../Middleware_3/Animation/ClipFormat.h"
+#include "../../../../Middleware_3/Text/BakedFontFormat.h"
+#include "../../../Renderer/GeometryFormat.h"
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../../../ThirdParty/OpenSource/Nothings/stb_truetype.h"
+
 #include "../../../OS/Interfaces/IMemory.h"    //NOTE: this should be the last include in a .cpp
 
 typedef eastl::unordered_map<eastl::string, eastl::vector<eastl::string>> AnimationAssetMap;
@@ -551,6 +562,573 @@ bool AssetPipeline::ProcessVirtualTextures(ProcessAssetsSettings* settings)
 	return true;
 }
 
+bool AssetPipeline::ProcessFonts(ProcessAssetsSettings* settings)
+{
+	// Get all font files
+	eastl::vector<eastl::string> fontFilesInDirectory;
+	fsGetFilesWithExtension(RD_INPUT, "", ".ttf", fontFilesInDirectory);
+	fsGetFilesWithExtension(RD_INPUT, "", ".otf", fontFilesInDirectory);
+
+	bool success = true;
+	for (size_t i = 0; i < fontFilesInDirectory.size(); ++i)
+	{
+		const eastl::string& fontFile = fontFilesInDirectory[i];
+
+		eastl::string outputFile = fontFile;
+		outputFile.resize(outputFile.size() - 4);
+		outputFile.append("." BAKED_FONT_EXTENSION);
+
+		if (!settings->force)
+		{
+			time_t lastModified = fsGetLastModifiedTime(RD_INPUT, fontFile.c_str());
+			time_t lastProcessed = fsGetLastModifiedTime(RD_OUTPUT, outputFile.c_str());
+			if (lastModified < lastProcessed && lastProcessed != ~0u && lastProcessed > settings->minLastModifiedTime)
+				continue;
+		}
+
+		if (!settings->quiet)
+			LOGF(LogLevel::eINFO, "Baking font %s", fontFile.c_str());
+
+		if (!BakeFont(fontFile.c_str(), outputFile.c_str(), settings))
+		{
+			LOGF(LogLevel::eERROR, "Failed to bake font %s.", fontFile.c_str());
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+struct BakedGlyphBitmap
+{
+	BakedGlyph     mGlyph;
+	int            mGlyphIndex;
+	int            mWidth;
+	int            mHeight;
+	unsigned char* pPixels;
+};
+
+// Pixels between glyphs in the atlas so bilinear filtering never reads a neighbour
+#define BAKED_FONT_GLYPH_SPACING 1
+// Kerning of every glyph pair is only looked up below this many glyphs
+#define BAKED_FONT_MAX_KERNING_GLYPHS 1024
+
+bool AssetPipeline::BakeFont(const char* fontAsset, const char* fontOutput, ProcessAssetsSettings* settings)
+{
+	const float bakeSize = settings->mFontBakeSize > 0.0f ? settings->mFontBakeSize : 48.0f;
+	const int   padding = settings->mFontSdfPadding > 0.0f ? (int)settings->mFontSdfPadding : 8;
+
+	FileStream file = {};
+	if (!fsOpenStreamFromPath(RD_INPUT, fontAsset, FM_READ_BINARY, &file))
+		return false;
+
+	ssize_t fontSize = fsGetStreamFileSize(&file);
+	unsigned char* fontData = (unsigned char*)tf_malloc(fontSize);
+	fsReadFromStream(&file, fontData, fontSize);
+	fsCloseStream(&file);
+
+	stbtt_fontinfo info = {};
+	if (!stbtt_InitFont(&info, fontData, stbtt_GetFontOffsetForIndex(fontData, 0)))
+	{
+		tf_free(fontData);
+		return false;
+	}
+
+	const float scale = stbtt_ScaleForPixelHeight(&info, bakeSize);
+	int         ascent = 0;
+	int         descent = 0;
+	int         lineGap = 0;
+	stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+
+	// Printable Latin-1 when no range is given
+	uint32_t       defaultRanges[2][2] = { { 32, 126 }, { 160, 255 } };
+	uint32_t(*ranges)[2] = settings->mFontGlyphRangeCount ? settings->mFontGlyphRanges : defaultRanges;
+	const uint32_t rangeCount = settings->mFontGlyphRangeCount ? settings->mFontGlyphRangeCount : 2;
+
+	// Rasterize the distance field of every glyph
+	eastl::vector<BakedGlyphBitmap> glyphs;
+	const unsigned char onEdgeValue = 128;
+	const float         pixelDistScale = (float)onEdgeValue / (float)padding;
+	for (uint32_t r = 0; r < rangeCount; ++r)
+	{
+		for (uint32_t codepoint = ranges[r][0]; codepoint <= ranges[r][1]; ++codepoint)
+		{
+			bool duplicate = false;
+			for (size_t g = 0; g < glyphs.size() && !duplicate; ++g)
+				duplicate = glyphs[g].mGlyph.mCodepoint == codepoint;
+
+			const int glyphIndex = stbtt_FindGlyphIndex(&info, (int)codepoint);
+			if (duplicate || (glyphIndex == 0 && codepoint != 0))
+				continue;
+
+			int advance = 0;
+			int leftSideBearing = 0;
+			stbtt_GetGlyphHMetrics(&info, glyphIndex, &advance, &leftSideBearing);
+
+			BakedGlyphBitmap bitmap = {};
+			int              xOffset = 0;
+			int              yOffset = 0;
+			bitmap.pPixels = stbtt_GetGlyphSDF(
+				&info, scale, glyphIndex, padding, onEdgeValue, pixelDistScale, &bitmap.mWidth, &bitmap.mHeight, &xOffset, &yOffset);
+			bitmap.mGlyphIndex = glyphIndex;
+			bitmap.mGlyph.mCodepoint = codepoint;
+			bitmap.mGlyph.mXOffset = (float)xOffset;
+			bitmap.mGlyph.mYOffset = (float)yOffset;
+			bitmap.mGlyph.mXAdvance = advance * scale;
+			if (!bitmap.pPixels)
+			{
+				// Glyphs without outline such as the space only need their advance
+				bitmap.mWidth = 0;
+				bitmap.mHeight = 0;
+			}
+			glyphs.push_back(bitmap);
+		}
+	}
+
+	eastl::sort(glyphs.begin(), glyphs.end(), [](const BakedGlyphBitmap& a, const BakedGlyphBitmap& b) {
+		return a.mGlyph.mCodepoint < b.mGlyph.mCodepoint;
+	});
+
+	// Shelf pack the glyphs, tallest first, in a power of two atlas wide enough to be roughly square
+	uint32_t area = 0;
+	for (size_t g = 0; g < glyphs.size(); ++g)
+		area += (glyphs[g].mWidth + BAKED_FONT_GLYPH_SPACING) * (glyphs[g].mHeight + BAKED_FONT_GLYPH_SPACING);
+
+	uint32_t atlasWidth = 64;
+	while (atlasWidth * atlasWidth < area)
+		atlasWidth *= 2;
+
+	eastl::vector<uint32_t> packOrder(glyphs.size());
+	for (uint32_t g = 0; g < (uint32_t)glyphs.size(); ++g)
+		packOrder[g] = g;
+	eastl::sort(packOrder.begin(), packOrder.end(), [&glyphs](uint32_t a, uint32_t b) { return glyphs[a].mHeight > glyphs[b].mHeight; });
+
+	uint32_t penX = 0;
+	uint32_t penY = 0;
+	uint32_t shelfHeight = 0;
+	for (size_t p = 0; p < packOrder.size(); ++p)
+	{
+		BakedGlyphBitmap& bitmap = glyphs[packOrder[p]];
+		if (penX + bitmap.mWidth > atlasWidth)
+		{
+			penX = 0;
+			penY += shelfHeight + BAKED_FONT_GLYPH_SPACING;
+			shelfHeight = 0;
+		}
+
+		bitmap.mGlyph.mX0 = (uint16_t)penX;
+		bitmap.mGlyph.mY0 = (uint16_t)penY;
+		bitmap.mGlyph.mX1 = (uint16_t)(penX + bitmap.mWidth);
+		bitmap.mGlyph.mY1 = (uint16_t)(penY + bitmap.mHeight);
+
+		penX += bitmap.mWidth + BAKED_FONT_GLYPH_SPACING;
+		shelfHeight = max(shelfHeight, (uint32_t)bitmap.mHeight);
+	}
+
+	uint32_t atlasHeight = 64;
+	while (atlasHeight < penY + shelfHeight)
+		atlasHeight *= 2;
+
+	eastl::vector<uint8_t> atlas(atlasWidth * atlasHeight, 0);
+	for (size_t g = 0; g < glyphs.size(); ++g)
+	{
+		const BakedGlyphBitmap& bitmap = glyphs[g];
+		for (int y = 0; y < bitmap.mHeight; ++y)
+			memcpy(&atlas[(bitmap.mGlyph.mY0 + y) * atlasWidth + bitmap.mGlyph.mX0], bitmap.pPixels + y * bitmap.mWidth, bitmap.mWidth);
+	}
+
+	// Kerning of every pair of baked glyphs
+	eastl::vector<BakedKerning> kerning;
+	if (glyphs.size() <= BAKED_FONT_MAX_KERNING_GLYPHS)
+	{
+		for (size_t a = 0; a < glyphs.size(); ++a)
+		{
+			for (size_t b = 0; b < glyphs.size(); ++b)
+			{
+				const int advance = stbtt_GetGlyphKernAdvance(&info, glyphs[a].mGlyphIndex, glyphs[b].mGlyphIndex);
+				if (advance != 0)
+					kerning.push_back({ glyphs[a].mGlyph.mCodepoint, glyphs[b].mGlyph.mCodepoint, advance * scale });
+			}
+		}
+	}
+	else if (!settings->quiet)
+	{
+		LOGF(LogLevel::eWARNING, "Font %s: kerning is not baked for more than %u glyphs", fontAsset, BAKED_FONT_MAX_KERNING_GLYPHS);
+	}
+
+	BakedFontHeader header = {};
+	header.mMagic = BAKED_FONT_MAGIC;
+	header.mVersion = BAKED_FONT_VERSION;
+	header.mAtlasWidth = atlasWidth;
+	header.mAtlasHeight = atlasHeight;
+	header.mGlyphCount = (uint32_t)glyphs.size();
+	header.mKerningCount = (uint32_t)kerning.size();
+	header.mBakeSize = bakeSize;
+	header.mSdfPadding = (float)padding;
+	header.mAscender = ascent * scale;
+	header.mDescender = descent * scale;
+	header.mLineGap = lineGap * scale;
+
+	bool success = fsOpenStreamFromPath(RD_OUTPUT, fontOutput, FM_WRITE_BINARY, &file);
+	if (success)
+	{
+		fsWriteToStream(&file, &header, sizeof(header));
+		for (size_t g = 0; g < glyphs.size(); ++g)
+			fsWriteToStream(&file, &glyphs[g].mGlyph, sizeof(BakedGlyph));
+		if (!kerning.empty())
+			fsWriteToStream(&file, kerning.data(), kerning.size() * sizeof(BakedKerning));
+		fsWriteToStream(&file, atlas.data(), atlas.size());
+		fsCloseStream(&file);
+	}
+
+	for (size_t g = 0; g < glyphs.size(); ++g)
+		stbtt_FreeSDF(glyphs[g].pPixels, NULL);
+	tf_free(fontData);
+
+	return success;
+}
+
+bool AssetPipeline::ProcessGeometry(ProcessAssetsSettings* settings)
+{
+	// Get all glTF files
+	eastl::vector<eastl::string> geometryFilesInDirectory;
+	fsGetFilesWithExtension(RD_INPUT, "", ".gltf", geometryFilesInDirectory);
+	fsGetFilesWithExtension(RD_INPUT, "", ".glb", geometryFilesInDirectory);
+
+	// Scratch memory of meshoptimizer goes through our allocator
+	meshopt_setAllocator([](size_t size) { return tf_malloc(size); }, [](void* ptr) { tf_free(ptr); });
+
+	bool success = true;
+	for (size_t i = 0; i < geometryFilesInDirectory.size(); ++i)
+	{
+		const eastl::string& geometryFile = geometryFilesInDirectory[i];
+
+		eastl::string outputFile = geometryFile;
+		outputFile.resize(outputFile.rfind('.'));
+		outputFile.append("." GEOMETRY_FILE_EXTENSION);
+
+		if (!settings->force)
+		{
+			time_t lastModified = fsGetLastModifiedTime(RD_INPUT, geometryFile.c_str());
+			time_t lastProcessed = fsGetLastModifiedTime(RD_OUTPUT, outputFile.c_str());
+			if (lastModified < lastProcessed && lastProcessed != ~0u && lastProcessed > settings->minLastModifiedTime)
+				continue;
+		}
+
+		if (!settings->quiet)
+			LOGF(LogLevel::eINFO, "Optimizing geometry %s", geometryFile.c_str());
+
+		if (!OptimizeGeometry(geometryFile.c_str(), outputFile.c_str(), settings))
+		{
+			LOGF(LogLevel::eERROR, "Failed to optimize geometry %s.", geometryFile.c_str());
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+static ShaderSemantic GeometryAttributeSemantic(const cgltf_attribute* attr)
+{
+	switch (attr->type)
+	{
+	case cgltf_attribute_type_position: return SEMANTIC_POSITION;
+	case cgltf_attribute_type_normal: return SEMANTIC_NORMAL;
+	case cgltf_attribute_type_tangent: return SEMANTIC_TANGENT;
+	case cgltf_attribute_type_color: return SEMANTIC_COLOR;
+	case cgltf_attribute_type_texcoord:
+		if (attr->index <= SEMANTIC_TEXCOORD9 - SEMANTIC_TEXCOORD0)
+			return (ShaderSemantic)(SEMANTIC_TEXCOORD0 + attr->index);
+		return SEMANTIC_UNDEFINED;
+	default: return SEMANTIC_UNDEFINED;
+	}
+}
+
+bool AssetPipeline::OptimizeGeometry(const char* geometryAsset, const char* geometryOutput, ProcessAssetsSettings* settings)
+{
+	const uint32_t maxMeshletVertices = settings->mMeshletMaxVertices ? min(settings->mMeshletMaxVertices, 64U) : 64;
+	const uint32_t maxMeshletTriangles = settings->mMeshletMaxTriangles ? min(settings->mMeshletMaxTriangles, 126U) : 124;
+	// Overdraw optimization may make the vertex cache hit ratio up to 5% worse
+	const float overdrawThreshold = 1.05f;
+
+	cgltf_data* data = NULL;
+	void* srcFileData = NULL;
+	cgltf_result result = cgltf_parse_and_load(geometryAsset, &data, &srcFileData);
+	if (cgltf_result_success != result)
+		return false;
+
+	if (data->skins_count)
+	{
+		LOGF(LogLevel::eWARNING, "%s is skinned. Skinned geometry is not supported by the geometry container yet", geometryAsset);
+		tf_free(srcFileData);
+		cgltf_free(data);
+		return true;
+	}
+
+	// Every stream is stored as 32 bit floats, the runtime packs them into the vertex layout it is loaded with
+	uint32_t componentCounts[SEMANTIC_TEXCOORD9 + 1] = {};
+	for (uint32_t i = 0; i < data->meshes_count; ++i)
+	{
+		for (uint32_t p = 0; p < data->meshes[i].primitives_count; ++p)
+		{
+			const cgltf_primitive* prim = &data->meshes[i].primitives[p];
+			if (cgltf_primitive_type_triangles != prim->type)
+			{
+				LOGF(LogLevel::eERROR, "%s: only triangle lists are supported", geometryAsset);
+				tf_free(srcFileData);
+				cgltf_free(data);
+				return false;
+			}
+
+			for (uint32_t a = 0; a < prim->attributes_count; ++a)
+			{
+				const ShaderSemantic semantic = GeometryAttributeSemantic(&prim->attributes[a]);
+				const uint32_t components = (uint32_t)cgltf_num_components(prim->attributes[a].data->type);
+				if (SEMANTIC_UNDEFINED == semantic)
+					continue;
+
+				if (componentCounts[semantic] && componentCounts[semantic] != components)
+				{
+					LOGF(LogLevel::eERROR, "%s: attribute %s has a different type in different primitives", geometryAsset, prim->attributes[a].name);
+					tf_free(srcFileData);
+					cgltf_free(data);
+					return false;
+				}
+				componentCounts[semantic] = components;
+			}
+		}
+	}
+
+	if (3 != componentCounts[SEMANTIC_POSITION])
+	{
+		LOGF(LogLevel::eERROR, "%s has no positions", geometryAsset);
+		tf_free(srcFileData);
+		cgltf_free(data);
+		return false;
+	}
+
+	eastl::vector<float>            streams[SEMANTIC_TEXCOORD9 + 1];
+	eastl::vector<uint32_t>         indices;
+	eastl::vector<GeometryFileDraw> draws;
+	eastl::vector<Meshlet>          meshlets;
+	uint32_t                        vertexCount = 0;
+
+	eastl::vector<float>           primStreams[SEMANTIC_TEXCOORD9 + 1];
+	eastl::vector<uint32_t>        primIndices;
+	eastl::vector<uint32_t>        scratch;
+	eastl::vector<meshopt_Meshlet> primMeshlets;
+
+	for (uint32_t i = 0; i < data->meshes_count; ++i)
+	{
+		for (uint32_t p = 0; p < data->meshes[i].primitives_count; ++p)
+		{
+			const cgltf_primitive* prim = &data->meshes[i].primitives[p];
+			const uint32_t primVertexCount = (uint32_t)prim->attributes->data->count;
+			const uint32_t primIndexCount = prim->indices ? (uint32_t)prim->indices->count : primVertexCount;
+
+			// Unpack the primitive. Attributes missing in this primitive are zero
+			primIndices.resize(primIndexCount);
+			for (uint32_t idx = 0; idx < primIndexCount; ++idx)
+				primIndices[idx] = prim->indices ? (uint32_t)cgltf_accessor_read_index(prim->indices, idx) : idx;
+
+			for (uint32_t s = 0; s <= SEMANTIC_TEXCOORD9; ++s)
+			{
+				primStreams[s].clear();
+				primStreams[s].resize(primVertexCount * componentCounts[s], 0.0f);
+			}
+
+			for (uint32_t a = 0; a < prim->attributes_count; ++a)
+			{
+				const ShaderSemantic semantic = GeometryAttributeSemantic(&prim->attributes[a]);
+				if (SEMANTIC_UNDEFINED != semantic)
+					cgltf_accessor_unpack_floats(prim->attributes[a].data, primStreams[semantic].data(), primStreams[semantic].size());
+			}
+
+			const float* positions = primStreams[SEMANTIC_POSITION].data();
+
+			// Reorder triangles for the vertex cache, then to reduce overdraw
+			scratch.resize(primIndexCount);
+			meshopt_optimizeVertexCache(scratch.data(), primIndices.data(), primIndexCount, primVertexCount);
+			meshopt_optimizeOverdraw(
+				primIndices.data(), scratch.data(), primIndexCount, positions, primVertexCount, sizeof(float[3]), overdrawThreshold);
+
+			// Reorder vertices in the order the triangles use them, unused vertices are dropped
+			scratch.resize(primVertexCount);
+			const uint32_t usedVertexCount =
+				(uint32_t)meshopt_optimizeVertexFetchRemap(scratch.data(), primIndices.data(), primIndexCount, primVertexCount);
+			meshopt_remapIndexBuffer(primIndices.data(), primIndices.data(), primIndexCount, scratch.data());
+
+			for (uint32_t s = 0; s <= SEMANTIC_TEXCOORD9; ++s)
+			{
+				if (!componentCounts[s])
+					continue;
+
+				const size_t first = streams[s].size();
+				streams[s].resize(first + usedVertexCount * componentCounts[s]);
+				meshopt_remapVertexBuffer(
+					streams[s].data() + first, primStreams[s].data(), primVertexCount, componentCounts[s] * sizeof(float), scratch.data());
+			}
+
+			// Split into meshlets and store the index data meshlet by meshlet
+			positions = streams[SEMANTIC_POSITION].data() + vertexCount * 3;
+			primMeshlets.resize(meshopt_buildMeshletsBound(primIndexCount, maxMeshletVertices, maxMeshletTriangles));
+			primMeshlets.resize(meshopt_buildMeshlets(
+				primMeshlets.data(), primIndices.data(), primIndexCount, usedVertexCount, maxMeshletVertices, maxMeshletTriangles));
+
+			GeometryFileDraw draw = {};
+			draw.mStartIndex = (uint32_t)indices.size();
+			draw.mStartMeshlet = (uint32_t)meshlets.size();
+			draw.mMeshletCount = (uint32_t)primMeshlets.size();
+
+			for (size_t m = 0; m < primMeshlets.size(); ++m)
+			{
+				const meshopt_Meshlet& src = primMeshlets[m];
+				const meshopt_Bounds   bounds = meshopt_computeMeshletBounds(&src, positions, usedVertexCount, sizeof(float[3]));
+
+				Meshlet meshlet = {};
+				memcpy(meshlet.mCenter, bounds.center, sizeof(meshlet.mCenter));
+				meshlet.mRadius = bounds.radius;
+				memcpy(meshlet.mConeApex, bounds.cone_apex, sizeof(meshlet.mConeApex));
+				memcpy(meshlet.mConeAxis, bounds.cone_axis, sizeof(meshlet.mConeAxis));
+				meshlet.mConeCutoff = bounds.cone_cutoff;
+				meshlet.mStartIndex = (uint32_t)indices.size();
+				meshlet.mTriangleCount = src.triangle_count;
+				meshlet.mVertexCount = src.vertex_count;
+				meshlet.mDrawIndex = (uint32_t)draws.size();
+				meshlets.push_back(meshlet);
+
+				for (uint32_t t = 0; t < src.triangle_count; ++t)
+					for (uint32_t k = 0; k < 3; ++k)
+						indices.push_back(vertexCount + src.vertices[src.indices[t][k]]);
+			}
+
+			draw.mIndexCount = (uint32_t)indices.size() - draw.mStartIndex;
+			draws.push_back(draw);
+
+			vertexCount += usedVertexCount;
+		}
+	}
+
+	tf_free(srcFileData);
+	cgltf_free(data);
+
+	static const TinyImageFormat floatFormats[] = { TinyImageFormat_UNDEFINED, TinyImageFormat_R32_SFLOAT, TinyImageFormat_R32G32_SFLOAT,
+													TinyImageFormat_R32G32B32_SFLOAT, TinyImageFormat_R32G32B32A32_SFLOAT };
+
+	GeometryFileAttribute  attributes[SEMANTIC_TEXCOORD9 + 1] = {};
+	eastl::vector<uint8_t> attributeData[SEMANTIC_TEXCOORD9 + 1];
+	eastl::vector<uint8_t> packed;
+	uint32_t               attributeCount = 0;
+	for (uint32_t s = 0; s <= SEMANTIC_TEXCOORD9; ++s)
+	{
+		if (!componentCounts[s] || componentCounts[s] > 4)
+			continue;
+
+		GeometryFileAttribute& attr = attributes[attributeCount++];
+		attr.mSemantic = s;
+		attr.mFormat = (uint32_t)floatFormats[componentCounts[s]];
+		attr.mStride = componentCounts[s] * (uint32_t)sizeof(float);
+
+		const uint8_t* src = (const uint8_t*)streams[s].data();
+		const bool     texcoord = s >= SEMANTIC_TEXCOORD0 && s <= SEMANTIC_TEXCOORD9;
+		const bool     direction = SEMANTIC_NORMAL == s || SEMANTIC_TANGENT == s;
+		if (settings->mPackVertices && ((texcoord && 2 == componentCounts[s]) || (direction && componentCounts[s] >= 3)))
+		{
+			// Same formats the runtime packs these semantics to, so layouts asking for them load without any conversion
+			packed.resize(vertexCount * sizeof(uint32_t));
+			uint16_t* dst = (uint16_t*)packed.data();
+			for (uint32_t v = 0; v < vertexCount; ++v)
+			{
+				const float* f = streams[s].data() + v * componentCounts[s];
+				if (texcoord)
+				{
+					dst[v * 2 + 0] = meshopt_quantizeHalf(f[0]);
+					dst[v * 2 + 1] = meshopt_quantizeHalf(f[1]);
+					continue;
+				}
+
+				// Octahedral encoding, the tangent sign is dropped as the runtime does
+				const float absLength = fabsf(f[0]) + fabsf(f[1]) + fabsf(f[2]);
+				float       enc[2] = {};
+				if (absLength)
+				{
+					enc[0] = f[0] / absLength;
+					enc[1] = f[1] / absLength;
+					if (f[2] < 0.0f)
+					{
+						const float x = enc[0];
+						enc[0] = (1.0f - fabsf(enc[1])) * (x >= 0.0f ? 1.0f : -1.0f);
+						enc[1] = (1.0f - fabsf(x)) * (enc[1] >= 0.0f ? 1.0f : -1.0f);
+					}
+					enc[0] = enc[0] * 0.5f + 0.5f;
+					enc[1] = enc[1] * 0.5f + 0.5f;
+				}
+				dst[v * 2 + 0] = absLength ? (uint16_t)meshopt_quantizeUnorm(enc[0], 16) : 0;
+				dst[v * 2 + 1] = absLength ? (uint16_t)meshopt_quantizeUnorm(enc[1], 16) : 0;
+			}
+
+			attr.mFormat = (uint32_t)(texcoord ? TinyImageFormat_R16G16_SFLOAT : TinyImageFormat_R16G16_UNORM);
+			attr.mStride = sizeof(uint32_t);
+			src = packed.data();
+		}
+
+		// Strides are multiples of 4, as the vertex codec requires
+		eastl::vector<uint8_t>& data = attributeData[s];
+		data.resize(meshopt_encodeVertexBufferBound(vertexCount, attr.mStride));
+		data.resize(meshopt_encodeVertexBuffer(data.data(), data.size(), src, vertexCount, attr.mStride));
+		attr.mDataSize = (uint32_t)data.size();
+		// Keep the next stream 4 byte aligned
+		data.resize(round_up(attr.mDataSize, 4), 0);
+	}
+
+	// Same rule as the runtime, 16 bit indices whenever the vertices of the whole geometry can be addressed with them.
+	// The codec stores the indices independently of it, the stride only selects the size they are decoded to
+	const uint32_t indexStride = vertexCount > UINT16_MAX ? sizeof(uint32_t) : sizeof(uint16_t);
+
+	eastl::vector<uint8_t> indexData(meshopt_encodeIndexBufferBound(indices.size(), vertexCount));
+	indexData.resize(meshopt_encodeIndexBuffer(indexData.data(), indexData.size(), indices.data(), indices.size()));
+
+	GeometryFileHeader header = {};
+	header.mMagic = GEOMETRY_FILE_MAGIC;
+	header.mVersion = GEOMETRY_FILE_VERSION;
+	header.mVertexCount = vertexCount;
+	header.mIndexCount = (uint32_t)indices.size();
+	header.mIndexStride = indexStride;
+	header.mIndexDataSize = (uint32_t)indexData.size();
+	header.mDrawCount = (uint32_t)draws.size();
+	header.mMeshletCount = (uint32_t)meshlets.size();
+	header.mAttributeCount = attributeCount;
+
+	indexData.resize(round_up(header.mIndexDataSize, 4), 0);
+
+	FileStream file = {};
+	if (!fsOpenStreamFromPath(RD_OUTPUT, geometryOutput, FM_WRITE_BINARY, &file))
+		return false;
+
+	fsWriteToStream(&file, &header, sizeof(header));
+	fsWriteToStream(&file, attributes, attributeCount * sizeof(GeometryFileAttribute));
+	fsWriteToStream(&file, draws.data(), draws.size() * sizeof(GeometryFileDraw));
+	fsWriteToStream(&file, meshlets.data(), meshlets.size() * sizeof(Meshlet));
+	fsWriteToStream(&file, indexData.data(), indexData.size());
+
+	size_t dataSize = indexData.size();
+	for (uint32_t a = 0; a < attributeCount; ++a)
+	{
+		const eastl::vector<uint8_t>& data = attributeData[attributes[a].mSemantic];
+		fsWriteToStream(&file, data.data(), data.size());
+		dataSize += data.size();
+	}
+
+	fsCloseStream(&file);
+
+	if (!settings->quiet)
+		LOGF(
+			LogLevel::eINFO, "%s: %u draws, %u vertices, %u triangles in %u meshlets, %u KB of compressed index and vertex data",
+			geometryOutput, header.mDrawCount, vertexCount, header.mIndexCount / 3, header.mMeshletCount, (uint32_t)(dataSize >> 10));
+
+	return true;
+}
+
 bool AssetPipeline::ProcessTFX(ProcessAssetsSettings* settings)
 {
 	cgltf_result result = cgltf_result_success;
@@ -1033,6 +1611,132 @@ bool AssetPipeline::CreateRuntimeSkeleton(
 	return true;
 }
 
+// Copies the keys of a track that fall in [start, end] to out, moved to start at time 0.
+// Keys are interpolated on both boundaries so every segment plays back exactly like the original clip
+template <typename Key, typename LerpFunc>
+static void SliceTrackKeys(
+	const typename ozz::Vector<Key>::Std& keys, float start, float end, typename ozz::Vector<Key>::Std& out, LerpFunc lerpFunc)
+{
+	out.clear();
+	if (keys.empty())
+		return;
+
+	// Value of the track at time, keys are sorted and hold their value outside of the keyed range
+	auto evaluate = [&](float time) -> typename Key::Value
+	{
+		if (time <= keys.front().time)
+			return keys.front().value;
+		if (time >= keys.back().time)
+			return keys.back().value;
+
+		size_t next = 1;
+		while (keys[next].time < time)
+			++next;
+
+		const Key& a = keys[next - 1];
+		const Key& b = keys[next];
+		return lerpFunc(a.value, b.value, (time - a.time) / (b.time - a.time));
+	};
+
+	Key first = { 0.f, evaluate(start) };
+	out.push_back(first);
+
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		if (keys[i].time > start && keys[i].time < end)
+		{
+			Key key = { keys[i].time - start, keys[i].value };
+			out.push_back(key);
+		}
+	}
+
+	Key last = { end - start, evaluate(end) };
+	out.push_back(last);
+}
+
+static Vector3 LerpKeyValue(const Vector3& a, const Vector3& b, float t) { return lerp(t, a, b); }
+
+static Quat NLerpKeyValue(const Quat& a, const Quat& b, float t)
+{
+	// Take the shortest path like the runtime sampler does
+	const Quat end = dot(a, b) < 0.f ? -b : b;
+	return normalize(lerp(t, a, end));
+}
+
+// Builds the animation in segments of settings->mClipSegmentDuration and writes them as a segmented clip (see ClipFormat.h)
+static bool WriteSegmentedAnimation(
+	const ozz::animation::offline::RawAnimation& rawAnimation, const char* animationName, const char* animationOutput,
+	ProcessAssetsSettings* settings)
+{
+	const float    segmentDuration = settings->mClipSegmentDuration;
+	const uint32_t numSegments = (uint32_t)ceilf(rawAnimation.duration / segmentDuration);
+
+	FileStream file = {};
+	if (!fsOpenStreamFromPath(RD_OUTPUT, animationOutput, FM_WRITE_BINARY, &file))
+		return false;
+
+	SegmentedClipHeader header = {};
+	header.mMagic = SEGMENTED_CLIP_MAGIC;
+	header.mVersion = SEGMENTED_CLIP_VERSION;
+	header.mNumSegments = numSegments;
+	header.mDuration = rawAnimation.duration;
+	header.mSegmentDuration = segmentDuration;
+	fsWriteToStream(&file, &header, sizeof(header));
+
+	// Offsets are patched once the segments are written
+	eastl::vector<uint32_t> offsets(numSegments + 1, 0);
+	fsWriteToStream(&file, offsets.data(), offsets.size() * sizeof(uint32_t));
+
+	bool success = true;
+	for (uint32_t s = 0; s < numSegments && success; ++s)
+	{
+		const float start = s * segmentDuration;
+		const float end = min(start + segmentDuration, rawAnimation.duration);
+
+		ozz::animation::offline::RawAnimation rawSegment;
+		rawSegment.name = rawAnimation.name;
+		rawSegment.duration = max(end - start, 1e-3f);
+		rawSegment.tracks.resize(rawAnimation.tracks.size());
+
+		for (size_t t = 0; t < rawAnimation.tracks.size(); ++t)
+		{
+			const ozz::animation::offline::RawAnimation::JointTrack& track = rawAnimation.tracks[t];
+			ozz::animation::offline::RawAnimation::JointTrack&       segmentTrack = rawSegment.tracks[t];
+
+			SliceTrackKeys<ozz::animation::offline::RawAnimation::TranslationKey>(
+				track.translations, start, end, segmentTrack.translations, LerpKeyValue);
+			SliceTrackKeys<ozz::animation::offline::RawAnimation::RotationKey>(
+				track.rotations, start, end, segmentTrack.rotations, NLerpKeyValue);
+			SliceTrackKeys<ozz::animation::offline::RawAnimation::ScaleKey>(track.scales, start, end, segmentTrack.scales, LerpKeyValue);
+		}
+
+		ozz::animation::Animation segment;
+		if (!rawSegment.Validate() || !ozz::animation::offline::AnimationBuilder::Build(rawSegment, &segment))
+		{
+			LOGF(LogLevel::eERROR, "Segment %u of animation %s can not be created.", s, animationName);
+			success = false;
+			break;
+		}
+
+		offsets[s] = (uint32_t)fsGetStreamSeekPosition(&file);
+
+		ozz::io::OArchive archive(&file);
+		archive << segment;
+		segment.Deallocate();
+	}
+
+	if (success)
+	{
+		offsets[numSegments] = (uint32_t)fsGetStreamSeekPosition(&file);
+		fsSeekStream(&file, SBO_START_OF_FILE, sizeof(header));
+		fsWriteToStream(&file, offsets.data(), offsets.size() * sizeof(uint32_t));
+	}
+
+	fsCloseStream(&file);
+
+	return success;
+}
+
 bool AssetPipeline::CreateRuntimeAnimation(
 	const char* animationAsset, ozz::animation::Skeleton* skeleton, const char* skeletonName, const char* animationName,
 	const char* animationOutput, ProcessAssetsSettings* settings)
@@ -1141,6 +1845,10 @@ bool AssetPipeline::CreateRuntimeAnimation(
 		return false;
 	}
 
+	// Long clips are split so they can be streamed instead of being fully resident
+	if (settings->mClipSegmentDuration > 0.f && rawAnimation.duration > settings->mClipSegmentDuration)
+		return WriteSegmentedAnimation(rawAnimation, animationName, animationOutput, settings);
+
 	// Build runtime animation from raw animation
 	ozz::animation::Animation animation;
 	if (!ozz::animation::offline::AnimationBuilder::Build(rawAnimation, &animation))
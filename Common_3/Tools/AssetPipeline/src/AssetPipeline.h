@@ -32,12 +32,29 @@
 extern ResourceDirectory RD_INPUT;
 extern ResourceDirectory RD_OUTPUT;
 
+// Maximum number of codepoint ranges baked into one font
+#define MAX_FONT_GLYPH_RANGES 16
+
 struct ProcessAssetsSettings
 {
 	bool quiet;                  // Only output warnings.
 	bool force;                  // Force all assets to be processed.
 	uint minLastModifiedTime;    // Force all assets older than this to be processed.
 
+	// Animation settings
+	float       mClipSegmentDuration;    // Clips longer than this many seconds are written as segments that are streamed at runtime. 0 disables it
+
+	// Font settings
+	float       mFontBakeSize;                                  // Pixel height glyphs are baked at. 0 uses the default
+	float       mFontSdfPadding;                                // Distance field range in pixels around each glyph. 0 uses the default
+	uint32_t    mFontGlyphRanges[MAX_FONT_GLYPH_RANGES][2];    // Inclusive codepoint ranges to bake. None bakes printable Latin-1
+	uint32_t    mFontGlyphRangeCount;
+
+	// Geometry settings
+	uint32_t    mMeshletMaxVertices;     // Vertex limit of one meshlet, at most 64. 0 uses 64
+	uint32_t    mMeshletMaxTriangles;    // Triangle limit of one meshlet, at most 126. 0 uses 124
+	bool        mPackVertices;           // Store 2 component texcoords as half2 and normals and tangents as octahedral unorm2x16
+
 	// TressFX settings
 	uint32_t    mFollowHairCount;
 	float       mMaxRadiusAroundGuideHair;
@@ -56,5 +73,9 @@ public:
 		const char* animationOutput, ProcessAssetsSettings* settings);
 
 	static bool ProcessVirtualTextures(ProcessAssetsSettings* settings);
+	static bool ProcessFonts(ProcessAssetsSettings* settings);
+	static bool BakeFont(const char* fontAsset, const char* fontOutput, ProcessAssetsSettings* settings);
+	static bool ProcessGeometry(ProcessAssetsSettings* settings);
+	static bool OptimizeGeometry(const char* geometryAsset, const char* geometryOutput, ProcessAssetsSettings* settings);
 	static bool ProcessTFX(ProcessAssetsSettings* settings);
 };
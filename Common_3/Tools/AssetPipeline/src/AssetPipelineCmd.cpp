@@ -14,7 +14,16 @@ void PrintHelp()
 	printf("AssetPipelineCmd\n");
 	printf(
 		"\nCommand: ProcessAnimations          (GLTF to OZZ) -pa   \"animation/directory/\" \"output/directory/\" [flags]\n"
+			"\t --segment | -segmentduration : Write clips longer than this many seconds as streamed segments of that length\n"
 		"\nCommand: ProcessVirtualTextures     (DDS to SVT)  -pvt  \"source texture directory/\" \"output directory/\" [flags]\n"
+		"\nCommand: ProcessFonts             (TTF to SDF)  -pf   \"font/directory/\" \"output/directory/\" [flags]\n"
+			"\t --fontsize | -fontbakesize   : Pixel height the glyphs are baked at (default 48)\n"
+			"\t --sdfpadding | -sdfpadding   : Distance field range in pixels around each glyph (default 8)\n"
+			"\t --glyphs | -glyphrange       : Inclusive codepoint range to bake, e.g. 32-126. Can be repeated (default printable Latin-1)\n"
+		"\nCommand: ProcessGeometry          (GLTF to GEOM) -pg  \"geometry/directory/\" \"output/directory/\" [flags]\n"
+			"\t --mv | -meshletvertices      : Maximum number of vertices in a meshlet (default 64, at most 64)\n"
+			"\t --mt | -meshlettriangles     : Maximum number of triangles in a meshlet (default 124, at most 126)\n"
+			"\t --pv | -packvertices         : Store texcoords as half2 and normals/tangents as octahedral unorm2x16\n"
 		"\nCommand: ProcessTFX                 (TFX to GLTF) -ptfx \"source tfx directory/\" \"output directory/\" [flags]\n"
 			"\t --fhc | -followhaircount      : Number of follow hairs around loaded guide hairs procedually\n"
 			"\t --tsf | -tipseparationfactor  : Separation factor for the follow hairs\n"
@@ -81,6 +90,60 @@ int AssetPipelineCmd(int argc, char** argv)
 			else
 				printf("WARNING: Argument expects a value: %s\n", arg);
 		}
+		else if (stricmp(arg, "-segmentduration") == 0 || stricmp(arg, "--segment") == 0)
+		{
+			if (i + 1 < argc)
+				settings.mClipSegmentDuration = (float)atof(argv[++i]);
+			else
+				printf("WARNING: Argument expects a value: %s\n", arg);
+		}
+		else if (stricmp(arg, "-fontbakesize") == 0 || stricmp(arg, "--fontsize") == 0)
+		{
+			if (i + 1 < argc)
+				settings.mFontBakeSize = (float)atof(argv[++i]);
+			else
+				printf("WARNING: Argument expects a value: %s\n", arg);
+		}
+		else if (stricmp(arg, "-sdfpadding") == 0 || stricmp(arg, "--sdfpadding") == 0)
+		{
+			if (i + 1 < argc)
+				settings.mFontSdfPadding = (float)atof(argv[++i]);
+			else
+				printf("WARNING: Argument expects a value: %s\n", arg);
+		}
+		else if (stricmp(arg, "-glyphrange") == 0 || stricmp(arg, "--glyphs") == 0)
+		{
+			unsigned int first = 0;
+			unsigned int last = 0;
+			if (i + 1 < argc && sscanf(argv[i + 1], "%u-%u", &first, &last) == 2 && first <= last &&
+				settings.mFontGlyphRangeCount < MAX_FONT_GLYPH_RANGES)
+			{
+				settings.mFontGlyphRanges[settings.mFontGlyphRangeCount][0] = first;
+				settings.mFontGlyphRanges[settings.mFontGlyphRangeCount][1] = last;
+				settings.mFontGlyphRangeCount++;
+				++i;
+			}
+			else
+				printf("WARNING: Argument expects a range such as 32-126: %s\n", arg);
+		}
+		else if (stricmp(arg, "-meshletvertices") == 0 || stricmp(arg, "--mv") == 0)
+		{
+			if (i + 1 < argc && isdigit(argv[i + 1][0]))
+				settings.mMeshletMaxVertices = atoi(argv[++i]);
+			else
+				printf("WARNING: Argument expects a value: %s\n", arg);
+		}
+		else if (stricmp(arg, "-meshlettriangles") == 0 || stricmp(arg, "--mt") == 0)
+		{
+			if (i + 1 < argc && isdigit(argv[i + 1][0]))
+				settings.mMeshletMaxTriangles = atoi(argv[++i]);
+			else
+				printf("WARNING: Argument expects a value: %s\n", arg);
+		}
+		else if (stricmp(arg, "-packvertices") == 0 || stricmp(arg, "--pv") == 0)
+		{
+			settings.mPackVertices = true;
+		}
 		else if (stricmp(arg, "-tipseparationfactor") == 0 || stricmp(arg, "--tsf") == 0)
 		{
 			settings.mTipSeperationFactor = (float)atof(argv[++i]);
@@ -105,6 +168,16 @@ int AssetPipelineCmd(int argc, char** argv)
 		if (!AssetPipeline::ProcessVirtualTextures(&settings))
 			return 1;
 	}
+	else if (stricmp(command, "-pf") == 0)
+	{
+		if (!AssetPipeline::ProcessFonts(&settings))
+			return 1;
+	}
+	else if (stricmp(command, "-pg") == 0)
+	{
+		if (!AssetPipeline::ProcessGeometry(&settings))
+			return 1;
+	}
 	else if (stricmp(command, "-ptfx") == 0)
 	{
 		if (!AssetPipeline::ProcessTFX(&settings))
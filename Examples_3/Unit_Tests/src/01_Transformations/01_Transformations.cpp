@@ -470,19 +470,23 @@ public:
 		params[4].ppTextures = &pSkyBoxTextures[4];
 		params[5].pName = "BackText";
 		params[5].ppTextures = &pSkyBoxTextures[5];
-		updateDescriptorSet(pRenderer, 0, pDescriptorSetTexture, 6, params);
 
+		// All sets are written with a single update call on backends which support it
+		DescriptorSetUpdateDesc setUpdates[1 + gImageCount * 2] = {};
+		setUpdates[0] = { pDescriptorSetTexture, params, 0, 6 };
+
+		DescriptorData uniformParams[gImageCount * 2] = {};
 		for (uint32_t i = 0; i < gImageCount; ++i)
 		{
-			DescriptorData params[1] = {};
-			params[0].pName = "uniformBlock";
-			params[0].ppBuffers = &pSkyboxUniformBuffer[i];
-			updateDescriptorSet(pRenderer, i * 2 + 0, pDescriptorSetUniforms, 1, params);
-
-			params[0].pName = "uniformBlock";
-			params[0].ppBuffers = &pProjViewUniformBuffer[i];
-			updateDescriptorSet(pRenderer, i * 2 + 1, pDescriptorSetUniforms, 1, params);
+			uniformParams[i * 2 + 0].pName = "uniformBlock";
+			uniformParams[i * 2 + 0].ppBuffers = &pSkyboxUniformBuffer[i];
+			setUpdates[1 + i * 2 + 0] = { pDescriptorSetUniforms, &uniformParams[i * 2 + 0], i * 2 + 0, 1 };
+
+			uniformParams[i * 2 + 1].pName = "uniformBlock";
+			uniformParams[i * 2 + 1].ppBuffers = &pProjViewUniformBuffer[i];
+			setUpdates[1 + i * 2 + 1] = { pDescriptorSetUniforms, &uniformParams[i * 2 + 1], i * 2 + 1, 1 };
 		}
+		updateDescriptorSets(pRenderer, 1 + gImageCount * 2, setUpdates);
 
 		return true;
 	}
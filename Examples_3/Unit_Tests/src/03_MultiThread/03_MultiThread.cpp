@@ -43,6 +43,7 @@
 #include "../../../../Common_3/OS/Interfaces/IInput.h"
 #include "../../../../Common_3/OS/Math/MathTypes.h"
 #include "../../../../Common_3/OS/Core/ThreadSystem.h"
+#include "../../../../Common_3/OS/Core/ParallelCmdRecorder.h"
 
 
 // for cpu usage query
@@ -82,12 +83,7 @@ struct ParticleData
 
 struct ThreadData
 {
-	CmdPool*          pCmdPool;
-	Cmd*              pCmd;
 	RenderTarget*     pRenderTarget;
-	int               mStartPoint;
-	int               mDrawCount;
-    int               mThreadIndex;
     ThreadID          mThreadID;
 	uint32_t          mFrameIndex;
 };
@@ -140,8 +136,8 @@ CmdPool*  pCmdPool[gImageCount] = { NULL };
 Cmd*      ppCmds[gImageCount] = { NULL };
 Cmd*      ppGraphCmds[gImageCount] = { NULL };
 
-Cmd**     ppThreadCmds[gImageCount] = { NULL };
-CmdPool** pThreadCmdPools[gImageCount] = { NULL };
+// Records the particle draws of each frame across pThreadSystem
+ParallelCmdRecorder* pParticleCmdRecorder = NULL;
 
 Fence*     pRenderCompleteFences[gImageCount] = { NULL };
 Semaphore* pImageAcquiredSemaphore = NULL;
@@ -277,10 +273,6 @@ class MultiThread: public IApp
 		// initial needed data for each thread
 		for (uint32_t i = 0; i < gThreadCount; ++i)
 		{
-			// fill up the data for drawing point
-			pThreadData[i].mStartPoint = i * (gTotalParticleCount / gThreadCount);
-			pThreadData[i].mDrawCount = (gTotalParticleCount / gThreadCount);
-			pThreadData[i].mThreadIndex = i;
 			pThreadData[i].mThreadID = Thread::mainThreadID;
 		}
 
@@ -306,17 +298,6 @@ class MultiThread: public IApp
 
 			addFence(pRenderer, &pRenderCompleteFences[i]);
 			addSemaphore(pRenderer, &pRenderCompleteSemaphores[i]);
-
-			ppThreadCmds[i] = (Cmd**)tf_malloc(gThreadCount * sizeof(Cmd*));
-			pThreadCmdPools[i] = (CmdPool**)tf_malloc(gThreadCount * sizeof(CmdPool*));
-
-			for (uint32_t t = 0; t < gThreadCount; ++t)
-			{
-				// create cmd pools and and cmdbuffers for all thread
-				addCmdPool(pRenderer, &cmdPoolDesc, &pThreadCmdPools[i][t]);
-				cmdDesc.pPool = pThreadCmdPools[i][t];
-				addCmd(pRenderer, &cmdDesc, &ppThreadCmds[i][t]);
-			}
 		}
 		addSemaphore(pRenderer, &pImageAcquiredSemaphore);
 
@@ -529,6 +510,14 @@ class MultiThread: public IApp
 
 		initThreadSystem(&pThreadSystem);
 
+		// one cmd pool and cmd buffer per particle thread and frame
+		ParallelCmdRecorderDesc recorderDesc = {};
+		recorderDesc.pQueue = pGraphicsQueue;
+		recorderDesc.pThreadSystem = pThreadSystem;
+		recorderDesc.mFrameCount = gImageCount;
+		recorderDesc.mMaxCmdCount = gThreadCount;
+		addParallelCmdRecorder(pRenderer, &recorderDesc, &pParticleCmdRecorder);
+
 		CameraMotionParameters cmp{ 100.0f, 800.0f, 1000.0f };
 		vec3                   camPos{ 24.0f, 24.0f, 10.0f };
 		vec3                   lookAt{ 0 };
@@ -681,17 +670,10 @@ class MultiThread: public IApp
 			removeCmd(pRenderer, ppCmds[i]);
 			removeCmd(pRenderer, ppGraphCmds[i]);
 			removeCmdPool(pRenderer, pCmdPool[i]);
-
-			for (uint32_t t = 0; t < gThreadCount; ++t)
-			{
-				removeCmd(pRenderer, ppThreadCmds[i][t]);
-				removeCmdPool(pRenderer, pThreadCmdPools[i][t]);
-			}
-
-			tf_free(ppThreadCmds[i]);
-			tf_free(pThreadCmdPools[i]);
 		}
 
+		removeParallelCmdRecorder(pRenderer, pParticleCmdRecorder);
+
 		removeSemaphore(pRenderer, pImageAcquiredSemaphore);
 
 		removeQueue(pRenderer, pGraphicsQueue);
@@ -936,10 +918,14 @@ class MultiThread: public IApp
 		{
 			pThreadData[i].pRenderTarget = pRenderTarget;
 			pThreadData[i].mFrameIndex = frameIdx;
-			pThreadData[i].pCmdPool = pThreadCmdPools[gFrameIndex][i];
-			pThreadData[i].pCmd = ppThreadCmds[gFrameIndex][i];
 		}
-		addThreadSystemRangeTask(pThreadSystem, &MultiThread::ParticleThreadDraw, pThreadData, gThreadCount);
+		ParallelCmdRecordDesc recordDesc = {};
+		recordDesc.pRecordFunc = &MultiThread::ParticleThreadDraw;
+		recordDesc.pUserData = pThreadData;
+		recordDesc.mFrameIndex = frameIdx;
+		recordDesc.mItemCount = gTotalParticleCount;
+		recordDesc.mMinItemsPerCmd = 1;
+		beginParallelCmds(pParticleCmdRecorder, &recordDesc);
 		// simply record the screen cleaning command
 
 		LoadActionsDesc loadActions = {};
@@ -1068,21 +1054,22 @@ class MultiThread: public IApp
 		cmdDrawProfilerUI();
 
 		// wait all particle threads done
-		waitThreadSystemIdle(pThreadSystem);
+		Cmd**          ppParticleCmds = NULL;
+		const uint32_t particleCmdCount = endParallelCmds(pParticleCmdRecorder, &ppParticleCmds);
 		// Wait till graph buffers have been uploaded to the gpu
 		waitForToken(&graphUpdateToken);
 		/***************draw cpu graph*****************************/
 		/***************draw cpu graph*****************************/
 		// gather all command buffer, it is important to keep the screen clean command at the beginning
-		uint32_t cmdCount = gThreadCount + 2;
+		uint32_t cmdCount = particleCmdCount + 2;
 		Cmd** allCmds = (Cmd**)alloca(cmdCount * sizeof(Cmd*));
 		allCmds[0] = cmd;
 
-		for (uint32_t i = 0; i < gThreadCount; ++i)
+		for (uint32_t i = 0; i < particleCmdCount; ++i)
 		{
-			allCmds[i + 1] = pThreadData[i].pCmd;
+			allCmds[i + 1] = ppParticleCmds[i];
 		}
-		allCmds[gThreadCount + 1] = ppGraphCmds[frameIdx];
+		allCmds[particleCmdCount + 1] = ppGraphCmds[frameIdx];
 
 		QueueSubmitDesc submitDesc = {};
 		submitDesc.mCmdCount = cmdCount;
@@ -1520,16 +1507,13 @@ class MultiThread: public IApp
 	}
 
 	// thread for recording particle draw
-	static void ParticleThreadDraw(void* pData, uintptr_t i)
+	static void ParticleThreadDraw(void* pData, Cmd* cmd, uint32_t i, uint32_t firstParticle, uint32_t particleCount)
 	{
 		ThreadData& data = ((ThreadData*)pData)[i];
         if(data.mThreadID ==  Thread::mainThreadID)
             data.mThreadID = Thread::GetCurrentThreadID();
         PROFILER_SET_CPU_SCOPE("Threads", "Cpu draw", 0xffffff);
-		Cmd*        cmd = data.pCmd;
-		resetCmdPool(pRenderer, data.pCmdPool);
-		beginCmd(cmd);
-		cmdBeginGpuFrameProfile(cmd, pGpuProfiletokens[data.mThreadIndex + 1]); // pGpuProfiletokens[0] is reserved for main thread
+		cmdBeginGpuFrameProfile(cmd, pGpuProfiletokens[i + 1]); // pGpuProfiletokens[0] is reserved for main thread
 
 		LoadActionsDesc loadActions = {};
 		loadActions.mLoadActionsColor[0] = LOAD_ACTION_LOAD;
@@ -1545,10 +1529,9 @@ class MultiThread: public IApp
 		cmdBindPushConstants(cmd, pRootSignature, "particleRootConstant", &gParticleData);
 		cmdBindVertexBuffer(cmd, 1, &pParticleVertexBuffer, &parDataStride, NULL);
 
-		cmdDrawInstanced(cmd, data.mDrawCount, data.mStartPoint, 1, 0);
+		cmdDrawInstanced(cmd, particleCount, firstParticle, 1, 0);
 
-		cmdEndGpuFrameProfile(cmd, pGpuProfiletokens[data.mThreadIndex + 1]);  // pGpuProfiletokens[0] is reserved for main thread
-		endCmd(cmd);
+		cmdEndGpuFrameProfile(cmd, pGpuProfiletokens[i + 1]);  // pGpuProfiletokens[0] is reserved for main thread
 	}
 };
 
@@ -48,8 +48,11 @@
 // Middleware packages
 #include "../../../../Middleware_3/Animation/SkeletonBatcher.h"
 #include "../../../../Middleware_3/Animation/AnimatedObject.h"
+#include "../../../../Middleware_3/Animation/AnimationSystem.h"
+#include "../../../../Middleware_3/Animation/AnimationLod.h"
 #include "../../../../Middleware_3/Animation/Animation.h"
 #include "../../../../Middleware_3/Animation/Clip.h"
+#include "../../../../Middleware_3/Animation/ClipCache.h"
 #include "../../../../Middleware_3/Animation/ClipController.h"
 #include "../../../../Middleware_3/Animation/Rig.h"
 
@@ -135,8 +138,9 @@ Animation gWalkAnimations[kMaxNumRigs];
 // ClipControllers
 ClipController gWalkClipControllers[kMaxNumRigs];
 
-// Clips
-Clip gWalkClip;
+// Clips, one per rig. They all load the same file through gClipCache so the animation data is only loaded once
+Clip      gWalkClips[kMaxNumRigs];
+ClipCache gClipCache;
 
 // Rigs
 Rig gStickFigureRigs[kMaxNumRigs];
@@ -144,6 +148,15 @@ Rig gStickFigureRigs[kMaxNumRigs];
 // SkeletonBatcher
 SkeletonBatcher gSkeletonBatcher;
 
+// Draw all rigs from one instance buffer (basicInstanced.vert) instead of batches of uniform buffers (basic.vert)
+const bool gUseInstanceBuffer = true;
+
+// Detail levels shared by all rigs, picked from the inverse distance to the camera
+AnimationLod gAnimationLod;
+
+// Toggle for enabling/disabling animation LOD through UI
+bool gEnableAnimationLod = true;
+
 // Filenames
 const char* gStickFigureName = "stickFigure/skeleton.ozz";
 const char* gWalkClipName = "stickFigure/animations/walk.ozz";
@@ -162,22 +175,17 @@ static HiresTimer gAnimationUpdateTimer;
 // Toggle for enabling/disabling threading through UI
 bool gEnableThreading = true;
 
-// Maximum number of tasks to be threaded
-const unsigned int kMaxTaskCount = kMaxNumRigs;
-
 // Number of rigs per task that will be adjusted by the UI
 unsigned int gGrainSize = 32;
 
-struct ThreadData
-{
-	AnimatedObject* mAnimatedObject;
-	float           mDeltaTime;
-	unsigned int    mNumberSystems;
-};
-ThreadData gThreadData[kMaxTaskCount];
-
 ThreadSystem* pThreadSystem = NULL;
 
+// Updates the animated objects across pThreadSystem
+AnimationSystem gAnimationSystem;
+
+// Updates the animated objects on the main thread when threading is disabled
+AnimationSystem gSerialAnimationSystem;
+
 //--------------------------------------------------------------------------------------------
 // UI DATA
 //--------------------------------------------------------------------------------------------
@@ -193,6 +201,7 @@ struct UIData
 	struct SampleControlData
 	{
 		unsigned int* mNumberOfRigs = &gNumRigs;
+		bool*         mEnableAnimationLod = &gEnableAnimationLod;
 	};
 	SampleControlData mSampleControl;
 
@@ -275,7 +284,7 @@ class MultiThread: public IApp
 		planeShader.mStages[0] = { "plane.vert", NULL, 0 };
 		planeShader.mStages[1] = { "plane.frag", NULL, 0 };
 		ShaderLoadDesc basicShader = {};
-		basicShader.mStages[0] = { "basic.vert", NULL, 0 };
+		basicShader.mStages[0] = { gUseInstanceBuffer ? "basicInstanced.vert" : "basic.vert", NULL, 0 };
 		basicShader.mStages[1] = { "basic.frag", NULL, 0 };
 
 		addShader(pRenderer, &planeShader, &pPlaneDrawShader);
@@ -362,7 +371,7 @@ class MultiThread: public IApp
 		skeletonRenderDesc.mNumBonePoints = gNumberOfBonePoints;
 		skeletonRenderDesc.mBoneVertexStride = sizeof(float) * 6;
 		skeletonRenderDesc.mJointVertexStride = sizeof(float) * 6;
-		gSkeletonBatcher.Initialize(skeletonRenderDesc);
+		skeletonRenderDesc.mUseInstanceBuffer = gUseInstanceBuffer;
         
         // RIGS
         //
@@ -382,17 +391,25 @@ class MultiThread: public IApp
 			}
 		}
 
+		// Start with room for every joint of every rig now that the rigs are loaded
+		skeletonRenderDesc.mMaxInstances = kMaxNumRigs * gStickFigureRigs[0].GetNumJoints();
+		gSkeletonBatcher.Initialize(skeletonRenderDesc);
+
 		// CLIPS
 		//
-		// Since all the skeletons are the same we can just initialize with the first one
-		gWalkClip.Initialize(RD_ANIMATIONS, gWalkClipName, &gStickFigureRigs[0]);
+		// Each rig gets its own clip, the cache shares the loaded walk animation between all of them
+		gClipCache.Initialize();
+		for (unsigned int i = 0; i < kMaxNumRigs; i++)
+		{
+			gWalkClips[i].Initialize(RD_ANIMATIONS, gWalkClipName, &gStickFigureRigs[i], &gClipCache);
+		}
 
 		// CLIP CONTROLLERS
 		//
 		// Initialize with the length of the clip they are controlling
 		for (unsigned int i = 0; i < kMaxNumRigs; i++)
 		{
-			gWalkClipControllers[i].Initialize(gWalkClip.GetDuration());
+			gWalkClipControllers[i].Initialize(gWalkClips[i].GetDuration());
 		}
 
 		// ANIMATIONS
@@ -402,12 +419,26 @@ class MultiThread: public IApp
 			AnimationDesc animationDesc{};
 			animationDesc.mRig = &gStickFigureRigs[i];
 			animationDesc.mNumLayers = 1;
-			animationDesc.mLayerProperties[0].mClip = &gWalkClip;
+			animationDesc.mLayerProperties[0].mClip = &gWalkClips[i];
 			animationDesc.mLayerProperties[0].mClipController = &gWalkClipControllers[i];
+			// Clips are sampled into the animation systems' scratch buffers
+			animationDesc.mUseExternalScratch = true;
 
 			gWalkAnimations[i].Initialize(animationDesc);
 		}
 
+		// ANIMATION LOD
+		//
+		// Rigs further than 10 units update every 2nd frame, further than 25 units every 4th
+		AnimationLodLevel lodLevels[3] = {};
+		lodLevels[0].mMinMetric = 1.f / 10.f;
+		lodLevels[0].mUpdateInterval = 1;
+		lodLevels[1].mMinMetric = 1.f / 25.f;
+		lodLevels[1].mUpdateInterval = 2;
+		lodLevels[2].mMinMetric = 0.f;
+		lodLevels[2].mUpdateInterval = 4;
+		gAnimationLod.Initialize(lodLevels, 3);
+
 		// ANIMATED OBJECTS
 		//
 		for (unsigned int i = 0; i < kMaxNumRigs; i++)
@@ -417,6 +448,7 @@ class MultiThread: public IApp
 			// Calculate and set offset for each rig
 			vec3 offset = vec3(-8.75f + 0.75f * (i % 25), 0.0f, 6.0f - 2 * (i / 25));
 			gStickFigureAnimObjects[i].SetRootTransform(mat4::translation(offset));
+			gStickFigureAnimObjects[i].SetLod(&gAnimationLod);
 		}
 
 		/************************************************************************/
@@ -432,6 +464,17 @@ class MultiThread: public IApp
 		//
 		initThreadSystem(&pThreadSystem);
 
+		// INITIALIZE ANIMATION SYSTEMS
+		//
+		AnimationSystemDesc animationSystemDesc = {};
+		animationSystemDesc.mMaxSoaJoints = gStickFigureRigs[0].GetNumSoaJoints();
+		animationSystemDesc.mPoseRigs = true;
+		gSerialAnimationSystem.Initialize(animationSystemDesc);
+
+		animationSystemDesc.pThreadSystem = pThreadSystem;
+		animationSystemDesc.mGrainSize = gGrainSize;
+		gAnimationSystem.Initialize(animationSystemDesc);
+
 		// Add the GUI Panels/Windows
 		const TextDrawDesc UIPanelWindowTitleTextDesc = { 0, 0xffff00ff, 16 };
 
@@ -478,6 +521,11 @@ class MultiThread: public IApp
 				SliderUintWidget("Number of Rigs", gUIData.mSampleControl.mNumberOfRigs, uintValMin, uintValMax, sliderStepSizeUint));
 			CollapsingSampleControlWidgets.AddSubWidget(SeparatorWidget());
 
+			// EnableAnimationLod - Checkbox
+			CollapsingSampleControlWidgets.AddSubWidget(
+				CheckboxWidget("Enable Animation LOD", gUIData.mSampleControl.mEnableAnimationLod));
+			CollapsingSampleControlWidgets.AddSubWidget(SeparatorWidget());
+
 			// GENERAL SETTINGS
 			//
 			CollapsingHeaderWidget CollapsingGeneralSettingsWidgets("General Settings");
@@ -549,6 +597,8 @@ class MultiThread: public IApp
 	void Exit()
 	{
 		exitInputSystem();
+		gAnimationSystem.Destroy();
+		gSerialAnimationSystem.Destroy();
 		shutdownThreadSystem(pThreadSystem);
 		// wait for rendering to finish before freeing resources
 		waitQueueIdle(pGraphicsQueue);
@@ -567,7 +617,11 @@ class MultiThread: public IApp
 		}
 
 		// Clips
-		gWalkClip.Destroy();
+		for (unsigned int i = 0; i < kMaxNumRigs; i++)
+		{
+			gWalkClips[i].Destroy();
+		}
+		gClipCache.Destroy();
 
 		// Animations
 		for (unsigned int i = 0; i < kMaxNumRigs; i++)
@@ -747,46 +801,33 @@ class MultiThread: public IApp
 		/************************************************************************/
 		gAnimationUpdateTimer.Reset();
 
-		// Update the animated objects amd pose the rigs based on the animated object's updated values for this frame
-
-		// Threading
-		if (gEnableThreading)
+		// Pick each rig's detail level from its distance to the camera
+		const vec3 camPos = pCameraController->getViewPosition();
+		for (unsigned int i = 0; i < gNumRigs; i++)
 		{
-			unsigned int taskCount = max(1U, gNumRigs / gGrainSize);
-
-			// Submit taskCount number of jobs
-			for (unsigned int i = 0; i < taskCount; i++)
+			float metric = FLT_MAX;
+			if (gEnableAnimationLod)
 			{
-				gThreadData[i].mAnimatedObject = &gStickFigureAnimObjects[gGrainSize * i];
-				gThreadData[i].mDeltaTime = deltaTime;
-				gThreadData[i].mNumberSystems = gGrainSize;
+				const vec3 rigPos = gStickFigureAnimObjects[i].GetRootTransform().getTranslation();
+				metric = 1.f / max((float)length(rigPos - camPos), 1e-3f);
 			}
-			addThreadSystemRangeTask(pThreadSystem, &MultiThread::AnimatedObjectThreadedUpdate, gThreadData, taskCount);
-
-			// If there is a remainder, submit another job to finish it
-			unsigned int remainder = (uint32_t)max(0, (int32_t)gNumRigs - (int32_t)(taskCount * gGrainSize));
-			if (remainder != 0)
-			{
-				gThreadData[taskCount].mAnimatedObject = &gStickFigureAnimObjects[gGrainSize * taskCount];
-				gThreadData[taskCount].mDeltaTime = deltaTime;
-				gThreadData[taskCount].mNumberSystems = remainder;
+			gStickFigureAnimObjects[i].SetLodMetric(metric);
+		}
 
-				addThreadSystemTask(pThreadSystem, &MultiThread::AnimatedObjectThreadedUpdate, &gThreadData[taskCount]);
-			}
+		// Update the animated objects amd pose the rigs based on the animated object's updated values for this frame
 
-			// Ensure all jobs are finished before proceeding
-			waitThreadSystemIdle(pThreadSystem);
+		// Threading
+		if (gEnableThreading)
+		{
+			gAnimationSystem.SetGrainSize(gGrainSize);
+			if (!gAnimationSystem.Update(gStickFigureAnimObjects, gNumRigs, deltaTime))
+				LOGF(eERROR, "Animation NOT Updating!");
 		}
 		// Naive
 		else
 		{
-			for (unsigned int i = 0; i < gNumRigs; i++)
-			{
-				if (!gStickFigureAnimObjects[i].Update(deltaTime))
-					LOGF(eERROR, "Animation NOT Updating!");
-
-				gStickFigureAnimObjects[i].PoseRig();
-			}
+			if (!gSerialAnimationSystem.Update(gStickFigureAnimObjects, gNumRigs, deltaTime))
+				LOGF(eERROR, "Animation NOT Updating!");
 		}
 
 		// Record animation update time
@@ -812,17 +853,6 @@ class MultiThread: public IApp
 		uint32_t swapchainImageIndex;
 		acquireNextImage(pRenderer, pSwapChain, pImageAcquiredSemaphore, NULL, &swapchainImageIndex);
 
-		// UPDATE UNIFORM BUFFERS
-		//
-
-		// Update all the instanced uniform data for each batch of joints and bones
-		gSkeletonBatcher.SetPerInstanceUniforms(gFrameIndex, gNumRigs);
-
-		BufferUpdateDesc planeViewProjCbv = { pPlaneUniformBuffer[gFrameIndex] };
-		beginUpdateResource(&planeViewProjCbv);
-		*(UniformBlockPlane*)planeViewProjCbv.pMappedData = gUniformDataPlane;
-		endUpdateResource(&planeViewProjCbv, NULL);
-
 		// FRAME SYNC & ACQUIRE SWAPCHAIN RENDER TARGET
 		//
 		// Stall if CPU is running "Swap Chain Buffer Count" frames ahead of GPU
@@ -834,6 +864,18 @@ class MultiThread: public IApp
 
 		resetCmdPool(pRenderer, pCmdPools[gFrameIndex]);
 
+		// UPDATE UNIFORM BUFFERS
+		//
+		// Written after the fence wait, the skeleton batcher may replace the instance buffer of this frame index
+
+		// Update all the instanced uniform data for each batch of joints and bones
+		gSkeletonBatcher.SetPerInstanceUniforms(gFrameIndex, gNumRigs);
+
+		BufferUpdateDesc planeViewProjCbv = { pPlaneUniformBuffer[gFrameIndex] };
+		beginUpdateResource(&planeViewProjCbv);
+		*(UniformBlockPlane*)planeViewProjCbv.pMappedData = gUniformDataPlane;
+		endUpdateResource(&planeViewProjCbv, NULL);
+
 		// Acquire the main render target from the swapchain
 		RenderTarget* pRenderTarget = pSwapChain->ppRenderTargets[swapchainImageIndex];
 		Semaphore*    pRenderCompleteSemaphore = pRenderCompleteSemaphores[gFrameIndex];
@@ -969,25 +1011,6 @@ class MultiThread: public IApp
 
 		return pDepthBuffer != NULL;
 	}
-
-	// Threaded animated object update call
-	static void AnimatedObjectThreadedUpdate(void* pData, uintptr_t i)
-	{
-		// Unpack data
-		ThreadData*     data = ((ThreadData*)pData)+i;
-		AnimatedObject* animSystem = data->mAnimatedObject;
-		float           deltaTime = data->mDeltaTime;
-		unsigned int    numberSystems = data->mNumberSystems;
-
-		// Update the systems
-		for (unsigned int i = 0; i < numberSystems; i++)
-		{
-			if (!(animSystem[i].Update(deltaTime)))
-				LOGF(eERROR, "Animation NOT Updating!");
-
-			animSystem[i].PoseRig();
-		}
-	}
 };
 
 DEFINE_APPLICATION_MAIN(MultiThread)
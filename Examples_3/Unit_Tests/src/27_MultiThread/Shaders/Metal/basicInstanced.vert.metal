@@ -0,0 +1,83 @@
+/* Write your header comments here */
+#include <metal_stdlib>
+#include <metal_atomic>
+using namespace metal;
+
+inline float3x3 matrix_ctor(float4x4 m) {
+        return float3x3(m[0].xyz, m[1].xyz, m[2].xyz);
+}
+struct Vertex_Shader
+{
+    struct Uniforms_uniformBlock {
+
+        float4x4 mvp;
+
+        float4 lightPosition;
+        float4 lightColor;
+
+        // Index of the first instance of this draw in instanceBuffer
+        uint instanceOffset;
+    };
+
+    struct InstanceData
+    {
+        float4x4 toWorld;
+        float4 color;
+    };
+
+    constant Uniforms_uniformBlock & uniformBlock;
+    constant InstanceData* instanceBuffer;
+    struct VSInput
+    {
+        float4 Position [[attribute(0)]];
+        float4 Normal [[attribute(1)]];
+    };
+
+    struct VSOutput
+    {
+
+        float4 Position [[position]];
+        float4 Color;
+    };
+
+    VSOutput main(VSInput input, uint InstanceID)
+    {
+        VSOutput result;
+        float4x4 toWorld = instanceBuffer[uniformBlock.instanceOffset + InstanceID].toWorld;
+        float4x4 tempMat = ((uniformBlock.mvp)*(toWorld));
+        result.Position = ((tempMat)*(input.Position));
+
+        float4 normal = normalize(((toWorld)*(float4(input.Normal.xyz, 0.0))));
+        float4 pos = ((toWorld)*(float4(input.Position.xyz, 1.0)));
+
+        float lightIntensity = 1.0;
+		float ambientCoeff = 0.4;
+
+        float3 lightDir = (float3)(normalize(uniformBlock.lightPosition.xyz - pos.xyz));
+		
+        float3 baseColor = instanceBuffer[uniformBlock.instanceOffset + InstanceID].color.xyz;
+        float3 blendedColor = ((uniformBlock.lightColor.xyz * baseColor)*(lightIntensity));
+        float3 diffuse = ((blendedColor)*(max(dot(normal.xyz, lightDir), 0.0)));
+        float3 ambient = ((baseColor)*(ambientCoeff));
+        result.Color = float4(diffuse + ambient, 1.0);
+
+        return result;
+    };
+
+    Vertex_Shader(constant Uniforms_uniformBlock & uniformBlock, constant InstanceData* instanceBuffer) :
+        uniformBlock(uniformBlock), instanceBuffer(instanceBuffer) {}
+};
+
+vertex Vertex_Shader::VSOutput stageMain(Vertex_Shader::VSInput input [[stage_in]],
+    uint InstanceID                                                   [[instance_id]],
+    constant Vertex_Shader::Uniforms_uniformBlock & uniformBlock      [[buffer(0)]],
+    constant Vertex_Shader::InstanceData* instanceBuffer               [[buffer(1)]]
+) {
+    Vertex_Shader::VSInput input0;
+    input0.Position = input.Position;
+    input0.Normal = input.Normal;
+    uint InstanceID0;
+    InstanceID0 = InstanceID;
+    Vertex_Shader main(uniformBlock, instanceBuffer);
+    return main.main(input0, InstanceID0);
+}
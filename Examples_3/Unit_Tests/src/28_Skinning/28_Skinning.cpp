@@ -115,15 +115,9 @@ struct Vertex
 	uint4  mBoneIndices;
 };
 
-struct UniformDataBones
-{
-	mat4 mBoneMatrix[MAX_NUM_BONES];
-};
-
 VertexLayout     gVertexLayoutSkinned = {};
 Geometry*        pGeom = NULL;
 Buffer*          pUniformBufferBones[gImageCount] = { NULL };
-UniformDataBones gUniformDataBones;
 Texture*         pTextureDiffuse = NULL;
 
 struct UniformBlockPlane
@@ -863,13 +857,6 @@ class Skinning: public IApp
 		// Update uniforms that will be shared between all skeletons
 		gSkeletonBatcher.SetSharedUniforms(projViewMat, lightPos, lightColor);
 
-		for (uint i = 0; i < pGeom->mJointCount; ++i)
-		{
-			gUniformDataBones.mBoneMatrix[i] = //mat4::scale(vec3(1, 1, -1)) *
-				gStickFigureRig.GetJointWorldMat(pGeom->pJointRemaps[i]) * 
-				pGeom->pInverseBindPoses[i];
-
-		}
 		/************************************************************************/
 		// Plane
 		/************************************************************************/
@@ -911,7 +898,10 @@ class Skinning: public IApp
 
 		BufferUpdateDesc boneBufferUpdateDesc = { pUniformBufferBones[gFrameIndex] };
 		beginUpdateResource(&boneBufferUpdateDesc);
-		memcpy(boneBufferUpdateDesc.pMappedData, &gUniformDataBones, sizeof(mat4) * gStickFigureRig.GetNumJoints());
+		// Skinning matrices are written straight into the mapped bone buffer
+		ASSERT(pGeom->mJointCount <= MAX_NUM_BONES);
+		gStickFigureRig.WriteSkinningMatrices(
+			pGeom->pInverseBindPoses, pGeom->pJointRemaps, pGeom->mJointCount, (mat4*)boneBufferUpdateDesc.pMappedData);
 		endUpdateResource(&boneBufferUpdateDesc, NULL);
 
 		// Acquire the main render target from the swapchain
@@ -52,6 +52,7 @@
 #include "soloud_speech.h"
 #include "soloud_fftfilter.h"
 #include "soloud_wav.h"
+#include "soloud_wavstream.h"
 
 #include "../../../../Common_3/ThirdParty/OpenSource/EASTL/string.h"
 
@@ -93,7 +94,7 @@ struct GlobalAudio
 	SoLoud::FFTFilter mFftFilter;
 
 	SoLoud::Speech mSpeech;  // A sound source (speech, in this case)
-	SoLoud::Wav    mBgWavObj;
+	SoLoud::WavStream mBgWavObj;  // Long background track, decoded while playing
 	SoLoud::Wav    mWarWavObj;
 };
 
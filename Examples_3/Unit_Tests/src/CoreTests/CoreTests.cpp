@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+// Runs the tests in this folder and returns EXIT_FAILURE when any of them fails. Pass --benchmark to also log how long the
+// optimized code paths take compared to their reference versions.
+
+#include "CoreTests.h"
+
+#include "../../../../Common_3/OS/Interfaces/IFileSystem.h"
+
+#include <string.h>
+
+#include "../../../../Common_3/OS/Interfaces/IMemory.h"
+
+static const char* gApplicationName = "CoreTests";
+
+typedef struct CoreTest
+{
+	const char* pName;
+	bool (*pTest)();
+	void (*pBenchmark)();
+} CoreTest;
+
+static const CoreTest gCoreTests[] = {
+	{ "Vertex packing", testVertexPacking, benchmarkVertexPacking },
+	{ "Shader reflection", testShaderReflection, NULL },
+	{ "File stream reader", testFileStreamReader, benchmarkFileStreamReader },
+};
+
+bool testCheck(bool condition, const char* pCondition, const char* pFile, int line)
+{
+	if (!condition)
+		Log::Write(LogLevel::eERROR, pFile, line, "Check failed: %s", pCondition);
+	return condition;
+}
+
+static int runCoreTests(bool benchmark)
+{
+	uint32_t failedCount = 0;
+	for (uint32_t i = 0; i < sizeof(gCoreTests) / sizeof(gCoreTests[0]); ++i)
+	{
+		const CoreTest& test = gCoreTests[i];
+		const bool passed = test.pTest();
+		LOGF(passed ? LogLevel::eINFO : LogLevel::eERROR, "%s: %s", test.pName, passed ? "passed" : "FAILED");
+		failedCount += passed ? 0 : 1;
+
+		if (benchmark && test.pBenchmark)
+			test.pBenchmark();
+	}
+
+	LOGF(LogLevel::eINFO, "%u of %u tests failed", failedCount, (uint32_t)(sizeof(gCoreTests) / sizeof(gCoreTests[0])));
+	return failedCount ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+	extern bool MemAllocInit(const char*);
+	extern void MemAllocExit();
+
+	if (!MemAllocInit(gApplicationName))
+		return EXIT_FAILURE;
+
+	FileSystemInitDesc fsDesc = {};
+	fsDesc.pAppName = gApplicationName;
+
+	if (!initFileSystem(&fsDesc))
+		return EXIT_FAILURE;
+
+	fsSetPathForResourceDir(pSystemFileIO, RM_DEBUG, RD_LOG, "");
+
+	Log::Init(gApplicationName);
+
+	bool benchmark = false;
+	for (int i = 1; i < argc; ++i)
+		benchmark = benchmark || !strcmp(argv[i], "--benchmark");
+
+	int ret = runCoreTests(benchmark);
+
+	Log::Exit();
+	exitFileSystem();
+	MemAllocExit();
+
+	return ret;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+// Tests for Common_3 code that needs neither a window nor a GPU. Every test logs its failed checks and returns whether all of
+// them passed; benchmarks only log timings and run when CoreTests is started with --benchmark.
+
+#include "../../../../Common_3/OS/Interfaces/ILog.h"
+
+// Logs the check when it fails and returns whether it passed, so a test can keep going and report every failure
+bool testCheck(bool condition, const char* pCondition, const char* pFile, int line);
+
+#define TEST_CHECK(condition) testCheck((condition), #condition, __FILE__, __LINE__)
+
+// Vertex packing (Common_3/Renderer/VertexPacking.h)
+bool testVertexPacking();
+void benchmarkVertexPacking();
+
+// Shader reflection serialization (Common_3/Renderer/IShaderReflection.h)
+bool testShaderReflection();
+
+// Buffered text reading (FileStreamReader in Common_3/OS/Interfaces/IFileSystem.h)
+bool testFileStreamReader();
+void benchmarkFileStreamReader();
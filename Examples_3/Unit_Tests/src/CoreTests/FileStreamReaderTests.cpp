@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+// FileStreamReader over memory streams, at block sizes that split lines and tokens everywhere
+
+#include "CoreTests.h"
+
+#include "../../../../Common_3/OS/Interfaces/IFileSystem.h"
+#include "../../../../Common_3/OS/Interfaces/ITime.h"
+#include "../../../../Common_3/ThirdParty/OpenSource/EASTL/string.h"
+
+#include "../../../../Common_3/OS/Interfaces/IMemory.h"
+
+using namespace theforge;
+
+static const size_t gBlockSizes[] = { 1, 2, 3, 7, 255, FS_READER_DEFAULT_BLOCK_SIZE };
+
+// Reads the next line of any length the way the shader include scanning does, in chunks of chunkSize - 1 characters
+static bool readLine(FileStreamReader* pReader, size_t chunkSize, eastl::string& outLine)
+{
+	char    chunk[256];
+	bool    partial = false;
+	ssize_t length = fsReaderReadLine(pReader, chunk, chunkSize, &partial);
+	if (length < 0)
+		return false;
+
+	outLine.assign(chunk, chunk + length);
+	while (partial && (length = fsReaderReadLine(pReader, chunk, chunkSize, &partial)) >= 0)
+		outLine.append(chunk, chunk + length);
+
+	return true;
+}
+
+// Per byte line reading like before FileStreamReader existed, the baseline of the benchmark
+static bool readLinePerByte(FileStream* pStream, eastl::string& outLine)
+{
+	if (fsStreamAtEnd(pStream))
+		return false;
+
+	outLine.clear();
+	while (!fsStreamAtEnd(pStream))
+	{
+		char nextChar = 0;
+		fsReadFromStream(pStream, &nextChar, sizeof(nextChar));
+		if (nextChar == '\n')
+			break;
+		if (nextChar == '\r')
+		{
+			char         newLine = 0;
+			const size_t read = fsReadFromStream(pStream, &newLine, sizeof(newLine));
+			if (read && newLine == '\n')
+				break;
+			// Not a "\r\n" sequence, so the '\r' belongs to the line
+			if (read)
+				fsSeekStream(pStream, SBO_CURRENT_POSITION, -1);
+		}
+		outLine.push_back(nextChar);
+	}
+	return true;
+}
+
+static bool testLines()
+{
+	// CRLF, a lone '\r', an empty line, an embedded NUL, a "\r\n" straddling the 255 characters read at once with a 256 byte
+	// chunk and no newline after the last line
+	const eastl::string longLine(254, 'x');
+	const eastl::string expected[] = { "first", "second", "", "lone\rcarriage", eastl::string("embedded\0nul", 12), longLine, "last" };
+	const uint32_t      expectedCount = sizeof(expected) / sizeof(expected[0]);
+
+	eastl::string text = "first\r\nsecond\n\r\nlone\rcarriage\n";
+	text += expected[4] + "\n" + longLine + "\r\nlast";
+
+	bool passed = true;
+	const size_t chunkSizes[] = { 256, 4 };
+	for (uint32_t i = 0; i < sizeof(gBlockSizes) / sizeof(gBlockSizes[0]); ++i)
+	{
+		for (uint32_t c = 0; c < sizeof(chunkSizes) / sizeof(chunkSizes[0]); ++c)
+		{
+			FileStream stream = {};
+			fsOpenStreamFromMemory(text.data(), text.size(), FM_READ_BINARY, false, &stream);
+			FileStreamReader reader = {};
+			fsInitStreamReader(&stream, gBlockSizes[i], NULL, &reader);
+
+			eastl::string line;
+			uint32_t      count = 0;
+			bool          linesMatch = true;
+			while (readLine(&reader, chunkSizes[c], line))
+			{
+				linesMatch = linesMatch && count < expectedCount && line == expected[count];
+				++count;
+			}
+
+			passed = TEST_CHECK(fsReaderAtEnd(&reader)) && passed;
+			fsExitStreamReader(&reader);
+			fsCloseStream(&stream);
+
+			if (!TEST_CHECK(linesMatch && count == expectedCount))
+			{
+				LOGF(
+					LogLevel::eERROR, "Lines split wrongly with a block size of %u and a chunk size of %u", (uint32_t)gBlockSizes[i],
+					(uint32_t)chunkSizes[c]);
+				passed = false;
+			}
+		}
+	}
+	return passed;
+}
+
+static bool testTokens()
+{
+	// A token longer than the 64 bytes the number parsing reads must not be cut into a number
+	const eastl::string longNumber(70, '1');
+	const eastl::string text =
+		" \t42 -0x1F +7\r\n3.5e2\v-0.25 word 9223372036854775808 0x 12abc " + longNumber + " " + longNumber + " truncated next\n";
+
+	bool passed = true;
+	for (uint32_t i = 0; i < sizeof(gBlockSizes) / sizeof(gBlockSizes[0]); ++i)
+	{
+		FileStream stream = {};
+		fsOpenStreamFromMemory(text.data(), text.size(), FM_READ_BINARY, false, &stream);
+		FileStreamReader reader = {};
+		fsInitStreamReader(&stream, gBlockSizes[i], NULL, &reader);
+
+		int64_t intValue = 0;
+		float   floatValue = 0.0f;
+		char    token[5] = {};
+		passed = TEST_CHECK(fsReaderPeek(&reader) == ' ') && passed;
+		passed = TEST_CHECK(fsReaderReadInt64(&reader, &intValue) && intValue == 42) && passed;
+		passed = TEST_CHECK(fsReaderReadInt64(&reader, &intValue) && intValue == -31) && passed;
+		passed = TEST_CHECK(fsReaderReadInt64(&reader, &intValue) && intValue == 7) && passed;
+		passed = TEST_CHECK(fsReaderReadFloat(&reader, &floatValue) && floatValue == 350.0f) && passed;
+		passed = TEST_CHECK(fsReaderReadFloat(&reader, &floatValue) && floatValue == -0.25f) && passed;
+		// Tokens that are not numbers are consumed all the same
+		passed = TEST_CHECK(!fsReaderReadInt64(&reader, &intValue)) && passed;
+		passed = TEST_CHECK(!fsReaderReadInt64(&reader, &intValue)) && passed;
+		passed = TEST_CHECK(!fsReaderReadInt64(&reader, &intValue)) && passed;
+		passed = TEST_CHECK(!fsReaderReadInt64(&reader, &intValue)) && passed;
+		passed = TEST_CHECK(!fsReaderReadInt64(&reader, &intValue)) && passed;
+		passed = TEST_CHECK(!fsReaderReadFloat(&reader, &floatValue)) && passed;
+		passed = TEST_CHECK(fsReaderReadToken(&reader, token, sizeof(token)) == 4 && eastl::string(token) == "trun") && passed;
+		passed = TEST_CHECK(fsReaderReadToken(&reader, token, sizeof(token)) == 4 && eastl::string(token) == "next") && passed;
+		passed = TEST_CHECK(fsReaderReadToken(&reader, token, sizeof(token)) == -1 && token[0] == 0) && passed;
+		passed = TEST_CHECK(!fsReaderReadFloat(&reader, &floatValue) && fsReaderPeek(&reader) == -1) && passed;
+
+		fsExitStreamReader(&reader);
+		fsCloseStream(&stream);
+	}
+	return passed;
+}
+
+static bool testExit()
+{
+	// Bytes the reader buffered but did not consume go back to the stream
+	const char text[] = "header\nbinary payload";
+	bool       passed = true;
+	for (uint32_t i = 0; i < sizeof(gBlockSizes) / sizeof(gBlockSizes[0]); ++i)
+	{
+		FileStream stream = {};
+		fsOpenStreamFromMemory(text, sizeof(text) - 1, FM_READ_BINARY, false, &stream);
+		FileStreamReader reader = {};
+		fsInitStreamReader(&stream, gBlockSizes[i], NULL, &reader);
+
+		eastl::string line;
+		passed = TEST_CHECK(readLine(&reader, 256, line) && line == "header") && passed;
+		fsExitStreamReader(&reader);
+
+		char         payload[sizeof(text)] = {};
+		const size_t size = fsReadFromStream(&stream, payload, sizeof(payload));
+		passed = TEST_CHECK(eastl::string(payload, size) == "binary payload") && passed;
+		fsCloseStream(&stream);
+	}
+	return passed;
+}
+
+bool testFileStreamReader()
+{
+	bool passed = testLines();
+	passed = testTokens() && passed;
+	passed = testExit() && passed;
+	return passed;
+}
+
+void benchmarkFileStreamReader()
+{
+	// Shader source like text, lines of 0 to 119 characters with a mix of "\n" and "\r\n" endings
+	eastl::string text;
+	uint32_t      seed = 1;
+	uint32_t      lineCount = 0;
+	while (text.size() < (8u << 20))
+	{
+		seed = seed * 1664525u + 1013904223u;
+		text.append((seed >> 8) % 120, 'a' + (char)(seed % 26));
+		text += (seed & 0x100) ? "\r\n" : "\n";
+		++lineCount;
+	}
+
+	// Best of a few runs so page faults and clock changes stay out of the numbers
+	int64_t       perByteTime = INT64_MAX;
+	int64_t       readerTime = INT64_MAX;
+	eastl::string line;
+	for (uint32_t run = 0; run < 5; ++run)
+	{
+		FileStream stream = {};
+		fsOpenStreamFromMemory(text.data(), text.size(), FM_READ_BINARY, false, &stream);
+		int64_t start = getUSec();
+		while (readLinePerByte(&stream, line))
+		{
+		}
+		int64_t time = getUSec() - start;
+		perByteTime = time < perByteTime ? time : perByteTime;
+		fsCloseStream(&stream);
+
+		fsOpenStreamFromMemory(text.data(), text.size(), FM_READ_BINARY, false, &stream);
+		FileStreamReader reader = {};
+		fsInitStreamReader(&stream, 0, NULL, &reader);
+		start = getUSec();
+		while (readLine(&reader, 256, line))
+		{
+		}
+		time = getUSec() - start;
+		readerTime = time < readerTime ? time : readerTime;
+		fsExitStreamReader(&reader);
+		fsCloseStream(&stream);
+	}
+
+	LOGF(
+		LogLevel::eINFO, "Reading %u lines (%u bytes): per byte %.3f ms, FileStreamReader %.3f ms (%.1fx)", lineCount,
+		(uint32_t)text.size(), perByteTime / 1000.0, readerTime / 1000.0, (double)perByteTime / (double)(readerTime ? readerTime : 1));
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+// Shader reflections written to the reflection cache by serializeShaderReflection and read back by deserializeShaderReflection
+
+#include "CoreTests.h"
+
+#include "../../../../Common_3/Renderer/IRenderer.h"
+
+#include "../../../../Common_3/OS/Interfaces/IMemory.h"
+
+template <typename T>
+static bool itemsEqual(const T* pA, const T* pB, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (pA[i].name_size != pB[i].name_size || strncmp(pA[i].name, pB[i].name, pA[i].name_size) != 0)
+			return false;
+
+		// Everything but the name pointer is copied as is
+		T a = pA[i];
+		T b = pB[i];
+		a.name = NULL;
+		b.name = NULL;
+		if (memcmp(&a, &b, sizeof(T)) != 0)
+			return false;
+	}
+	return true;
+}
+
+static bool reflectionsEqual(const ShaderReflection* pA, const ShaderReflection* pB)
+{
+	bool equal = pA->mShaderStage == pB->mShaderStage && pA->mNamePoolSize == pB->mNamePoolSize &&
+				 pA->mVertexInputsCount == pB->mVertexInputsCount && pA->mShaderResourceCount == pB->mShaderResourceCount &&
+				 pA->mVariableCount == pB->mVariableCount && pA->mNumControlPoint == pB->mNumControlPoint &&
+				 memcmp(pA->mNumThreadsPerGroup, pB->mNumThreadsPerGroup, sizeof(pA->mNumThreadsPerGroup)) == 0;
+	equal = equal && (!pA->mNamePoolSize || memcmp(pA->pNamePool, pB->pNamePool, pA->mNamePoolSize) == 0);
+	equal = equal && itemsEqual(pA->pVertexInputs, pB->pVertexInputs, pA->mVertexInputsCount);
+	equal = equal && itemsEqual(pA->pShaderResources, pB->pShaderResources, pA->mShaderResourceCount);
+	equal = equal && itemsEqual(pA->pVariables, pB->pVariables, pA->mVariableCount);
+#if defined(VULKAN)
+	equal = equal && (pA->pEntryPoint ? pB->pEntryPoint && pA->pEntryPoint - pA->pNamePool == pB->pEntryPoint - pB->pNamePool
+									   : !pB->pEntryPoint);
+#endif
+	return equal;
+}
+
+template <typename T>
+static T* allocateItems(uint32_t count)
+{
+	// Zeroed so the padding compared by itemsEqual is defined
+	return (T*)tf_calloc(count, sizeof(T));
+}
+
+// A vertex stage with an input layout, a uniform block and its members, the way the backend reflection fills them in
+static void createVertexStageReflection(ShaderReflection* pOutReflection)
+{
+	static const char names[] = "POSITION\0TEXCOORD\0uniformBlock\0mvp\0color\0diffuseMap\0main";
+	const uint32_t    namePoolSize = sizeof(names);
+
+	ShaderReflection reflection = {};
+	reflection.mShaderStage = SHADER_STAGE_VERT;
+	reflection.pNamePool = (char*)tf_malloc(namePoolSize);
+	memcpy(reflection.pNamePool, names, namePoolSize);
+	reflection.mNamePoolSize = namePoolSize;
+	const char* pPosition = reflection.pNamePool;
+	const char* pTexcoord = pPosition + sizeof("POSITION");
+	const char* pUniformBlock = pTexcoord + sizeof("TEXCOORD");
+	const char* pMvp = pUniformBlock + sizeof("uniformBlock");
+	const char* pColor = pMvp + sizeof("mvp");
+	const char* pDiffuseMap = pColor + sizeof("color");
+
+	reflection.mVertexInputsCount = 2;
+	reflection.pVertexInputs = allocateItems<VertexInput>(reflection.mVertexInputsCount);
+	reflection.pVertexInputs[0].size = sizeof(float[3]);
+	reflection.pVertexInputs[0].name = pPosition;
+	reflection.pVertexInputs[0].name_size = (uint32_t)strlen(pPosition);
+	reflection.pVertexInputs[1].size = sizeof(float[2]);
+	reflection.pVertexInputs[1].name = pTexcoord;
+	reflection.pVertexInputs[1].name_size = (uint32_t)strlen(pTexcoord);
+
+	reflection.mShaderResourceCount = 2;
+	reflection.pShaderResources = allocateItems<ShaderResource>(reflection.mShaderResourceCount);
+	reflection.pShaderResources[0].type = DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	reflection.pShaderResources[0].set = 1;
+	reflection.pShaderResources[0].reg = 0;
+	reflection.pShaderResources[0].size = 1;
+	reflection.pShaderResources[0].used_stages = SHADER_STAGE_VERT;
+	reflection.pShaderResources[0].name = pUniformBlock;
+	reflection.pShaderResources[0].name_size = (uint32_t)strlen(pUniformBlock);
+	reflection.pShaderResources[0].dim = TEXTURE_DIM_UNDEFINED;
+	reflection.pShaderResources[1].type = DESCRIPTOR_TYPE_TEXTURE;
+	reflection.pShaderResources[1].set = 0;
+	reflection.pShaderResources[1].reg = 3;
+	reflection.pShaderResources[1].size = 4;
+	reflection.pShaderResources[1].used_stages = SHADER_STAGE_VERT;
+	reflection.pShaderResources[1].name = pDiffuseMap;
+	reflection.pShaderResources[1].name_size = (uint32_t)strlen(pDiffuseMap);
+	reflection.pShaderResources[1].dim = TEXTURE_DIM_2D_ARRAY;
+
+	reflection.mVariableCount = 2;
+	reflection.pVariables = allocateItems<ShaderVariable>(reflection.mVariableCount);
+	reflection.pVariables[0].parent_index = 0;
+	reflection.pVariables[0].offset = 0;
+	reflection.pVariables[0].size = sizeof(float[16]);
+	reflection.pVariables[0].name = pMvp;
+	reflection.pVariables[0].name_size = (uint32_t)strlen(pMvp);
+	reflection.pVariables[1].parent_index = 0;
+	reflection.pVariables[1].offset = sizeof(float[16]);
+	reflection.pVariables[1].size = sizeof(float[4]);
+	reflection.pVariables[1].name = pColor;
+	reflection.pVariables[1].name_size = (uint32_t)strlen(pColor);
+
+#if defined(VULKAN)
+	reflection.pEntryPoint = (char*)pDiffuseMap + sizeof("diffuseMap");
+#endif
+
+	*pOutReflection = reflection;
+}
+
+static bool testRoundTrip(const ShaderReflection* pReflection)
+{
+	void*    pBlob = NULL;
+	uint32_t blobSize = 0;
+	serializeShaderReflection(pReflection, &pBlob, &blobSize);
+
+	ShaderReflection roundTrip = {};
+	bool passed = TEST_CHECK(deserializeShaderReflection(pBlob, blobSize, &roundTrip));
+	passed = TEST_CHECK(reflectionsEqual(pReflection, &roundTrip)) && passed;
+	destroyShaderReflection(&roundTrip);
+
+	tf_free(pBlob);
+	return passed;
+}
+
+bool testShaderReflection()
+{
+	ShaderReflection reflection = {};
+	createVertexStageReflection(&reflection);
+	bool passed = testRoundTrip(&reflection);
+
+	// Compute stages only carry their thread group size
+	ShaderReflection compute = {};
+	compute.mShaderStage = SHADER_STAGE_COMP;
+	compute.mNumThreadsPerGroup[0] = 64;
+	compute.mNumThreadsPerGroup[1] = 2;
+	compute.mNumThreadsPerGroup[2] = 1;
+	passed = testRoundTrip(&compute) && passed;
+
+	void*    pBlob = NULL;
+	uint32_t blobSize = 0;
+	serializeShaderReflection(&reflection, &pBlob, &blobSize);
+
+	// Blobs from a cache file that was cut short or has names outside the name pool are rejected
+	ShaderReflection rejected = {};
+	passed = TEST_CHECK(!deserializeShaderReflection(pBlob, blobSize - 1, &rejected)) && passed;
+	passed = TEST_CHECK(!deserializeShaderReflection(pBlob, sizeof(uint32_t), &rejected)) && passed;
+	VertexInput* pBlobVertexInputs = (VertexInput*)((uint8_t*)pBlob + blobSize - reflection.mNamePoolSize -
+													reflection.mVariableCount * sizeof(ShaderVariable) -
+													reflection.mShaderResourceCount * sizeof(ShaderResource) -
+													reflection.mVertexInputsCount * sizeof(VertexInput));
+	pBlobVertexInputs[1].name = (const char*)(uintptr_t)(reflection.mNamePoolSize - 2);
+	passed = TEST_CHECK(!deserializeShaderReflection(pBlob, blobSize, &rejected)) && passed;
+
+	tf_free(pBlob);
+	destroyShaderReflection(&reflection);
+	return passed;
+}
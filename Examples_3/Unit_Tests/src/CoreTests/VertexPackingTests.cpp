@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+// The packing functions util_init_packing_functions selects against the scalar ones. The SIMD versions round to nearest even
+// and keep half float denormals where the scalar ones truncate, so the packed components may differ by one unit.
+
+#include "CoreTests.h"
+
+#include "../../../../Common_3/OS/Interfaces/ITime.h"
+#include "../../../../Common_3/Renderer/VertexPacking.h"
+
+#include "../../../../Common_3/OS/Interfaces/IMemory.h"
+
+using namespace theforge;
+
+typedef enum PackedComponent
+{
+	PACKED_HALF,
+	PACKED_UNORM16,
+	PACKED_UNORM8,
+} PackedComponent;
+
+typedef struct PackingCase
+{
+	const char*     pName;
+	PackingFunction pScalar;
+	PackingFunction PackingFunctions::*pSelected;
+	uint32_t        mSrcStride;
+	uint32_t        mDstSize;
+	PackedComponent mComponent;
+} PackingCase;
+
+static const PackingCase gPackingCases[] = {
+	{ "float2 to half2", util_pack_float2_to_half2, &PackingFunctions::pFloat2ToHalf2, sizeof(float[2]), sizeof(uint32_t), PACKED_HALF },
+	{ "float3 to half4", util_pack_float3_to_half4, &PackingFunctions::pFloat3ToHalf4, sizeof(float[3]), sizeof(uint16_t[4]), PACKED_HALF },
+	{ "normal to octahedral unorm2x16", util_pack_float3_direction_to_half2, &PackingFunctions::pFloat3DirectionToHalf2, sizeof(float[3]),
+	  sizeof(uint32_t), PACKED_UNORM16 },
+	{ "tangent to octahedral unorm2x16", util_pack_float3_direction_to_half2, &PackingFunctions::pFloat3DirectionToHalf2, sizeof(float[4]),
+	  sizeof(uint32_t), PACKED_UNORM16 },
+	{ "float2 to unorm2x16", util_pack_float2_to_unorm2x16, &PackingFunctions::pFloat2ToUnorm2x16, sizeof(float[2]), sizeof(uint32_t),
+	  PACKED_UNORM16 },
+	{ "float4 to unorm4x8", util_pack_float4_to_unorm4x8, &PackingFunctions::pFloat4ToUnorm4x8, sizeof(float[4]), sizeof(uint32_t),
+	  PACKED_UNORM8 },
+};
+
+// Values in [-1.25, 1.25], so directions of all lengths and texcoords or weights that get clamped, after a few that sit on the edges
+// of the half float and unorm ranges
+static float* createPackingSource(uint32_t floatCount)
+{
+	static const float edges[] = { 0.0f,     -0.0f,    1.0f,     -1.0f,     0.5f,       1.0f / 510.0f, 0.99999f, 1.00001f,
+								   65504.0f, 65519.0f, 65520.0f, -70000.0f, 6.1035e-5f, 1e-5f,         -3e-7f,   1e-9f };
+
+	float* src = (float*)tf_malloc(floatCount * sizeof(float));
+	uint32_t seed = 1;
+	for (uint32_t i = 0; i < floatCount; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		src[i] = i < sizeof(edges) / sizeof(edges[0]) ? edges[i] : (float)(seed >> 8) / (float)(1 << 24) * 2.5f - 1.25f;
+	}
+	return src;
+}
+
+static float halfToFloat(uint16_t h)
+{
+	const float sign = (h & 0x8000) ? -1.0f : 1.0f;
+	const int exponent = (h >> 10) & 0x1F;
+	const int mantissa = h & 0x3FF;
+	// Infinity is treated as the value after the largest half, one unit away from it
+	if (exponent == 0x1F)
+		return sign * 65536.0f;
+	if (exponent == 0)
+		return sign * ldexpf((float)mantissa, -24);
+	return sign * ldexpf((float)(mantissa | 0x400), exponent - 25);
+}
+
+static bool componentsMatch(PackedComponent component, const uint8_t* pScalar, const uint8_t* pSelected)
+{
+	switch (component)
+	{
+	case PACKED_HALF:
+	{
+		const float a = halfToFloat(*(const uint16_t*)pScalar);
+		const float b = halfToFloat(*(const uint16_t*)pSelected);
+		// One unit of the larger value, flushed denormals are within the smallest normal
+		const float larger = fmaxf(fabsf(a), fabsf(b));
+		const float unit = larger <= 6.1035156e-5f ? 6.1035156e-5f : ldexpf(1.0f, ilogbf(larger) - 10);
+		return fabsf(a - b) <= unit;
+	}
+	case PACKED_UNORM16:
+		return abs((int)*(const uint16_t*)pScalar - (int)*(const uint16_t*)pSelected) <= 1;
+	case PACKED_UNORM8:
+		return abs((int)*pScalar - (int)*pSelected) <= 1;
+	}
+	return false;
+}
+
+static bool testPackingCase(const PackingCase& packingCase, const float* src, uint32_t count, uint32_t dstStride, uint32_t offset)
+{
+	const uint32_t componentSize = packingCase.mComponent == PACKED_UNORM8 ? 1 : 2;
+	const uint32_t dstSize = count * dstStride;
+	uint8_t* scalarDst = (uint8_t*)tf_malloc(dstSize + 1);
+	uint8_t* selectedDst = (uint8_t*)tf_malloc(dstSize + 1);
+	memset(scalarDst, 0xCD, dstSize + 1);
+	memset(selectedDst, 0xCD, dstSize + 1);
+
+	const PackingFunction pSelected = gPackingFunctions.*packingCase.pSelected;
+	packingCase.pScalar(count, packingCase.mSrcStride, dstStride, offset, (const uint8_t*)src, scalarDst);
+	pSelected(count, packingCase.mSrcStride, dstStride, offset, (const uint8_t*)src, selectedDst);
+
+	uint32_t overwrittenCount = 0;
+	uint32_t mismatchCount = 0;
+	for (uint32_t e = 0; e < count; ++e)
+	{
+		const uint8_t* s = scalarDst + e * dstStride;
+		const uint8_t* d = selectedDst + e * dstStride;
+		for (uint32_t b = 0; b < dstStride; ++b)
+		{
+			if ((b < offset || b >= offset + packingCase.mDstSize) && d[b] != 0xCD)
+				++overwrittenCount;
+		}
+		for (uint32_t c = 0; c < packingCase.mDstSize; c += componentSize)
+		{
+			if (!componentsMatch(packingCase.mComponent, s + offset + c, d + offset + c))
+			{
+				if (!mismatchCount)
+				{
+					const float* f = (const float*)((const uint8_t*)src + e * packingCase.mSrcStride);
+					LOGF(
+						LogLevel::eERROR, "Packing %s, element %u of %u (%f %f %f): component %u differs", packingCase.pName, e, count,
+						f[0], f[1], packingCase.mSrcStride > sizeof(float[2]) ? f[2] : 0.0f, c / componentSize);
+				}
+				++mismatchCount;
+			}
+		}
+	}
+	// Bytes outside the packed attribute belong to the other attributes of the vertex
+	bool passed = TEST_CHECK(mismatchCount == 0);
+	passed = TEST_CHECK(overwrittenCount == 0 && selectedDst[dstSize] == 0xCD) && passed;
+
+	tf_free(selectedDst);
+	tf_free(scalarDst);
+	return passed;
+}
+
+bool testVertexPacking()
+{
+	util_init_packing_functions();
+
+	// Counts around the SIMD widths so the scalar tails run as well, into packed and interleaved vertex buffers
+	static const uint32_t counts[] = { 1, 3, 4, 7, 8, 9, 17, 1003 };
+	float* src = createPackingSource(1003 * 4);
+
+	bool passed = true;
+	for (uint32_t i = 0; i < sizeof(gPackingCases) / sizeof(gPackingCases[0]); ++i)
+	{
+		const PackingCase& packingCase = gPackingCases[i];
+		for (uint32_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+		{
+			passed = testPackingCase(packingCase, src, counts[c], packingCase.mDstSize, 0) && passed;
+			passed = testPackingCase(packingCase, src, counts[c], 28, 12) && passed;
+		}
+	}
+
+	tf_free(src);
+	return passed;
+}
+
+void benchmarkVertexPacking()
+{
+	util_init_packing_functions();
+
+	const uint32_t count = 1 << 20;
+	float* src = createPackingSource(count * 4);
+	uint8_t* dst = (uint8_t*)tf_malloc(count * sizeof(uint16_t[4]));
+
+	for (uint32_t i = 0; i < sizeof(gPackingCases) / sizeof(gPackingCases[0]); ++i)
+	{
+		const PackingCase& packingCase = gPackingCases[i];
+		const PackingFunction pSelected = gPackingFunctions.*packingCase.pSelected;
+
+		// Best of a few runs so page faults and clock changes stay out of the numbers
+		int64_t scalarTime = INT64_MAX;
+		int64_t selectedTime = INT64_MAX;
+		for (uint32_t run = 0; run < 5; ++run)
+		{
+			int64_t start = getUSec();
+			packingCase.pScalar(count, packingCase.mSrcStride, packingCase.mDstSize, 0, (const uint8_t*)src, dst);
+			int64_t time = getUSec() - start;
+			scalarTime = time < scalarTime ? time : scalarTime;
+
+			start = getUSec();
+			pSelected(count, packingCase.mSrcStride, packingCase.mDstSize, 0, (const uint8_t*)src, dst);
+			time = getUSec() - start;
+			selectedTime = time < selectedTime ? time : selectedTime;
+		}
+
+		LOGF(
+			LogLevel::eINFO, "Packing %s, %u vertices: scalar %.3f ms, selected %.3f ms (%.1fx)", packingCase.pName, count,
+			scalarTime / 1000.0, selectedTime / 1000.0, (double)scalarTime / (double)(selectedTime ? selectedTime : 1));
+	}
+
+	tf_free(dst);
+	tf_free(src);
+}
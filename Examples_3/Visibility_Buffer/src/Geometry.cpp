@@ -28,6 +28,7 @@
 
 #include "../../../Common_3/OS/Interfaces/IFileSystem.h"
 #include "../../../Common_3/OS/Interfaces/ILog.h"
+#include "../../../Common_3/Renderer/GeometryFormat.h"
 #include "../../../Common_3/OS/Core/Compiler.h"
 
 #include "../../../Common_3/OS/Interfaces/IMemory.h"
@@ -912,11 +913,20 @@ Scene* loadScene(const char* pFileName, float scale, float offsetX, float offset
 	vertexLayout.mAttribs[3].mBinding = 3;
 	vertexLayout.mAttribs[3].mLocation = 3;
 
+	// Prefer the container written by the AssetPipeline (-pg) when it is there. Its meshlets replace the clusters
+	// computed from the CPU copy of the geometry, so no shadow copy is needed
+	char containerFileName[FS_MAX_PATH] = {};
+	fsReplacePathExtension(pFileName, GEOMETRY_FILE_EXTENSION, containerFileName);
+	FileStream containerFile = {};
+	const bool hasContainer = fsOpenStreamFromPath(RD_MESHES, containerFileName, FM_READ_BINARY, &containerFile);
+	if (hasContainer)
+		fsCloseStream(&containerFile);
+
 	GeometryLoadDesc loadDesc = {};
-	loadDesc.pFileName = pFileName;
+	loadDesc.pFileName = hasContainer ? containerFileName : pFileName;
 	loadDesc.ppGeometry = &scene->geom;
 	loadDesc.pVertexLayout = &vertexLayout;
-	loadDesc.mFlags = GEOMETRY_LOAD_FLAG_SHADOWED;
+	loadDesc.mFlags = hasContainer ? (GeometryLoadFlags)0 : GEOMETRY_LOAD_FLAG_SHADOWED;
 	SyncToken token = {};
 	addResource(&loadDesc, &token);
 
@@ -1110,6 +1120,45 @@ void createClusters(bool twoSided, const Scene* pScene, IndirectDrawIndexArgumen
 	}
 }
 
+// Build the clusters from the meshlets generated offline. Meshlet triangles are contiguous in the index buffer, so each
+// meshlet maps to one cluster and the per triangle work of createClusters is skipped
+void createClustersFromMeshlets(bool twoSided, const Scene* pScene, uint32_t drawIndex, ClusterContainer* mesh)
+{
+	const Geometry*                   geom = pScene->geom;
+	const IndirectDrawIndexArguments* draw = &geom->pDrawArgs[drawIndex];
+
+	ASSERT(geom->pDrawMeshlets);
+	const uint32_t firstMeshlet = geom->pDrawMeshlets[drawIndex].mStartMeshlet;
+	const uint32_t meshletCount = geom->pDrawMeshlets[drawIndex].mMeshletCount;
+	ASSERT(firstMeshlet + meshletCount <= geom->mMeshletCount);
+
+	mesh->clusterCount = meshletCount;
+	mesh->clusterCompacts = (ClusterCompact*)tf_calloc(max(1U, meshletCount), sizeof(ClusterCompact));
+	mesh->clusters = (Cluster*)tf_calloc(max(1U, meshletCount), sizeof(Cluster));
+
+	for (uint32_t i = 0; i < meshletCount; ++i)
+	{
+		const Meshlet* meshlet = &geom->pMeshlets[firstMeshlet + i];
+		ASSERT(meshlet->mTriangleCount <= CLUSTER_SIZE);
+
+		const float3 center = float3(meshlet->mCenter[0], meshlet->mCenter[1], meshlet->mCenter[2]);
+		const float3 extent = float3(meshlet->mRadius, meshlet->mRadius, meshlet->mRadius);
+
+		Cluster* cluster = &mesh->clusters[i];
+		cluster->aabbMin = center - extent;
+		cluster->aabbMax = center + extent;
+		// The meshlet cone axis is the average normal, the cluster cone axis points away from the triangles
+		cluster->coneCenter = float3(meshlet->mConeApex[0], meshlet->mConeApex[1], meshlet->mConeApex[2]);
+		cluster->coneAxis = float3(-meshlet->mConeAxis[0], -meshlet->mConeAxis[1], -meshlet->mConeAxis[2]);
+		cluster->coneAngleCosine = meshlet->mConeCutoff;
+		// A cutoff of 1 marks a normal cone too wide to cull with. Dont cull two sided meshes
+		cluster->valid = !twoSided && meshlet->mConeCutoff < 1.0f;
+
+		mesh->clusterCompacts[i].triangleCount = meshlet->mTriangleCount;
+		mesh->clusterCompacts[i].clusterStart = (meshlet->mStartIndex - draw->mStartIndex) / 3;
+	}
+}
+
 void destroyClusters(ClusterContainer* pMesh)
 {
 	// Destroy clusters
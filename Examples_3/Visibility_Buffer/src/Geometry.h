@@ -119,6 +119,7 @@ typedef struct FilterBatchChunk
 Scene* loadScene(const char* pFileName, float scale, float offsetX, float offsetY, float offsetZ);
 void   removeScene(Scene* scene);
 void   createClusters(bool twoSided, const Scene* pScene, IndirectDrawIndexArguments* draw, ClusterContainer* mesh);
+void   createClustersFromMeshlets(bool twoSided, const Scene* pScene, uint32_t drawIndex, ClusterContainer* mesh);
 void   destroyClusters(ClusterContainer* mesh);
 
 void addClusterToBatchChunk(
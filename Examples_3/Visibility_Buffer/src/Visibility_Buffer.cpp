@@ -941,7 +941,10 @@ public:
 		{
 			ClusterContainer*   mesh = pMeshes + i;
 			Material* material = pScene->materials + i;
-			createClusters(material->twoSided, pScene, pScene->geom->pDrawArgs + i, mesh);
+			if (pScene->geom->mMeshletCount)
+				createClustersFromMeshlets(material->twoSided, pScene, i, mesh);
+			else
+				createClusters(material->twoSided, pScene, pScene->geom->pDrawArgs + i, mesh);
 		}
 
 		tf_free(pScene->geom->pShadow);
@@ -56,16 +56,118 @@ void AnimatedObject::Destroy()
 {
 	ozz::memory::Allocator* allocator = ozz::memory::default_allocator();
 	allocator->Deallocate(mLocalTrans);
+	allocator->Deallocate(mLodSamples[0]);
+	allocator->Deallocate(mLodSamples[1]);
 }
 
 bool AnimatedObject::Update(float dt)
 {
 	// sample the current animation to get mLocalTrans
-	if (!mAnimation->Sample(dt, mLocalTrans))
-		return false;
+	return UpdateLod(dt, NULL);
+}
+
+bool AnimatedObject::Update(float dt, ozz::Range<SoaTransform>* clipScratch)
+{
+	// sample the current animation to get mLocalTrans, clips are sampled into the scratch buffers
+	return UpdateLod(dt, clipScratch);
+}
+
+void AnimatedObject::SetLod(AnimationLod* lod)
+{
+	pLod = lod;
+	mLodLevel = 0;
+	mFramesSinceSample = 0;
+	mAccumulatedDt = 0.f;
+	mLodSamplesValid = false;
+
+	// History buffers are only needed once an object can be throttled
+	if (pLod && !mLodSamples[0].begin)
+	{
+		ozz::memory::Allocator* allocator = ozz::memory::default_allocator();
+		mLodSamples[0] = allocator->AllocateRange<SoaTransform>(mRig->GetNumSoaJoints());
+		mLodSamples[1] = allocator->AllocateRange<SoaTransform>(mRig->GetNumSoaJoints());
+	}
+}
+
+bool AnimatedObject::UpdateLod(float dt, ozz::Range<SoaTransform>* clipScratch)
+{
+	if (!pLod)
+	{
+		if (!mAnimation->Sample(dt, mLocalTrans, clipScratch))
+			return false;
+
+		return LocalToModel();
+	}
+
+	mLodLevel = pLod->SelectLevel(mLodMetric);
+	const AnimationLodLevel* level = pLod->GetLevel(mLodLevel);
+	const unsigned int       interval = level->mUpdateInterval;
+
+	mAccumulatedDt += dt;
+
+	// Full rate, sample straight into the output
+	if (interval <= 1)
+	{
+		if (!mAnimation->Sample(mAccumulatedDt, mLocalTrans, clipScratch, level))
+			return false;
 
-	// Local to model job
+		mAccumulatedDt = 0.f;
+		mLodSamplesValid = false;
+		return LocalToModel();
+	}
+
+	// The interval can shrink when the level changes, sample as soon as it has passed
+	if (!mLodSamplesValid || mFramesSinceSample + 1 >= interval)
+	{
+		mLodNewestSample ^= 1;
+		if (!mAnimation->Sample(mAccumulatedDt, mLodSamples[mLodNewestSample], clipScratch, level))
+			return false;
+
+		if (!mLodSamplesValid)
+		{
+			// Nothing to interpolate from yet
+			memcpy(mLodSamples[!mLodNewestSample].begin, mLodSamples[mLodNewestSample].begin, mLodSamples[0].size());
+			mLodSamplesValid = true;
+		}
+
+		mAccumulatedDt = 0.f;
+		mFramesSinceSample = 0;
+	}
+	else
+	{
+		mFramesSinceSample++;
+	}
 
+	// Interpolate from the previous sample to the newest one over the interval.
+	// The displayed pose trails the animation by one interval in exchange for smooth motion
+	const float alpha = (float)(mFramesSinceSample + 1) / (float)interval;
+
+	if (alpha >= 1.f)
+	{
+		memcpy(mLocalTrans.begin, mLodSamples[mLodNewestSample].begin, mLocalTrans.size());
+	}
+	else
+	{
+		ozz::animation::BlendingJob::Layer layers[2];
+		layers[0].transform = mLodSamples[!mLodNewestSample];
+		layers[0].weight = 1.f - alpha;
+		layers[1].transform = mLodSamples[mLodNewestSample];
+		layers[1].weight = alpha;
+
+		ozz::animation::BlendingJob blendJob;
+		blendJob.layers = layers;
+		blendJob.bind_pose = mRig->GetSkeleton()->bind_pose();
+		blendJob.output = mLocalTrans;
+
+		if (!blendJob.Run())
+			return false;
+	}
+
+	return LocalToModel();
+}
+
+bool AnimatedObject::LocalToModel()
+{
 	// Setup local-to-model conversion job.
 	ozz::animation::LocalToModelJob ltmJob;
 	ltmJob.skeleton = mRig->GetSkeleton();
@@ -95,6 +95,10 @@ class AnimatedObject
 	// To be called every frame of the main application, handles sampling and updating the current animation
 	bool Update(float dt);
 
+	// Same as Update but samples the animation clips into caller provided scratch buffers.
+	// Used by AnimationSystem so clip buffers are shared between objects instead of owned per animation
+	bool Update(float dt, ozz::Range<SoaTransform>* clipScratch);
+
 	bool AimIK(AimIKDesc* params, Point3 target);
 
 	// Apply two bone inverse kinematic
@@ -112,10 +116,31 @@ class AnimatedObject
 	// Set the root transform of the object
 	inline void SetRootTransform(const Matrix4& rootTransform) { mRootTransform = rootTransform; };
 
+	// Get the root transform of the object
+	inline const Matrix4& GetRootTransform() { return mRootTransform; };
+
 	// Get the rig of this animated object
 	inline Rig* GetRig() { return mRig; };
 
+	// Get the animation this object is sampling
+	inline Animation* GetAnimation() { return mAnimation; };
+
+	// Set the detail levels used to throttle the update of this object. NULL always updates at full detail
+	void SetLod(AnimationLod* lod);
+
+	// Set the metric the detail level is picked from, e.g. screen size or inverse distance to the camera
+	inline void SetLodMetric(float metric) { mLodMetric = metric; };
+
+	// Get the index of the detail level used by the last update
+	inline unsigned int GetLodLevel() { return mLodLevel; };
+
 	private:
+	// Shared implementation of both Update functions, clipScratch can be NULL
+	bool UpdateLod(float dt, ozz::Range<SoaTransform>* clipScratch);
+
+	// Converts mLocalTrans to model space into mRig's joint model matrices
+	bool LocalToModel();
+
 	// The Rig the AnimatedObject will be posing
 	Rig* mRig;
 
@@ -127,4 +152,28 @@ class AnimatedObject
 
 	// Transform to apply to entire rig
 	Matrix4 mRootTransform = Matrix4::identity();
+
+	// Detail levels of this object, NULL if LOD is disabled
+	AnimationLod* pLod = NULL;
+
+	// Value selecting the detail level, larger is more detailed
+	float mLodMetric = 0.f;
+
+	// Index of the current detail level
+	unsigned int mLodLevel = 0;
+
+	// The last two samples of a throttled animation, mLocalTrans is interpolated between them
+	ozz::Range<SoaTransform> mLodSamples[2];
+
+	// Index in mLodSamples of the newest sample
+	unsigned int mLodNewestSample = 0;
+
+	// Frames since the newest sample was taken
+	unsigned int mFramesSinceSample = 0;
+
+	// Time that passed since the newest sample, the next sample advances the animation by this much
+	float mAccumulatedDt = 0.f;
+
+	// False until mLodSamples hold a sample
+	bool mLodSamplesValid = false;
 };
@@ -54,10 +54,15 @@ void Animation::Initialize(AnimationDesc animationDesc)
 		// Prepare input and output of clip sampling
 
 		// Allocates sampler runtime buffers.
-		mClipLocalTrans[i] = allocator->AllocateRange<SoaTransform>(mRig->GetNumSoaJoints());
+		if (!animationDesc.mUseExternalScratch)
+			mClipLocalTrans[i] = allocator->AllocateRange<SoaTransform>(mRig->GetNumSoaJoints());
 
 		// Allocates a cache that matches animation requirements.
 		mClipSamplingCaches[i] = allocator->New<ozz::animation::SamplingCache>(mRig->GetNumJoints());
+
+		// Masked clips need room to combine their mask with an LOD joint mask
+		if (mClipMasks[i])
+			mLodJointWeights[i] = allocator->AllocateRange<Vector4>(mRig->GetNumSoaJoints());
 	}
 
 	// Allocate the blend layers that will be set each sampling based on each clip's properties
@@ -73,6 +78,7 @@ void Animation::Destroy()
 	{
 		allocator->Delete(mClipSamplingCaches[i]);
 		allocator->Deallocate(mClipLocalTrans[i]);
+		allocator->Deallocate(mLodJointWeights[i]);
 	}
 	allocator->Deallocate(mLayers);
 	allocator->Deallocate(mAdditiveLayers);
@@ -80,6 +86,21 @@ void Animation::Destroy()
 
 bool Animation::Sample(float dt, ozz::Range<SoaTransform>& localTrans)
 {
+	return Sample(dt, localTrans, NULL);
+}
+
+bool Animation::Sample(
+	float dt, ozz::Range<SoaTransform>& localTrans, ozz::Range<SoaTransform>* clipScratch, const AnimationLodLevel* pLod)
+{
+	if (!clipScratch)
+	{
+		ASSERT((mNumClips == 0 || mClipLocalTrans[0].begin) && "Animation was initialized with mUseExternalScratch, provide clip scratch buffers");
+		clipScratch = mClipLocalTrans;
+	}
+
+	// Weights used for blending, after LOD culling of additive layers
+	float clipWeights[MAX_NUM_CLIPS];
+
 	//update blend and sample parameters
 	if (mAutoSetBlendParams)
 	{
@@ -92,11 +113,17 @@ bool Animation::Sample(float dt, ozz::Range<SoaTransform>& localTrans)
 		// Updates clips time.
 		mClipControllers[i]->Update(dt);
 
+		clipWeights[i] = mClipControllers[i]->GetWeight();
+
+		// Additive layers with too little influence at this LOD are dropped
+		if (pLod && mClipControllers[i]->IsAdditive() && clipWeights[i] < pLod->mAdditiveWeightThreshold)
+			clipWeights[i] = 0.f;
+
 		// Early out if this layers weight makes it irrelevant during blending.
-		if (mClipControllers[i]->GetWeight() != 0.f)
+		if (clipWeights[i] != 0.f)
 		{
 			//if (!mClips[i]->Sample(mClipControllers[i]->GetTimeRatio()))
-			if (!mClips[i]->Sample(mClipSamplingCaches[i], mClipLocalTrans[i], mClipControllers[i]->GetTimeRatio()))
+			if (!mClips[i]->Sample(mClipSamplingCaches[i], clipScratch[i], mClipControllers[i]->GetTimeRatio()))
 				return false;
 		}
 	}
@@ -105,7 +132,7 @@ bool Animation::Sample(float dt, ozz::Range<SoaTransform>& localTrans)
 	mTimeRatio = mClipControllers[mLongestClipIndex]->GetTimeRatio();
 
 	//blend these samples together
-	return Blend(localTrans);
+	return Blend(localTrans, clipScratch, clipWeights, pLod);
 }
 
 void Animation::UpdateBlendParameters()
@@ -182,32 +209,28 @@ void Animation::UpdateBlendParameters()
 	}
 }
 
-bool Animation::Blend(ozz::Range<SoaTransform>& localTrans)
+bool Animation::Blend(
+	ozz::Range<SoaTransform>& localTrans, ozz::Range<SoaTransform>* clipLocalTrans, const float* clipWeights,
+	const AnimationLodLevel* pLod)
 {
+	ClipMask* pLodMask = pLod ? pLod->pJointMask : NULL;
+
 	unsigned int additiveIndex = 0;
 	for (unsigned int i = 0; i < mNumClips; i++)
 	{
 		if (mClipControllers[i]->IsAdditive())
 		{
-			mAdditiveLayers[additiveIndex].transform = mClipLocalTrans[i];
-			mAdditiveLayers[additiveIndex].weight = mClipControllers[i]->GetWeight();
-
-			if (mClipMasks[i])
-				mAdditiveLayers[additiveIndex].joint_weights = mClipMasks[i]->GetJointWeights();
-			else
-				mAdditiveLayers[additiveIndex].joint_weights = ozz::Range<const Vector4>();
+			mAdditiveLayers[additiveIndex].transform = clipLocalTrans[i];
+			mAdditiveLayers[additiveIndex].weight = clipWeights[i];
+			mAdditiveLayers[additiveIndex].joint_weights = GetLodJointWeights(i, pLodMask);
 
 			additiveIndex++;
 		}
 		else
 		{
-			mLayers[i].transform = mClipLocalTrans[i];
-			mLayers[i].weight = mClipControllers[i]->GetWeight();
-
-			if (mClipMasks[i])
-				mLayers[i].joint_weights = mClipMasks[i]->GetJointWeights();
-			else
-				mLayers[i].joint_weights = ozz::Range<const Vector4>();
+			mLayers[i].transform = clipLocalTrans[i];
+			mLayers[i].weight = clipWeights[i];
+			mLayers[i].joint_weights = GetLodJointWeights(i, pLodMask);
 		}
 	}
 
@@ -229,6 +252,26 @@ bool Animation::Blend(ozz::Range<SoaTransform>& localTrans)
 	return true;
 }
 
+ozz::Range<const Vector4> Animation::GetLodJointWeights(unsigned int clipIndex, ClipMask* pLodMask)
+{
+	ClipMask* pClipMask = mClipMasks[clipIndex];
+
+	if (!pLodMask)
+		return pClipMask ? pClipMask->GetJointWeights() : ozz::Range<const Vector4>();
+
+	if (!pClipMask)
+		return pLodMask->GetJointWeights();
+
+	// Both masks apply, joints keep the product of the two weights
+	ozz::Range<Vector4> clipWeights = pClipMask->GetJointWeights();
+	ozz::Range<Vector4> lodWeights = pLodMask->GetJointWeights();
+	ozz::Range<Vector4> out = mLodJointWeights[clipIndex];
+	for (size_t i = 0; i < out.count(); i++)
+		out[i] = mulPerElem(clipWeights[i], lodWeights[i]);
+
+	return out;
+}
+
 void Animation::SetTimeRatio(float timeRatio)
 {
 	float time = timeRatio * mDuration;
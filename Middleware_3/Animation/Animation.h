@@ -34,6 +34,7 @@
 #include "Clip.h"
 #include "ClipMask.h"
 #include "ClipController.h"
+#include "AnimationLod.h"
 
 // Maximum number of clips that can make up one animation
 const unsigned int MAX_NUM_CLIPS = 10;
@@ -63,6 +64,9 @@ struct AnimationDesc
 	unsigned int  mNumLayers;
 	LayerProperty mLayerProperties[MAX_NUM_CLIPS];
 	BlendType     mBlendType = BlendType::EQUAL;
+	// When true the per clip local transform buffers are not allocated by the animation.
+	// Sample must then be given scratch buffers, for example from an AnimationSystem
+	bool          mUseExternalScratch = false;
 };
 
 // Allows for blending and sampling of loaded clips
@@ -78,6 +82,12 @@ class Animation
 	// Will sample the animation at dt, storing the local transform results in localTrans
 	bool Sample(float dt, ozz::Range<SoaTransform>& localTrans);
 
+	// Same as above but samples the clips into clipScratch (one buffer of at least GetNumSoaJoints() per clip)
+	// instead of the buffers owned by the animation. clipScratch can be NULL to use the owned buffers.
+	// When pLod is set, additive clips below its weight threshold are skipped and its joint mask is applied to every layer
+	bool Sample(
+		float dt, ozz::Range<SoaTransform>& localTrans, ozz::Range<SoaTransform>* clipScratch, const AnimationLodLevel* pLod = NULL);
+
 	// Set if UpdateBlendParameters() be called or not
 	inline void SetAutoSetBlendParams(bool setValue) { mAutoSetBlendParams = setValue; };
 
@@ -93,6 +103,9 @@ class Animation
 	// Get the length of the animation - (length of the longest clip)
 	inline float GetDuration() { return mDuration; };
 
+	// Get the number of clips that make up this animation
+	inline unsigned int GetNumClips() { return mNumClips; };
+
 	// Gets the address of mBlendRatio so it can be edited externally
 	inline float* GetBlendRatioPtr() { return &mBlendRatio; };
 
@@ -104,7 +117,12 @@ class Animation
 	void UpdateBlendParameters();
 
 	// Blend the sampled clips together based on their blend parameters
-	bool Blend(ozz::Range<SoaTransform>& localTrans);
+	bool Blend(
+		ozz::Range<SoaTransform>& localTrans, ozz::Range<SoaTransform>* clipLocalTrans, const float* clipWeights,
+		const AnimationLodLevel* pLod);
+
+	// Returns the joint weights of clipIndex combined with the LOD joint mask
+	ozz::Range<const Vector4> GetLodJointWeights(unsigned int clipIndex, ClipMask* pLodMask);
 
 	// Pointer to the rig that this animation corresponds to
 	Rig* mRig;
@@ -124,6 +142,9 @@ class Animation
 	// The buffer of local transforms that will be updated as output when each clip is sampled
 	ozz::Range<SoaTransform> mClipLocalTrans[MAX_NUM_CLIPS];
 
+	// Product of each clip mask with the current LOD joint mask, only allocated for clips that have a mask
+	ozz::Range<Vector4> mLodJointWeights[MAX_NUM_CLIPS];
+
 	// The blend layers that will be set each sampling based on each clip's properties
 	ozz::Range<ozz::animation::BlendingJob::Layer> mLayers;
 	ozz::Range<ozz::animation::BlendingJob::Layer> mAdditiveLayers;
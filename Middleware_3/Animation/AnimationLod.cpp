@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include "AnimationLod.h"
+
+void AnimationLod::Initialize(const AnimationLodLevel* levels, unsigned int numLevels)
+{
+	ASSERT(levels);
+	ASSERT(numLevels > 0);
+
+	mNumLevels = min(numLevels, MAX_NUM_ANIMATION_LODS);
+
+	for (unsigned int i = 0; i < mNumLevels; i++)
+	{
+		ASSERT((i == 0 || levels[i].mMinMetric <= levels[i - 1].mMinMetric) && "Levels must go from most to least detailed");
+
+		mLevels[i] = levels[i];
+		mLevels[i].mUpdateInterval = max(1U, levels[i].mUpdateInterval);
+	}
+}
+
+unsigned int AnimationLod::SelectLevel(float metric) const
+{
+	// Most detailed level the metric qualifies for, falling back to the least detailed one
+	for (unsigned int i = 0; i < mNumLevels; i++)
+	{
+		if (metric >= mLevels[i].mMinMetric)
+			return i;
+	}
+
+	return mNumLevels - 1;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include "../../Common_3/OS/Math/MathTypes.h"
+
+#include "ClipMask.h"
+
+// Maximum number of detail levels in one AnimationLod
+const unsigned int MAX_NUM_ANIMATION_LODS = 4;
+
+// Settings of one animation detail level
+struct AnimationLodLevel
+{
+	// The level is used while the caller supplied metric is >= mMinMetric.
+	// Typically the metric is the screen size of the character, or an inverse distance
+	float     mMinMetric = 0.f;
+	// Sample the animation every mUpdateInterval frames and interpolate the pose in between
+	unsigned  mUpdateInterval = 1;
+	// Optional mask applied to every layer while blending. Joints with a weight of zero keep their bind pose
+	ClipMask* pJointMask = nullptr;
+	// Additive layers with a weight below this value are neither sampled nor blended
+	float     mAdditiveWeightThreshold = 0.f;
+};
+
+// Set of detail levels shared by any number of AnimatedObjects
+class AnimationLod
+{
+	public:
+	// Set up the levels. They must be ordered from the most detailed level (highest mMinMetric) to the least
+	void Initialize(const AnimationLodLevel* levels, unsigned int numLevels);
+
+	// Returns the index of the level to use for metric
+	unsigned int SelectLevel(float metric) const;
+
+	// Get the level at index
+	inline const AnimationLodLevel* GetLevel(unsigned int index) const { return &mLevels[index]; };
+
+	// Gets the number of levels
+	inline unsigned int GetNumLevels() const { return mNumLevels; };
+
+	// Gets the address of the level at index so it can be edited externally
+	inline AnimationLodLevel* GetLevelPtr(unsigned int index) { return &mLevels[index]; };
+
+	private:
+	AnimationLodLevel mLevels[MAX_NUM_ANIMATION_LODS];
+
+	unsigned int mNumLevels = 0;
+};
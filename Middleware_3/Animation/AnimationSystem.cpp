@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include "AnimationSystem.h"
+
+// Number of tasks each thread should get when the grain size is picked automatically.
+// More than one so threads that finish early can pick up the remaining work
+const unsigned int kTasksPerThread = 4;
+
+void AnimationSystem::Initialize(const AnimationSystemDesc& desc)
+{
+	ASSERT(desc.mMaxSoaJoints > 0);
+
+	pThreadSystem = desc.pThreadSystem;
+	mMaxSoaJoints = desc.mMaxSoaJoints;
+	mGrainSize = desc.mGrainSize;
+	mPoseRigs = desc.mPoseRigs;
+
+	// The calling thread helps with the tasks so it needs a slot as well
+	mNumScratchSlots = pThreadSystem ? min(getThreadSystemThreadCount(pThreadSystem) + 1, MAX_ANIMATION_SCRATCH_SLOTS) : 1;
+
+	ozz::memory::Allocator* allocator = ozz::memory::default_allocator();
+
+	for (unsigned int i = 0; i < mNumScratchSlots; i++)
+	{
+		for (unsigned int j = 0; j < MAX_NUM_CLIPS; j++)
+			mScratchSlots[i].mClipLocalTrans[j] = allocator->AllocateRange<SoaTransform>(mMaxSoaJoints);
+
+		mScratchSlots[i].mInUse = 0;
+	}
+}
+
+void AnimationSystem::Destroy()
+{
+	ozz::memory::Allocator* allocator = ozz::memory::default_allocator();
+
+	for (unsigned int i = 0; i < mNumScratchSlots; i++)
+	{
+		for (unsigned int j = 0; j < MAX_NUM_CLIPS; j++)
+			allocator->Deallocate(mScratchSlots[i].mClipLocalTrans[j]);
+	}
+
+	mNumScratchSlots = 0;
+}
+
+bool AnimationSystem::Update(AnimatedObject* pObjects, unsigned int objectCount, float dt)
+{
+	if (objectCount == 0)
+		return true;
+
+	ASSERT(pObjects);
+	ASSERT(mNumScratchSlots > 0 && "AnimationSystem was not initialized");
+
+	this->pObjects = pObjects;
+	mObjectCount = objectCount;
+	mDeltaTime = dt;
+	mFailedCount = 0;
+
+	if (!pThreadSystem)
+	{
+		mChunkSize = objectCount;
+		UpdateChunk(this, 0);
+	}
+	else
+	{
+		const unsigned int threadCount = mNumScratchSlots;
+		mChunkSize = mGrainSize ? mGrainSize : max(1U, objectCount / (threadCount * kTasksPerThread));
+
+		const unsigned int chunkCount = (objectCount + mChunkSize - 1) / mChunkSize;
+		addThreadSystemRangeTask(pThreadSystem, &AnimationSystem::UpdateChunk, this, chunkCount);
+
+		// Help out instead of idling, then wait for the tasks still running on the workers
+		while (assistThreadSystem(pThreadSystem))
+			;
+		waitThreadSystemIdle(pThreadSystem);
+	}
+
+	this->pObjects = NULL;
+
+	if (mFailedCount != 0)
+	{
+		LOGF(eERROR, "AnimationSystem: %u of %u animated objects failed to update", (uint32_t)mFailedCount, objectCount);
+		return false;
+	}
+
+	return true;
+}
+
+void AnimationSystem::UpdateChunk(void* pUser, uintptr_t chunkIndex)
+{
+	AnimationSystem* pSystem = (AnimationSystem*)pUser;
+
+	const unsigned int begin = (unsigned int)chunkIndex * pSystem->mChunkSize;
+	const unsigned int end = min(begin + pSystem->mChunkSize, pSystem->mObjectCount);
+
+	ScratchSlot* pSlot = pSystem->AcquireScratch();
+
+	unsigned int failedCount = 0;
+	for (unsigned int i = begin; i < end; i++)
+	{
+		AnimatedObject& object = pSystem->pObjects[i];
+		ASSERT(object.GetRig()->GetNumSoaJoints() <= pSystem->mMaxSoaJoints);
+
+		// Sample, blend and convert to model space
+		if (!object.Update(pSystem->mDeltaTime, pSlot->mClipLocalTrans))
+		{
+			failedCount++;
+			continue;
+		}
+
+		if (pSystem->mPoseRigs)
+			object.PoseRig();
+	}
+
+	pSystem->ReleaseScratch(pSlot);
+
+	if (failedCount)
+		tfrg_atomic32_add_relaxed(&pSystem->mFailedCount, failedCount);
+}
+
+AnimationSystem::ScratchSlot* AnimationSystem::AcquireScratch()
+{
+	for (;;)
+	{
+		for (unsigned int i = 0; i < mNumScratchSlots; i++)
+		{
+			if (tfrg_atomic32_load_relaxed(&mScratchSlots[i].mInUse) == 0 &&
+				tfrg_atomic32_cas_relaxed(&mScratchSlots[i].mInUse, 0, 1) == 0)
+			{
+				tfrg_memorybarrier_acquire();
+				return &mScratchSlots[i];
+			}
+		}
+	}
+}
+
+void AnimationSystem::ReleaseScratch(ScratchSlot* pSlot)
+{
+	tfrg_atomic32_store_release(&pSlot->mInUse, 0);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include "../../Common_3/OS/Math/MathTypes.h"
+#include "../../Common_3/OS/Core/Atomics.h"
+#include "../../Common_3/OS/Core/ThreadSystem.h"
+
+#include "AnimatedObject.h"
+
+// Maximum number of scratch slots, one per thread that can run an update task at the same time
+const unsigned int MAX_ANIMATION_SCRATCH_SLOTS = MAX_LOAD_THREADS + 1;
+
+struct AnimationSystemDesc
+{
+	// Thread system the update tasks are scheduled on. When NULL objects are updated on the calling thread
+	ThreadSystem* pThreadSystem = NULL;
+	// Largest number of SOA joints of any rig that will be updated by the system
+	unsigned int  mMaxSoaJoints = 0;
+	// Number of objects updated per task. 0 picks a size that gives every thread a few tasks
+	unsigned int  mGrainSize = 0;
+	// Also call PoseRig on each object after it has been updated
+	bool          mPoseRigs = true;
+};
+
+// Updates many AnimatedObjects at once.
+// Objects are split into chunks that are scheduled on a ThreadSystem. Each task samples, blends,
+// converts to model space and poses the rigs of its chunk, using clip scratch buffers taken from a
+// pool owned by the system so animations do not each need their own
+// (see AnimationDesc::mUseExternalScratch).
+class AnimationSystem
+{
+	public:
+	// Allocates the scratch pool, sized for desc.mMaxSoaJoints
+	void Initialize(const AnimationSystemDesc& desc);
+
+	// Must be called to clean up the system if it has been initialized
+	void Destroy();
+
+	// Updates objectCount objects from pObjects and waits for all of them to finish.
+	// Returns false if any of the objects failed to update
+	bool Update(AnimatedObject* pObjects, unsigned int objectCount, float dt);
+
+	// Set the number of objects per task. 0 picks it automatically
+	inline void SetGrainSize(unsigned int grainSize) { mGrainSize = grainSize; };
+
+	// Gets the address of mGrainSize so it can be edited externally
+	inline unsigned int* GetGrainSizePtr() { return &mGrainSize; };
+
+	// Set if PoseRig is called on the objects after updating them
+	inline void SetPoseRigs(bool setValue) { mPoseRigs = setValue; };
+
+	private:
+	// Clip sampling buffers used by one task while it runs
+	struct ScratchSlot
+	{
+		ozz::Range<SoaTransform> mClipLocalTrans[MAX_NUM_CLIPS];
+		tfrg_atomic32_t          mInUse;
+	};
+
+	// Range task entry point, updates one chunk
+	static void UpdateChunk(void* pUser, uintptr_t chunkIndex);
+
+	// Finds a free scratch slot. One always exists since there are more slots than threads
+	ScratchSlot* AcquireScratch();
+	void         ReleaseScratch(ScratchSlot* pSlot);
+
+	ThreadSystem* pThreadSystem = NULL;
+
+	// Pool of scratch buffers
+	ScratchSlot  mScratchSlots[MAX_ANIMATION_SCRATCH_SLOTS];
+	unsigned int mNumScratchSlots = 0;
+	unsigned int mMaxSoaJoints = 0;
+
+	unsigned int mGrainSize = 0;
+	bool         mPoseRigs = true;
+
+	// State of the current Update call, read by the tasks
+	AnimatedObject* pObjects = NULL;
+	unsigned int    mObjectCount = 0;
+	unsigned int    mChunkSize = 1;
+	float           mDeltaTime = 0.f;
+	tfrg_atomic32_t mFailedCount = 0;
+};
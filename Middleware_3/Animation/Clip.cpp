@@ -23,63 +23,282 @@
 */
 
 #include "Clip.h"
+#include "ClipCache.h"
+#include "ClipFormat.h"
+
+using namespace theforge;
 
 void Clip::Initialize(const ResourceDirectory resourceDir, const char* fileName, Rig* rig)
 {
-	LoadClip(resourceDir, fileName);
+	Initialize(resourceDir, fileName, rig, NULL, CLIP_LOAD_FLAG_NONE);
+}
+
+void Clip::Initialize(const ResourceDirectory resourceDir, const char* fileName, Rig* rig, ClipCache* cache, uint32_t loadFlags)
+{
+	pCache = cache;
+
+	if (pCache)
+	{
+		pData = pCache->Acquire(resourceDir, fileName, loadFlags);
+		return;
+	}
+
+	pData = tf_placement_new<ClipData>(tf_calloc(1, sizeof(ClipData)));
+	if (!pData->Load(resourceDir, fileName, loadFlags))
+	{
+		pData->Destroy();
+		pData->~ClipData();
+		tf_free(pData);
+		pData = NULL;
+	}
 }
 
 void Clip::Destroy()
 {
-	mAnimation.Deallocate();
+	if (!pData)
+		return;
+
+	if (pCache)
+	{
+		pCache->Release(pData);
+	}
+	else
+	{
+		pData->Destroy();
+		pData->~ClipData();
+		tf_free(pData);
+	}
+
+	pData = NULL;
+	pCache = NULL;
 }
 
 bool Clip::Sample(ozz::animation::SamplingCache* cacheInput, ozz::Range<SoaTransform>& localTransOutput, float timeRatio)
 {
+	if (!pData)
+		return false;
+
 	// Setup sampling job.
 	ozz::animation::SamplingJob samplingJob;
-	samplingJob.animation = &mAnimation;
 	samplingJob.cache = cacheInput;
-	samplingJob.ratio = timeRatio;
 	samplingJob.output = localTransOutput;
 
-	// Samples animation.
-	if (!samplingJob.Run())
+	if (!pData->mNumSegments)
+	{
+		samplingJob.animation = &pData->mAnimation;
+		samplingJob.ratio = timeRatio;
+
+		// Samples animation.
+		return samplingJob.Run();
+	}
+
+	// Find the segment covering the time and the ratio inside of it
+	const float    time = clamp(timeRatio, 0.f, 1.f) * pData->mDuration;
+	const uint32_t segment = min((uint32_t)(time / pData->mSegmentDuration), pData->mNumSegments - 1);
+	const float    segmentStart = segment * pData->mSegmentDuration;
+	const float    segmentLength = segment == pData->mNumSegments - 1 ? pData->mDuration - segmentStart : pData->mSegmentDuration;
+
+	samplingJob.animation = pData->AcquireSegment(segment);
+	if (!samplingJob.animation)
 		return false;
 
-	return true;
+	// Every segment is its own animation so the sampling cache resets itself when playback crosses into the next one
+	samplingJob.ratio = segmentLength > 0.f ? clamp((time - segmentStart) / segmentLength, 0.f, 1.f) : 0.f;
+	const bool result = samplingJob.Run();
+
+	pData->ReleaseSegment(segment);
+
+	return result;
 }
 
-bool Clip::LoadClip(const ResourceDirectory resourceDir, const char* fileName)
+bool ClipData::Load(const ResourceDirectory resourceDir, const char* fileName, uint32_t loadFlags)
 {
 	FileStream file = {};
 	if (!fsOpenStreamFromPath(resourceDir, fileName, FM_READ_BINARY, &file))
 	{
-		LOGF(eERROR, "Cannot open skeleton file");
+		LOGF(eERROR, "Cannot open clip file %s", fileName);
 		return false;
 	}
 
 	ssize_t size = fsGetStreamFileSize(&file);
-	void* data = tf_malloc(size);
-	fsReadFromStream(&file, data, (size_t)size);
-	fsCloseStream(&file);
+	if (size <= 0)
+	{
+		LOGF(eERROR, "Clip file %s is empty", fileName);
+		fsCloseStream(&file);
+		return false;
+	}
 
 	// Archive is doing a lot of freads from disk which is slow on some platforms and also generally not good
-	// So we just read the entire file once into a mem stream so the freads from IArchive are actually
+	// So we just read the entire file once (or map it) so the freads from IArchive are actually
 	// only reading from system memory instead of disk or network
-	FileStream memStream = {};
-	fsOpenStreamFromMemory(data, size, FM_READ, true, &memStream);
+	mFileSize = (size_t)size;
+	mMapped = (loadFlags & CLIP_LOAD_FLAG_MEMORY_MAP) && fsMapStream(&file, &pFileData);
+	if (!mMapped)
+	{
+		pFileData = tf_malloc(mFileSize);
+		fsReadFromStream(&file, pFileData, mFileSize);
+	}
+	fsCloseStream(&file);
+
+	SegmentedClipHeader header = {};
+	if (mFileSize >= sizeof(header))
+		memcpy(&header, pFileData, sizeof(header));
+
+	if (header.mMagic != SEGMENTED_CLIP_MAGIC)
+	{
+		// Plain animation, decode it and drop the serialized data
+		FileStream memStream = {};
+		fsOpenStreamFromMemory(pFileData, mFileSize, FM_READ, false, &memStream);
+
+		ozz::io::IArchive archive(&memStream);
+		const bool        valid = archive.TestTag<ozz::animation::Animation>();
+		if (valid)
+			archive >> mAnimation;
+		fsCloseStream(&memStream);
 
-	ozz::io::IArchive archive(&memStream);
-	if (!archive.TestTag<ozz::animation::Animation>())
+		if (mMapped)
+			fsUnmapStream(pFileData, mFileSize);
+		else
+			tf_free(pFileData);
+		pFileData = NULL;
+
+		if (!valid)
+		{
+			LOGF(eERROR, "Archive doesn't contain the expected object type.");
+			return false;
+		}
+
+		mDuration = mAnimation.duration();
+		return true;
+	}
+
+	// Segmented clip, the serialized data stays resident and segments are decoded when sampled
+	const size_t offsetsEnd = sizeof(header) + (header.mNumSegments + 1) * sizeof(uint32_t);
+	if (header.mVersion != SEGMENTED_CLIP_VERSION || header.mNumSegments == 0 || header.mSegmentDuration <= 0.f ||
+		offsetsEnd > mFileSize)
+	{
+		LOGF(eERROR, "Segmented clip %s has an invalid header", fileName);
+		return false;
+	}
+
+	pSegmentOffsets = (const uint32_t*)((const uint8_t*)pFileData + sizeof(header));
+	if (pSegmentOffsets[header.mNumSegments] > mFileSize)
 	{
-		LOGF(eERROR, "Archive doesn't contain the expected object type.");
+		LOGF(eERROR, "Segmented clip %s is truncated", fileName);
+		pSegmentOffsets = NULL;
 		return false;
 	}
 
-	archive >> mAnimation;
+	mNumSegments = header.mNumSegments;
+	mDuration = header.mDuration;
+	mSegmentDuration = header.mSegmentDuration;
 
-	fsCloseStream(&memStream);
+	pSegments = (ozz::animation::Animation*)tf_calloc(mNumSegments, sizeof(ozz::animation::Animation));
+	for (uint32_t i = 0; i < mNumSegments; i++)
+		tf_placement_new<ozz::animation::Animation>(&pSegments[i]);
+	pSegmentPins = (uint32_t*)tf_calloc(mNumSegments, sizeof(uint32_t));
+	pSegmentLastUse = (uint64_t*)tf_calloc(mNumSegments, sizeof(uint64_t));
+
+	mSegmentMutex.Init();
 
 	return true;
 }
+
+void ClipData::Destroy()
+{
+	mAnimation.Deallocate();
+
+	if (pSegments)
+	{
+		for (uint32_t i = 0; i < mNumSegments; i++)
+		{
+			ASSERT(pSegmentPins[i] == 0);
+			pSegments[i].Deallocate();
+			pSegments[i].~Animation();
+		}
+
+		tf_free(pSegments);
+		tf_free(pSegmentPins);
+		tf_free(pSegmentLastUse);
+		mSegmentMutex.Destroy();
+	}
+
+	if (mMapped)
+		fsUnmapStream(pFileData, mFileSize);
+	else
+		tf_free(pFileData);
+
+	pSegments = NULL;
+	pSegmentOffsets = NULL;
+	pSegmentPins = NULL;
+	pSegmentLastUse = NULL;
+	pFileData = NULL;
+	mNumSegments = 0;
+	mNumResidentSegments = 0;
+}
+
+ozz::animation::Animation* ClipData::AcquireSegment(uint32_t index)
+{
+	ASSERT(index < mNumSegments);
+
+	MutexLock lock(mSegmentMutex);
+
+	ozz::animation::Animation* pSegment = &pSegments[index];
+
+	// A last use of zero marks segments that are not decoded
+	if (pSegmentLastUse[index] == 0)
+	{
+		// Make room by dropping the least recently used segment nobody is sampling.
+		// If all of them are in use the budget is exceeded until they are released
+		if (mNumResidentSegments >= MAX_RESIDENT_CLIP_SEGMENTS)
+		{
+			uint32_t evict = UINT32_MAX;
+			for (uint32_t i = 0; i < mNumSegments; i++)
+			{
+				if (pSegmentLastUse[i] != 0 && pSegmentPins[i] == 0 &&
+					(evict == UINT32_MAX || pSegmentLastUse[i] < pSegmentLastUse[evict]))
+					evict = i;
+			}
+
+			if (evict != UINT32_MAX)
+			{
+				pSegments[evict].Deallocate();
+				pSegmentLastUse[evict] = 0;
+				mNumResidentSegments--;
+			}
+		}
+
+		// Decode the segment from the serialized data
+		const uint32_t begin = pSegmentOffsets[index];
+		const uint32_t end = pSegmentOffsets[index + 1];
+
+		FileStream memStream = {};
+		fsOpenStreamFromMemory((const uint8_t*)pFileData + begin, end - begin, FM_READ, false, &memStream);
+
+		ozz::io::IArchive archive(&memStream);
+		const bool        valid = archive.TestTag<ozz::animation::Animation>();
+		if (valid)
+			archive >> *pSegment;
+		fsCloseStream(&memStream);
+
+		if (!valid || pSegment->num_tracks() == 0)
+		{
+			LOGF(eERROR, "Failed to decode clip segment %u", index);
+			return NULL;
+		}
+
+		mNumResidentSegments++;
+	}
+
+	pSegmentLastUse[index] = ++mUseCounter;
+	pSegmentPins[index]++;
+	return pSegment;
+}
+
+void ClipData::ReleaseSegment(uint32_t index)
+{
+	MutexLock lock(mSegmentMutex);
+
+	ASSERT(pSegmentPins[index] > 0);
+	pSegmentPins[index]--;
+}
@@ -26,6 +26,7 @@
 
 #include "../../Common_3/OS/Math/MathTypes.h"
 #include "../../Common_3/OS/Interfaces/IFileSystem.h"
+#include "../../Common_3/OS/Interfaces/IThread.h"
 
 #include "../../Common_3/ThirdParty/OpenSource/ozz-animation/include/ozz/animation/runtime/animation.h"
 #include "../../Common_3/ThirdParty/OpenSource/ozz-animation/include/ozz/animation/runtime/sampling_job.h"
@@ -34,6 +35,59 @@
 
 #include "Rig.h"
 
+class ClipCache;
+
+// Number of segments of a streamed clip kept decoded before the least recently used one is dropped.
+// Enough for the segment being played, the next one and one more user at a different time
+const uint32_t MAX_RESIDENT_CLIP_SEGMENTS = 3;
+
+// Options for loading a clip
+enum ClipLoadFlags
+{
+	CLIP_LOAD_FLAG_NONE = 0,
+	// Map the file instead of reading it into a heap buffer. Streamed clips keep the mapping
+	// while they are loaded and decode their segments straight from it
+	CLIP_LOAD_FLAG_MEMORY_MAP = 0x1,
+};
+
+// Runtime data loaded from a clip file.
+// Immutable once loaded, apart from which segments of a streamed clip are resident, so it can be
+// shared by all the clips loaded from the same file (see ClipCache)
+struct ClipData
+{
+	// Load the clip, either a plain ozz animation or a segmented clip (see ClipFormat.h)
+	bool Load(const ResourceDirectory resourceDir, const char* fileName, uint32_t loadFlags);
+
+	// Must be called to clean up if Load was called
+	void Destroy();
+
+	// Returns the decoded segment at index, decoding it first if needed. The segment stays resident until ReleaseSegment
+	ozz::animation::Animation* AcquireSegment(uint32_t index);
+	void                       ReleaseSegment(uint32_t index);
+
+	// Runtime animation, unused by streamed clips
+	ozz::animation::Animation mAnimation;
+
+	// Length of the clip in seconds
+	float mDuration = 0.f;
+
+	// Streamed clips only. Segment i covers [i * mSegmentDuration, (i + 1) * mSegmentDuration)
+	ozz::animation::Animation* pSegments = NULL;
+	const uint32_t*            pSegmentOffsets = NULL;
+	uint32_t*                  pSegmentPins = NULL;
+	uint64_t*                  pSegmentLastUse = NULL;
+	uint32_t                   mNumSegments = 0;
+	uint32_t                   mNumResidentSegments = 0;
+	float                      mSegmentDuration = 0.f;
+	uint64_t                   mUseCounter = 0;
+	theforge::Mutex            mSegmentMutex;
+
+	// Serialized file, kept while segments are streamed from it
+	void*  pFileData = NULL;
+	size_t mFileSize = 0;
+	bool   mMapped = false;
+};
+
 //Responsible for loading and storing a clip. Only need one per clip file
 //all rigs can sample the same clip object
 class Clip
@@ -42,6 +96,11 @@ class Clip
 	// Set up a clip associated with a rig and read from an ozz animation file path
 	void Initialize(const ResourceDirectory resourceDir, const char* fileName, Rig* rig);
 
+	// Same as above with load options. When pCache is set the loaded data is shared with every clip
+	// initialized from the same file through that cache
+	void Initialize(
+		const ResourceDirectory resourceDir, const char* fileName, Rig* rig, ClipCache* pCache, uint32_t loadFlags = CLIP_LOAD_FLAG_NONE);
+
 	// Must be called to clean up if the clip was initialized
 	void Destroy();
 
@@ -49,12 +108,13 @@ class Clip
 	bool Sample(ozz::animation::SamplingCache* cacheInput, ozz::Range<SoaTransform>& localTransOutput, float timeRatio);
 
 	// Get the length of the clip
-	inline float GetDuration() { return mAnimation.duration(); };
+	inline float GetDuration() { return pData ? pData->mDuration : 0.f; };
 
-	private:
-	// Load a clip from an ozz animation file
-	bool LoadClip(const ResourceDirectory resourceDir, const char* fileName);
+	// Returns true if the clip is streamed in segments instead of being fully resident
+	inline bool IsStreamed() { return pData && pData->mNumSegments > 0; };
 
-	// Runtime animation.
-	ozz::animation::Animation mAnimation;
+	private:
+	// Loaded data, owned by pCache when set
+	ClipData*  pData = NULL;
+	ClipCache* pCache = NULL;
 };
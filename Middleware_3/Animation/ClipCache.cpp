@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include "ClipCache.h"
+
+using namespace theforge;
+
+void ClipCache::Initialize()
+{
+	mMutex.Init();
+}
+
+void ClipCache::Destroy()
+{
+	ASSERT(mEntries.empty() && "All clips must be destroyed before the clip cache");
+
+	for (eastl::unordered_map<ClipData*, Entry>::iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+	{
+		it->first->Destroy();
+		it->first->~ClipData();
+		tf_free(it->first);
+	}
+	mEntries.clear();
+	mFiles.clear();
+
+	mMutex.Destroy();
+}
+
+ClipData* ClipCache::Acquire(const ResourceDirectory resourceDir, const char* fileName, uint32_t loadFlags)
+{
+	eastl::string key;
+	key.sprintf("%d/%s", (int)resourceDir, fileName);
+
+	MutexLock lock(mMutex);
+
+	eastl::unordered_map<eastl::string, ClipData*>::iterator it = mFiles.find(key);
+	if (it != mFiles.end())
+	{
+		mEntries[it->second].mRefCount++;
+		return it->second;
+	}
+
+	// Loading under the lock keeps two clips from loading the same file at once
+	ClipData* pData = tf_placement_new<ClipData>(tf_calloc(1, sizeof(ClipData)));
+	if (!pData->Load(resourceDir, fileName, loadFlags))
+	{
+		pData->Destroy();
+		pData->~ClipData();
+		tf_free(pData);
+		return NULL;
+	}
+
+	Entry entry = { key, 1 };
+	mEntries.insert(eastl::make_pair(pData, entry));
+	mFiles.insert(eastl::make_pair(key, pData));
+
+	return pData;
+}
+
+void ClipCache::Release(ClipData* pData)
+{
+	MutexLock lock(mMutex);
+
+	eastl::unordered_map<ClipData*, Entry>::iterator it = mEntries.find(pData);
+	if (it == mEntries.end())
+	{
+		ASSERT(false && "Clip data was not loaded through this cache");
+		return;
+	}
+
+	if (--it->second.mRefCount == 0)
+	{
+		mFiles.erase(it->second.mKey);
+		mEntries.erase(it);
+
+		pData->Destroy();
+		pData->~ClipData();
+		tf_free(pData);
+	}
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include "../../Common_3/OS/Interfaces/IFileSystem.h"
+#include "../../Common_3/OS/Interfaces/IThread.h"
+#include "../../Common_3/ThirdParty/OpenSource/EASTL/unordered_map.h"
+#include "../../Common_3/ThirdParty/OpenSource/EASTL/string.h"
+
+#include "Clip.h"
+
+// Shares the data of clip files between all the Clips that load them.
+// Two characters playing the same file then reference one immutable animation instead of each owning a copy.
+// Thread safe, entries are reference counted and freed when the last clip using them is destroyed
+class ClipCache
+{
+	public:
+	// Must be called before clips are loaded through the cache
+	void Initialize();
+
+	// Frees the cache. All clips loaded through it must have been destroyed
+	void Destroy();
+
+	// Returns the data of fileName, loading it on first use. Returns NULL if the file could not be loaded.
+	// The load flags of the first request are used for the file
+	ClipData* Acquire(const ResourceDirectory resourceDir, const char* fileName, uint32_t loadFlags);
+
+	// Releases data returned by Acquire
+	void Release(ClipData* pData);
+
+	// Gets the number of distinct files currently loaded
+	inline uint32_t GetNumLoadedClips() { return (uint32_t)mEntries.size(); };
+
+	private:
+	struct Entry
+	{
+		eastl::string mKey;
+		uint32_t      mRefCount;
+	};
+
+	// Loaded files, keyed by resource directory and file name
+	eastl::unordered_map<eastl::string, ClipData*> mFiles;
+	// Reference count and file key of each loaded data so Release does not have to search mFiles
+	eastl::unordered_map<ClipData*, Entry> mEntries;
+
+	theforge::Mutex mMutex;
+};
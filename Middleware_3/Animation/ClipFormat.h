@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// Layout of segmented clip files, written by the AssetPipeline for long clips so they can be streamed.
+//
+// SegmentedClipHeader
+// uint32_t offsets[mNumSegments + 1]    Byte offset of each segment from the start of the file, the last one is the file size
+// Segments                             Each one a complete ozz archive of an ozz::animation::Animation covering
+//                                      mSegmentDuration seconds (the last one covers the remainder)
+//
+// Plain ozz animation files start with the ozz archive tag instead of the magic so both are told apart on load.
+
+const uint32_t SEGMENTED_CLIP_MAGIC = 0x53504C43;    // "CLPS"
+const uint32_t SEGMENTED_CLIP_VERSION = 1;
+
+struct SegmentedClipHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mNumSegments;
+	float    mDuration;
+	float    mSegmentDuration;
+};
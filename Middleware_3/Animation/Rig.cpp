@@ -43,6 +43,14 @@ void Rig::Initialize(const ResourceDirectory resourceDir, const char* fileName)
 		}
 	}
 
+	// Cache parent indices so posing does not walk the skeleton's joint properties
+	mParentIndices = eastl::vector<int>(mNumSoaJoints * 4, (int)mRootIndex);
+	for (unsigned int i = 0; i < mNumJoints; i++)
+	{
+		const int parent = mSkeleton.joint_properties()[i].parent;
+		mParentIndices[i] = parent == ozz::animation::Skeleton::kNoParentIndex ? (int)i : parent;
+	}
+
 	mJointWorldMats = eastl::vector<Matrix4>(mNumJoints, Matrix4::identity());
 	mBoneWorldMats = eastl::vector<Matrix4>(mNumJoints, Matrix4::identity());
 	mJointScales = eastl::vector<Vector3>(mNumJoints, Vector3(1.0f, 1.0f, 1.0f));
@@ -62,6 +70,7 @@ void Rig::Destroy()
 	mJointWorldMats.set_capacity(0);
 	mBoneWorldMats.set_capacity(0);
 	mJointScales.set_capacity(0);
+	mParentIndices.set_capacity(0);
 }
 
 void Rig::Pose(const Matrix4& rootTransform)
@@ -76,60 +85,124 @@ void Rig::Pose(const Matrix4& rootTransform)
 	// based on the distance between each joint
 	if (mUpdateBones)
 	{
-		// Traverses through the skeleton's joint hierarchy, placing bones between
-		// joints and altering the size of joints and bones to reflect distances
-		// between joints
+		// Places bones between each joint and its parent and sizes joints and bones to reflect
+		// the distances between joints. Works on 4 joints at a time, one per SIMD lane.
+		// Results of the root lane (which is its own parent) and of lanes past the last joint are discarded
+		const Vector4 bigLen = Vector4(FLT_MAX);
+		const Vector4 threshold = Vector4(0.01f);
+		const Vector4 half = Vector4(0.5f);
 
-		// Store smallest bone lenth to be reused for root joint scale
-		float minBoneLen = 0.f;
-		bool  minBoneLenSet = false;
+		// Store smallest bone length to be reused for root joint scale
+		Vector4 minBoneLen = bigLen;
 
-		// For each joint
-		for (unsigned int childIndex = 0; childIndex < mNumJoints; childIndex++)
+		for (unsigned int base = 0; base < mNumJoints; base += 4)
 		{
-			// Do not make a bone if it is the root
-			// Handle the root joint specially after the loop
-			if (childIndex == mRootIndex)
+			// Gather the parent and child columns of 4 joints and transpose them to SoA
+			Vector4 parentY[4], parentZ[4], parentPos[4], childPos[4];
+			for (unsigned int lane = 0; lane < 4; lane++)
 			{
-				mBoneWorldMats[childIndex] = mat4::scale(vec3(0.0f, 0.0f, 0.0f));
-				continue;
+				const unsigned int childIndex = min(base + lane, mNumJoints - 1);
+				const Matrix4&     parentMat = mJointModelMats[mParentIndices[base + lane]];
+
+				parentY[lane] = parentMat.getCol1();
+				parentZ[lane] = parentMat.getCol2();
+				parentPos[lane] = parentMat.getCol3();
+				childPos[lane] = mJointModelMats[childIndex].getCol3();
 			}
 
-			// Get the index of the parent of childIndex
-			const int parentIndex = mSkeleton.joint_properties()[childIndex].parent;
+			Vector4 soa[4];
+			transpose4x4(parentY, soa);
+			const SoaFloat3 parentYSoa = { soa[0], soa[1], soa[2] };
+			transpose4x4(parentZ, soa);
+			const SoaFloat3 parentZSoa = { soa[0], soa[1], soa[2] };
+			transpose4x4(parentPos, soa);
+			const SoaFloat3 parentPosSoa = { soa[0], soa[1], soa[2] };
+			transpose4x4(childPos, soa);
+			const SoaFloat3 childPosSoa = { soa[0], soa[1], soa[2] };
 
-			// Selects joint matrices.
-			const mat4 parentMat = mJointModelMats[parentIndex];
-			const mat4 childMat = mJointModelMats[childIndex];
+			const SoaFloat3 boneDir = childPosSoa - parentPosSoa;
+			const Vector4   boneLen = Length(boneDir);
 
-			vec3  boneDir = childMat.getCol3().getXYZ() - parentMat.getCol3().getXYZ();
-			float boneLen = length(boneDir);
+			// Use the parent and child matricies to create a bone matrix which will place it between
+			// the two joints using Gram Schmidt. Pick the binormal per lane based on how aligned
+			// the parent's z axis is with the bone
+			const Vector4Int useZ = cmpLt(absPerElem(Dot(parentZSoa, boneDir)), threshold);
+			const Vector4Int useY = Not(useZ);
+			const SoaFloat3  binormal = { orPerElem(andPerElem(parentZSoa.x, useZ), andPerElem(parentYSoa.x, useY)),
+										  orPerElem(andPerElem(parentZSoa.y, useZ), andPerElem(parentYSoa.y, useY)),
+										  orPerElem(andPerElem(parentZSoa.z, useZ), andPerElem(parentYSoa.z, useY)) };
 
-			// Save smallest boneLen for the root joints scale size
-			if ((!minBoneLenSet) || (boneLen < minBoneLen))
+			const SoaFloat3 col1 = Normalize(CrossProduct(binormal, boneDir)) * boneLen;
+			const SoaFloat3 col2 = Normalize(CrossProduct(boneDir, col1)) * boneLen;
+
+			// Back to AoS
+			Vector4 col0Aos[4], col1Aos[4], col2Aos[4], scaleAos[4];
+			const Vector4 zero = Vector4(0.0f);
+			const Vector4 dirIn[4] = { boneDir.x, boneDir.y, boneDir.z, zero };
+			const Vector4 col1In[4] = { col1.x, col1.y, col1.z, zero };
+			const Vector4 col2In[4] = { col2.x, col2.y, col2.z, zero };
+			const Vector4 halfLen = mulPerElem(boneLen, half);
+			const Vector4 scaleIn[4] = { halfLen, halfLen, halfLen, zero };
+			transpose4x4(dirIn, col0Aos);
+			transpose4x4(col1In, col1Aos);
+			transpose4x4(col2In, col2Aos);
+			transpose4x4(scaleIn, scaleAos);
+
+			const unsigned int laneCount = min(4U, mNumJoints - base);
+			for (unsigned int lane = 0; lane < laneCount; lane++)
 			{
-				minBoneLen = boneLen;
+				const unsigned int childIndex = base + lane;
+
+				// Do not make a bone if it is the root
+				// Handle the root joint specially after the loop
+				if (childIndex == mRootIndex)
+				{
+					mBoneWorldMats[childIndex] = mat4::scale(vec3(0.0f, 0.0f, 0.0f));
+					continue;
+				}
+
+				const Vector4 col3 = vec4(parentPos[lane].getXYZ(), 1.0f);
+				mBoneWorldMats[childIndex] = rootTransform * mat4(col0Aos[lane], col1Aos[lane], col2Aos[lane], col3);
+
+				// Sets the scale of the joint equivilant to the boneLen between it and its parent joint
+				// Separete from world so outside objects can use a joint's world mat w/o its scale
+				mJointScales[childIndex] = scaleAos[lane].getXYZ();
 			}
 
-			// Use the parent and child world matricies to create a bone world
-			// matrix which will place it between the two joints
-			// Using Gramm Schmidt process'
-			float dotProd = dot(parentMat.getCol2().getXYZ(), boneDir);
-			vec3  binormal = abs(dotProd) < 0.01f ? parentMat.getCol2().getXYZ() : parentMat.getCol1().getXYZ();
-
-			vec4 col0 = vec4(boneDir, 0.0f);
-			vec4 col1 = vec4(boneLen * normalize(cross(binormal, boneDir)), 0.0f);
-			vec4 col2 = vec4(boneLen * normalize(cross(boneDir, col1.getXYZ())), 0.0f);
-			vec4 col3 = vec4(parentMat.getCol3().getXYZ(), 1.0f);
-			mBoneWorldMats[childIndex] = rootTransform * mat4(col0, col1, col2, col3);
-
-			// Sets the scale of the joint equivilant to the boneLen between it and its parent joint
-			// Separete from world so outside objects can use a joint's world mat w/o its scale
-			mJointScales[childIndex] = vec3(boneLen / 2.0f);
+			// Padding lanes and the root have zero length, exclude them from the minimum
+			Vector4Int validLanes = cmpLt(Vector4((float)base, (float)base + 1.0f, (float)base + 2.0f, (float)base + 3.0f), Vector4((float)mNumJoints));
+			if (base <= mRootIndex && mRootIndex < base + 4)
+				validLanes = And(validLanes, Not(cmpEq(Vector4((float)base, (float)base + 1.0f, (float)base + 2.0f, (float)base + 3.0f), Vector4((float)mRootIndex))));
+			minBoneLen = minPerElem(minBoneLen, orPerElem(andPerElem(boneLen, validLanes), andPerElem(bigLen, Not(validLanes))));
 		}
 
 		// Set the root joints scale based on the saved min value
-		mJointScales[mRootIndex] = vec3(minBoneLen / 2.0f);
+		float minLen = min(min((float)minBoneLen.getX(), (float)minBoneLen.getY()), min((float)minBoneLen.getZ(), (float)minBoneLen.getW()));
+		if (minLen == FLT_MAX)
+			minLen = 0.0f;
+		mJointScales[mRootIndex] = vec3(minLen / 2.0f);
+	}
+}
+
+void Rig::WriteSkinningMatrices(const Matrix4* pInverseBindPoses, const uint32_t* pJointRemaps, uint32_t jointCount, Matrix4* pOutput)
+{
+	ASSERT(pInverseBindPoses);
+	ASSERT(pOutput);
+
+	// Compute in registers and store each matrix once so write combined memory is only written to
+	if (pJointRemaps)
+	{
+		for (uint32_t i = 0; i < jointCount; ++i)
+		{
+			ASSERT(pJointRemaps[i] < mNumJoints);
+			pOutput[i] = mJointWorldMats[pJointRemaps[i]] * pInverseBindPoses[i];
+		}
+	}
+	else
+	{
+		ASSERT(jointCount <= mNumJoints);
+		for (uint32_t i = 0; i < jointCount; ++i)
+			pOutput[i] = mJointWorldMats[i] * pInverseBindPoses[i];
 	}
 }
 
@@ -53,8 +53,15 @@ class Rig
 	void Destroy();
 
 	// Updates the skeleton's joint and bone world matricies based on mJointModelMats
+	// Bones are generated 4 joints at a time using SoA math
 	void Pose(const Matrix4& rootTransform);
 
+	// Writes jointCount skinning matrices (joint world matrix * inverse bind pose) to pOutput.
+	// Joint i of the skin uses rig joint pJointRemaps[i], or joint i if pJointRemaps is NULL.
+	// pOutput is written sequentially and never read so it can point directly into a mapped GPU buffer.
+	// Uses the world matrices computed by the last call to Pose
+	void WriteSkinningMatrices(const Matrix4* pInverseBindPoses, const uint32_t* pJointRemaps, uint32_t jointCount, Matrix4* pOutput);
+
 	// Set the color of the joints
 	inline void SetJointColor(const Vector4& color) { mJointColor = color; };
 
@@ -158,6 +165,11 @@ class Rig
 	// Location of the root joint
 	unsigned int mRootIndex;
 
+	// Parent index of each joint, the root joint references itself.
+	// Padded to a multiple of 4 so Pose can read whole SoA groups.
+	// ozz stores joints depth first so parents always come before their children
+	eastl::vector<int> mParentIndices;
+
 	// Color of the joints
 	Vector4 mJointColor = vec4(.9f, .9f, .9f, 1.f);    // white
 
@@ -35,10 +35,6 @@ void SkeletonBatcher::Initialize(const SkeletonRenderDesc& skeletonRenderDesc)
 	mJointVertexStride = skeletonRenderDesc.mJointVertexStride;
 	mBoneVertexStride = skeletonRenderDesc.mBoneVertexStride;
 
-	// 2 because updates buffer twice per instanced draw call: one for joints and one for bones
-	DescriptorSetDesc setDesc = { mRootSignature, DESCRIPTOR_UPDATE_FREQ_PER_DRAW, MAX_BATCHES * 2 * ImageCount };
-	addDescriptorSet(mRenderer, &setDesc, &pDescriptorSet);
-
 	// Determine if we will ever expect to use this renderer to draw bones
 	mDrawBones = skeletonRenderDesc.mDrawBones;
 	if (mDrawBones)
@@ -47,6 +43,41 @@ void SkeletonBatcher::Initialize(const SkeletonRenderDesc& skeletonRenderDesc)
 		mNumBonePoints = skeletonRenderDesc.mNumBonePoints;
 	}
 
+	mUseInstanceBuffer = skeletonRenderDesc.mUseInstanceBuffer;
+	if (mUseInstanceBuffer)
+	{
+		mCreationFlag = skeletonRenderDesc.mCreationFlag;
+
+		// One set for the joints and one for the bones of each frame index
+		DescriptorSetDesc instanceSetDesc = { mRootSignature, DESCRIPTOR_UPDATE_FREQ_PER_DRAW, 2 * ImageCount };
+		addDescriptorSet(mRenderer, &instanceSetDesc, &pDescriptorSet);
+
+		BufferLoadDesc sharedDesc = {};
+		sharedDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		sharedDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
+		sharedDesc.mDesc.mSize = sizeof(UniformSkeletonSharedBlock);
+		sharedDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | mCreationFlag;
+
+		for (uint32_t i = 0; i < ImageCount; ++i)
+		{
+			for (uint32_t j = 0; j < 2; ++j)
+			{
+				sharedDesc.ppBuffer = &pSharedUniformBuffers[i][j];
+				addResource(&sharedDesc, NULL);
+			}
+
+			// Also binds the shared uniforms of this frame index
+			if (skeletonRenderDesc.mMaxInstances)
+				ResizeInstanceBuffer(i, skeletonRenderDesc.mMaxInstances);
+		}
+
+		return;
+	}
+
+	// 2 because updates buffer twice per instanced draw call: one for joints and one for bones
+	DescriptorSetDesc setDesc = { mRootSignature, DESCRIPTOR_UPDATE_FREQ_PER_DRAW, MAX_BATCHES * 2 * ImageCount };
+	addDescriptorSet(mRenderer, &setDesc, &pDescriptorSet);
+
 	// Initialize all the buffer that will be used for each batch per each frame index
 	BufferLoadDesc ubDesc = {};
 	ubDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_UNIFORM_BUFFER;
@@ -83,6 +114,23 @@ void SkeletonBatcher::Initialize(const SkeletonRenderDesc& skeletonRenderDesc)
 void SkeletonBatcher::Destroy()
 {
 	removeDescriptorSet(mRenderer, pDescriptorSet);
+
+	if (mUseInstanceBuffer)
+	{
+		for (uint32_t i = 0; i < ImageCount; ++i)
+		{
+			if (pInstanceBuffers[i])
+				removeResource(pInstanceBuffers[i]);
+			pInstanceBuffers[i] = NULL;
+			mInstanceCapacities[i] = 0;
+			removeResource(pSharedUniformBuffers[i][0]);
+			removeResource(pSharedUniformBuffers[i][1]);
+		}
+
+		mRigs.set_capacity(0);
+		return;
+	}
+
 	for (uint32_t i = 0; i < ImageCount; ++i)
 	{
 		for (uint32_t j = 0; j < MAX_BATCHES; ++j)
@@ -100,6 +148,14 @@ void SkeletonBatcher::Destroy()
 
 void SkeletonBatcher::SetSharedUniforms(const Matrix4& projViewMat, const Vector3& lightPos, const Vector3& lightColor)
 {
+	if (mUseInstanceBuffer)
+	{
+		mSharedUniformData.mProjectView = projViewMat;
+		mSharedUniformData.mLightPosition = Vector4(lightPos);
+		mSharedUniformData.mLightColor = Vector4(lightColor);
+		return;
+	}
+
 	mUniformDataJoints.mProjectView = projViewMat;
 	mUniformDataJoints.mLightPosition = Vector4(lightPos);
 	mUniformDataJoints.mLightColor = Vector4(lightColor);
@@ -114,6 +170,12 @@ void SkeletonBatcher::SetSharedUniforms(const Matrix4& projViewMat, const Vector
 
 void SkeletonBatcher::SetPerInstanceUniforms(const uint32_t& frameIndex, int numRigs)
 {
+	if (mUseInstanceBuffer)
+	{
+		SetInstanceBufferData(frameIndex, numRigs);
+		return;
+	}
+
 	// Will keep track of the current batch we are setting the uniforms for
 	// and will indicate how many catches to draw when draw is called for this frame index
 	mBatchCounts[frameIndex] = 0;
@@ -195,6 +257,106 @@ void SkeletonBatcher::SetPerInstanceUniforms(const uint32_t& frameIndex, int num
 	}
 }
 
+void SkeletonBatcher::SetInstanceBufferData(const uint32_t& frameIndex, int numRigs)
+{
+	// If the numRigs parameter was not initialized, used the data from all the rigs
+	if (numRigs == -1)
+	{
+		numRigs = mNumRigs;
+	}
+
+	uint32_t jointCount = 0;
+	for (int rigIndex = 0; rigIndex < numRigs; rigIndex++)
+		jointCount += mRigs[rigIndex]->GetNumJoints();
+
+	// Grow instead of dropping rigs. The GPU is done with this frame index, so its buffer can be replaced right away
+	const uint32_t capacity = mInstanceCapacities[frameIndex];
+	if (jointCount > capacity || !pInstanceBuffers[frameIndex])
+		ResizeInstanceBuffer(frameIndex, max(jointCount, capacity * 2));
+
+	// The joints are followed by the bones
+	const uint32_t jointsOffset = 0;
+	const uint32_t bonesOffset = mInstanceCapacities[frameIndex];
+
+	BufferUpdateDesc instanceUpdate = { pInstanceBuffers[frameIndex] };
+	instanceUpdate.mSize = (uint64_t)2 * bonesOffset * sizeof(SkeletonInstanceData);
+	beginUpdateResource(&instanceUpdate);
+
+	SkeletonInstanceData* pJoints = (SkeletonInstanceData*)instanceUpdate.pMappedData;
+	SkeletonInstanceData* pBones = pJoints + bonesOffset;
+
+	// Matrices are written straight to the mapped memory, no staging copy
+	uint32_t instanceCount = 0;
+	for (int rigIndex = 0; rigIndex < numRigs; rigIndex++)
+	{
+		Rig*         rig = mRigs[rigIndex];
+		unsigned int numJoints = rig->GetNumJoints();
+
+		const vec4 jointColor = rig->GetJointColor();
+		const vec4 boneColor = rig->GetBoneColor();
+
+		for (unsigned int jointIndex = 0; jointIndex < numJoints; jointIndex++, instanceCount++)
+		{
+			if (mDrawBones)
+			{
+				pBones[instanceCount].mToWorldMat = rig->GetBoneWorldMat(jointIndex);
+				pBones[instanceCount].mColor = boneColor;
+
+				// scale the joints by their determined chlid bone length
+				pJoints[instanceCount].mToWorldMat = rig->GetJointWorldMatNoScale(jointIndex) * mat4::scale(rig->GetJointScale(jointIndex));
+			}
+			else
+			{
+				pJoints[instanceCount].mToWorldMat = rig->GetJointWorldMatNoScale(jointIndex);
+			}
+			pJoints[instanceCount].mColor = jointColor;
+		}
+	}
+
+	endUpdateResource(&instanceUpdate, NULL);
+
+	mInstanceCounts[frameIndex] = instanceCount;
+
+	// Shared uniforms with the offset of each draw
+	for (uint32_t i = 0; i < (mDrawBones ? 2U : 1U); ++i)
+	{
+		mSharedUniformData.mInstanceOffset = i == 0 ? jointsOffset : bonesOffset;
+
+		BufferUpdateDesc sharedUpdate = { pSharedUniformBuffers[frameIndex][i] };
+		beginUpdateResource(&sharedUpdate);
+		memcpy(sharedUpdate.pMappedData, &mSharedUniformData, sizeof(mSharedUniformData));
+		endUpdateResource(&sharedUpdate, NULL);
+	}
+}
+
+void SkeletonBatcher::ResizeInstanceBuffer(const uint32_t& frameIndex, uint32_t capacity)
+{
+	if (pInstanceBuffers[frameIndex])
+		removeResource(pInstanceBuffers[frameIndex]);
+
+	BufferLoadDesc instanceDesc = {};
+	instanceDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_BUFFER;
+	instanceDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
+	instanceDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | mCreationFlag;
+	instanceDesc.mDesc.mStructStride = sizeof(SkeletonInstanceData);
+	instanceDesc.mDesc.mElementCount = (uint64_t)2 * max(capacity, 1U);
+	instanceDesc.mDesc.mSize = instanceDesc.mDesc.mStructStride * instanceDesc.mDesc.mElementCount;
+	instanceDesc.mDesc.pName = "Skeleton Instance Buffer";
+	instanceDesc.ppBuffer = &pInstanceBuffers[frameIndex];
+	addResource(&instanceDesc, NULL);
+	mInstanceCapacities[frameIndex] = max(capacity, 1U);
+
+	DescriptorData instanceParams[2] = {};
+	instanceParams[0].pName = "uniformBlock";
+	instanceParams[1].pName = "instanceBuffer";
+	instanceParams[1].ppBuffers = &pInstanceBuffers[frameIndex];
+	for (uint32_t j = 0; j < 2; ++j)
+	{
+		instanceParams[0].ppBuffers = &pSharedUniformBuffers[frameIndex][j];
+		updateDescriptorSet(mRenderer, frameIndex * 2 + j, pDescriptorSet, 2, instanceParams);
+	}
+}
+
 void SkeletonBatcher::AddRig(Rig* rig)
 {
 	// Adds the rig so its data can be used and increments the rig count
@@ -204,6 +366,12 @@ void SkeletonBatcher::AddRig(Rig* rig)
 
 void SkeletonBatcher::Draw(Cmd* cmd, const uint32_t& frameIndex)
 {
+	if (mUseInstanceBuffer)
+	{
+		DrawInstanceBuffer(cmd, frameIndex);
+		return;
+	}
+
 	// Get the number of batches to draw for this frameindex
 	unsigned int numBatches = mBatchCounts[frameIndex];
 
@@ -255,4 +423,29 @@ void SkeletonBatcher::Draw(Cmd* cmd, const uint32_t& frameIndex)
 		}
 		cmdEndDebugMarker(cmd);
 	}
-}
\ No newline at end of file
+}
+void SkeletonBatcher::DrawInstanceBuffer(Cmd* cmd, const uint32_t& frameIndex)
+{
+	const uint32_t instanceCount = mInstanceCounts[frameIndex];
+	if (instanceCount == 0)
+		return;
+
+	cmdBindPipeline(cmd, mSkeletonPipeline);
+
+	// Joints
+	cmdBeginDebugMarker(cmd, 1, 0, 1, "Draw Skeletons Joints");
+	cmdBindVertexBuffer(cmd, 1, &mJointVertexBuffer, &mJointVertexStride, NULL);
+	cmdBindDescriptorSet(cmd, frameIndex * 2 + 0, pDescriptorSet);
+	cmdDrawInstanced(cmd, mNumJointPoints / 6, 0, instanceCount, 0);
+	cmdEndDebugMarker(cmd);
+
+	// Bones
+	if (mDrawBones)
+	{
+		cmdBeginDebugMarker(cmd, 1, 0, 1, "Draw Skeletons Bones");
+		cmdBindVertexBuffer(cmd, 1, &mBoneVertexBuffer, &mBoneVertexStride, NULL);
+		cmdBindDescriptorSet(cmd, frameIndex * 2 + 1, pDescriptorSet);
+		cmdDrawInstanced(cmd, mNumBonePoints / 6, 0, instanceCount, 0);
+		cmdEndDebugMarker(cmd);
+	}
+}
@@ -48,6 +48,27 @@ struct UniformSkeletonBlock
 	mat4 mToWorldMat[MAX_INSTANCES];
 };
 
+// Uniform data shared by all instances when drawing from the instance buffer
+struct UniformSkeletonSharedBlock
+{
+	mat4 mProjectView;
+
+	// Point Light Information
+	vec4 mLightPosition;
+	vec4 mLightColor;
+
+	// Index of the first instance of the draw in the instance buffer
+	uint32_t mInstanceOffset;
+	uint32_t mPadding[3];
+};
+
+// Per instance data stored in the instance buffer. Must match with shader
+struct SkeletonInstanceData
+{
+	mat4 mToWorldMat;
+	vec4 mColor;
+};
+
 // Description needed to handle buffer updates and draw calls
 struct SkeletonRenderDesc
 {
@@ -62,6 +83,12 @@ struct SkeletonRenderDesc
 	uint32_t            mNumBonePoints;
 	BufferCreationFlags mCreationFlag;
 	bool                mDrawBones;
+	// Write all instances to one structured buffer and draw them with a single instanced call
+	// instead of batches of MAX_INSTANCES. The shader must read "instanceBuffer" (see SkeletonInstanceData)
+	bool                mUseInstanceBuffer = false;
+	// Number of joints the instance buffer of each frame starts with when mUseInstanceBuffer is set.
+	// The buffer grows when more are drawn, 0 sizes it for the rigs drawn in the first frame
+	uint32_t            mMaxInstances = 0;
 };
 
 // Allows for efficiently instance rendering all joints and bones of all skeletons in the scene
@@ -85,12 +112,19 @@ class SkeletonBatcher
 	void SetSharedUniforms(const Matrix4& projViewMat, const Vector3& lightPos, const Vector3& lightColor);
 
 	// Update all the instanced uniform data for each batch of joints and bones
+	// With mUseInstanceBuffer set this may replace the instance buffer of frameIndex, so the GPU must be done with that frame
 	void SetPerInstanceUniforms(const uint32_t& frameIndex, int numRigs = -1);
 
 	// Instance draw all the skeletons
 	void Draw(Cmd* cmd, const uint32_t& frameIndex);
 
 	private:
+	// SetPerInstanceUniforms and Draw when mUseInstanceBuffer is set
+	void SetInstanceBufferData(const uint32_t& frameIndex, int numRigs);
+	void DrawInstanceBuffer(Cmd* cmd, const uint32_t& frameIndex);
+	// Replaces the instance buffer of frameIndex with one holding `capacity` joints and as many bones
+	void ResizeInstanceBuffer(const uint32_t& frameIndex, uint32_t capacity);
+
 	// List of Rigs whose skeletons need to be rendered
 	eastl::vector<Rig*> mRigs;
 	uint32_t            mNumRigs = 0;
@@ -127,4 +161,17 @@ class SkeletonBatcher
 	// Determines if this renderer will need to draw bones between each joint
 	// Set in initialize
 	bool mDrawBones;
+
+	// Instance buffer mode. Each frame index has its own buffer holding the joints followed by the bones
+	bool                mUseInstanceBuffer = false;
+	BufferCreationFlags mCreationFlag;
+	Buffer*             pInstanceBuffers[ImageCount] = {};
+	uint32_t            mInstanceCapacities[ImageCount] = {};
+
+	// Shared uniforms for the joints [0] and bones [1] draw of each frame index
+	Buffer*                    pSharedUniformBuffers[ImageCount][2] = {};
+	UniformSkeletonSharedBlock mSharedUniformData;
+
+	// Number of joints written for each frame index
+	uint32_t mInstanceCounts[ImageCount] = {};
 };
@@ -117,12 +117,9 @@ static int msghandler(lua_State* L)
 
 const char* luaReaderFunction(lua_State *L, void *ud, size_t *sz)
 {
-	FileStream* pHandle = (FileStream*)ud;
-	const size_t size = 1024;
-	static char buffer[size];
-	//*sz = read_file((void*)buffer, size, pHandle);
-	*sz = fsReadFromStream(pHandle, buffer, size);
-	return buffer;
+	// Hands the reader's buffer to lua directly, it stays valid until the next call
+	FileStreamReader* pReader = (FileStreamReader*)ud;
+	return (const char*)fsReaderNextBlock(pReader, sz);
 }
 
 int RunScriptFile(const char* scriptFile, lua_State* L)
@@ -137,7 +134,15 @@ int RunScriptFile(const char* scriptFile, lua_State* L)
         return false;
     }
     
-	int loadfile_error = lua_load(L, reader, &fh, NULL, NULL);
+	FileStreamReader fileReader = {};
+	if (!fsInitStreamReader(&fh, 0, NULL, &fileReader))
+	{
+		fsCloseStream(&fh);
+		return false;
+	}
+
+	int loadfile_error = lua_load(L, reader, &fileReader, NULL, NULL);
+	fsExitStreamReader(&fileReader);
     fsCloseStream(&fh);
 	if (loadfile_error != 0)
 	{
@@ -196,7 +201,15 @@ bool LuaManagerImpl::SetUpdatableScript(const char* scriptFile, const char* upda
         return false;
     }
     
-	int loadfile_error = lua_load(m_UpdatableScriptLuaState, reader, &fHandle, NULL, NULL);
+	FileStreamReader fileReader = {};
+	if (!fsInitStreamReader(&fHandle, 0, NULL, &fileReader))
+	{
+		fsCloseStream(&fHandle);
+		return false;
+	}
+
+	int loadfile_error = lua_load(m_UpdatableScriptLuaState, reader, &fileReader, NULL, NULL);
+	fsExitStreamReader(&fileReader);
     fsCloseStream(&fHandle);
     
 	if (loadfile_error != 0)
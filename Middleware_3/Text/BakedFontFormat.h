@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// Layout of baked font files, written by the AssetPipeline (ProcessFonts) and loaded with Fontstash::defineBakedFont.
+//
+// BakedFontHeader
+// BakedGlyph   glyphs[mGlyphCount]      Sorted by codepoint
+// BakedKerning kerning[mKerningCount]   Sorted by (mFirst, mSecond), only pairs with a non zero adjustment
+// uint8_t      atlas[mAtlasWidth * mAtlasHeight]
+//                                       Signed distance field, 128 on the glyph outline and mSdfPadding pixels of
+//                                       distance to either side mapped to the rest of the [0, 255] range
+//
+// All metrics are in pixels at mBakeSize and scale linearly with the size text is drawn at.
+
+const uint32_t BAKED_FONT_MAGIC = 0x42544E46;    // "FNTB"
+const uint32_t BAKED_FONT_VERSION = 1;
+
+// Extension of baked font files
+#define BAKED_FONT_EXTENSION "sdfont"
+
+struct BakedFontHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mAtlasWidth;
+	uint32_t mAtlasHeight;
+	uint32_t mGlyphCount;
+	uint32_t mKerningCount;
+	float    mBakeSize;
+	float    mSdfPadding;
+	float    mAscender;     // Above the baseline, positive
+	float    mDescender;    // Below the baseline, negative
+	float    mLineGap;
+};
+
+struct BakedGlyph
+{
+	uint32_t mCodepoint;
+	// Rectangle of the glyph in the atlas, including the distance field padding
+	uint16_t mX0;
+	uint16_t mY0;
+	uint16_t mX1;
+	uint16_t mY1;
+	// Offset of the rectangle from the pen position on the baseline
+	float    mXOffset;
+	float    mYOffset;
+	float    mXAdvance;
+};
+
+struct BakedKerning
+{
+	uint32_t mFirst;
+	uint32_t mSecond;
+	float    mAdvance;
+};
@@ -26,9 +26,13 @@
 #include "Shaders/Compiled/fontstash2D.vert.h"
 #include "Shaders/Compiled/fontstash3D.vert.h"
 #include "Shaders/Compiled/fontstash.frag.h"
+#include "Shaders/Compiled/fontstashBatched.vert.h"
+#include "Shaders/Compiled/fontstashBatched.frag.h"
+#include "Shaders/Compiled/fontstashSDF.frag.h"
 #endif
 
 #include "Fontstash.h"
+#include "BakedFontFormat.h"
 
 // include Fontstash (should be after MemoryTracking so that it also detects memory free/remove in fontstash)
 #define FONTSTASH_IMPLEMENTATION
@@ -36,6 +40,7 @@
 
 #include "../../Common_3/ThirdParty/OpenSource/EASTL/vector.h"
 #include "../../Common_3/ThirdParty/OpenSource/EASTL/string.h"
+#include "../../Common_3/ThirdParty/OpenSource/EASTL/algorithm.h"
 
 #include "../../Common_3/OS/Interfaces/ILog.h"
 #include "../../Common_3/OS/Interfaces/IFileSystem.h"
@@ -48,24 +53,78 @@
 
 #include "../../Common_3/OS/Interfaces/IMemory.h"
 
+// Vertex recorded in batched mode. The position is already transformed to clip space
+struct TextVertex
+{
+	float4   mPosition;
+	float2   mTexCoord;
+	uint32_t mColor;
+};
+
+// Number of glyph atlas textures. New glyphs are uploaded into an atlas the GPU is not reading
+// while drawing continues with the current one, which is replaced once the upload completed
+#define FONTSTASH_ATLAS_VERSION_COUNT 3
+// Frames an atlas has to stay unused before it can be overwritten
+#define FONTSTASH_MAX_FRAMES_IN_FLIGHT 3
+
+struct AtlasVersion
+{
+	Texture*  pTexture;
+	// Upload into this atlas, only meaningful while it is the pending atlas
+	SyncToken mUploadToken;
+	// Value of the frame counter the last time this atlas was drawn with
+	uint64_t  mLastUseFrame;
+	// Region (x0, y0, x1, y1) changed in the CPU atlas since the last upload into this texture
+	int       mDirtyRect[4];
+	// False until the texture received its first full upload
+	bool      mValid;
+};
+
+// Batches of recorded text, in the order they are drawn by flush
+enum TextBatch
+{
+	TEXT_BATCH_WORLD = 0,
+	TEXT_BATCH_SCREEN,
+	TEXT_BATCH_COUNT
+};
+
+// Set in the IDs returned by defineBakedFont, the other bits index mBakedFonts
+#define FONTSTASH_BAKED_FONT_FLAG 0x40000000
+
+// Font baked offline into a distance field atlas, see BakedFontFormat.h
+struct BakedFont
+{
+	// File contents, the pointers below point into it
+	uint8_t*               pData;
+	const BakedFontHeader* pHeader;
+	const BakedGlyph*      pGlyphs;
+	const BakedKerning*    pKerning;
+
+	Texture*       pTexture;
+	DescriptorSet* pDescriptorSet;
+
+	// Text recorded since the last flush when batching
+	eastl::vector<TextVertex> mBatchVertices[TEXT_BATCH_COUNT];
+};
+
 class _Impl_FontStash
 {
 public:
 	_Impl_FontStash()
 	{
-		pCurrentTexture = {};
 		mWidth = 0;
 		mHeight = 0;
 		pContext = NULL;
 
 		mText3D = false;
+		mBatching = false;
 	}
 
 	bool init(Renderer* renderer, int width_, int height_, uint32_t ringSizeBytes)
 	{
 		pRenderer = renderer;
 
-		// create image
+		// create atlas textures
 		TextureDesc desc = {};
 		desc.mArraySize = 1;
 		desc.mDepth = 1;
@@ -77,10 +136,21 @@ public:
 		desc.mStartState = RESOURCE_STATE_COMMON;
 		desc.mWidth = width_;
 		desc.pName = "Fontstash Texture";
-		TextureLoadDesc loadDesc = {};
-		loadDesc.ppTexture = &pCurrentTexture;
-		loadDesc.pDesc = &desc;
-		addResource(&loadDesc, NULL);
+		for (uint32_t i = 0; i < FONTSTASH_ATLAS_VERSION_COUNT; ++i)
+		{
+			TextureLoadDesc loadDesc = {};
+			loadDesc.ppTexture = &mAtlas[i].pTexture;
+			loadDesc.pDesc = &desc;
+			addResource(&loadDesc, NULL);
+
+			mAtlas[i].mLastUseFrame = 0;
+			mAtlas[i].mValid = false;
+			resetDirtyRect(i);
+		}
+		mCurrentAtlas = 0;
+		mPendingAtlas = UINT32_MAX;
+		mFrame = FONTSTASH_MAX_FRAMES_IN_FLIGHT;
+		mFrameCounted = false;
 
 		// create FONS context
 		FONSparams params;
@@ -120,6 +190,17 @@ public:
 		binaryShaderDesc.mVert.pByteCode = (char*)gShaderFontstash3DVert;
 		binaryShaderDesc.mVert.pEntryPoint = "main";
 		addShaderBinary(pRenderer, &binaryShaderDesc, &pShaders[1]);
+		binaryShaderDesc.mVert.mByteCodeSize = sizeof(gShaderFontstashBatchedVert);
+		binaryShaderDesc.mVert.pByteCode = (char*)gShaderFontstashBatchedVert;
+		binaryShaderDesc.mVert.pEntryPoint = "main";
+		binaryShaderDesc.mFrag.mByteCodeSize = sizeof(gShaderFontstashBatchedFrag);
+		binaryShaderDesc.mFrag.pByteCode = (char*)gShaderFontstashBatchedFrag;
+		binaryShaderDesc.mFrag.pEntryPoint = "main";
+		addShaderBinary(pRenderer, &binaryShaderDesc, &pShaders[2]);
+		binaryShaderDesc.mFrag.mByteCodeSize = sizeof(gShaderFontstashSDFFrag);
+		binaryShaderDesc.mFrag.pByteCode = (char*)gShaderFontstashSDFFrag;
+		binaryShaderDesc.mFrag.pEntryPoint = "main";
+		addShaderBinary(pRenderer, &binaryShaderDesc, &pShaders[3]);
 #else
 		ShaderLoadDesc text2DShaderDesc = {};
 		text2DShaderDesc.mStages[0] = { "fontstash2D.vert", NULL, 0, NULL };
@@ -127,31 +208,45 @@ public:
 		ShaderLoadDesc text3DShaderDesc = {};
 		text3DShaderDesc.mStages[0] = { "fontstash3D.vert", NULL, 0, NULL };
 		text3DShaderDesc.mStages[1] = { "fontstash.frag", NULL, 0, NULL };
+		ShaderLoadDesc textBatchedShaderDesc = {};
+		textBatchedShaderDesc.mStages[0] = { "fontstashBatched.vert", NULL, 0, NULL };
+		textBatchedShaderDesc.mStages[1] = { "fontstashBatched.frag", NULL, 0, NULL };
+		ShaderLoadDesc textSdfShaderDesc = {};
+		textSdfShaderDesc.mStages[0] = { "fontstashBatched.vert", NULL, 0, NULL };
+		textSdfShaderDesc.mStages[1] = { "fontstashSDF.frag", NULL, 0, NULL };
 
 		addShader(pRenderer, &text2DShaderDesc, &pShaders[0]);
 		addShader(pRenderer, &text3DShaderDesc, &pShaders[1]);
+		addShader(pRenderer, &textBatchedShaderDesc, &pShaders[2]);
+		addShader(pRenderer, &textSdfShaderDesc, &pShaders[3]);
 #endif
 
-		RootSignatureDesc textureRootDesc = { pShaders, 2 };
+		RootSignatureDesc textureRootDesc = { pShaders, 4 };
 		const char* pStaticSamplers[] = { "uSampler0" };
 		textureRootDesc.mStaticSamplerCount = 1;
 		textureRootDesc.ppStaticSamplerNames = pStaticSamplers;
 		textureRootDesc.ppStaticSamplers = &pDefaultSampler;
 		addRootSignature(pRenderer, &textureRootDesc, &pRootSignature);
+		mRootConstantIndex = getDescriptorIndexFromName(pRootSignature, "uRootConstants");
+		mUniformBlockIndex = getDescriptorIndexFromName(pRootSignature, "uniformBlock_rootcbv");
 
 		addUniformGPURingBuffer(pRenderer, 65536, &pUniformRingBuffer, true);
 
+		// One set per pipeline for each atlas, see getDescriptorSetIndex
 		uint64_t size = sizeof(mat4);
-		DescriptorSetDesc setDesc = { pRootSignature, DESCRIPTOR_UPDATE_FREQ_NONE, 2 };
+		DescriptorSetDesc setDesc = { pRootSignature, DESCRIPTOR_UPDATE_FREQ_NONE, 2 * FONTSTASH_ATLAS_VERSION_COUNT };
 		addDescriptorSet(pRenderer, &setDesc, &pDescriptorSets);
-		DescriptorData setParams[2] = {};
-		setParams[0].pName = "uniformBlock_rootcbv";
-		setParams[0].ppBuffers = &pUniformRingBuffer->pBuffer;
-		setParams[0].pSizes = &size;
-		setParams[1].pName = "uTex0";
-		setParams[1].ppTextures = &pCurrentTexture;
-		updateDescriptorSet(pRenderer, 0, pDescriptorSets, 2, setParams);
-		updateDescriptorSet(pRenderer, 1, pDescriptorSets, 2, setParams);
+		for (uint32_t i = 0; i < FONTSTASH_ATLAS_VERSION_COUNT; ++i)
+		{
+			DescriptorData setParams[2] = {};
+			setParams[0].pName = "uniformBlock_rootcbv";
+			setParams[0].ppBuffers = &pUniformRingBuffer->pBuffer;
+			setParams[0].pSizes = &size;
+			setParams[1].pName = "uTex0";
+			setParams[1].ppTextures = &mAtlas[i].pTexture;
+			updateDescriptorSet(pRenderer, getDescriptorSetIndex(i, 0), pDescriptorSets, 2, setParams);
+			updateDescriptorSet(pRenderer, getDescriptorSetIndex(i, 1), pDescriptorSets, 2, setParams);
+		}
 
 		BufferDesc vbDesc = {};
 		vbDesc.mDescriptors = DESCRIPTOR_TYPE_VERTEX_BUFFER;
@@ -170,16 +265,28 @@ public:
 		// unload fontstash context
 		fonsDeleteInternal(pContext);
 
-		removeResource(pCurrentTexture);
+		// An upload may still be in flight
+		if (mPendingAtlas != UINT32_MAX)
+			waitForToken(&mAtlas[mPendingAtlas].mUploadToken);
+
+		for (uint32_t i = 0; i < FONTSTASH_ATLAS_VERSION_COUNT; ++i)
+			removeResource(mAtlas[i].pTexture);
 
 		// unload font buffers
 		for (unsigned int i = 0; i < (uint32_t)mFontBuffers.size(); i++)
 			tf_free(mFontBuffers[i]);
 
+		for (uint32_t i = 0; i < (uint32_t)mBakedFonts.size(); ++i)
+		{
+			removeDescriptorSet(pRenderer, mBakedFonts[i].pDescriptorSet);
+			removeResource(mBakedFonts[i].pTexture);
+			tf_free(mBakedFonts[i].pData);
+		}
+
 		removeDescriptorSet(pRenderer, pDescriptorSets);
 		removeRootSignature(pRenderer, pRootSignature);
 
-		for (uint32_t i = 0; i < 2; ++i)
+		for (uint32_t i = 0; i < 4; ++i)
 		{
 			removeShader(pRenderer, pShaders[i]);
 		}
@@ -251,6 +358,47 @@ public:
 			addPipeline(pRenderer, &pipelineDesc, &pPipelines[i]);
 		}
 
+		// Batched pipelines, same states but with pre-transformed positions and per vertex color
+		VertexLayout batchedVertexLayout = {};
+		batchedVertexLayout.mAttribCount = 3;
+		batchedVertexLayout.mAttribs[0].mSemantic = SEMANTIC_POSITION;
+		batchedVertexLayout.mAttribs[0].mFormat = TinyImageFormat_R32G32B32A32_SFLOAT;
+		batchedVertexLayout.mAttribs[0].mBinding = 0;
+		batchedVertexLayout.mAttribs[0].mLocation = 0;
+		batchedVertexLayout.mAttribs[0].mOffset = offsetof(TextVertex, mPosition);
+
+		batchedVertexLayout.mAttribs[1].mSemantic = SEMANTIC_TEXCOORD0;
+		batchedVertexLayout.mAttribs[1].mFormat = TinyImageFormat_R32G32_SFLOAT;
+		batchedVertexLayout.mAttribs[1].mBinding = 0;
+		batchedVertexLayout.mAttribs[1].mLocation = 1;
+		batchedVertexLayout.mAttribs[1].mOffset = offsetof(TextVertex, mTexCoord);
+
+		batchedVertexLayout.mAttribs[2].mSemantic = SEMANTIC_COLOR;
+		batchedVertexLayout.mAttribs[2].mFormat = TinyImageFormat_R8G8B8A8_UNORM;
+		batchedVertexLayout.mAttribs[2].mBinding = 0;
+		batchedVertexLayout.mAttribs[2].mLocation = 2;
+		batchedVertexLayout.mAttribs[2].mOffset = offsetof(TextVertex, mColor);
+
+		pipelineDesc.mGraphicsDesc.pVertexLayout = &batchedVertexLayout;
+		pipelineDesc.mGraphicsDesc.pShaderProgram = pShaders[2];
+		for (uint32_t i = 0; i < TEXT_BATCH_COUNT; ++i)
+		{
+			// World space text is tested against the depth buffer, screen space text is not
+			const uint32_t stateIndex = (i == TEXT_BATCH_WORLD) ? 1 : 0;
+			if (stateIndex >= count)
+				continue;
+
+			pipelineDesc.mGraphicsDesc.mDepthStencilFormat = (stateIndex > 0) ? pRts[1]->mFormat : TinyImageFormat_UNDEFINED;
+			pipelineDesc.mGraphicsDesc.pDepthState = &depthStateDesc[stateIndex];
+			pipelineDesc.mGraphicsDesc.pRasterizerState = &rasterizerStateDesc[stateIndex];
+			addPipeline(pRenderer, &pipelineDesc, &pBatchPipelines[i]);
+
+			// Baked fonts share the batched vertex format
+			pipelineDesc.mGraphicsDesc.pShaderProgram = pShaders[3];
+			addPipeline(pRenderer, &pipelineDesc, &pSdfPipelines[i]);
+			pipelineDesc.mGraphicsDesc.pShaderProgram = pShaders[2];
+		}
+
 		mScaleBias = { 2.0f / (float)pRts[0]->mWidth, -2.0f / (float)pRts[0]->mHeight };
 
 		return true;
@@ -265,6 +413,401 @@ public:
 
 			pPipelines[i] = {};
 		}
+
+		for (uint32_t i = 0; i < TEXT_BATCH_COUNT; ++i)
+		{
+			if (pBatchPipelines[i])
+				removePipeline(pRenderer, pBatchPipelines[i]);
+			if (pSdfPipelines[i])
+				removePipeline(pRenderer, pSdfPipelines[i]);
+
+			pBatchPipelines[i] = {};
+			pSdfPipelines[i] = {};
+		}
+	}
+
+	static uint32_t getDescriptorSetIndex(uint32_t atlas, uint32_t pipelineIndex) { return atlas * 2 + pipelineIndex; }
+
+	void resetDirtyRect(uint32_t atlas)
+	{
+		int* rect = mAtlas[atlas].mDirtyRect;
+		rect[0] = INT_MAX;
+		rect[1] = INT_MAX;
+		rect[2] = 0;
+		rect[3] = 0;
+	}
+
+	bool isDirty(uint32_t atlas) const { return mAtlas[atlas].mDirtyRect[0] < mAtlas[atlas].mDirtyRect[2]; }
+
+	// Copies the dirty region of the CPU atlas to the texture. The texture is written asynchronously on the copy queue
+	void uploadAtlas(uint32_t atlas)
+	{
+		AtlasVersion& version = mAtlas[atlas];
+
+		// The first upload initializes the whole texture, later ones only the region that changed since
+		int rect[4] = { 0, 0, (int)mWidth, (int)mHeight };
+		if (version.mValid)
+			memcpy(rect, version.mDirtyRect, sizeof(rect));
+
+		TextureUpdateDesc updateDesc = {};
+		updateDesc.pTexture = version.pTexture;
+		if (version.mValid)
+		{
+			updateDesc.mRegionX = (uint32_t)rect[0];
+			updateDesc.mRegionY = (uint32_t)rect[1];
+			updateDesc.mRegionWidth = (uint32_t)(rect[2] - rect[0]);
+			updateDesc.mRegionHeight = (uint32_t)(rect[3] - rect[1]);
+		}
+		beginUpdateResource(&updateDesc);
+		const uint8_t* pSrc = pPixels + rect[1] * mWidth + rect[0];
+		for (uint32_t r = 0; r < updateDesc.mRowCount; ++r)
+		{
+			memcpy(updateDesc.pMappedData + r * updateDesc.mDstRowStride,
+				pSrc + r * mWidth, updateDesc.mSrcRowStride);
+		}
+		version.mUploadToken = 0;
+		endUpdateResource(&updateDesc, &version.mUploadToken);
+
+		version.mValid = true;
+		resetDirtyRect(atlas);
+	}
+
+	// Returns the atlas to draw with and starts uploading new glyphs into another one.
+	// Drawing never waits on the graphics queue: new glyphs show up once their upload completed
+	uint32_t acquireAtlas(Cmd* pCmd)
+	{
+		if (mPendingAtlas != UINT32_MAX && isTokenCompleted(&mAtlas[mPendingAtlas].mUploadToken))
+		{
+			mCurrentAtlas = mPendingAtlas;
+			mPendingAtlas = UINT32_MAX;
+		}
+
+		if (mPendingAtlas == UINT32_MAX && (isDirty(mCurrentAtlas) || !mAtlas[mCurrentAtlas].mValid) && pPixels)
+		{
+			uint32_t target = UINT32_MAX;
+			for (uint32_t i = 0; i < FONTSTASH_ATLAS_VERSION_COUNT; ++i)
+			{
+				if (i != mCurrentAtlas && mAtlas[i].mLastUseFrame + FONTSTASH_MAX_FRAMES_IN_FLIGHT <= mFrame)
+				{
+					target = i;
+					break;
+				}
+			}
+
+			if (!mAtlas[mCurrentAtlas].mValid)
+			{
+				// Nothing was drawn yet so there is no previous atlas to keep drawing with
+				uploadAtlas(mCurrentAtlas);
+				waitForToken(&mAtlas[mCurrentAtlas].mUploadToken);
+			}
+			else if (target != UINT32_MAX)
+			{
+				uploadAtlas(target);
+				mPendingAtlas = target;
+			}
+			else if (!mFrameCounted)
+			{
+				// flush() is never called so there is no way to tell when an atlas is no longer in use.
+				// Update the current atlas in place after the GPU is done with it
+				// #TODO: Investigate - Causes hang on low-mid end Android phones (tested on Samsung Galaxy A50s)
+#ifndef __ANDROID__
+				waitQueueIdle(pCmd->pQueue);
+#endif
+				uploadAtlas(mCurrentAtlas);
+				waitForToken(&mAtlas[mCurrentAtlas].mUploadToken);
+			}
+		}
+
+		mAtlas[mCurrentAtlas].mLastUseFrame = mFrame;
+		return mCurrentAtlas;
+	}
+
+	void flush(Cmd* pCmd)
+	{
+		// Per batch the atlas text is drawn first, then the text of every baked font
+		uint32_t atlasVertexCount = 0;
+		uint32_t vertexCount = 0;
+		for (uint32_t i = 0; i < TEXT_BATCH_COUNT; ++i)
+		{
+			atlasVertexCount += (uint32_t)mBatchVertices[i].size();
+			for (uint32_t f = 0; f < (uint32_t)mBakedFonts.size(); ++f)
+				vertexCount += (uint32_t)mBakedFonts[f].mBatchVertices[i].size();
+		}
+		vertexCount += atlasVertexCount;
+
+		if (!vertexCount)
+			return;
+
+		const uint32_t atlas = atlasVertexCount ? acquireAtlas(pCmd) : 0;
+
+		// One upload for every batch of the frame
+		GPURingBufferOffset buffer = getGPURingBufferOffset(pMeshRingBuffer, vertexCount * sizeof(TextVertex));
+		if (!buffer.pBuffer)
+		{
+			LOGF(eERROR, "Fontstash: %u batched text vertices do not fit in the ring buffer, increase ringSizeBytes", vertexCount);
+			for (uint32_t i = 0; i < TEXT_BATCH_COUNT; ++i)
+			{
+				mBatchVertices[i].clear();
+				for (uint32_t f = 0; f < (uint32_t)mBakedFonts.size(); ++f)
+					mBakedFonts[f].mBatchVertices[i].clear();
+			}
+			return;
+		}
+
+		BufferUpdateDesc update = { buffer.pBuffer, buffer.mOffset };
+		beginUpdateResource(&update);
+		TextVertex* pDst = (TextVertex*)update.pMappedData;
+		for (uint32_t i = 0; i < TEXT_BATCH_COUNT; ++i)
+		{
+			memcpy(pDst, mBatchVertices[i].data(), mBatchVertices[i].size() * sizeof(TextVertex));
+			pDst += mBatchVertices[i].size();
+			for (uint32_t f = 0; f < (uint32_t)mBakedFonts.size(); ++f)
+			{
+				const eastl::vector<TextVertex>& vertices = mBakedFonts[f].mBatchVertices[i];
+				memcpy(pDst, vertices.data(), vertices.size() * sizeof(TextVertex));
+				pDst += vertices.size();
+			}
+		}
+		endUpdateResource(&update, NULL);
+
+		uint32_t firstVertex = 0;
+		for (uint32_t i = 0; i < TEXT_BATCH_COUNT; ++i)
+		{
+			drawVertices(pCmd, pBatchPipelines[i], pDescriptorSets, getDescriptorSetIndex(atlas, 0), buffer, mBatchVertices[i], firstVertex);
+			for (uint32_t f = 0; f < (uint32_t)mBakedFonts.size(); ++f)
+				drawVertices(pCmd, pSdfPipelines[i], mBakedFonts[f].pDescriptorSet, 0, buffer, mBakedFonts[f].mBatchVertices[i], firstVertex);
+		}
+	}
+
+	// Draws vertices uploaded to buffer at firstVertex, advances firstVertex past them and clears them
+	void drawVertices(
+		Cmd* pCmd, Pipeline* pPipeline, DescriptorSet* pSet, uint32_t setIndex, GPURingBufferOffset& buffer,
+		eastl::vector<TextVertex>& vertices, uint32_t& firstVertex)
+	{
+		const uint32_t vertexCount = (uint32_t)vertices.size();
+		vertices.clear();
+		if (!vertexCount)
+			return;
+
+		const uint32_t first = firstVertex;
+		firstVertex += vertexCount;
+
+		if (!pPipeline)
+		{
+			LOGF(eWARNING, "Fontstash: world space text needs a depth target, call load with two render targets");
+			return;
+		}
+
+		const uint32_t stride = sizeof(TextVertex);
+		cmdBindPipeline(pCmd, pPipeline);
+		cmdBindDescriptorSet(pCmd, setIndex, pSet);
+		cmdBindVertexBuffer(pCmd, 1, &buffer.pBuffer, &stride, &buffer.mOffset);
+		cmdDraw(pCmd, vertexCount, first);
+	}
+
+	// Moves vertex positions from pixels to clip space. This is the math of the fontstash2D and fontstash3D vertex shaders
+	void toClipSpace(TextVertex* pVertices, uint32_t count, bool text3D)
+	{
+		const float2 scaleBias = mScaleBias;
+		if (text3D)
+		{
+			const mat4 mvp = mProjView * mWorldMat;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const float4 p = pVertices[i].mPosition;
+				pVertices[i].mPosition = v4ToF4(mvp * Vector4(-p.x * scaleBias.x, p.y * scaleBias.y, 1.0f, 1.0f));
+			}
+		}
+		else
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const float4 p = pVertices[i].mPosition;
+				pVertices[i].mPosition = float4(p.x * scaleBias.x - 1.0f, p.y * scaleBias.y + 1.0f, 0.0f, 1.0f);
+			}
+		}
+	}
+
+	bool addBakedFont(uint8_t* pData, size_t size, const char* pFontPath)
+	{
+		const BakedFontHeader* pHeader = (const BakedFontHeader*)pData;
+		if (size < sizeof(BakedFontHeader) || pHeader->mMagic != BAKED_FONT_MAGIC || pHeader->mVersion != BAKED_FONT_VERSION)
+		{
+			LOGF(eERROR, "Fontstash: %s is not a baked font of version %u", pFontPath, BAKED_FONT_VERSION);
+			return false;
+		}
+
+		const size_t atlasOffset =
+			sizeof(BakedFontHeader) + pHeader->mGlyphCount * sizeof(BakedGlyph) + pHeader->mKerningCount * sizeof(BakedKerning);
+		if (size < atlasOffset + (size_t)pHeader->mAtlasWidth * pHeader->mAtlasHeight)
+		{
+			LOGF(eERROR, "Fontstash: baked font %s is truncated", pFontPath);
+			return false;
+		}
+
+		BakedFont font = {};
+		font.pData = pData;
+		font.pHeader = pHeader;
+		font.pGlyphs = (const BakedGlyph*)(pHeader + 1);
+		font.pKerning = (const BakedKerning*)(font.pGlyphs + pHeader->mGlyphCount);
+
+		TextureDesc desc = {};
+		desc.mArraySize = 1;
+		desc.mDepth = 1;
+		desc.mDescriptors = DESCRIPTOR_TYPE_TEXTURE;
+		desc.mFormat = TinyImageFormat_R8_UNORM;
+		desc.mHeight = pHeader->mAtlasHeight;
+		desc.mMipLevels = 1;
+		desc.mSampleCount = SAMPLE_COUNT_1;
+		desc.mStartState = RESOURCE_STATE_COMMON;
+		desc.mWidth = pHeader->mAtlasWidth;
+		desc.pName = "Fontstash Baked Font Texture";
+		TextureLoadDesc loadDesc = {};
+		loadDesc.ppTexture = &font.pTexture;
+		loadDesc.pDesc = &desc;
+		addResource(&loadDesc, NULL);
+
+		// The atlas never changes so it is uploaded once
+		TextureUpdateDesc updateDesc = {};
+		updateDesc.pTexture = font.pTexture;
+		beginUpdateResource(&updateDesc);
+		const uint8_t* pSrc = pData + atlasOffset;
+		for (uint32_t r = 0; r < updateDesc.mRowCount; ++r)
+		{
+			memcpy(updateDesc.pMappedData + r * updateDesc.mDstRowStride,
+				pSrc + r * pHeader->mAtlasWidth, updateDesc.mSrcRowStride);
+		}
+		SyncToken token = {};
+		endUpdateResource(&updateDesc, &token);
+		waitForToken(&token);
+
+		uint64_t          bufferSize = sizeof(mat4);
+		DescriptorSetDesc setDesc = { pRootSignature, DESCRIPTOR_UPDATE_FREQ_NONE, 1 };
+		addDescriptorSet(pRenderer, &setDesc, &font.pDescriptorSet);
+		DescriptorData setParams[2] = {};
+		setParams[0].pName = "uniformBlock_rootcbv";
+		setParams[0].ppBuffers = &pUniformRingBuffer->pBuffer;
+		setParams[0].pSizes = &bufferSize;
+		setParams[1].pName = "uTex0";
+		setParams[1].ppTextures = &font.pTexture;
+		updateDescriptorSet(pRenderer, 0, font.pDescriptorSet, 2, setParams);
+
+		mBakedFonts.push_back(font);
+		return true;
+	}
+
+	static const BakedGlyph* findBakedGlyph(const BakedFont& font, uint32_t codepoint)
+	{
+		const BakedGlyph* pEnd = font.pGlyphs + font.pHeader->mGlyphCount;
+		const BakedGlyph* pGlyph = eastl::lower_bound(
+			font.pGlyphs, pEnd, codepoint, [](const BakedGlyph& glyph, uint32_t value) { return glyph.mCodepoint < value; });
+		return (pGlyph != pEnd && pGlyph->mCodepoint == codepoint) ? pGlyph : NULL;
+	}
+
+	static float findBakedKerning(const BakedFont& font, uint32_t first, uint32_t second)
+	{
+		const BakedKerning* pEnd = font.pKerning + font.pHeader->mKerningCount;
+		const BakedKerning  pair = { first, second, 0.0f };
+		const BakedKerning* pKerning = eastl::lower_bound(font.pKerning, pEnd, pair, [](const BakedKerning& a, const BakedKerning& b) {
+			return a.mFirst < b.mFirst || (a.mFirst == b.mFirst && a.mSecond < b.mSecond);
+		});
+		return (pKerning != pEnd && pKerning->mFirst == first && pKerning->mSecond == second) ? pKerning->mAdvance : 0.0f;
+	}
+
+	// Lays out message with a baked font, in pixels and aligned like the atlas text: left and top for screen text,
+	// centered on (x, y) for world text. Appends six vertices per visible glyph to pVertices and returns the advance
+	float layoutBakedText(
+		const BakedFont& font, const char* message, float x, float y, float size, float spacing, uint32_t color, bool centered,
+		eastl::vector<TextVertex>* pVertices, float* pBounds)
+	{
+		const BakedFontHeader& header = *font.pHeader;
+		const float            scale = size / header.mBakeSize;
+
+		float baseline = y + header.mAscender * scale;
+		if (centered)
+		{
+			baseline = y + (header.mAscender + header.mDescender) * 0.5f * scale;
+			x -= 0.5f * layoutBakedText(font, message, 0.0f, 0.0f, size, spacing, color, false, NULL, NULL);
+		}
+
+		const float invAtlasWidth = 1.0f / (float)header.mAtlasWidth;
+		const float invAtlasHeight = 1.0f / (float)header.mAtlasHeight;
+
+		float        penX = x;
+		unsigned int utf8State = FONS_UTF8_ACCEPT;
+		unsigned int codepoint = 0;
+		uint32_t     prevCodepoint = UINT32_MAX;
+		for (const char* str = message; *str; ++str)
+		{
+			if (fons__decutf8(&utf8State, &codepoint, *(const unsigned char*)str))
+				continue;
+
+			const BakedGlyph* pGlyph = findBakedGlyph(font, codepoint);
+			if (!pGlyph)
+				continue;
+
+			if (prevCodepoint != UINT32_MAX)
+				penX += findBakedKerning(font, prevCodepoint, codepoint) * scale;
+			prevCodepoint = codepoint;
+
+			if (pVertices && pGlyph->mX1 > pGlyph->mX0)
+			{
+				const float x0 = penX + pGlyph->mXOffset * scale;
+				const float y0 = baseline + pGlyph->mYOffset * scale;
+				const float x1 = x0 + (pGlyph->mX1 - pGlyph->mX0) * scale;
+				const float y1 = y0 + (pGlyph->mY1 - pGlyph->mY0) * scale;
+				const float s0 = pGlyph->mX0 * invAtlasWidth;
+				const float t0 = pGlyph->mY0 * invAtlasHeight;
+				const float s1 = pGlyph->mX1 * invAtlasWidth;
+				const float t1 = pGlyph->mY1 * invAtlasHeight;
+
+				// Same winding as fonsDrawText
+				const TextVertex quad[6] = {
+					{ float4(x0, y0, 0.0f, 1.0f), float2(s0, t0), color }, { float4(x1, y1, 0.0f, 1.0f), float2(s1, t1), color },
+					{ float4(x1, y0, 0.0f, 1.0f), float2(s1, t0), color }, { float4(x0, y0, 0.0f, 1.0f), float2(s0, t0), color },
+					{ float4(x0, y1, 0.0f, 1.0f), float2(s0, t1), color }, { float4(x1, y1, 0.0f, 1.0f), float2(s1, t1), color },
+				};
+				pVertices->insert(pVertices->end(), quad, quad + 6);
+			}
+
+			penX += pGlyph->mXAdvance * scale + spacing;
+		}
+
+		if (pBounds)
+		{
+			pBounds[0] = x;
+			pBounds[1] = baseline - header.mAscender * scale;
+			pBounds[2] = penX;
+			pBounds[3] = baseline - header.mDescender * scale;
+		}
+
+		return penX - x;
+	}
+
+	void drawBakedText(Cmd* pCmd, uint32_t fontIndex, const char* message, float x, float y, float size, float spacing, uint32_t color)
+	{
+		if (fontIndex >= (uint32_t)mBakedFonts.size())
+			return;
+
+		BakedFont&                 font = mBakedFonts[fontIndex];
+		const uint32_t             batch = mText3D ? TEXT_BATCH_WORLD : TEXT_BATCH_SCREEN;
+		eastl::vector<TextVertex>& vertices = mBatching ? font.mBatchVertices[batch] : mBakedVertices;
+
+		const size_t first = vertices.size();
+		layoutBakedText(font, message, x, y, size, spacing, color, mText3D, &vertices, NULL);
+		toClipSpace(vertices.data() + first, (uint32_t)(vertices.size() - first), mText3D);
+
+		if (mBatching || vertices.empty())
+			return;
+
+		GPURingBufferOffset buffer = getGPURingBufferOffset(pMeshRingBuffer, (uint32_t)(vertices.size() * sizeof(TextVertex)));
+		BufferUpdateDesc    update = { buffer.pBuffer, buffer.mOffset };
+		beginUpdateResource(&update);
+		memcpy(update.pMappedData, vertices.data(), vertices.size() * sizeof(TextVertex));
+		endUpdateResource(&update, NULL);
+
+		uint32_t firstVertex = 0;
+		drawVertices(pCmd, pSdfPipelines[batch], font.pDescriptorSet, 0, buffer, vertices, firstVertex);
 	}
 
 	static int  fonsImplementationGenerateTexture(void* userPtr, int width, int height);
@@ -276,8 +819,14 @@ public:
 	FONScontext* pContext;
 
 	const uint8_t* pPixels;
-	Texture*       pCurrentTexture;
-	bool           mUpdateTexture;
+
+	// Glyph atlas textures, see acquireAtlas
+	AtlasVersion mAtlas[FONTSTASH_ATLAS_VERSION_COUNT];
+	uint32_t     mCurrentAtlas;
+	uint32_t     mPendingAtlas;
+	// Frames counted by flush(). Atlases are only recycled once frames are counted
+	uint64_t     mFrame;
+	bool         mFrameCounted;
 
 	uint32_t mWidth;
 	uint32_t mHeight;
@@ -291,10 +840,15 @@ public:
 	mat4 mWorldMat;
 	Cmd* pCmd;
 
-	Shader*            pShaders[2];
+	Shader*            pShaders[4];
 	RootSignature*     pRootSignature;
+	// Resolved once so text draws skip the descriptor name lookup
+	uint32_t           mRootConstantIndex;
+	uint32_t           mUniformBlockIndex;
 	DescriptorSet*     pDescriptorSets;
 	Pipeline*          pPipelines[2];
+	Pipeline*          pBatchPipelines[TEXT_BATCH_COUNT];
+	Pipeline*          pSdfPipelines[TEXT_BATCH_COUNT];
 	/// Default states
 	Sampler*             pDefaultSampler;
 	GPURingBuffer*       pUniformRingBuffer;
@@ -302,6 +856,14 @@ public:
 	float2               mDpiScale;
 	float                mDpiScaleMin;
 	bool                 mText3D;
+
+	// Text recorded since the last flush when batching
+	bool                      mBatching;
+	eastl::vector<TextVertex> mBatchVertices[TEXT_BATCH_COUNT];
+
+	eastl::vector<BakedFont>  mBakedFonts;
+	// Layout of immediate mode baked font text
+	eastl::vector<TextVertex> mBakedVertices;
 };
 
 bool Fontstash::init(Renderer* renderer, uint32_t width, uint32_t height, uint32_t ringSizeBytes)
@@ -336,6 +898,34 @@ void Fontstash::unload()
 	impl->unload();
 }
 
+void Fontstash::setBatching(bool enable)
+{
+	impl->mBatching = enable;
+	if (!enable)
+	{
+		for (uint32_t i = 0; i < TEXT_BATCH_COUNT; ++i)
+		{
+			impl->mBatchVertices[i].clear();
+			for (uint32_t f = 0; f < (uint32_t)impl->mBakedFonts.size(); ++f)
+				impl->mBakedFonts[f].mBatchVertices[i].clear();
+		}
+	}
+}
+
+bool Fontstash::isBatching() const
+{
+	return impl->mBatching;
+}
+
+void Fontstash::flush(Cmd* pCmd)
+{
+	if (impl->mBatching)
+		impl->flush(pCmd);
+
+	impl->mFrame++;
+	impl->mFrameCounted = true;
+}
+
 int Fontstash::defineFont(const char* identification, const char* pFontPath)
 {
 	FONScontext* fs = impl->pContext;
@@ -360,6 +950,26 @@ int Fontstash::defineFont(const char* identification, const char* pFontPath)
 	return INT32_MAX;
 }
 
+int Fontstash::defineBakedFont(const char* pBakedFontPath)
+{
+	FileStream fh = {};
+	if (!fsOpenStreamFromPath(RD_FONTS, pBakedFontPath, FM_READ_BINARY, &fh))
+		return INT32_MAX;
+
+	ssize_t  bytes = fsGetStreamFileSize(&fh);
+	uint8_t* buffer = (uint8_t*)tf_malloc(bytes);
+	fsReadFromStream(&fh, buffer, bytes);
+	fsCloseStream(&fh);
+
+	if (!impl->addBakedFont(buffer, (size_t)bytes, pBakedFontPath))
+	{
+		tf_free(buffer);
+		return INT32_MAX;
+	}
+
+	return FONTSTASH_BAKED_FONT_FLAG | (int)(impl->mBakedFonts.size() - 1);
+}
+
 void* Fontstash::getFontBuffer(uint32_t index)
 {
 	if (index < impl->mFontBuffers.size())
@@ -380,6 +990,14 @@ void Fontstash::drawText(
 {
 	impl->mText3D = false;
 	impl->pCmd = pCmd;
+
+	if (fontID & FONTSTASH_BAKED_FONT_FLAG)
+	{
+		impl->drawBakedText(
+			pCmd, fontID & ~FONTSTASH_BAKED_FONT_FLAG, message, x, y, size * impl->mDpiScaleMin, spacing * impl->mDpiScaleMin, color);
+		return;
+	}
+
 	// clamp the font size to max size.
 	// Precomputed font texture puts limitation to the maximum size.
 	size = min(size, m_fFontMaxSize);
@@ -406,6 +1024,14 @@ void Fontstash::drawText(
 	impl->mProjView = projView;
 	impl->mWorldMat = worldMat;
 	impl->pCmd = pCmd;
+
+	if (fontID & FONTSTASH_BAKED_FONT_FLAG)
+	{
+		impl->drawBakedText(
+			pCmd, fontID & ~FONTSTASH_BAKED_FONT_FLAG, message, 0.0f, 0.0f, size * impl->mDpiScaleMin, spacing * impl->mDpiScaleMin, color);
+		return;
+	}
+
 	// clamp the font size to max size.
 	// Precomputed font texture puts limitation to the maximum size.
 	size = min(size, m_fFontMaxSize);
@@ -433,6 +1059,17 @@ float Fontstash::measureText(
 	if (out_bounds == NULL)
 		return 0;
 
+	if (fontID & FONTSTASH_BAKED_FONT_FLAG)
+	{
+		const uint32_t fontIndex = fontID & ~FONTSTASH_BAKED_FONT_FLAG;
+		if (fontIndex >= (uint32_t)impl->mBakedFonts.size())
+			return 0;
+
+		return impl->layoutBakedText(
+			impl->mBakedFonts[fontIndex], message, x, y, size * impl->mDpiScaleMin, spacing * impl->mDpiScaleMin, color, false, NULL,
+			out_bounds);
+	}
+
 	const int    messageLength = (int)strlen(message);
 	FONScontext* fs = impl->pContext;
 	fonsSetSize(fs, size * impl->mDpiScaleMin);
@@ -455,52 +1092,54 @@ int _Impl_FontStash::fonsImplementationGenerateTexture(void* userPtr, int width,
 	ctx->mWidth = width;
 	ctx->mHeight = height;
 
-	ctx->mUpdateTexture = true;
-
 	return 1;
 }
 
 void _Impl_FontStash::fonsImplementationModifyTexture(void* userPtr, int* rect, const unsigned char* data)
 {
-	UNREF_PARAM(rect);
-
 	_Impl_FontStash* ctx = (_Impl_FontStash*)userPtr;
 
 	ctx->pPixels = data;
-	ctx->mUpdateTexture = true;
+
+	// Every atlas texture misses this region until its next upload
+	for (uint32_t i = 0; i < FONTSTASH_ATLAS_VERSION_COUNT; ++i)
+	{
+		int* dirty = ctx->mAtlas[i].mDirtyRect;
+		dirty[0] = min(dirty[0], rect[0]);
+		dirty[1] = min(dirty[1], rect[1]);
+		dirty[2] = max(dirty[2], rect[2]);
+		dirty[3] = max(dirty[3], rect[3]);
+	}
 }
 
 void _Impl_FontStash::fonsImplementationRenderText(
 	void* userPtr, const float* verts, const float* tcoords, const unsigned int* colors, int nverts)
 {
 	_Impl_FontStash* ctx = (_Impl_FontStash*)userPtr;
-	if (!ctx->pCurrentTexture)
-		return;
 
 	Cmd* pCmd = ctx->pCmd;
 
-	if (ctx->mUpdateTexture)
+	if (ctx->mBatching)
 	{
-		// #TODO: Investigate - Causes hang on low-mid end Android phones (tested on Samsung Galaxy A50s)
-#ifndef __ANDROID__
-		waitQueueIdle(pCmd->pQueue);
-#endif
-
-		SyncToken token = {};
-		TextureUpdateDesc updateDesc = {};
-		updateDesc.pTexture = ctx->pCurrentTexture;
-		beginUpdateResource(&updateDesc);
-		for (uint32_t r = 0; r < updateDesc.mRowCount; ++r)
+		// Bake the transform into the vertices so the text can join the frame's batch
+		const uint32_t                 batch = ctx->mText3D ? TEXT_BATCH_WORLD : TEXT_BATCH_SCREEN;
+		eastl::vector<TextVertex>& vertices = ctx->mBatchVertices[batch];
+		const size_t                   first = vertices.size();
+		vertices.resize(first + nverts);
+		TextVertex* vtx = vertices.data() + first;
+
+		for (int i = 0; i < nverts; i++)
 		{
-			memcpy(updateDesc.pMappedData + r * updateDesc.mDstRowStride,
-				ctx->pPixels + r * updateDesc.mSrcRowStride, updateDesc.mSrcRowStride);
+			vtx[i].mPosition = float4(verts[i * 2 + 0], verts[i * 2 + 1], 0.0f, 1.0f);
+			vtx[i].mTexCoord = float2(tcoords[i * 2 + 0], tcoords[i * 2 + 1]);
+			vtx[i].mColor = colors[i];
 		}
-		endUpdateResource(&updateDesc, &token);
-		waitForToken(&token);
-
-		ctx->mUpdateTexture = false;
+		ctx->toClipSpace(vtx, (uint32_t)nverts, ctx->mText3D);
+		return;
 	}
 
+	const uint32_t atlas = ctx->acquireAtlas(pCmd);
+
 	GPURingBufferOffset buffer = getGPURingBufferOffset(ctx->pMeshRingBuffer, nverts * sizeof(float4));
 	BufferUpdateDesc update = { buffer.pBuffer, buffer.mOffset };
 	beginUpdateResource(&update);
@@ -553,21 +1192,21 @@ void _Impl_FontStash::fonsImplementationRenderText(
 		const uint32_t stride = sizeof(float4);
 
 		DescriptorData params[1] = {};
-		params[0].pName = "uniformBlock_rootcbv";
+		params[0].mIndex = ctx->mUniformBlockIndex;
 		params[0].ppBuffers = &uniformBlock.pBuffer;
 		params[0].pOffsets = &uniformBlock.mOffset;
 		params[0].pSizes = &size;
-		updateDescriptorSet(ctx->pRenderer, pipelineIndex, ctx->pDescriptorSets, 1, params);
-		cmdBindDescriptorSet(pCmd, pipelineIndex, ctx->pDescriptorSets);
-		cmdBindPushConstants(pCmd, ctx->pRootSignature, "uRootConstants", &data);
+		updateDescriptorSet(ctx->pRenderer, getDescriptorSetIndex(atlas, pipelineIndex), ctx->pDescriptorSets, 1, params);
+		cmdBindDescriptorSet(pCmd, getDescriptorSetIndex(atlas, pipelineIndex), ctx->pDescriptorSets);
+		cmdBindPushConstantsByIndex(pCmd, ctx->pRootSignature, ctx->mRootConstantIndex, &data);
 		cmdBindVertexBuffer(pCmd, 1, &buffer.pBuffer, &stride, &buffer.mOffset);
 		cmdDraw(pCmd, nverts, 0);
 	}
 	else
 	{
 		const uint32_t stride = sizeof(float4);
-		cmdBindDescriptorSet(pCmd, pipelineIndex, ctx->pDescriptorSets);
-		cmdBindPushConstants(pCmd, ctx->pRootSignature, "uRootConstants", &data);
+		cmdBindDescriptorSet(pCmd, getDescriptorSetIndex(atlas, pipelineIndex), ctx->pDescriptorSets);
+		cmdBindPushConstantsByIndex(pCmd, ctx->pRootSignature, ctx->mRootConstantIndex, &data);
 		cmdBindVertexBuffer(pCmd, 1, &buffer.pBuffer, &stride, &buffer.mOffset);
 		cmdDraw(pCmd, nverts, 0);
 	}
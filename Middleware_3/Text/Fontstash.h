@@ -63,6 +63,11 @@ public:
 	//! - When it is paramount to be able to unload individual fonts, use multiple fontstashes.
 	int defineFont(const char* identification, const char* pFontPath);
 
+	//! Makes a font baked offline by the AssetPipeline (-pf) available to the font stash.
+	//! Its glyphs are a distance field that stays sharp at any size, and drawing never updates an atlas.
+	//! Only the baked glyphs can be drawn and blur is ignored. Returns INT32_MAX on failure.
+	int defineBakedFont(const char* pBakedFontPath);
+
 	void*       getFontBuffer(uint32_t index);
 	uint32_t    getFontBufferSize(uint32_t index);
 
@@ -76,6 +81,18 @@ public:
 		struct Cmd* pCmd, const char* message, const mat4& projView, const mat4& worldMat, int fontID, unsigned int color = 0xffffffff,
 		float size = 16.0f, float spacing = 0.0f, float blur = 0.0f);
 
+	//! Batched mode: drawText only records the text of the frame, which is then submitted by flush()
+	//! with at most one draw for world space text and one draw for screen space text.
+	//! Color and world transform are baked into the recorded vertices so any mix of them can share a batch.
+	void setBatching(bool enable);
+	bool isBatching() const;
+
+	//! Uploads and draws all the text recorded since the last flush when batching.
+	//! World space text is drawn first so screen space text always ends up on top.
+	//! Must be called once per frame, also when not batching: it lets the glyph atlas textures
+	//! the GPU is done with receive new glyphs without waiting on the queue.
+	void flush(struct Cmd* pCmd);
+
 	//! Measure text boundaries. Results will be written to out_bounds (x,y,x2,y2).
 	float measureText(
 		float* out_bounds, const char* message, float x, float y, int fontID, unsigned int color = 0xffffffff, float size = 16.0f,
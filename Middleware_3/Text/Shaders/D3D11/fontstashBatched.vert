@@ -0,0 +1,22 @@
+struct VsIn
+{
+	float4 position: Position;
+	float2 texCoord: TEXCOORD0;
+	float4 color: COLOR;
+};
+
+struct PsIn
+{
+	float4 position: SV_Position;
+	float2 texCoord: TEXCOORD0;
+	float4 color: COLOR;
+};
+
+PsIn main(VsIn In)
+{
+	PsIn Out;
+	Out.position = In.position;
+	Out.texCoord = In.texCoord;
+	Out.color = In.color;
+	return Out;
+}
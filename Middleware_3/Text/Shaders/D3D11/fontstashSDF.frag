@@ -0,0 +1,18 @@
+struct PsIn
+{
+	float4 position: SV_Position;
+	float2 texCoord: TEXCOORD0;
+	float4 color: COLOR;
+};
+
+Texture2D uTex0 : register(t1);
+SamplerState uSampler0 : register(s2);
+
+float4 main(PsIn In) : SV_Target
+{
+	// Distance field with the glyph edge at 0.5, antialiased over one screen pixel
+	float dist = uTex0.Sample(uSampler0, In.texCoord).r;
+	float width = fwidth(dist);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, dist);
+	return float4(1.0, 1.0, 1.0, alpha) * In.color;
+}
@@ -0,0 +1,42 @@
+#include <metal_stdlib>
+using namespace metal;
+
+struct Vertex_Shader
+{
+    struct VsIn
+    {
+        float4 position [[attribute(0)]];
+        float2 texCoord [[attribute(1)]];
+        float4 color [[attribute(2)]];
+    };
+    struct PsIn
+    {
+        float4 position [[position]];
+        float2 texCoord;
+        float4 color;
+    };
+    PsIn main(VsIn In)
+    {
+        PsIn Out;
+        ((Out).position = (In).position);
+        ((Out).texCoord = (In).texCoord);
+        ((Out).color = (In).color);
+        return Out;
+    };
+
+    Vertex_Shader()
+    {
+    }
+};
+
+vertex Vertex_Shader::PsIn stageMain(
+                                     Vertex_Shader::VsIn In                                           [[stage_in]]
+)
+{
+    Vertex_Shader::VsIn In0;
+    In0.position = In.position;
+    In0.texCoord = In.texCoord;
+    In0.color = In.color;
+    Vertex_Shader main;
+    return main.main(In0);
+}
@@ -0,0 +1,40 @@
+#include <metal_stdlib>
+using namespace metal;
+
+struct Fragment_Shader
+{
+    struct PsIn
+    {
+        float4 position [[position]];
+        float2 texCoord;
+        float4 color;
+    };
+    texture2d<float> uTex0;
+    sampler uSampler0;
+    float4 main(PsIn In)
+    {
+        // Distance field with the glyph edge at 0.5, antialiased over one screen pixel
+        float dist = uTex0.sample(uSampler0, (In).texCoord).r;
+        float width = fwidth(dist);
+        float alpha = smoothstep((0.5 - width), (0.5 + width), dist);
+        return (float4(1.0, 1.0, 1.0, alpha) * (In).color);
+    };
+
+    Fragment_Shader(
+texture2d<float> uTex0,sampler uSampler0) :
+uTex0(uTex0),uSampler0(uSampler0) {}
+};
+
+fragment float4 stageMain(
+                          Fragment_Shader::PsIn In                                           [[stage_in]],
+						  texture2d<float> uTex0                                       [[texture(0)]],
+						  sampler uSampler0                                                   [[sampler(0)]]
+)
+{
+    Fragment_Shader::PsIn In0;
+    In0.position = float4(In.position.xyz, 1.0 / In.position.w);
+    In0.texCoord = In.texCoord;
+    In0.color = In.color;
+    Fragment_Shader main(uTex0, uSampler0);
+    return main.main(In0);
+}
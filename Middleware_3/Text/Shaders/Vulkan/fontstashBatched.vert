@@ -0,0 +1,42 @@
+#version 450 core
+
+layout(location = 0) in vec4 Position;
+layout(location = 1) in vec2 TEXCOORD0;
+layout(location = 2) in vec4 COLOR;
+layout(location = 0) out vec2 vertOutput_TEXCOORD0;
+layout(location = 1) out vec4 vertOutput_COLOR;
+
+struct VsIn
+{
+    vec4 position;
+    vec2 texCoord;
+    vec4 color;
+};
+
+struct PsIn
+{
+    vec4 position;
+    vec2 texCoord;
+    vec4 color;
+};
+
+PsIn HLSLmain(VsIn In)
+{
+    PsIn Out;
+    ((Out).position = (In).position);
+    ((Out).texCoord = (In).texCoord);
+    ((Out).color = (In).color);
+    return Out;
+}
+
+void main()
+{
+    VsIn In;
+    In.position = Position;
+    In.texCoord = TEXCOORD0;
+    In.color = COLOR;
+    PsIn result = HLSLmain(In);
+    gl_Position = result.position;
+    vertOutput_TEXCOORD0 = result.texCoord;
+    vertOutput_COLOR = result.color;
+}
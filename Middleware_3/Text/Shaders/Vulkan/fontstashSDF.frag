@@ -0,0 +1,34 @@
+#version 450 core
+
+layout(location = 0) in vec2 fragInput_TEXCOORD0;
+layout(location = 1) in vec4 fragInput_COLOR;
+layout(location = 0) out vec4 rast_FragData0; 
+
+struct PsIn
+{
+    vec4 position;
+    vec2 texCoord;
+    vec4 color;
+};
+
+layout(set = 0, binding = 2) uniform texture2D uTex0;
+layout(set = 0, binding = 3) uniform sampler uSampler0;
+
+vec4 HLSLmain(PsIn In)
+{
+    // Distance field with the glyph edge at 0.5, antialiased over one screen pixel
+    float dist = (texture(sampler2D( uTex0, uSampler0), vec2((In).texCoord))).r;
+    float width = fwidth(dist);
+    float alpha = smoothstep((0.5 - width), (0.5 + width), dist);
+    return (vec4(1.0, 1.0, 1.0, alpha) * (In).color);
+}
+
+void main()
+{
+    PsIn In;
+    In.position = vec4(gl_FragCoord.xyz, 1.0 / gl_FragCoord.w);
+    In.texCoord = fragInput_TEXCOORD0;
+    In.color = fragInput_COLOR;
+    vec4 result = HLSLmain(In);
+    rast_FragData0 = result;
+}
@@ -33,6 +33,7 @@
 #include "../../Common_3/ThirdParty/OpenSource/EASTL/vector.h"
 
 #include "../../Middleware_3/Text/Fontstash.h"
+#include "../../Middleware_3/Text/BakedFontFormat.h"
 #include "../../Common_3/ThirdParty/OpenSource/tinyimageformat/tinyimageformat_query.h"
 
 #include "../../Common_3/OS/Interfaces/IMemory.h"
@@ -387,10 +388,12 @@ bool UIApp::Init(Renderer* renderer, PipelineCache* pCache)
 
 	pImpl->pFontStash = tf_new(Fontstash);
 	bool success = pImpl->pFontStash->init(renderer, mFontAtlasSize, mFontAtlasSize, mFontstashRingSizeBytes);
+	pImpl->pFontStash->setBatching(mBatchText);
 
 	initGUIDriver(pImpl->pRenderer, &pDriver);
 	if (pCustomShader)
 		pDriver->setCustomShader(pCustomShader);
+	pDriver->setSkipUnchangedUploads(mSkipUnchangedGuiUploads);
 	success &= pDriver->init(pImpl->pRenderer, mMaxDynamicUIUpdatesPerBatch);
 
 	return success;
@@ -430,7 +433,12 @@ void UIApp::Unload()
 
 uint32_t UIApp::LoadFont(const char* pFontPath)
 {
-	uint32_t fontID = (uint32_t)pImpl->pFontStash->defineFont("default", pFontPath);
+	// Fonts baked by the AssetPipeline are drawn from their distance field atlas
+	char extension[FS_MAX_PATH] = {};
+	fsGetPathExtension(pFontPath, extension);
+	uint32_t fontID = (strcmp(extension, BAKED_FONT_EXTENSION) == 0)
+						  ? (uint32_t)pImpl->pFontStash->defineBakedFont(pFontPath)
+						  : (uint32_t)pImpl->pFontStash->defineFont("default", pFontPath);
 	ASSERT(fontID != -1);
 
 	return fontID;
@@ -542,6 +550,9 @@ void UIApp::Update(float deltaTime)
 
 void UIApp::Draw(Cmd* pCmd)
 {
+	// Text recorded this frame in batched mode, also ends the frame for the glyph atlas
+	pImpl->pFontStash->flush(pCmd);
+
 	if (pImpl->mUpdated)
 	{
 		pImpl->mUpdated = false;
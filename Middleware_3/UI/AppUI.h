@@ -889,6 +889,9 @@ public:
 	// For GUI with custom shaders not necessary in a normal application
 	virtual void setCustomShader(Shader* pShader) = 0;
 
+	// Skips copying the GUI geometry to the GPU when the buffers of the frame already hold the same geometry
+	virtual void setSkipUnchangedUploads(bool skip) = 0;
+
 	virtual bool addFont(void* pFontBuffer, uint32_t fontBufferSize, void* pFontGlyphRanges, float fontSize, uintptr_t* pFont) = 0;
 
 	virtual void* getContext() = 0;
@@ -974,6 +977,14 @@ public:
 	Shader*           pCustomShader = NULL;
 	PipelineCache*    pPipelineCache = NULL;
 
+	// When true (set before Init), DrawText and DrawTextInWorldSpace only record the text
+	// and Draw submits all of it with one draw per text space before drawing the GUI.
+	bool mBatchText = false;
+
+	// When true (set before Init), the GUI geometry is hashed every frame and only copied to the GPU when it changed.
+	// Saves the upload for mostly static UIs such as tools.
+	bool mSkipUnchangedGuiUploads = false;
+
 	// Following var is useful for seeing UI capabilities and tweaking style settings.
 	// Will only take effect if at least one GUI Component is active.
 	bool mShowDemoUiWindow;
@@ -287,6 +287,8 @@ class ImguiGUIDriver: public GUIDriver
 		mCustomShader = true;
 	}
 
+	void setSkipUnchangedUploads(bool skip) { mSkipUnchangedUploads = skip; }
+
 	static void* alloc_func(size_t size, void* user_data) { return tf_malloc(size); }
 
 	static void dealloc_func(void* ptr, void* user_data) { tf_free(ptr); }
@@ -301,12 +303,27 @@ class ImguiGUIDriver: public GUIDriver
 	Renderer*          pRenderer;
 	Shader*            pShaderTextured;
 	RootSignature*     pRootSignatureTextured;
+	uint32_t           mTextureIndex;
 	DescriptorSet*     pDescriptorSetUniforms;
 	DescriptorSet*     pDescriptorSetTexture;
 	Pipeline*          pPipelineTextured;
-	Buffer*            pVertexBuffer;
-	Buffer*            pIndexBuffer;
+	Buffer*            pVertexBuffer[MAX_FRAMES];
+	Buffer*            pIndexBuffer[MAX_FRAMES];
 	Buffer*            pUniformBuffer[MAX_FRAMES];
+	// Sizes of the vertex and index buffers, which grow when a frame does not fit
+	uint64_t           mVertexBufferSize[MAX_FRAMES];
+	uint64_t           mIndexBufferSize[MAX_FRAMES];
+	// Hash of the draw data in the vertex and index buffers of each frame, 0 when unknown
+	size_t             mUploadHash[MAX_FRAMES];
+	// Buffers replaced by larger ones, released once the GPU can no longer be reading them
+	struct RetiredBuffer
+	{
+		Buffer*  pBuffer;
+		uint32_t mFrame;
+	};
+	eastl::vector<RetiredBuffer> mRetiredBuffers;
+	// Number of frames started with update, the frame a buffer was retired in is compared to it
+	uint32_t                     mFrameCount;
 	/// Default states
 	Sampler*         pDefaultSampler;
 	VertexLayout     mVertexLayoutTextured = {};
@@ -319,12 +336,25 @@ class ImguiGUIDriver: public GUIDriver
 	float2           mLastUpdateMax[64] = {};
 	bool             mActive;
 	bool             mCustomShader;
+	bool             mSkipUnchangedUploads;
 	bool             mPostUpdateKeyDownStates[512];
 };
 
+// Initial sizes of the per frame vertex and index buffers
 static const uint64_t VERTEX_BUFFER_SIZE = 1024 * 64 * sizeof(ImDrawVert);
 static const uint64_t INDEX_BUFFER_SIZE = 128 * 1024 * sizeof(ImDrawIdx);
 
+static void addGeometryBuffer(DescriptorType descriptors, uint64_t size, Buffer** ppBuffer)
+{
+	BufferLoadDesc desc = {};
+	desc.mDesc.mDescriptors = descriptors;
+	desc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
+	desc.mDesc.mSize = size;
+	desc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT;
+	desc.ppBuffer = ppBuffer;
+	addResource(&desc, NULL);
+}
+
 void initGUIDriver(Renderer* pRenderer, GUIDriver** ppDriver)
 {
 	ImguiGUIDriver* pDriver = tf_new(ImguiGUIDriver);
@@ -781,6 +811,7 @@ bool ImguiGUIDriver::init(Renderer* renderer, uint32_t const maxDynamicUIUpdates
 	pRenderer = renderer;
 	mMaxDynamicUIUpdatesPerBatch = maxDynamicUIUpdatesPerBatch;
 	mActive = true;
+	mFrameCount = 0;
 	memset(mPostUpdateKeyDownStates, false, sizeof(mPostUpdateKeyDownStates));
 	/************************************************************************/
 	// Rendering resources
@@ -819,25 +850,21 @@ bool ImguiGUIDriver::init(Renderer* renderer, uint32_t const maxDynamicUIUpdates
 	textureRootDesc.ppStaticSamplerNames = pStaticSamplerNames;
 	textureRootDesc.ppStaticSamplers = &pDefaultSampler;
 	addRootSignature(pRenderer, &textureRootDesc, &pRootSignatureTextured);
+	mTextureIndex = getDescriptorIndexFromName(pRootSignatureTextured, "uTex");
 
 	DescriptorSetDesc setDesc = { pRootSignatureTextured, DESCRIPTOR_UPDATE_FREQ_PER_BATCH, 1 + (maxDynamicUIUpdatesPerBatch * MAX_FRAMES) };
 	addDescriptorSet(pRenderer, &setDesc, &pDescriptorSetTexture);
 	setDesc = { pRootSignatureTextured, DESCRIPTOR_UPDATE_FREQ_NONE, MAX_FRAMES };
 	addDescriptorSet(pRenderer, &setDesc, &pDescriptorSetUniforms);
 
-	BufferLoadDesc vbDesc = {};
-	vbDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_VERTEX_BUFFER;
-	vbDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
-	vbDesc.mDesc.mSize = VERTEX_BUFFER_SIZE * MAX_FRAMES;
-	vbDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT;
-	vbDesc.ppBuffer = &pVertexBuffer;
-	addResource(&vbDesc, NULL);
-
-	BufferLoadDesc ibDesc = vbDesc;
-	ibDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_INDEX_BUFFER;
-	ibDesc.mDesc.mSize = INDEX_BUFFER_SIZE * MAX_FRAMES;
-	ibDesc.ppBuffer = &pIndexBuffer;
-	addResource(&ibDesc, NULL);
+	for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+	{
+		mVertexBufferSize[i] = VERTEX_BUFFER_SIZE;
+		mIndexBufferSize[i] = INDEX_BUFFER_SIZE;
+		mUploadHash[i] = 0;
+		addGeometryBuffer(DESCRIPTOR_TYPE_VERTEX_BUFFER, mVertexBufferSize[i], &pVertexBuffer[i]);
+		addGeometryBuffer(DESCRIPTOR_TYPE_INDEX_BUFFER, mIndexBufferSize[i], &pIndexBuffer[i]);
+	}
 
 	BufferLoadDesc ubDesc = {};
 	ubDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_UNIFORM_BUFFER;
@@ -907,10 +934,16 @@ void ImguiGUIDriver::exit()
 	removeDescriptorSet(pRenderer, pDescriptorSetTexture);
 	removeDescriptorSet(pRenderer, pDescriptorSetUniforms);
 	removeRootSignature(pRenderer, pRootSignatureTextured);
-	removeResource(pVertexBuffer);
-	removeResource(pIndexBuffer);
 	for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+	{
+		removeResource(pVertexBuffer[i]);
+		removeResource(pIndexBuffer[i]);
 		removeResource(pUniformBuffer[i]);
+	}
+
+	for (RetiredBuffer& retired : mRetiredBuffers)
+		removeResource(retired.pBuffer);
+	mRetiredBuffers.set_capacity(0);
 
 	for (Texture*& pFontTexture : mFontTextures)
 		removeResource(pFontTexture);
@@ -980,7 +1013,7 @@ bool ImguiGUIDriver::addFont(void* pFontBuffer, uint32_t fontBufferSize, void* p
 	io.Fonts->TexID = (void*)(mFontTextures.size() - 1);
 
 	DescriptorData params[1] = {};
-	params[0].pName = "uTex";
+	params[0].mIndex = mTextureIndex;
 	params[0].ppTextures = &pTexture;
 	updateDescriptorSet(pRenderer, (uint32_t)mFontTextures.size() - 1, pDescriptorSetTexture, 1, params);
 
@@ -1054,6 +1087,21 @@ bool ImguiGUIDriver::update(GUIUpdate* pGuiUpdate)
 	
 	ImGui::NewFrame();
 
+	// At most MAX_FRAMES frames are in flight, so buffers retired before them are no longer read by the GPU
+	++mFrameCount;
+	for (uint32_t i = 0; i < (uint32_t)mRetiredBuffers.size();)
+	{
+		if (mFrameCount - mRetiredBuffers[i].mFrame > MAX_FRAMES)
+		{
+			removeResource(mRetiredBuffers[i].pBuffer);
+			mRetiredBuffers.erase_unsorted(mRetiredBuffers.begin() + i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
 	bool ret = false;
 
 	if (mActive)
@@ -1221,38 +1269,67 @@ void ImguiGUIDriver::draw(Cmd* pCmd)
 
 	Pipeline*            pPipeline = pPipelineTextured;
 
-	uint32_t vSize = 0;
-	uint32_t iSize = 0;
+	uint64_t vSize = 0;
+	uint64_t iSize = 0;
 	for (int n = 0; n < draw_data->CmdListsCount; n++)
 	{
 		const ImDrawList* cmd_list = draw_data->CmdLists[n];
-		vSize += (int)(cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
-		iSize += (int)(cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
+		vSize += cmd_list->VtxBuffer.size() * sizeof(ImDrawVert);
+		iSize += cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx);
 	}
 
-	vSize = min<uint32_t>(vSize, VERTEX_BUFFER_SIZE);
-	iSize = min<uint32_t>(iSize, INDEX_BUFFER_SIZE);
+	// Grow the buffers of this frame when the draw data does not fit. frameIdx advances with every draw, not with every
+	// GPU frame, so the GPU may still read the old buffers and they are only released after MAX_FRAMES frames
+	if (vSize > mVertexBufferSize[frameIdx])
+	{
+		mRetiredBuffers.push_back({ pVertexBuffer[frameIdx], mFrameCount });
+		mVertexBufferSize[frameIdx] = max(vSize, mVertexBufferSize[frameIdx] * 2);
+		addGeometryBuffer(DESCRIPTOR_TYPE_VERTEX_BUFFER, mVertexBufferSize[frameIdx], &pVertexBuffer[frameIdx]);
+		mUploadHash[frameIdx] = 0;
+	}
+	if (iSize > mIndexBufferSize[frameIdx])
+	{
+		mRetiredBuffers.push_back({ pIndexBuffer[frameIdx], mFrameCount });
+		mIndexBufferSize[frameIdx] = max(iSize, mIndexBufferSize[frameIdx] * 2);
+		addGeometryBuffer(DESCRIPTOR_TYPE_INDEX_BUFFER, mIndexBufferSize[frameIdx], &pIndexBuffer[frameIdx]);
+		mUploadHash[frameIdx] = 0;
+	}
 
-	// Copy and convert all vertices into a single contiguous buffer
-	uint64_t vOffset = frameIdx * VERTEX_BUFFER_SIZE;
-	uint64_t iOffset = frameIdx * INDEX_BUFFER_SIZE;
-	uint64_t vtx_dst = vOffset;
-	uint64_t idx_dst = iOffset;
-	for (int n = 0; n < draw_data->CmdListsCount; n++)
+	// Static UIs produce the same draw data every frame, which the buffers of this frame may already hold
+	size_t hash = 0;
+	if (mSkipUnchangedUploads)
 	{
-		const ImDrawList* cmd_list = draw_data->CmdLists[n];
-		BufferUpdateDesc  update = { pVertexBuffer, vtx_dst };
-		beginUpdateResource(&update);
-		memcpy(update.pMappedData, cmd_list->VtxBuffer.data(), cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
-		endUpdateResource(&update, NULL);
-
-		update = { pIndexBuffer, idx_dst };
-		beginUpdateResource(&update);
-		memcpy(update.pMappedData, cmd_list->IdxBuffer.data(), cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
-		endUpdateResource(&update, NULL);
-
-		vtx_dst += (cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
-		idx_dst += (cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
+		hash = tf_mem_hash<uint64_t>(&vSize, 1);
+		for (int n = 0; n < draw_data->CmdListsCount; n++)
+		{
+			const ImDrawList* cmd_list = draw_data->CmdLists[n];
+			hash = tf_mem_hash<uint32_t>(
+				(const uint32_t*)cmd_list->VtxBuffer.data(), cmd_list->VtxBuffer.size() * sizeof(ImDrawVert) / sizeof(uint32_t), hash);
+			hash = tf_mem_hash<ImDrawIdx>(cmd_list->IdxBuffer.data(), cmd_list->IdxBuffer.size(), hash);
+		}
+	}
+
+	// Copy all vertices and indices into the buffers of this frame with one mapping each
+	if (!mSkipUnchangedUploads || hash != mUploadHash[frameIdx])
+	{
+		BufferUpdateDesc vertexUpdate = { pVertexBuffer[frameIdx], 0, vSize };
+		BufferUpdateDesc indexUpdate = { pIndexBuffer[frameIdx], 0, iSize };
+		beginUpdateResource(&vertexUpdate);
+		beginUpdateResource(&indexUpdate);
+		uint8_t* vtx_dst = (uint8_t*)vertexUpdate.pMappedData;
+		uint8_t* idx_dst = (uint8_t*)indexUpdate.pMappedData;
+		for (int n = 0; n < draw_data->CmdListsCount; n++)
+		{
+			const ImDrawList* cmd_list = draw_data->CmdLists[n];
+			memcpy(vtx_dst, cmd_list->VtxBuffer.data(), cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
+			memcpy(idx_dst, cmd_list->IdxBuffer.data(), cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
+			vtx_dst += cmd_list->VtxBuffer.size() * sizeof(ImDrawVert);
+			idx_dst += cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx);
+		}
+		endUpdateResource(&vertexUpdate, NULL);
+		endUpdateResource(&indexUpdate, NULL);
+
+		mUploadHash[frameIdx] = hash;
 	}
 
 	float L = draw_data->DisplayPos.x;
@@ -1277,8 +1354,9 @@ void ImguiGUIDriver::draw(Cmd* pCmd)
 		pCmd, (uint32_t)draw_data->DisplayPos.x, (uint32_t)draw_data->DisplayPos.y, (uint32_t)draw_data->DisplaySize.x,
 		(uint32_t)draw_data->DisplaySize.y);
 	cmdBindPipeline(pCmd, pPipeline);
-	cmdBindIndexBuffer(pCmd, pIndexBuffer, INDEX_TYPE_UINT16, iOffset);
-	cmdBindVertexBuffer(pCmd, 1, &pVertexBuffer, &vertexStride, &vOffset);
+	const uint64_t vOffset = 0;
+	cmdBindIndexBuffer(pCmd, pIndexBuffer[frameIdx], INDEX_TYPE_UINT16, 0);
+	cmdBindVertexBuffer(pCmd, 1, &pVertexBuffer[frameIdx], &vertexStride, &vOffset);
 
 	cmdBindDescriptorSet(pCmd, frameIdx, pDescriptorSetUniforms);
 
@@ -1311,7 +1389,7 @@ void ImguiGUIDriver::draw(Cmd* pCmd)
 				{
 					uint32_t setIndex = (uint32_t)mFontTextures.size() + (frameIdx * mMaxDynamicUIUpdatesPerBatch + mDynamicUIUpdates);
 					DescriptorData params[1] = {};
-					params[0].pName = "uTex";
+					params[0].mIndex = mTextureIndex;
 					params[0].ppTextures = (Texture**)&pcmd->TextureId;
 					updateDescriptorSet(pRenderer, setIndex, pDescriptorSetTexture, 1, params);
 					cmdBindDescriptorSet(pCmd, setIndex, pDescriptorSetTexture);